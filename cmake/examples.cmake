@@ -29,12 +29,37 @@ if(LPSM_BUILD_TEST AND NOT EMSCRIPTEN)
         sentence_count_equal
         paragraph_count_in_bounds
         paragraph_count_equal
+        source_word_view
+        sink_matches_string
+        into_appends
+        engine_reproducible
+        sampler_in_bounds
+        weighted_table
+        predicted_size
+        compile_time
+        analyze_text
+        tag_scanner
+        text_stats_accumulator
     )
     if(NOT LPSM_MIN_BUILD)
         list(APPEND LPSM_TESTS_LIST
             md_sentence_count_in_bounds
             md_paragraph_count_equal
             md_text_count_equal
+            source_tokenizer
+            source_compiled
+            source_registry
+            word_frequencies
+            markov_source
+            parallel_generator
+            generator_pool
+            random_access
+            text_views
+            chunk_streams
+            byte_budget
+            format_policies
+            html_escaping
+            json_writer
         )
     endif()
     foreach(test IN LISTS LPSM_TESTS_LIST)
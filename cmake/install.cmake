@@ -50,6 +50,9 @@ write_basic_package_version_file(
 file(
     WRITE "${CMAKE_CURRENT_BINARY_DIR}/${PROJECT_NAME}Config.cmake"
     "include(CMakeFindDependencyMacro)\n"
+    "if(NOT ${LPSM_MIN_BUILD} AND NOT EMSCRIPTEN)\n"
+    "    find_dependency(Threads)\n"
+    "endif()\n"
     "include(\"\${CMAKE_CURRENT_LIST_DIR}/${PROJECT_NAME}Targets.cmake\")\n"
 )
 
@@ -1,17 +1,52 @@
 #!/bin/python3
 # Basic script that splits a source "lorem ipsum" into the unique
 # words it uses. It outputs it in C++ syntax to be put in sample.inl.
+# With two arguments, it instead compiles a single source into a
+# .lpsmsrc file that lpsm::Source::load() can use without splitting:
+#   python3 split.py <source.txt> <output.lpsmsrc>
 import re
+import struct
 import sys
 from collections import Counter
 
-def count_unique_words(filename):
+# layout of .lpsmsrc files, see src/lipsum/core/sourcefile.hpp
+LPSMSRC_MAGIC = b"LPSMSRC\0"
+LPSMSRC_VERSION = 1
+LPSMSRC_HAS_WEIGHTS = 1
+
+def count_words(filename):
+    with open(filename, "r", encoding="utf-8") as f:
+        text = f.read()
+    # the same words as lpsm::Source::load(): runs of ASCII letters, digits,
+    # underscores, hyphens and apostrophes, in lowercase
+    words = re.findall(r"[A-Za-z0-9_'\-]+", text)
+    return Counter(word.lower() for word in words)
+
+def count_sample_words(filename):
+    # the split the built-in sources in sample.inl were made with, which
+    # keeps words such as "h*ck" and "30,000" whole; kept so that running
+    # this script again does not change them
     with open(filename, "r", encoding="utf-8") as f:
         text = f.read()
     words = re.findall(r"\b[\w'-_]+\b", text.lower())
-    word_counts = Counter(words)
-    unique_words = list(word_counts.keys())
-    return unique_words
+    return Counter(words)
+
+def write_lpsmsrc(word_counts, filename):
+    # words in order of first appearance, weighted by how often they appear
+    words = [word.encode("utf-8") for word in word_counts.keys()]
+    weights = [min(count, 0xFFFFFFFF) for count in word_counts.values()]
+    offsets = [0]
+    for word in words:
+        offsets.append(offsets[-1] + len(word))
+    with open(filename, "wb") as f:
+        f.write(LPSMSRC_MAGIC)
+        f.write(struct.pack("<IIQQ", LPSMSRC_VERSION, LPSMSRC_HAS_WEIGHTS,
+                            len(words), offsets[-1]))
+        f.write(struct.pack(f"<{len(offsets)}Q", *offsets))
+        f.write(struct.pack(f"<{len(weights)}I", *weights))
+        if len(weights) % 2 == 1:
+            f.write(b"\0" * 4)
+        f.write(b"".join(words))
 
 def write_array(array, name, f):
     f.write("static constexpr std::array<const char*, " + str(len(array)) + "> " 
@@ -20,11 +55,22 @@ def write_array(array, name, f):
         f.write(f"\"{word}\",\n")
     f.write("};\n")
 
+def write_counts(word_counts, name, f):
+    f.write("static constexpr std::array<std::uint32_t, "
+            + str(len(word_counts)) + "> " + name + " = {")
+    for count in word_counts.values():
+        f.write(f"{count},\n")
+    f.write("};\n")
+
 if __name__ == "__main__":
-    lorem_ipsum = count_unique_words("lipsum.txt")
-    cat_ipsum = count_unique_words("catipsum.txt")
-    dog_ipsum = count_unique_words("dogipsum.txt")
-    corpo_ipsum = count_unique_words("corporateipsum.txt")
+    if len(sys.argv) == 3:
+        write_lpsmsrc(count_words(sys.argv[1]), sys.argv[2])
+        sys.exit(0)
+
+    lorem_ipsum = count_sample_words("lipsum.txt")
+    cat_ipsum = count_sample_words("catipsum.txt")
+    dog_ipsum = count_sample_words("dogipsum.txt")
+    corpo_ipsum = count_sample_words("corporateipsum.txt")
 
     with open("../src/lipsum/core/sample.inl", "w") as file:
         file.write("""/** 
@@ -33,17 +79,23 @@ if __name__ == "__main__":
  * @brief File containing all of the words used by lipsum::Source
  * 
  * This file contains constexpr arrays of strings,
- * each a word in the original samples.
+ * each a word in the original samples, and of
+ * how many times each word appears in them.
  * 
  * @author LambBread from github.com
  */
 #pragma once
 
 """)
-        write_array(lorem_ipsum, "LIPSUM_VEC", file)
+        write_array(list(lorem_ipsum.keys()), "LIPSUM_VEC", file)
         file.write("#ifndef LIPSUM_MIN_BUILD\n")
-        write_array(cat_ipsum, "CAT_IPSUM", file)
-        write_array(dog_ipsum, "DOG_IPSUM", file)
-        write_array(corpo_ipsum, "CORPO_IPSUM", file)
+        write_array(list(cat_ipsum.keys()), "CAT_IPSUM", file)
+        write_array(list(dog_ipsum.keys()), "DOG_IPSUM", file)
+        write_array(list(corpo_ipsum.keys()), "CORPO_IPSUM", file)
+        # how often each word appears, for frequency-weighted sampling
+        write_counts(lorem_ipsum, "LIPSUM_COUNTS", file)
+        write_counts(cat_ipsum, "CAT_COUNTS", file)
+        write_counts(dog_ipsum, "DOG_COUNTS", file)
+        write_counts(corpo_ipsum, "CORPO_COUNTS", file)
         file.write("#endif\n")
 
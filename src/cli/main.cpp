@@ -15,9 +15,6 @@
         varName = lpsm::internal::ToType<type>(commandOpts.at(idx - 1));       \
     }
 
-#define NUM_AND_USELIPSUM_SUBCOMMAND(name)                                     \
-    DOUBLE_ARG_SUBCOMMAND(name, int, 1, bool, true)
-
 #define SINGLE_ARG_SUBCOMMAND(name, type, defaultVal)                          \
     if (subcommand == #name)                                                   \
     {                                                                          \
@@ -35,6 +32,32 @@
         (*ostr) << gen.name(argName1, argName2);                               \
     }
 
+// streamed subcommands write through a lpsm::StreamSink, so large outputs are
+// never held in memory at once
+
+#define NUM_AND_USELIPSUM_SINK_SUBCOMMAND(name)                                \
+    DOUBLE_ARG_SINK_SUBCOMMAND(name, int, 1, bool, true)
+
+#define SINGLE_ARG_SINK_SUBCOMMAND(name, type, defaultVal)                     \
+    if (subcommand == #name)                                                   \
+    {                                                                          \
+        type argName = defaultVal;                                             \
+        GET_ARG(argName, 2, type);                                             \
+        lpsm::StreamSink sink(*ostr);                                          \
+        gen.name##_to(sink, argName);                                          \
+    }
+#define DOUBLE_ARG_SINK_SUBCOMMAND(                                            \
+        name, type1, defaultVal1, type2, defaultVal2)                          \
+    if (subcommand == #name)                                                   \
+    {                                                                          \
+        type1 argName1 = defaultVal1;                                          \
+        type2 argName2 = defaultVal2;                                          \
+        GET_ARG(argName1, 2, type1);                                           \
+        GET_ARG(argName2, 3, type2);                                           \
+        lpsm::StreamSink sink(*ostr);                                          \
+        gen.name##_to(sink, argName1, argName2);                               \
+    }
+
 #define NO_ARG_SUBCOMMAND(name)                                                \
     if (subcommand == #name)                                                   \
     {                                                                          \
@@ -80,6 +103,99 @@ lpsm::ArgVec2 ParseAv2(const std::string& str)
     return ret;
 }
 
+bool LoadEngine(const std::string& name, lpsm::Generator& gen)
+{
+    constexpr std::array<lpsm::EngineType, 6> TYPES = {
+            lpsm::EngineType::MT19937,
+            lpsm::EngineType::Xoshiro256ss,
+            lpsm::EngineType::Pcg32,
+            lpsm::EngineType::Pcg64,
+            lpsm::EngineType::WyRand,
+            lpsm::EngineType::Philox4x32};
+    for (lpsm::EngineType type : TYPES)
+    {
+        if (lpsm::Engine::name(type) == name)
+        {
+            gen.load_engine(type);
+            return true;
+        }
+    }
+    return false;
+}
+
+// the slice of the units of a subcommand that this process generates, from
+// --shard=<index>/<count>
+struct Shard
+{
+    std::uint64_t index = 0;
+    std::uint64_t count = 0; // 0 when not sharding
+};
+
+#ifndef LIPSUM_MIN_BUILD
+bool ParseShard(const std::string& value, Shard& shard)
+{
+    size_t pos = value.find('/');
+    if (pos == std::string::npos)
+    {
+        return false;
+    }
+    shard.index = lpsm::internal::ToType<std::uint64_t>(value.substr(0, pos));
+    shard.count = lpsm::internal::ToType<std::uint64_t>(value.substr(pos + 1));
+    return shard.index < shard.count;
+}
+
+bool IsShardable(const std::string& subcommand)
+{
+    return subcommand == "word" || subcommand == "sentence" ||
+           subcommand == "paragraph" || subcommand == "csv";
+}
+
+int ShardLogic(const std::vector<std::string>& commandOpts,
+               std::ostream*                   ostr,
+               lpsm::Generator&                gen,
+               const Shard&                    shard)
+{
+    constexpr std::uint64_t UNITS_PER_CHUNK = 64;
+
+    const std::string& subcommand = commandOpts.at(0);
+    std::uint64_t      num        = 1;
+    bool               useLipsum  = true;
+    GET_ARG(num, 2, std::uint64_t);
+    GET_ARG(useLipsum, 3, bool);
+
+    // split num units into count near-equal runs without overflowing
+    auto start = [&](std::uint64_t index)
+    {
+        return (num / shard.count * index) +
+               (num % shard.count * index / shard.count);
+    };
+    std::uint64_t    last = start(shard.index + 1);
+    lpsm::StreamSink sink(*ostr);
+    for (std::uint64_t i = start(shard.index); i < last; i += UNITS_PER_CHUNK)
+    {
+        auto chunk = static_cast<int>(std::min(UNITS_PER_CHUNK, last - i));
+        if (subcommand == "word")
+        {
+            gen.word_at_into(sink.buffer(), i, chunk);
+        }
+        else if (subcommand == "sentence")
+        {
+            gen.sentence_at_into(sink.buffer(), i, chunk, useLipsum);
+        }
+        else if (subcommand == "paragraph")
+        {
+            gen.paragraph_at_into(sink.buffer(), i, chunk, useLipsum);
+        }
+        else
+        {
+            gen.csv_at_into(sink.buffer(), i, chunk);
+        }
+        sink.commit();
+    }
+    return 0;
+}
+#endif
+
 void SettingOption(const std::string& option,
                    const std::string& name,
                    lpsm::Generator&   gen)
@@ -109,10 +225,21 @@ void Help(const std::string& page)
         std::cout << "  --help, -h - Show this help\n";
         std::cout << "  --version, -v - Show the current version of lipsum-cpp.\n";
         std::cout << "  --seed=<seed>, -E - Load specified seed.\n";
+        std::cout << "  --engine=<engine>, -e - Load specified random engine.\n";
+        std::cout << "      Engines include: mt19937 (default), xoshiro256ss, pcg32, pcg64, wyrand, philox4x32.\n";
         std::cout << "  --output=<file>, -o - Output to the specified file.\n";
         std::cout << "  --source=<source>, -S - Load specified source.\n";
-        std::cout << "      <source> may be a path to a file or a built-in source.\n";
-        std::cout << "      Built in sources include: default/lorem, cat, dog/doggo, corpo/corporate.\n\n";
+        std::cout << "      <source> may be a path to a file, - for standard input, or a built-in source.\n";
+        std::cout << "      Built in sources include: default/lorem, cat, dog/doggo, corpo/corporate.\n";
+#ifndef LIPSUM_MIN_BUILD
+        std::cout << "  --frequencies - Pick words as often as they appear in the source.\n";
+        std::cout << "  --markov=<file>, -M - Pick words with a Markov chain.\n";
+        std::cout << "      <file> may be a text to train an order 2 chain on, or a model from compile_markov.\n";
+        std::cout << "  --shard=<index>/<count> - Generate only part <index> (from 0) of <count> of the output.\n";
+        std::cout << "      Needs --seed, the same for every part. Units are generated by index, so the parts joined in order are the same output for any count.\n";
+        std::cout << "      Applies to word, sentence, paragraph and csv <num>, without the final newline; faster with --engine=philox4x32.\n";
+#endif
+        std::cout << "\n";
         std::cout << "  --bulk - Separate bulk operations.\n";
         std::cout << "      Example: lpsmcpp-cli paragraph 2 --bulk sentence 4\n\n";
         std::cout << "  --word=<min,max>, -w - The min and max words per sentence fragment.\n";
@@ -132,7 +259,11 @@ void Help(const std::string& page)
         std::cout << "  url, plain_url, email, slug, scramble, case_slug,\n";
         std::cout << "  code, ip_addr, phone_number, fmt_paragraph, fmt_text, fmt_header\n";
         std::cout << "  fmt_emphasis, fmt_link, fmt_list, xml, json, json_value,\n";
-        std::cout << "  csv\n\n";
+#ifndef LIPSUM_MIN_BUILD
+        std::cout << "  csv, compile, compile_markov, stats\n\n";
+#else
+        std::cout << "  csv, stats\n\n";
+#endif
         std::cout << "For more information, type lpsmcpp-cli help <subcommand>.\n";
     }
     if (page == "help")
@@ -266,14 +397,49 @@ void Help(const std::string& page)
     }
     if (page == "csv")
     {
-        std::cout << "  csv - Generate a CSV document.\n\n";
+        std::cout << "  csv - Generate a CSV document.\n";
+#ifndef LIPSUM_MIN_BUILD
+        std::cout << "  csv <numRows = 1> --seed=<seed> --shard=<index>/<count> - Generate part of a CSV document of numRows rows.\n";
+#endif
+        std::cout << "\n";
+    }
+#ifndef LIPSUM_MIN_BUILD
+    if (page == "compile")
+    {
+        std::cout << "  compile <source> <file> - Compile a source into a .lpsmsrc file.\n";
+        std::cout << "    source - A path to a file, - for standard input, or a built-in source.\n";
+        std::cout << "    file - The .lpsmsrc file to write. Pass it to --source to load it without splitting any text.\n\n";
+    }
+    if (page == "compile_markov")
+    {
+        std::cout << "  compile_markov <corpus> <file> <order = 2> - Train a Markov chain and save it.\n";
+        std::cout << "    corpus - A path to the text to train on.\n";
+        std::cout << "    file - The model file to write. Pass it to --markov to load it without training.\n";
+        std::cout << "    order - The number of words each word depends on, from 1 to 8.\n\n";
+    }
+#endif
+    if (page == "stats")
+    {
+        std::cout << "  stats <file> <format = 0> <threads = 0> - Count the words, sentence fragments, sentences and paragraphs of a file.\n";
+#ifndef LIPSUM_MIN_BUILD
+        std::cout << "    file - A path to the text to count. It is mapped into memory and counted in 4 MiB chunks on every thread.\n";
+#else
+        std::cout << "    file - A path to the text to count. It is read and counted in 4 MiB chunks.\n";
+#endif
+        std::cout << "    format - How paragraphs are counted. 0 - tabs, 1 - Markdown blank lines, 2 - HTML block elements\n";
+#ifndef LIPSUM_MIN_BUILD
+        std::cout << "    threads - The number of threads, or 0 for one per hardware thread.\n\n";
+#else
+        std::cout << "    threads - Ignored in minimum builds.\n\n";
+#endif
     }
     // clang-format on
 }
 
 int MainLogic(const std::vector<std::string>& commandOpts,
               std::ostream*                   ostr,
-              lpsm::Generator&                gen)
+              lpsm::Generator&                gen,
+              [[maybe_unused]] const Shard&   shard)
 {
     // no subcommand
     if (commandOpts.empty())
@@ -283,22 +449,28 @@ int MainLogic(const std::vector<std::string>& commandOpts,
     }
 
     std::string subcommand = commandOpts.at(0);
+#ifndef LIPSUM_MIN_BUILD
+    if (shard.count != 0 && IsShardable(subcommand))
+    {
+        return ShardLogic(commandOpts, ostr, gen, shard);
+    }
+#endif
 
     // clang-format off
-    SINGLE_ARG_SUBCOMMAND(word, int, 1)
+    SINGLE_ARG_SINK_SUBCOMMAND(word, int, 1)
     else NO_ARG_SUBCOMMAND(fragment)
-    else NUM_AND_USELIPSUM_SUBCOMMAND(sentence)
-    else NUM_AND_USELIPSUM_SUBCOMMAND(paragraph)
-    else SINGLE_ARG_SUBCOMMAND(text, bool, true)
+    else NUM_AND_USELIPSUM_SINK_SUBCOMMAND(sentence)
+    else NUM_AND_USELIPSUM_SINK_SUBCOMMAND(paragraph)
+    else SINGLE_ARG_SINK_SUBCOMMAND(text, bool, true)
     else NO_ARG_SUBCOMMAND(url)
     else NO_ARG_SUBCOMMAND(plain_url)
     else NO_ARG_SUBCOMMAND(email)
     else NO_ARG_SUBCOMMAND(phone_number)
     else DOUBLE_ARG_SUBCOMMAND(ip_addr, bool, false, bool, false)
-    else SINGLE_ARG_SUBCOMMAND(xml, int, 30)
+    else SINGLE_ARG_SINK_SUBCOMMAND(xml, int, 30)
     else SINGLE_ARG_SUBCOMMAND(json_value, int, 3)
-    else DOUBLE_ARG_SUBCOMMAND(json, int, 3, bool, true)
-    else DOUBLE_ARG_SUBCOMMAND(fmt_text, int, 15, bool, false)
+    else DOUBLE_ARG_SINK_SUBCOMMAND(json, int, 3, bool, true)
+    else DOUBLE_ARG_SINK_SUBCOMMAND(fmt_text, int, 15, bool, false)
     else DOUBLE_ARG_SUBCOMMAND(fmt_header, int, 1, bool, false)
     else DOUBLE_ARG_SUBCOMMAND(fmt_emphasis, bool, true, bool, false)
     else SINGLE_ARG_SUBCOMMAND(fmt_link, bool, false)
@@ -313,7 +485,8 @@ int MainLogic(const std::vector<std::string>& commandOpts,
         GET_ARG(num, 2, int);
         GET_ARG(useLipsum, 3, bool);
         GET_ARG(useHtml, 4, bool);
-        (*ostr) << gen.fmt_paragraph(num, useLipsum, useHtml);
+        lpsm::StreamSink sink(*ostr);
+        gen.fmt_paragraph_to(sink, num, useLipsum, useHtml);
     }
     else if (subcommand == "slug")
     {
@@ -379,6 +552,88 @@ int MainLogic(const std::vector<std::string>& commandOpts,
         }
         (*ostr) << gen.code(static_cast<lpsm::CodeLanguage>(lang));
     }
+#ifndef LIPSUM_MIN_BUILD
+    else if (subcommand == "compile")
+    {
+        if (commandOpts.size() < 3)
+        {
+            lpsm::internal::LogWarn(lpsm::internal::LogType::Error,
+                                    "compile needs a source and a file");
+            return -1;
+        }
+        lpsm::Source source(commandOpts.at(1));
+        return source.save(commandOpts.at(2)) ? 0 : -1;
+    }
+    else if (subcommand == "compile_markov")
+    {
+        if (commandOpts.size() < 3)
+        {
+            lpsm::internal::LogWarn(lpsm::internal::LogType::Error,
+                                    "compile_markov needs a corpus and a file");
+            return -1;
+        }
+        unsigned int order = 2;
+        GET_ARG(order, 4, unsigned int);
+        lpsm::MarkovSource model;
+        if (!model.load(commandOpts.at(1), order))
+        {
+            return -1;
+        }
+        return model.save(commandOpts.at(2)) ? 0 : -1;
+    }
+#endif
+    else if (subcommand == "stats")
+    {
+        if (commandOpts.size() < 2)
+        {
+            lpsm::internal::LogWarn(lpsm::internal::LogType::Error,
+                                    "stats needs a file");
+            return -1;
+        }
+        int          format  = 0;
+        unsigned int threads = 0;
+        GET_ARG(format, 3, int);
+        GET_ARG(threads, 4, unsigned int);
+        if (format < 0 || format > 2)
+        {
+            lpsm::internal::LogWarn(lpsm::internal::LogType::Error,
+                                    "format out of range. Please use number "
+                                    "between 0 and 2.\nGot format=",
+                                    format);
+            return -1;
+        }
+        lpsm::TextStatsAccumulator stats(
+                static_cast<lpsm::CountParaMethod>(format));
+#ifndef LIPSUM_MIN_BUILD
+        if (!stats.add_file(commandOpts.at(1), threads))
+        {
+            return -1;
+        }
+#else
+        // files cannot be mapped in minimum builds, so read them in chunks
+        constexpr std::size_t CHUNK = 4 * 1024 * 1024;
+        std::ifstream         file(commandOpts.at(1), std::ios::binary);
+        if (!file)
+        {
+            lpsm::internal::LogWarn(lpsm::internal::LogType::Error,
+                                    "Could not open file ",
+                                    commandOpts.at(1));
+            return -1;
+        }
+        std::string chunk(CHUNK, '\0');
+        while (file.read(chunk.data(), static_cast<std::streamsize>(CHUNK)) ||
+               file.gcount() > 0)
+        {
+            stats.add(std::string_view(
+                    chunk.data(), static_cast<std::size_t>(file.gcount())));
+        }
+#endif
+        lpsm::TextStats counts = stats.stats();
+        (*ostr) << "bytes: " << stats.size() << "\nwords: " << counts.words
+                << "\nfragments: " << counts.fragments
+                << "\nsentences: " << counts.sentences
+                << "\nparagraphs: " << counts.paragraphs;
+    }
     else if (subcommand == "help")
     {
         std::string page = "home";
@@ -419,6 +674,9 @@ int main(int argc, char** argv)
     std::vector<std::string> cmdOptsToAdd;
 
     lpsm::Generator gen;
+    Shard           shard;
+
+    [[maybe_unused]] bool seeded = false; // whether --seed was given
 
     for (int i = 1; i < argc; ++i)
     {
@@ -493,6 +751,7 @@ int main(int argc, char** argv)
                 std::string value = option.substr(pos + 1);
                 int         seed  = lpsm::internal::ToType<int>(value);
                 gen.load_seed(seed);
+                seeded = true;
             }
             else
             {
@@ -502,6 +761,26 @@ int main(int argc, char** argv)
                                         option);
             }
         }
+        else if (OPTION_COND(engine, "-e"))
+        {
+            size_t pos = option.find('=');
+            if (pos == std::string::npos)
+            {
+                lpsm::internal::LogWarn(lpsm::internal::LogType::Error,
+                                        "must be in format "
+                                        "--option=value\nGot: ",
+                                        option);
+                return -1;
+            }
+            std::string value = option.substr(pos + 1);
+            if (!LoadEngine(value, gen))
+            {
+                lpsm::internal::LogWarn(lpsm::internal::LogType::Error,
+                                        "unknown engine ",
+                                        value);
+                return -1;
+            }
+        }
         else if (OPTION_COND(output, "-o"))
         {
 
@@ -521,6 +800,44 @@ int main(int argc, char** argv)
                 return -1;
             }
         }
+#ifndef LIPSUM_MIN_BUILD
+        else if (option == "--frequencies")
+        {
+            gen.use_word_frequencies(true);
+        }
+        else if (OPTION_COND(markov, "-M"))
+        {
+            size_t pos = option.find('=');
+            if (pos == std::string::npos)
+            {
+                lpsm::internal::LogWarn(lpsm::internal::LogType::Error,
+                                        "must be in format "
+                                        "--option=value\nGot: ",
+                                        option);
+                return -1;
+            }
+            auto model = std::make_shared<lpsm::MarkovSource>();
+            if (!model->load(option.substr(pos + 1)))
+            {
+                return -1;
+            }
+            gen.load_markov(std::move(model));
+        }
+        else if (option.starts_with("--shard"))
+        {
+            size_t pos = option.find('=');
+            if (pos == std::string::npos ||
+                !ParseShard(option.substr(pos + 1), shard))
+            {
+                lpsm::internal::LogWarn(lpsm::internal::LogType::Error,
+                                        "must be in format "
+                                        "--shard=<index>/<count> with index "
+                                        "< count\nGot: ",
+                                        option);
+                return -1;
+            }
+        }
+#endif
         else if (option.starts_with("--bulk"))
         {
             // acceptable, skip
@@ -534,9 +851,20 @@ int main(int argc, char** argv)
         }
     }
 
+#ifndef LIPSUM_MIN_BUILD
+    // without a common seed, every process would draw unrelated parts
+    if (shard.count != 0 && !seeded)
+    {
+        lpsm::internal::LogWarn(lpsm::internal::LogType::Error,
+                                "--shard needs --seed, the same for every "
+                                "part");
+        return -1;
+    }
+#endif
+
     for (const auto& internalCmdOpts : commandOpts)
     {
-        int ret = MainLogic(internalCmdOpts, ostr, gen);
+        int ret = MainLogic(internalCmdOpts, ostr, gen, shard);
         if (ret != 0)
         {
             return ret;
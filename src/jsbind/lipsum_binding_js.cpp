@@ -34,7 +34,9 @@ EMSCRIPTEN_BINDINGS(lipsumcpp)
             .constructor<>()
             .constructor<std::string>()
             .constructor<std::string, int>()
-            .function("load_source", &lpsm::Generator::load_source)
+            .function("load_source",
+                      select_overload<void(const std::string&)>(
+                              &lpsm::Generator::load_source))
             .function("load_seed", &lpsm::Generator::load_seed)
             .function("change_setting",
                       select_overload<void(const std::string&, int, int)>(
@@ -22,10 +22,18 @@
 
 #pragma once
 
+#include "lipsum/chunkstream.hpp"
 #include "lipsum/core/internal.hpp"
 #include "lipsum/core/stdincludes.hpp"
+#include "lipsum/ct.hpp"
 #include "lipsum/generator.hpp"
+#include "lipsum/generatorpool.hpp"
 #include "lipsum/misc.hpp"
+#include "lipsum/parallelgenerator.hpp"
+#include "lipsum/sink.hpp"
+#include "lipsum/tagscanner.hpp"
+#include "lipsum/textstats.hpp"
+#include "lipsum/textview.hpp"
 
 /**
  * @namespace lipsum
@@ -42,9 +50,26 @@ namespace lpsm = lipsum; ///< Alias for namespace lipsum
 
 #ifdef LIPSUM_IMPLEMENTATION
 
+#    include "lipsum/chunkstream.inl"
 #    include "lipsum/core/argvec2.inl"
+#    include "lipsum/core/engine.inl"
+#    include "lipsum/core/escapedwords.inl"
+#    include "lipsum/core/format.inl"
+#    include "lipsum/core/mappedfile.inl"
+#    include "lipsum/core/markovsource.inl"
+#    include "lipsum/core/parallel.inl"
 #    include "lipsum/core/source.inl"
+#    include "lipsum/core/sourcefile.inl"
+#    include "lipsum/core/sourceregistry.inl"
+#    include "lipsum/core/tokenizer.inl"
+#    include "lipsum/core/weightedtable.inl"
 #    include "lipsum/generator.inl"
+#    include "lipsum/generatorpool.inl"
 #    include "lipsum/misc.inl"
+#    include "lipsum/parallelgenerator.inl"
+#    include "lipsum/sink.inl"
+#    include "lipsum/tagscanner.inl"
+#    include "lipsum/textstats.inl"
+#    include "lipsum/textview.inl"
 
 #endif
@@ -0,0 +1,284 @@
+/**
+ * @file lipsum/chunkstream.hpp
+ *
+ * @brief Declaration of lipsum::ChunkStream
+ *
+ * This declares lipsum::ChunkStream, a coroutine that yields a document in
+ * chunks as it is generated. This file is under the BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core/core.hpp"
+#include "core/stdincludes.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum
+{
+    /**
+     * @brief Coroutine that yields a document chunk by chunk
+     *
+     * @since 0.5.3
+     *
+     * Returned by lipsum::Generator::fmt_text_stream(),
+     * lipsum::Generator::xml_stream() and lipsum::Generator::json_stream().
+     * Nothing is generated until the first chunk is asked for; each chunk is
+     * then generated on demand, and all state between chunks (open XML tags,
+     * nested JSON values...) is kept in the coroutine frame instead of the
+     * output. A chunk is a std::string_view, valid until the next one is
+     * asked for, so memory use stays bounded by the chunk size however large
+     * the document is. Use it as an std::ranges input view or call next().
+     * Move-only; the generator it came from must outlive it. Not available
+     * in minimum builds.
+     */
+    class LIPSUM_API ChunkStream
+        : public std::ranges::view_interface<ChunkStream>
+    {
+    public:
+        /**
+         * @brief Promise type of the coroutine
+         *
+         * @since 0.5.3
+         *
+         * Used by the compiler; the coroutine co_yields each chunk as a
+         * std::string_view.
+         */
+        struct promise_type
+        {
+            /**
+             * @brief Make the stream that owns the coroutine.
+             *
+             * @since 0.5.3
+             *
+             * @return ChunkStream The stream.
+             */
+            ChunkStream get_return_object();
+
+            /**
+             * @brief Do not start before the first chunk is asked for.
+             *
+             * @since 0.5.3
+             *
+             * @return std::suspend_always Always suspend.
+             */
+            static std::suspend_always initial_suspend() noexcept;
+
+            /**
+             * @brief Stay suspended once done, so that done() can be checked.
+             *
+             * @since 0.5.3
+             *
+             * @return std::suspend_always Always suspend.
+             */
+            static std::suspend_always final_suspend() noexcept;
+
+            /**
+             * @brief Hand a chunk to the consumer.
+             *
+             * @since 0.5.3
+             *
+             * @param chunk The chunk, which must stay valid until the
+             * coroutine is resumed.
+             *
+             * @return std::suspend_always Always suspend.
+             */
+            std::suspend_always yield_value(std::string_view chunk) noexcept;
+
+            /**
+             * @brief End the stream.
+             *
+             * @since 0.5.3
+             */
+            void return_void() noexcept;
+
+            /**
+             * @brief Keep an exception to rethrow to the consumer.
+             *
+             * @since 0.5.3
+             */
+            void unhandled_exception();
+
+            std::string_view   chunk;     ///< Last chunk yielded
+            std::exception_ptr exception; ///< Exception thrown, if any
+        };
+
+        /**
+         * @brief Input iterator of lipsum::ChunkStream
+         *
+         * @since 0.5.3
+         */
+        class LIPSUM_API Iterator
+        {
+        public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type       = std::string_view;
+            using difference_type  = std::ptrdiff_t;
+
+            /**
+             * @brief Default constructor for Iterator
+             *
+             * @since 0.5.3
+             */
+            Iterator() = default;
+
+            /**
+             * @brief Constructor for Iterator
+             *
+             * @since 0.5.3
+             *
+             * @param stream The stream to read from.
+             */
+            explicit Iterator(ChunkStream& stream);
+
+            /**
+             * @brief Get the current chunk.
+             *
+             * @since 0.5.3
+             *
+             * @return std::string_view The chunk, valid until the iterator is
+             * incremented.
+             */
+            std::string_view operator*() const;
+
+            /**
+             * @brief Generate the next chunk.
+             *
+             * @since 0.5.3
+             *
+             * @return Iterator& This iterator.
+             */
+            Iterator& operator++();
+
+            /**
+             * @brief Generate the next chunk.
+             *
+             * @since 0.5.3
+             */
+            void operator++(int);
+
+            /**
+             * @brief Check if the stream is done.
+             *
+             * @since 0.5.3
+             *
+             * @return bool Whether every chunk has been read.
+             */
+            bool operator==(std::default_sentinel_t) const;
+
+        private:
+            ChunkStream* m_Stream = nullptr; ///< The stream read from
+        };
+
+        /**
+         * @brief Default constructor for ChunkStream
+         *
+         * @since 0.5.3
+         *
+         * Make an empty stream.
+         */
+        ChunkStream() = default;
+
+        /**
+         * @brief Move constructor for ChunkStream
+         *
+         * @since 0.5.3
+         *
+         * @param other The stream to take the coroutine from; left empty.
+         */
+        ChunkStream(ChunkStream&& other) noexcept;
+
+        /**
+         * @brief Move assignment for ChunkStream
+         *
+         * @since 0.5.3
+         *
+         * @param other The stream to take the coroutine from; left empty.
+         *
+         * @return ChunkStream& This stream.
+         */
+        ChunkStream& operator=(ChunkStream&& other) noexcept;
+
+        ChunkStream(const ChunkStream&)            = delete;
+        ChunkStream& operator=(const ChunkStream&) = delete;
+
+        /**
+         * @brief Destructor for ChunkStream
+         *
+         * @since 0.5.3
+         *
+         * Destroy the coroutine, even if it is not done.
+         */
+        ~ChunkStream();
+
+        /**
+         * @brief Generate the next chunk.
+         *
+         * @since 0.5.3
+         *
+         * @return std::string_view The chunk, valid until next() is called
+         * again, or an empty view once the document is done.
+         */
+        std::string_view next();
+
+        /**
+         * @brief Get an iterator to the current chunk.
+         *
+         * @since 0.5.3
+         *
+         * Generate the first chunk if no chunk was generated yet; otherwise,
+         * point to the last chunk returned by next().
+         *
+         * @return Iterator The iterator.
+         */
+        [[nodiscard]] Iterator begin();
+
+        /**
+         * @brief Get the end of the stream.
+         *
+         * @since 0.5.3
+         *
+         * @return std::default_sentinel_t The sentinel.
+         */
+        [[nodiscard]] static constexpr std::default_sentinel_t end()
+        {
+            return std::default_sentinel;
+        }
+
+    private:
+        using Handle = std::coroutine_handle<promise_type>;
+
+        /**
+         * @brief Constructor for a coroutine
+         *
+         * @since 0.5.3
+         *
+         * @param handle The coroutine.
+         */
+        explicit ChunkStream(Handle handle);
+
+        /**
+         * @brief Check if the coroutine has no chunk left.
+         *
+         * @since 0.5.3
+         *
+         * @return bool Whether the coroutine is done or missing.
+         */
+        [[nodiscard]] bool done() const;
+
+        /**
+         * @brief Run the coroutine up to its next chunk.
+         *
+         * @since 0.5.3
+         *
+         * Rethrow any exception thrown by the coroutine.
+         */
+        void resume();
+
+        Handle m_Handle  = nullptr; ///< The coroutine
+        bool   m_Started = false;   ///< Whether a chunk was generated
+    };
+} // namespace lipsum
+#endif
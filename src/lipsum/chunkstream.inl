@@ -0,0 +1,149 @@
+/**
+ * @file lipsum/chunkstream.inl
+ *
+ * @brief Definition of lipsum::ChunkStream
+ *
+ * This defines lipsum::ChunkStream. This file is under the BSD Zero-Clause
+ * License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "chunkstream.hpp"
+#include "core/internal.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum
+{
+    ChunkStream ChunkStream::promise_type::get_return_object()
+    {
+        return ChunkStream(Handle::from_promise(*this));
+    }
+
+    std::suspend_always ChunkStream::promise_type::initial_suspend() noexcept
+    {
+        return {};
+    }
+
+    std::suspend_always ChunkStream::promise_type::final_suspend() noexcept
+    {
+        return {};
+    }
+
+    std::suspend_always
+    ChunkStream::promise_type::yield_value(std::string_view chunk) noexcept
+    {
+        this->chunk = chunk;
+        return {};
+    }
+
+    void ChunkStream::promise_type::return_void() noexcept
+    {
+        chunk = {};
+    }
+
+    void ChunkStream::promise_type::unhandled_exception()
+    {
+        exception = std::current_exception();
+    }
+
+    ChunkStream::Iterator::Iterator(ChunkStream& stream) : m_Stream(&stream)
+    {
+    }
+
+    std::string_view ChunkStream::Iterator::operator*() const
+    {
+        return m_Stream->m_Handle.promise().chunk;
+    }
+
+    ChunkStream::Iterator& ChunkStream::Iterator::operator++()
+    {
+        m_Stream->resume();
+        return *this;
+    }
+
+    void ChunkStream::Iterator::operator++(int)
+    {
+        ++*this;
+    }
+
+    bool ChunkStream::Iterator::operator==(std::default_sentinel_t) const
+    {
+        return m_Stream == nullptr || m_Stream->done();
+    }
+
+    ChunkStream::ChunkStream(ChunkStream&& other) noexcept
+        : m_Handle(std::exchange(other.m_Handle, nullptr)),
+          m_Started(other.m_Started)
+    {
+    }
+
+    ChunkStream& ChunkStream::operator=(ChunkStream&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (m_Handle)
+            {
+                m_Handle.destroy();
+            }
+            m_Handle  = std::exchange(other.m_Handle, nullptr);
+            m_Started = other.m_Started;
+        }
+        return *this;
+    }
+
+    ChunkStream::~ChunkStream()
+    {
+        if (m_Handle)
+        {
+            m_Handle.destroy();
+        }
+    }
+
+    std::string_view ChunkStream::next()
+    {
+        resume();
+        return done() ? std::string_view() : m_Handle.promise().chunk;
+    }
+
+    ChunkStream::Iterator ChunkStream::begin()
+    {
+        if (!m_Started)
+        {
+            resume();
+        }
+        return Iterator(*this);
+    }
+
+    /*
+     * PRIVATE
+     */
+
+    ChunkStream::ChunkStream(Handle handle) : m_Handle(handle)
+    {
+    }
+
+    bool ChunkStream::done() const
+    {
+        return !m_Handle || m_Handle.done();
+    }
+
+    void ChunkStream::resume()
+    {
+        m_Started = true;
+        if (done())
+        {
+            return;
+        }
+        m_Handle.resume();
+        if (m_Handle.promise().exception)
+        {
+            std::rethrow_exception(
+                    std::exchange(m_Handle.promise().exception, nullptr));
+        }
+    }
+} // namespace lipsum
+#endif
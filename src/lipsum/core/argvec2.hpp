@@ -13,6 +13,7 @@
 #pragma once
 
 #include "core.hpp"
+#include "engine.hpp"
 
 namespace lipsum
 {
@@ -31,10 +32,20 @@ namespace lipsum
          *
          * @since 0.1.0
          *
+         * Constant since 0.5.3, so that ranges can be used as settings of
+         * the lipsum::ct functions. A negative min or max raises a warning,
+         * or fails to compile in a constant expression.
+         *
          * @param min Value to enter into this->min
          * @param max Value to enter into this->max
          */
-        ArgVec2(int min, int max);
+        constexpr ArgVec2(int min, int max) : min(min), max(max)
+        {
+            if (min < 0 || max < 0)
+            {
+                warn_negative(min, max);
+            }
+        }
 
         /**
          * @brief Return a number between min and max.
@@ -50,7 +61,43 @@ namespace lipsum
          */
         [[nodiscard]] int roll(std::mt19937& gen) const;
 
+        /**
+         * @brief Return a number between min and max.
+         *
+         * @since 0.5.3
+         *
+         * @overload
+         *
+         * @param gen The generator to use.
+         *
+         * @return int The random number.
+         */
+        [[nodiscard]] int roll(Engine& gen) const;
+
+        /**
+         * @brief Return the mean of the numbers roll() returns.
+         *
+         * @since 0.5.3
+         *
+         * @return double The midpoint of min and max.
+         */
+        [[nodiscard]] double mean() const;
+
         int min; ///< The minimum value
         int max; ///< The maximum value
+
+    private:
+        /**
+         * @brief Warn about a negative min or max.
+         *
+         * @since 0.5.3
+         *
+         * Not constexpr, so that negative ranges cannot be constant. This
+         * function is private.
+         *
+         * @param min The minimum value.
+         * @param max The maximum value.
+         */
+        static void warn_negative(int min, int max);
     };
 } // namespace lipsum
@@ -13,38 +13,37 @@
 #pragma once
 
 #include "internal.hpp"
+#include "sampler.hpp"
 
 namespace lipsum
 {
 
-    ArgVec2::ArgVec2(int min, int max)
+    void ArgVec2::warn_negative(int min, int max)
     {
-        if (min < 0 || max < 0)
-        {
-            internal::LogWarn(internal::LogType::Warn,
-                              "lpsm::ArgVec2::ArgVec2(): min and max set to (",
-                              min,
-                              ", ",
-                              max,
-                              "), expected both >= 0. If "
-                              "this is intentional,"
-                              "use another method to generate random numbers "
-                              "instead.");
-        }
-
-        this->min = min;
-        this->max = max;
+        internal::LogWarn(internal::LogType::Warn,
+                          "lpsm::ArgVec2::ArgVec2(): min and max set to (",
+                          min,
+                          ", ",
+                          max,
+                          "), expected both >= 0. If "
+                          "this is intentional,"
+                          "use another method to generate random numbers "
+                          "instead.");
     }
 
     int ArgVec2::roll(std::mt19937& gen) const
     {
-        if (min <= max)
-        {
-            std::uniform_int_distribution<int> dist(min, max);
-            return dist(gen);
-        }
-        std::uniform_int_distribution<int> dist(max, min);
-        return dist(gen);
+        return internal::UniformInt(gen, min, max);
+    }
+
+    int ArgVec2::roll(Engine& gen) const
+    {
+        return internal::UniformInt(gen, min, max);
+    }
+
+    double ArgVec2::mean() const
+    {
+        return (static_cast<double>(min) + static_cast<double>(max)) / 2.0;
     }
 
 #ifndef LIPSUM_MIN_BUILD
@@ -60,48 +59,144 @@ namespace lipsum
 
         result.reserve((str.length() * RESERVE_NUMER / RESERVE_DENOM) +
                        RESERVE_PLUS);
-        for (const auto& letter : str)
+        HandleHTMLEntityInto(result, str);
+        return result;
+    }
+
+    std::size_t internal::FindHTMLEntity(std::string_view str, std::size_t pos)
+    {
+#    ifdef LPSM_HAS_SSE2
+        constexpr std::size_t BLOCK = 16;
+
+        const __m128i ampersand  = _mm_set1_epi8('&');
+        const __m128i lessThan   = _mm_set1_epi8('<');
+        const __m128i moreThan   = _mm_set1_epi8('>');
+        const __m128i quote      = _mm_set1_epi8('"');
+        const __m128i apostrophe = _mm_set1_epi8('\'');
+        for (; pos + BLOCK <= str.size(); pos += BLOCK)
         {
-            switch (letter)
+            __m128i bytes = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(str.data() + pos));
+            __m128i found = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(bytes, ampersand),
+                                 _mm_cmpeq_epi8(bytes, lessThan)),
+                    _mm_or_si128(_mm_cmpeq_epi8(bytes, moreThan),
+                                 _mm_or_si128(_mm_cmpeq_epi8(bytes, quote),
+                                              _mm_cmpeq_epi8(bytes,
+                                                             apostrophe))));
+            auto bits = static_cast<std::uint32_t>(_mm_movemask_epi8(found));
+            if (bits != 0)
+            {
+                return pos + static_cast<std::size_t>(std::countr_zero(bits));
+            }
+        }
+#    endif
+        for (; pos < str.size(); ++pos)
+        {
+            switch (str[pos])
             {
                 case '&':
+                case '<':
+                case '>':
+                case '"':
+                case '\'':
+                {
+                    return pos;
+                }
+                default:
                 {
-                    result.append("&amp;");
                     break;
                 }
-                case '<':
+            }
+        }
+        return std::string::npos;
+    }
+
+    void internal::HandleHTMLEntityInto(std::string& out, std::string_view str)
+    {
+        std::size_t start = 0;
+        std::size_t found = FindHTMLEntity(str);
+        while (found != std::string::npos)
+        {
+            out.append(str.substr(start, found - start));
+            switch (str[found])
+            {
+                case '&':
                 {
-                    result.append("&lt;");
+                    out.append("&amp;");
                     break;
                 }
-                case '>':
+                case '<':
                 {
-                    result.append("&gt;");
+                    out.append("&lt;");
                     break;
                 }
-                case '"':
+                case '>':
                 {
-                    result.append("&quot;");
+                    out.append("&gt;");
                     break;
                 }
-                case '\'':
+                case '"':
                 {
-                    result.append("&apos;");
+                    out.append("&quot;");
                     break;
                 }
                 default:
                 {
-                    result.push_back(letter);
+                    out.append("&apos;");
+                    break;
                 }
             }
+            start = found + 1;
+            found = FindHTMLEntity(str, start);
+        }
+        out.append(str.substr(start));
+    }
+
+    static constexpr bool IsXmlNameStart(char letter)
+    {
+        return (letter >= 'a' && letter <= 'z') ||
+               (letter >= 'A' && letter <= 'Z') || letter == '_';
+    }
+
+    static constexpr bool IsXmlNameChar(char letter)
+    {
+        return IsXmlNameStart(letter) || (letter >= '0' && letter <= '9') ||
+               letter == '-' || letter == '.';
+    }
+
+    bool internal::IsXmlName(std::string_view str)
+    {
+        return !str.empty() && IsXmlNameStart(str.front()) &&
+               std::all_of(str.begin(), str.end(), IsXmlNameChar);
+    }
+
+    void internal::XmlNameInto(std::string& out, std::string_view str)
+    {
+        if (str.empty() || !IsXmlNameStart(str.front()))
+        {
+            out += '_';
+        }
+        for (char letter : str)
+        {
+            out += (IsXmlNameChar(letter) ? letter : '_');
         }
-        return result;
     }
 #else
     std::string internal::HandleHTMLEntity(const std::string& str)
     {
         return str;
     }
+
+    std::size_t internal::FindHTMLEntity(std::string_view, std::size_t)
+    {
+        return std::string::npos;
+    }
+
+    void internal::HandleHTMLEntityInto(std::string& out, std::string_view str)
+    {
+        out.append(str);
+    }
 #endif
 
 } // namespace lipsum
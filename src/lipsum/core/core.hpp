@@ -70,3 +70,25 @@
 #else
 #    define LIPSUM_API
 #endif
+
+/**
+ * @brief Whether lipsum-cpp may start threads
+ *
+ * @since 0.5.3
+ *
+ * Defined unless doing a minimum build or building for Emscripten, where
+ * threads need extra compiler flags.
+ */
+#if !defined(LIPSUM_MIN_BUILD) && !defined(__EMSCRIPTEN__)
+#    define LPSM_HAS_THREADS
+#endif
+
+/**
+ * @brief Whether SSE2 intrinsics are available
+ *
+ * @since 0.5.3
+ */
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define LPSM_HAS_SSE2
+#endif
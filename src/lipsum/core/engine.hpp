@@ -0,0 +1,905 @@
+/**
+ * @file lipsum/core/engine.hpp
+ *
+ * @brief Random engines of lipsum-cpp
+ *
+ * This declares lipsum::Engine and defines the small-state engines it can
+ * wrap. The engines are constexpr and defined here so that they can be inlined
+ * into the generation loops. This file is under the BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core.hpp"
+
+namespace lipsum
+{
+    namespace internal
+    {
+        /**
+         * @brief Advance a SplitMix64 state and return its output.
+         *
+         * @since 0.5.3
+         *
+         * Used to expand a single seed into the state of the small-state
+         * engines.
+         *
+         * @param state The state to advance.
+         *
+         * @return std::uint64_t The next output.
+         */
+        constexpr std::uint64_t SplitMix64(std::uint64_t& state)
+        {
+            std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z               = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z               = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        /**
+         * @brief Derive the seed of one of many streams from a root seed.
+         *
+         * @since 0.5.3
+         *
+         * Mix seed and stream with SplitMix64 so that neighbouring streams of
+         * the same seed get unrelated seeds.
+         *
+         * @param seed The root seed.
+         * @param stream The index of the stream.
+         *
+         * @return std::uint64_t The seed of the stream.
+         */
+        constexpr std::uint64_t StreamSeed(std::uint64_t seed,
+                                           std::uint64_t stream)
+        {
+            std::uint64_t state = SplitMix64(seed) ^ stream;
+            return SplitMix64(state);
+        }
+
+        /**
+         * @brief Rotate a 64-bit value right.
+         *
+         * @since 0.5.3
+         *
+         * @param value The value to rotate.
+         * @param amount The number of bits, from 0 to 63.
+         *
+         * @return std::uint64_t The rotated value.
+         */
+        constexpr std::uint64_t RotR64(std::uint64_t value, unsigned amount)
+        {
+            return (value >> amount) | (value << ((64U - amount) & 63U));
+        }
+
+        /**
+         * @brief Rotate a 32-bit value right.
+         *
+         * @since 0.5.3
+         *
+         * @param value The value to rotate.
+         * @param amount The number of bits, from 0 to 31.
+         *
+         * @return std::uint32_t The rotated value.
+         */
+        constexpr std::uint32_t RotR32(std::uint32_t value, unsigned amount)
+        {
+            return (value >> amount) | (value << ((32U - amount) & 31U));
+        }
+
+        /**
+         * @brief Multiply two 64-bit values into a 128-bit product.
+         *
+         * @since 0.5.3
+         *
+         * Use the compiler's 128-bit integer when available, and four 32-bit
+         * multiplications otherwise.
+         *
+         * @param a The first factor.
+         * @param b The second factor.
+         * @param hi Set to the upper 64 bits of the product.
+         *
+         * @return std::uint64_t The lower 64 bits of the product.
+         */
+        constexpr std::uint64_t
+        Mul128(std::uint64_t a, std::uint64_t b, std::uint64_t& hi)
+        {
+#ifdef __SIZEOF_INT128__
+            __extension__ using Uint128 = unsigned __int128;
+            Uint128 product             = static_cast<Uint128>(a) * b;
+            hi = static_cast<std::uint64_t>(product >> 64);
+            return static_cast<std::uint64_t>(product);
+#else
+            constexpr std::uint64_t LOW_MASK = 0xFFFFFFFFULL;
+
+            std::uint64_t lowLow   = (a & LOW_MASK) * (b & LOW_MASK);
+            std::uint64_t lowHigh  = (a & LOW_MASK) * (b >> 32);
+            std::uint64_t highLow  = (a >> 32) * (b & LOW_MASK);
+            std::uint64_t highHigh = (a >> 32) * (b >> 32);
+            std::uint64_t middle   = (lowLow >> 32) + (lowHigh & LOW_MASK) +
+                                   (highLow & LOW_MASK);
+            hi = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+            return (middle << 32) | (lowLow & LOW_MASK);
+#endif
+        }
+    } // namespace internal
+
+    /**
+     * @brief The xoshiro256** engine
+     *
+     * @since 0.5.3
+     *
+     * 256 bits of state, 64-bit output. See https://prng.di.unimi.it/. The
+     * state is filled from the seed with SplitMix64.
+     */
+    class Xoshiro256ss
+    {
+    public:
+        using result_type = std::uint64_t; ///< Type of the output
+
+        /**
+         * @brief Constructor for Xoshiro256ss
+         *
+         * @since 0.5.3
+         *
+         * @param seed The seed. By default 0.
+         */
+        constexpr explicit Xoshiro256ss(std::uint64_t seed = 0)
+        {
+            this->seed(seed);
+        }
+
+        /**
+         * @brief Reseed the engine.
+         *
+         * @since 0.5.3
+         *
+         * @param seed The seed.
+         */
+        constexpr void seed(std::uint64_t seed)
+        {
+            for (auto& word : m_State)
+            {
+                word = internal::SplitMix64(seed);
+            }
+        }
+
+        /**
+         * @brief Get the smallest possible output.
+         *
+         * @since 0.5.3
+         *
+         * @return result_type 0.
+         */
+        static constexpr result_type min()
+        {
+            return 0;
+        }
+
+        /**
+         * @brief Get the largest possible output.
+         *
+         * @since 0.5.3
+         *
+         * @return result_type 2^64 - 1.
+         */
+        static constexpr result_type max()
+        {
+            return ~result_type{0};
+        }
+
+        /**
+         * @brief Generate the next output.
+         *
+         * @since 0.5.3
+         *
+         * @return result_type The output.
+         */
+        constexpr result_type operator()()
+        {
+            // rotating right by 57 and 19 is rotating left by 7 and 45
+            result_type result = internal::RotR64(m_State[1] * 5, 57) * 9;
+            result_type shift  = m_State[1] << 17;
+
+            m_State[2] ^= m_State[0];
+            m_State[3] ^= m_State[1];
+            m_State[1] ^= m_State[2];
+            m_State[0] ^= m_State[3];
+            m_State[2] ^= shift;
+            m_State[3]  = internal::RotR64(m_State[3], 19);
+            return result;
+        }
+
+    private:
+        std::array<std::uint64_t, 4> m_State{}; ///< The state
+    };
+
+    /**
+     * @brief The PCG32 engine
+     *
+     * @since 0.5.3
+     *
+     * PCG XSH-RR with 64 bits of state and 32-bit output, seeded like
+     * pcg32_srandom_r() in the reference implementation. See
+     * https://www.pcg-random.org/.
+     */
+    class Pcg32
+    {
+    public:
+        using result_type = std::uint32_t; ///< Type of the output
+
+        /**
+         * @brief Stream used when none is given
+         *
+         * @since 0.5.3
+         */
+        static constexpr std::uint64_t DEFAULT_STREAM = 0xDA3E39CB94B95BDBULL;
+
+        /**
+         * @brief Constructor for Pcg32
+         *
+         * @since 0.5.3
+         *
+         * @param seed The seed. By default 0.
+         * @param stream The stream. By default DEFAULT_STREAM.
+         */
+        constexpr explicit Pcg32(std::uint64_t seed   = 0,
+                                 std::uint64_t stream = DEFAULT_STREAM)
+        {
+            this->seed(seed, stream);
+        }
+
+        /**
+         * @brief Reseed the engine.
+         *
+         * @since 0.5.3
+         *
+         * @param seed The seed.
+         * @param stream The stream. By default DEFAULT_STREAM.
+         */
+        constexpr void seed(std::uint64_t seed,
+                            std::uint64_t stream = DEFAULT_STREAM)
+        {
+            m_State = 0;
+            m_Inc   = (stream << 1) | 1;
+            step();
+            m_State += seed;
+            step();
+        }
+
+        /**
+         * @brief Get the smallest possible output.
+         *
+         * @since 0.5.3
+         *
+         * @return result_type 0.
+         */
+        static constexpr result_type min()
+        {
+            return 0;
+        }
+
+        /**
+         * @brief Get the largest possible output.
+         *
+         * @since 0.5.3
+         *
+         * @return result_type 2^32 - 1.
+         */
+        static constexpr result_type max()
+        {
+            return ~result_type{0};
+        }
+
+        /**
+         * @brief Generate the next output.
+         *
+         * @since 0.5.3
+         *
+         * @return result_type The output.
+         */
+        constexpr result_type operator()()
+        {
+            std::uint64_t old = m_State;
+            step();
+            auto xorShifted =
+                    static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+            return internal::RotR32(xorShifted,
+                                    static_cast<unsigned>(old >> 59));
+        }
+
+    private:
+        /**
+         * @brief Advance the LCG.
+         *
+         * @since 0.5.3
+         */
+        constexpr void step()
+        {
+            m_State = (m_State * 6364136223846793005ULL) + m_Inc;
+        }
+
+        std::uint64_t m_State = 0; ///< The LCG state
+        std::uint64_t m_Inc   = 1; ///< The LCG increment, always odd
+    };
+
+    /**
+     * @brief The PCG64 engine
+     *
+     * @since 0.5.3
+     *
+     * PCG XSL-RR with 128 bits of state and 64-bit output. The state and
+     * stream are filled from the seed with SplitMix64. The 128-bit arithmetic
+     * is done with internal::Mul128(), so it does not need a compiler 128-bit
+     * integer.
+     */
+    class Pcg64
+    {
+    public:
+        using result_type = std::uint64_t; ///< Type of the output
+
+        /**
+         * @brief Constructor for Pcg64
+         *
+         * @since 0.5.3
+         *
+         * @param seed The seed. By default 0.
+         */
+        constexpr explicit Pcg64(std::uint64_t seed = 0)
+        {
+            this->seed(seed);
+        }
+
+        /**
+         * @brief Reseed the engine.
+         *
+         * @since 0.5.3
+         *
+         * @param seed The seed.
+         */
+        constexpr void seed(std::uint64_t seed)
+        {
+            std::uint64_t stateHigh = internal::SplitMix64(seed);
+            std::uint64_t stateLow  = internal::SplitMix64(seed);
+            std::uint64_t incHigh   = internal::SplitMix64(seed);
+            std::uint64_t incLow    = internal::SplitMix64(seed);
+
+            m_High    = 0;
+            m_Low     = 0;
+            m_IncHigh = (incHigh << 1) | (incLow >> 63);
+            m_IncLow  = (incLow << 1) | 1;
+            step();
+            add(stateHigh, stateLow);
+            step();
+        }
+
+        /**
+         * @brief Get the smallest possible output.
+         *
+         * @since 0.5.3
+         *
+         * @return result_type 0.
+         */
+        static constexpr result_type min()
+        {
+            return 0;
+        }
+
+        /**
+         * @brief Get the largest possible output.
+         *
+         * @since 0.5.3
+         *
+         * @return result_type 2^64 - 1.
+         */
+        static constexpr result_type max()
+        {
+            return ~result_type{0};
+        }
+
+        /**
+         * @brief Generate the next output.
+         *
+         * @since 0.5.3
+         *
+         * @return result_type The output.
+         */
+        constexpr result_type operator()()
+        {
+            step();
+            return internal::RotR64(m_High ^ m_Low,
+                                    static_cast<unsigned>(m_High >> 58));
+        }
+
+    private:
+        /**
+         * @brief Add a 128-bit value to the state.
+         *
+         * @since 0.5.3
+         *
+         * @param high The upper 64 bits.
+         * @param low The lower 64 bits.
+         */
+        constexpr void add(std::uint64_t high, std::uint64_t low)
+        {
+            m_Low  += low;
+            m_High += high + (m_Low < low ? 1 : 0);
+        }
+
+        /**
+         * @brief Advance the LCG.
+         *
+         * @since 0.5.3
+         */
+        constexpr void step()
+        {
+            constexpr std::uint64_t MULT_HIGH = 0x2360ED051FC65DA4ULL;
+            constexpr std::uint64_t MULT_LOW  = 0x4385DF649FCCF645ULL;
+
+            std::uint64_t high = 0;
+            std::uint64_t low  = internal::Mul128(m_Low, MULT_LOW, high);
+            high += (m_High * MULT_LOW) + (m_Low * MULT_HIGH);
+            m_High = high;
+            m_Low  = low;
+            add(m_IncHigh, m_IncLow);
+        }
+
+        std::uint64_t m_High    = 0; ///< Upper 64 bits of the LCG state
+        std::uint64_t m_Low     = 0; ///< Lower 64 bits of the LCG state
+        std::uint64_t m_IncHigh = 0; ///< Upper 64 bits of the increment
+        std::uint64_t m_IncLow  = 1; ///< Lower 64 bits of the increment
+    };
+
+    /**
+     * @brief The wyrand engine
+     *
+     * @since 0.5.3
+     *
+     * 64 bits of state, 64-bit output, from the wyhash family. The fastest of
+     * the built-in engines where a 64x64-bit multiplication is cheap.
+     */
+    class WyRand
+    {
+    public:
+        using result_type = std::uint64_t; ///< Type of the output
+
+        /**
+         * @brief Constructor for WyRand
+         *
+         * @since 0.5.3
+         *
+         * @param seed The seed. By default 0.
+         */
+        constexpr explicit WyRand(std::uint64_t seed = 0) : m_State(seed)
+        {
+        }
+
+        /**
+         * @brief Reseed the engine.
+         *
+         * @since 0.5.3
+         *
+         * @param seed The seed.
+         */
+        constexpr void seed(std::uint64_t seed)
+        {
+            m_State = seed;
+        }
+
+        /**
+         * @brief Get the smallest possible output.
+         *
+         * @since 0.5.3
+         *
+         * @return result_type 0.
+         */
+        static constexpr result_type min()
+        {
+            return 0;
+        }
+
+        /**
+         * @brief Get the largest possible output.
+         *
+         * @since 0.5.3
+         *
+         * @return result_type 2^64 - 1.
+         */
+        static constexpr result_type max()
+        {
+            return ~result_type{0};
+        }
+
+        /**
+         * @brief Generate the next output.
+         *
+         * @since 0.5.3
+         *
+         * @return result_type The output.
+         */
+        constexpr result_type operator()()
+        {
+            m_State           += 0xA0761D6478BD642FULL;
+            std::uint64_t high = 0;
+            std::uint64_t low  = internal::Mul128(
+                    m_State, m_State ^ 0xE7037ED1A0B428DBULL, high);
+            return high ^ low;
+        }
+
+    private:
+        std::uint64_t m_State; ///< The state
+    };
+
+    /**
+     * @brief The Philox4x32-10 engine
+     *
+     * @since 0.5.3
+     *
+     * Counter-based engine from Salmon et al., "Parallel Random Numbers: As
+     * Easy as 1, 2, 3" (2011). Each block of four 32-bit outputs is ten rounds
+     * of a keyed bijection applied to a 128-bit counter, so any position of
+     * any stream is reached without generating what comes before it. The key
+     * is the seed, the upper 64 bits of the counter are the stream, and the
+     * lower 64 bits count the blocks drawn from the stream.
+     */
+    class Philox4x32
+    {
+    public:
+        using result_type = std::uint32_t; ///< Type of the output
+
+        using Block = std::array<std::uint32_t, 4>; ///< Counter or output
+        using Key   = std::array<std::uint32_t, 2>; ///< Key
+
+        /**
+         * @brief Constructor for Philox4x32
+         *
+         * @since 0.5.3
+         *
+         * @param seed The seed. By default 0.
+         * @param stream The stream. By default 0.
+         */
+        constexpr explicit Philox4x32(std::uint64_t seed   = 0,
+                                      std::uint64_t stream = 0)
+        {
+            this->seed(seed, stream);
+        }
+
+        /**
+         * @brief Reseed the engine.
+         *
+         * @since 0.5.3
+         *
+         * Move to the start of a stream. This only sets the key and the
+         * counter, so it is as cheap as a draw.
+         *
+         * @param seed The seed.
+         * @param stream The stream. By default 0.
+         */
+        constexpr void seed(std::uint64_t seed, std::uint64_t stream = 0)
+        {
+            m_Key     = {static_cast<std::uint32_t>(seed),
+                         static_cast<std::uint32_t>(seed >> 32)};
+            m_Counter = {0,
+                         0,
+                         static_cast<std::uint32_t>(stream),
+                         static_cast<std::uint32_t>(stream >> 32)};
+            m_Index   = m_Output.size();
+        }
+
+        /**
+         * @brief Get the smallest possible output.
+         *
+         * @since 0.5.3
+         *
+         * @return result_type 0.
+         */
+        static constexpr result_type min()
+        {
+            return 0;
+        }
+
+        /**
+         * @brief Get the largest possible output.
+         *
+         * @since 0.5.3
+         *
+         * @return result_type 2^32 - 1.
+         */
+        static constexpr result_type max()
+        {
+            return ~result_type{0};
+        }
+
+        /**
+         * @brief Generate the next output.
+         *
+         * @since 0.5.3
+         *
+         * @return result_type The output.
+         */
+        constexpr result_type operator()()
+        {
+            if (m_Index == m_Output.size())
+            {
+                m_Output = encrypt(m_Counter, m_Key);
+                m_Index  = 0;
+                if (++m_Counter[0] == 0)
+                {
+                    ++m_Counter[1];
+                }
+            }
+            return m_Output[m_Index++];
+        }
+
+        /**
+         * @brief Apply the Philox4x32-10 bijection to a counter.
+         *
+         * @since 0.5.3
+         *
+         * @param counter The counter.
+         * @param key The key.
+         *
+         * @return Block The output block.
+         */
+        static constexpr Block encrypt(Block counter, Key key)
+        {
+            constexpr std::uint64_t MULT_0 = 0xD2511F53;
+            constexpr std::uint64_t MULT_1 = 0xCD9E8D57;
+            constexpr std::uint32_t WEYL_0 = 0x9E3779B9;
+            constexpr std::uint32_t WEYL_1 = 0xBB67AE85;
+            constexpr int           ROUNDS = 10;
+
+            for (int round = 0; round < ROUNDS; ++round)
+            {
+                std::uint64_t product0 = MULT_0 * counter[0];
+                std::uint64_t product1 = MULT_1 * counter[2];
+                counter                = {
+                        static_cast<std::uint32_t>(product1 >> 32) ^
+                                counter[1] ^ key[0],
+                        static_cast<std::uint32_t>(product1),
+                        static_cast<std::uint32_t>(product0 >> 32) ^
+                                counter[3] ^ key[1],
+                        static_cast<std::uint32_t>(product0)};
+                key[0] += WEYL_0;
+                key[1] += WEYL_1;
+            }
+            return counter;
+        }
+
+    private:
+        Key         m_Key{};     ///< The key, from the seed
+        Block       m_Counter{}; ///< The next counter to encrypt
+        Block       m_Output{};  ///< The last encrypted block
+        std::size_t m_Index = 4; ///< Next output of m_Output to return
+    };
+
+    /**
+     * @brief Engines that lipsum::Engine can wrap
+     *
+     * @since 0.5.3
+     *
+     * MT19937 is the default. The text for a seed is the same on every
+     * standard library, but differs from 0.5.2 and earlier, which drew
+     * through the standard distributions. The others have a few bytes of
+     * state instead of about 2.5 KB, and are faster to seed and to draw from.
+     * Philox4x32 is counter-based: moving to another stream costs nothing,
+     * which makes it the best fit for the random-access functions of
+     * lipsum::Generator.
+     */
+    enum class EngineType : int
+    {
+        MT19937 = 0,
+        Xoshiro256ss,
+        Pcg32,
+        Pcg64,
+        WyRand,
+        Philox4x32
+    };
+
+    /**
+     * @brief Type-erased random engine used by lipsum::Generator
+     *
+     * @since 0.5.3
+     *
+     * Wrap one of the engines listed in lpsm::EngineType behind a single
+     * 32-bit std::uniform_random_bit_generator, so that lipsum::Generator can
+     * switch engines at runtime without being a template. The 64-bit engines
+     * hand out each output as two 32-bit halves, so they are only advanced
+     * every other call.
+     */
+    class LIPSUM_API Engine
+    {
+    public:
+        using result_type = std::uint32_t; ///< Type of the output
+
+        /**
+         * @brief Constructor for Engine
+         *
+         * @since 0.5.3
+         *
+         * @param type The engine to use. By default EngineType::MT19937.
+         * @param seed The seed. By default the default seed of std::mt19937.
+         */
+        explicit Engine(EngineType    type = EngineType::MT19937,
+                        std::uint64_t seed = std::mt19937::default_seed);
+
+        /**
+         * @brief Reseed the engine.
+         *
+         * @since 0.5.3
+         *
+         * std::mt19937 only uses the lower 32 bits of the seed.
+         *
+         * @param seed The seed.
+         */
+        void seed(std::uint64_t seed);
+
+        /**
+         * @brief Reseed the engine with one of many streams of a seed.
+         *
+         * @since 0.5.3
+         *
+         * Philox4x32 moves its counter to the stream. The other engines are
+         * seeded with internal::StreamSeed(seed, stream), which costs as much
+         * as seed(); std::mt19937 takes all 64 bits of it through a
+         * std::seed_seq, so that streams do not repeat.
+         *
+         * @param seed The root seed.
+         * @param stream The stream.
+         */
+        void seed(std::uint64_t seed, std::uint64_t stream);
+
+        /**
+         * @brief Get the last root seed.
+         *
+         * @since 0.5.3
+         *
+         * @return std::uint64_t The last seed passed to seed(), without its
+         * stream.
+         */
+        [[nodiscard]] std::uint64_t root_seed() const;
+
+        /**
+         * @brief Switch to another engine.
+         *
+         * @since 0.5.3
+         *
+         * Replace the wrapped engine with a new one of the given type, seeded
+         * with the last seed and stream passed to this engine.
+         *
+         * @param type The engine to use.
+         */
+        void set_type(EngineType type);
+
+        /**
+         * @brief Get the type of the wrapped engine.
+         *
+         * @since 0.5.3
+         *
+         * @return EngineType The type.
+         */
+        [[nodiscard]] EngineType type() const;
+
+        /**
+         * @brief Get the name of an engine type.
+         *
+         * @since 0.5.3
+         *
+         * Names are "mt19937", "xoshiro256ss", "pcg32", "pcg64", "wyrand"
+         * and "philox4x32".
+         *
+         * @param type The type.
+         *
+         * @return std::string_view The name.
+         */
+        [[nodiscard]] static std::string_view name(EngineType type);
+
+        /**
+         * @brief Get the smallest possible output.
+         *
+         * @since 0.5.3
+         *
+         * @return result_type 0.
+         */
+        static constexpr result_type min()
+        {
+            return 0;
+        }
+
+        /**
+         * @brief Get the largest possible output.
+         *
+         * @since 0.5.3
+         *
+         * @return result_type 2^32 - 1.
+         */
+        static constexpr result_type max()
+        {
+            return ~result_type{0};
+        }
+
+        /**
+         * @brief Generate the next 32-bit output.
+         *
+         * @since 0.5.3
+         *
+         * Defined in the header so that the dispatch can be inlined into the
+         * distributions that call it.
+         *
+         * @return result_type The output.
+         */
+        result_type operator()()
+        {
+            switch (m_Engine.index())
+            {
+                case static_cast<std::size_t>(EngineType::MT19937):
+                {
+                    return static_cast<result_type>(
+                            (*std::get_if<std::mt19937>(&m_Engine))());
+                }
+                case static_cast<std::size_t>(EngineType::Pcg32):
+                {
+                    return (*std::get_if<Pcg32>(&m_Engine))();
+                }
+                case static_cast<std::size_t>(EngineType::Philox4x32):
+                {
+                    return (*std::get_if<Philox4x32>(&m_Engine))();
+                }
+                default:
+                {
+                    if (m_HasSpare)
+                    {
+                        m_HasSpare = false;
+                        return m_Spare;
+                    }
+                    std::uint64_t value = next_wide();
+                    m_Spare             = static_cast<result_type>(value >> 32);
+                    m_HasSpare          = true;
+                    return static_cast<result_type>(value);
+                }
+            }
+        }
+
+    private:
+        /**
+         * @brief Advance a 64-bit engine.
+         *
+         * @since 0.5.3
+         *
+         * @return std::uint64_t The output of the wrapped 64-bit engine.
+         */
+        std::uint64_t next_wide()
+        {
+            switch (m_Engine.index())
+            {
+                case static_cast<std::size_t>(EngineType::Xoshiro256ss):
+                {
+                    return (*std::get_if<Xoshiro256ss>(&m_Engine))();
+                }
+                case static_cast<std::size_t>(EngineType::Pcg64):
+                {
+                    return (*std::get_if<Pcg64>(&m_Engine))();
+                }
+                default:
+                {
+                    return (*std::get_if<WyRand>(&m_Engine))();
+                }
+            }
+        }
+
+        std::variant<std::mt19937,
+                     Xoshiro256ss,
+                     Pcg32,
+                     Pcg64,
+                     WyRand,
+                     Philox4x32>
+                      m_Engine;            ///< The wrapped engine
+        std::uint64_t m_Seed;              ///< The last root seed
+        std::uint64_t m_Stream    = 0;     ///< The last stream
+        bool          m_HasStream = false; ///< Whether a stream was given
+        result_type   m_Spare     = 0;     ///< Unused half of a 64-bit draw
+        bool          m_HasSpare  = false; ///< Whether m_Spare is unused
+    };
+} // namespace lipsum
@@ -0,0 +1,167 @@
+/**
+ * @file lipsum/core/engine.inl
+ *
+ * @brief Definition of lipsum::Engine
+ *
+ * This defines the non-inline functions of lipsum::Engine. This file is under
+ * the BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "engine.hpp"
+#include "internal.hpp"
+
+namespace lipsum
+{
+    Engine::Engine(EngineType type, std::uint64_t seed) : m_Seed(seed)
+    {
+        set_type(type);
+    }
+
+    void Engine::seed(std::uint64_t seed)
+    {
+        m_Seed      = seed;
+        m_Stream    = 0;
+        m_HasStream = false;
+        m_HasSpare  = false;
+        std::visit(
+                [seed](auto& engine)
+                {
+                    using EngineT = std::decay_t<decltype(engine)>;
+                    if constexpr (std::is_same_v<EngineT, std::mt19937>)
+                    {
+                        engine.seed(static_cast<std::uint32_t>(seed));
+                    }
+                    else
+                    {
+                        engine.seed(seed);
+                    }
+                },
+                m_Engine);
+    }
+
+    void Engine::seed(std::uint64_t seed, std::uint64_t stream)
+    {
+        if (auto* philox = std::get_if<Philox4x32>(&m_Engine))
+        {
+            philox->seed(seed, stream);
+        }
+        else if (auto* mt = std::get_if<std::mt19937>(&m_Engine))
+        {
+            // the lower 32 bits alone repeat among millions of streams, so
+            // keep all 64 through a seed_seq
+            std::uint64_t full = internal::StreamSeed(seed, stream);
+            std::seed_seq seq{static_cast<std::uint32_t>(full),
+                              static_cast<std::uint32_t>(full >> 32)};
+            mt->seed(seq);
+        }
+        else
+        {
+            this->seed(internal::StreamSeed(seed, stream));
+        }
+        m_Seed      = seed;
+        m_Stream    = stream;
+        m_HasStream = true;
+        m_HasSpare  = false;
+    }
+
+    std::uint64_t Engine::root_seed() const
+    {
+        return m_Seed;
+    }
+
+    void Engine::set_type(EngineType type)
+    {
+        switch (type)
+        {
+            case EngineType::MT19937:
+            {
+                m_Engine.emplace<std::mt19937>();
+                break;
+            }
+            case EngineType::Xoshiro256ss:
+            {
+                m_Engine.emplace<Xoshiro256ss>();
+                break;
+            }
+            case EngineType::Pcg32:
+            {
+                m_Engine.emplace<Pcg32>();
+                break;
+            }
+            case EngineType::Pcg64:
+            {
+                m_Engine.emplace<Pcg64>();
+                break;
+            }
+            case EngineType::WyRand:
+            {
+                m_Engine.emplace<WyRand>();
+                break;
+            }
+            case EngineType::Philox4x32:
+            {
+                m_Engine.emplace<Philox4x32>();
+                break;
+            }
+            default:
+            {
+                internal::LogWarn(internal::LogType::Warn,
+                                  "lpsm::Engine::set_type(): unknown engine ",
+                                  static_cast<int>(type),
+                                  ", using mt19937");
+                m_Engine.emplace<std::mt19937>();
+                break;
+            }
+        }
+        if (m_HasStream)
+        {
+            seed(m_Seed, m_Stream);
+        }
+        else
+        {
+            seed(m_Seed);
+        }
+    }
+
+    EngineType Engine::type() const
+    {
+        return static_cast<EngineType>(m_Engine.index());
+    }
+
+    std::string_view Engine::name(EngineType type)
+    {
+        switch (type)
+        {
+            case EngineType::MT19937:
+            {
+                return "mt19937";
+            }
+            case EngineType::Xoshiro256ss:
+            {
+                return "xoshiro256ss";
+            }
+            case EngineType::Pcg32:
+            {
+                return "pcg32";
+            }
+            case EngineType::Pcg64:
+            {
+                return "pcg64";
+            }
+            case EngineType::WyRand:
+            {
+                return "wyrand";
+            }
+            case EngineType::Philox4x32:
+            {
+                return "philox4x32";
+            }
+        }
+        return "unknown";
+    }
+} // namespace lipsum
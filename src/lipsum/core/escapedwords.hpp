@@ -0,0 +1,104 @@
+/**
+ * @file lipsum/core/escapedwords.hpp
+ *
+ * @brief Declaration of lipsum::internal::EscapedWords
+ *
+ * This declares lipsum::internal::EscapedWords, which keeps the escaped forms
+ * of the words of a source that HTML and XML cannot hold as they are, or
+ * that cannot name an XML element as they are. This file is under the BSD
+ * Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core.hpp"
+#include "stdincludes.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum::internal
+{
+    /**
+     * @brief Escaped forms of the words of a source
+     *
+     * @since 0.5.3
+     *
+     * Built once when a source is loaded: only words with a character that
+     * lipsum::internal::HandleHTMLEntity() escapes are kept, escaped, and
+     * looked up by where the word starts in the blob of the source. Most
+     * sources have none, so looking a word up is then a single check, and
+     * HTML and XML output needs no pass over its bytes. The same is done
+     * for the words that are not XML names, keeping a name made of each.
+     */
+    class LIPSUM_API EscapedWords
+    {
+    public:
+        /**
+         * @brief How the words are escaped
+         *
+         * @since 0.5.3
+         */
+        enum class Form
+        {
+            Html,   ///< Escape with lipsum::internal::HandleHTMLEntity()
+            XmlName ///< Make names with lipsum::internal::XmlNameInto()
+        };
+
+        /**
+         * @brief Find and escape the words that need it.
+         *
+         * @since 0.5.3
+         *
+         * @param blob The words of the source, back to back.
+         * @param offsets The start of each word in blob, followed by the
+         * size of blob.
+         * @param count The number of words.
+         * @param form How to escape the words.
+         */
+        void build(const char*          blob,
+                   const std::uint64_t* offsets,
+                   std::size_t          count,
+                   Form                 form = Form::Html);
+
+        /**
+         * @brief Forget every escaped word.
+         *
+         * @since 0.5.3
+         */
+        void clear();
+
+        /**
+         * @brief Get the escaped form of a word.
+         *
+         * @since 0.5.3
+         *
+         * @param word A word of the source, as a view into blob.
+         * @param blob The words of the source, as passed to build() or moved
+         * since with the source.
+         *
+         * @return std::string_view The escaped form, or word if it needs no
+         * escaping or is not a word of the source.
+         */
+        [[nodiscard]] std::string_view find(std::string_view word,
+                                            const char*      blob) const;
+
+        /**
+         * @brief Get the number of words that need escaping.
+         *
+         * @since 0.5.3
+         *
+         * @return std::size_t The number of escaped words.
+         */
+        [[nodiscard]] std::size_t size() const;
+
+    private:
+        std::vector<std::uint64_t> m_Starts; ///< Start of each word that
+                                             ///< needs escaping, ascending
+        std::string                m_Arena;  ///< Escaped forms back to back
+        std::vector<std::uint64_t> m_Ends;   ///< End of each escaped form
+                                             ///< in m_Arena
+    };
+} // namespace lipsum::internal
+#endif
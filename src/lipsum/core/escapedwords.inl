@@ -0,0 +1,89 @@
+/**
+ * @file lipsum/core/escapedwords.inl
+ *
+ * @brief Definition of lipsum::internal::EscapedWords
+ *
+ * This defines the functions in lipsum::internal::EscapedWords. This file is
+ * under the BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "escapedwords.hpp"
+#include "internal.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum::internal
+{
+    void EscapedWords::build(const char*          blob,
+                             const std::uint64_t* offsets,
+                             std::size_t          count,
+                             Form                 form)
+    {
+        clear();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::string_view word(blob + offsets[i],
+                                  static_cast<std::size_t>(offsets[i + 1] -
+                                                           offsets[i]));
+            bool isHtml = (form == Form::Html);
+            if (isHtml ? FindHTMLEntity(word) == std::string::npos
+                       : IsXmlName(word))
+            {
+                continue;
+            }
+            m_Starts.push_back(offsets[i]);
+            if (isHtml)
+            {
+                HandleHTMLEntityInto(m_Arena, word);
+            }
+            else
+            {
+                XmlNameInto(m_Arena, word);
+            }
+            m_Ends.push_back(m_Arena.size());
+        }
+        LPSM_VERBOSE_LOG(Trace,
+                         (form == Form::Html ? "Escaped " : "Named "),
+                         m_Starts.size(),
+                         " words");
+    }
+
+    void EscapedWords::clear()
+    {
+        m_Starts.clear();
+        m_Arena.clear();
+        m_Ends.clear();
+    }
+
+    std::string_view EscapedWords::find(std::string_view word,
+                                        const char*      blob) const
+    {
+        auto at   = reinterpret_cast<std::uintptr_t>(word.data());
+        auto base = reinterpret_cast<std::uintptr_t>(blob);
+        if (m_Starts.empty() || at < base)
+        {
+            return word;
+        }
+
+        std::uint64_t start = at - base;
+        auto found = std::lower_bound(m_Starts.begin(), m_Starts.end(), start);
+        if (found == m_Starts.end() || *found != start)
+        {
+            return word;
+        }
+        auto idx = static_cast<std::size_t>(found - m_Starts.begin());
+        std::uint64_t begin = (idx == 0 ? 0 : m_Ends[idx - 1]);
+        return {m_Arena.data() + begin,
+                static_cast<std::size_t>(m_Ends[idx] - begin)};
+    }
+
+    std::size_t EscapedWords::size() const
+    {
+        return m_Starts.size();
+    }
+} // namespace lipsum::internal
+#endif
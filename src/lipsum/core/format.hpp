@@ -0,0 +1,214 @@
+/**
+ * @file lipsum/core/format.hpp
+ *
+ * @brief Markup formats of lipsum-cpp
+ *
+ * This declares the format policies that lipsum::Generator uses to write
+ * Markdown and HTML. Each policy holds the markup of one format as constants,
+ * so the formatted functions are compiled once per format with no branch on
+ * the format inside their loops. This file is under the BSD Zero-Clause
+ * License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core.hpp"
+#include "stdincludes.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum
+{
+    namespace internal
+    {
+        /**
+         * @brief The highest header level with a constant tag
+         *
+         * @since 0.5.3
+         */
+        constexpr int MAX_HEADER_LEVEL = 6;
+
+        /**
+         * @brief Markdown, as written by lipsum::Generator
+         *
+         * @since 0.5.3
+         */
+        struct LIPSUM_API MarkdownFormat
+        {
+            /// Whether words are written with their HTML entities handled
+            static constexpr bool ESCAPES_WORDS = false;
+
+            static constexpr std::string_view PARAGRAPH_OPEN  = "";
+            static constexpr std::string_view PARAGRAPH_CLOSE = "\n\n";
+
+            static constexpr std::string_view BOLD_OPEN    = "**";
+            static constexpr std::string_view BOLD_CLOSE   = "**";
+            static constexpr std::string_view ITALIC_OPEN  = "*";
+            static constexpr std::string_view ITALIC_CLOSE = "*";
+
+            /// Whether the URL of a link comes before its text
+            static constexpr bool             URL_FIRST   = false;
+            static constexpr std::string_view LINK_OPEN   = "[";
+            static constexpr std::string_view LINK_MIDDLE = "](";
+            static constexpr std::string_view LINK_CLOSE  = ")";
+
+            static constexpr std::string_view ORDERED_LIST_OPEN    = "";
+            static constexpr std::string_view ORDERED_LIST_CLOSE   = "\n";
+            static constexpr std::string_view UNORDERED_LIST_OPEN  = "";
+            static constexpr std::string_view UNORDERED_LIST_CLOSE = "\n";
+
+            /// Whether the items of an ordered list start with their number
+            static constexpr bool             NUMBERED_ITEMS    = true;
+            static constexpr std::string_view ORDERED_ITEM_OPEN = ". ";
+            static constexpr std::string_view ITEM_OPEN         = "- ";
+            static constexpr std::string_view ITEM_CLOSE        = "\n";
+
+            /// Header markers by level
+            static constexpr std::array<std::string_view, MAX_HEADER_LEVEL + 1>
+                    HEADER_OPEN = {
+                            " ",
+                            "# ",
+                            "## ",
+                            "### ",
+                            "#### ",
+                            "##### ",
+                            "###### ",
+                    };
+
+            /**
+             * @brief Append the start of a header.
+             *
+             * @since 0.5.3
+             *
+             * Append a constant marker for levels from 0 to MAX_HEADER_LEVEL.
+             * Other levels, which are invalid, are built at run time.
+             *
+             * @param out The buffer to append to.
+             * @param level The header level.
+             */
+            static void open_header_into(std::string& out, int level);
+
+            /**
+             * @brief Append the end of a header.
+             *
+             * @since 0.5.3
+             *
+             * @param out The buffer to append to.
+             * @param level The header level.
+             */
+            static void close_header_into(std::string& out, int level);
+        };
+
+        /**
+         * @brief HTML, as written by lipsum::Generator
+         *
+         * @since 0.5.3
+         */
+        struct LIPSUM_API HtmlFormat
+        {
+            /// Whether words are written with their HTML entities handled
+            static constexpr bool ESCAPES_WORDS = true;
+
+            static constexpr std::string_view PARAGRAPH_OPEN  = "<p>";
+            static constexpr std::string_view PARAGRAPH_CLOSE = "</p>\n\n";
+
+            static constexpr std::string_view BOLD_OPEN    = "<strong>";
+            static constexpr std::string_view BOLD_CLOSE   = "</strong>";
+            static constexpr std::string_view ITALIC_OPEN  = "<em>";
+            static constexpr std::string_view ITALIC_CLOSE = "</em>";
+
+            /// Whether the URL of a link comes before its text
+            static constexpr bool             URL_FIRST   = true;
+            static constexpr std::string_view LINK_OPEN   = "<a href=\"";
+            static constexpr std::string_view LINK_MIDDLE = "\">";
+            static constexpr std::string_view LINK_CLOSE  = "</a>";
+
+            static constexpr std::string_view ORDERED_LIST_OPEN  = "<ol>";
+            static constexpr std::string_view ORDERED_LIST_CLOSE =
+                    "</ol>\n\n";
+            static constexpr std::string_view UNORDERED_LIST_OPEN = "<ul>";
+            static constexpr std::string_view UNORDERED_LIST_CLOSE =
+                    "</ul>\n\n";
+
+            /// Whether the items of an ordered list start with their number
+            static constexpr bool             NUMBERED_ITEMS    = false;
+            static constexpr std::string_view ORDERED_ITEM_OPEN = "<li>";
+            static constexpr std::string_view ITEM_OPEN         = "<li>";
+            static constexpr std::string_view ITEM_CLOSE        = "</li>";
+
+            /// Header start tags by level
+            static constexpr std::array<std::string_view, MAX_HEADER_LEVEL + 1>
+                    HEADER_OPEN = {
+                            "<h0>",
+                            "<h1>",
+                            "<h2>",
+                            "<h3>",
+                            "<h4>",
+                            "<h5>",
+                            "<h6>",
+                    };
+
+            /// Header end tags by level
+            static constexpr std::array<std::string_view, MAX_HEADER_LEVEL + 1>
+                    HEADER_CLOSE = {
+                            "</h0>\n\n",
+                            "</h1>\n\n",
+                            "</h2>\n\n",
+                            "</h3>\n\n",
+                            "</h4>\n\n",
+                            "</h5>\n\n",
+                            "</h6>\n\n",
+                    };
+
+            /**
+             * @brief Append the start tag of a header.
+             *
+             * @since 0.5.3
+             *
+             * Append a constant tag for levels from 0 to MAX_HEADER_LEVEL.
+             * Other levels, which are invalid, are built at run time.
+             *
+             * @param out The buffer to append to.
+             * @param level The header level.
+             */
+            static void open_header_into(std::string& out, int level);
+
+            /**
+             * @brief Append the end tag of a header.
+             *
+             * @since 0.5.3
+             *
+             * @param out The buffer to append to.
+             * @param level The header level.
+             */
+            static void close_header_into(std::string& out, int level);
+        };
+
+        /**
+         * @brief Is F a markup format lipsum::Generator can write?
+         *
+         * @since 0.5.3
+         *
+         * A new format is a struct with the same members as
+         * internal::MarkdownFormat.
+         */
+        template <typename F>
+        concept FormatPolicy = requires(std::string& out, int level) {
+            { F::PARAGRAPH_OPEN } -> std::convertible_to<std::string_view>;
+            { F::PARAGRAPH_CLOSE } -> std::convertible_to<std::string_view>;
+            { F::BOLD_OPEN } -> std::convertible_to<std::string_view>;
+            { F::ITALIC_OPEN } -> std::convertible_to<std::string_view>;
+            { F::LINK_MIDDLE } -> std::convertible_to<std::string_view>;
+            { F::ORDERED_ITEM_OPEN } -> std::convertible_to<std::string_view>;
+            { F::ITEM_CLOSE } -> std::convertible_to<std::string_view>;
+            { F::ESCAPES_WORDS } -> std::convertible_to<bool>;
+            { F::URL_FIRST } -> std::convertible_to<bool>;
+            { F::NUMBERED_ITEMS } -> std::convertible_to<bool>;
+            F::open_header_into(out, level);
+            F::close_header_into(out, level);
+        };
+    } // namespace internal
+} // namespace lipsum
+#endif
@@ -0,0 +1,65 @@
+/**
+ * @file lipsum/core/format.inl
+ *
+ * @brief Definition of the markup formats of lipsum-cpp
+ *
+ * This defines the functions in lipsum::internal::MarkdownFormat and
+ * lipsum::internal::HtmlFormat. This file is under the BSD Zero-Clause
+ * License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "format.hpp"
+#include "internal.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum
+{
+    namespace internal
+    {
+        void MarkdownFormat::open_header_into(std::string& out, int level)
+        {
+            if (level >= 0 && level <= MAX_HEADER_LEVEL)
+            {
+                out += HEADER_OPEN[static_cast<std::size_t>(level)];
+                return;
+            }
+            out.append(static_cast<std::size_t>(std::max(level, 0)), '#');
+            out += ' ';
+        }
+
+        void MarkdownFormat::close_header_into(std::string& out, int)
+        {
+            out += "\n\n";
+        }
+
+        void HtmlFormat::open_header_into(std::string& out, int level)
+        {
+            if (level >= 0 && level <= MAX_HEADER_LEVEL)
+            {
+                out += HEADER_OPEN[static_cast<std::size_t>(level)];
+                return;
+            }
+            out += "<h";
+            AppendNumber(out, level);
+            out += '>';
+        }
+
+        void HtmlFormat::close_header_into(std::string& out, int level)
+        {
+            if (level >= 0 && level <= MAX_HEADER_LEVEL)
+            {
+                out += HEADER_CLOSE[static_cast<std::size_t>(level)];
+                return;
+            }
+            out += "</h";
+            AppendNumber(out, level);
+            out += ">\n\n";
+        }
+    } // namespace internal
+} // namespace lipsum
+#endif
@@ -88,6 +88,17 @@ namespace lipsum::internal
     template <typename T>
     concept UniformDistributionType = (IsInt<T> || std::floating_point<T>);
 
+    /**
+     * @brief The default lorem-ipsum sentence.
+     *
+     * @since 0.5.3
+     *
+     * The sentence returned by lipsum::GenerateDefaultLipsumSentence(), kept as
+     * a constant so generators can append it without a temporary string.
+     */
+    inline constexpr std::string_view LIPSUM_DEFAULT_SENTENCE =
+            "Lorem ipsum dolor sit amet, consectetur adipiscing elit.";
+
     /**
      * @brief Handle HTML entities.
      *
@@ -103,6 +114,107 @@ namespace lipsum::internal
      */
     LIPSUM_API std::string HandleHTMLEntity(const std::string& str);
 
+    /**
+     * @brief Find the next character that HTML escapes.
+     *
+     * @since 0.5.3
+     *
+     * Look for a quotation mark, apostrophe, less-than sign, greater-than
+     * sign or ampersand, 16 bytes at a time if SSE2 is available. If doing a
+     * minimum build, find nothing.
+     *
+     * @param str The string to search.
+     * @param pos The index to start from.
+     *
+     * @return std::size_t The index of the character, or std::string::npos
+     * if there is none.
+     */
+    LIPSUM_API std::size_t FindHTMLEntity(std::string_view str,
+                                          std::size_t      pos = 0);
+
+    /**
+     * @brief Handle HTML entities, appending to a buffer.
+     *
+     * @since 0.5.3
+     *
+     * Same as HandleHTMLEntity(), but appends to out instead of returning a
+     * new string. Runs without an entity are appended whole, as found by
+     * FindHTMLEntity(). If doing a minimum build, append str as is.
+     *
+     * @param out The buffer to append to.
+     * @param str The string to handle.
+     */
+    LIPSUM_API void HandleHTMLEntityInto(std::string&     out,
+                                         std::string_view str);
+
+#ifndef LIPSUM_MIN_BUILD
+    /**
+     * @brief Check if a string is an XML name.
+     *
+     * @since 0.5.3
+     *
+     * An XML name, as written by lipsum::Generator::xml(), starts with an
+     * ASCII letter or an underscore, followed by ASCII letters, digits,
+     * underscores, hyphens and periods. Not available in minimum builds.
+     *
+     * @param str The string to check.
+     *
+     * @return bool Whether str can name an element or an attribute.
+     */
+    LIPSUM_API bool IsXmlName(std::string_view str);
+
+    /**
+     * @brief Append a string made into an XML name.
+     *
+     * @since 0.5.3
+     *
+     * Replace every character that IsXmlName() does not allow with an
+     * underscore, and start with an underscore if str does not start with a
+     * letter or an underscore, so that "it's" becomes "it_s" and "30,000"
+     * becomes "_30_000". Not available in minimum builds.
+     *
+     * @param out The buffer to append to.
+     * @param str The string to make into a name.
+     */
+    LIPSUM_API void XmlNameInto(std::string& out, std::string_view str);
+#endif
+
+    /**
+     * @brief Classes of 64 characters, one bit per character
+     *
+     * @since 0.5.3
+     *
+     * Bit i of each mask is set if character i is of that class. Used by
+     * lipsum::AnalyzeText().
+     */
+    struct LIPSUM_API TextMasks
+    {
+        std::uint64_t alnum    = 0; ///< ASCII letters and digits
+        std::uint64_t joiner   = 0; ///< Hyphens, plus signs and apostrophes
+        std::uint64_t hyphen   = 0; ///< Hyphens
+        std::uint64_t space    = 0; ///< Spaces
+        std::uint64_t newline  = 0; ///< Newlines
+        std::uint64_t tab      = 0; ///< Tabs
+        std::uint64_t sentence = 0; ///< Periods, question and exclamation marks
+        std::uint64_t clause   = 0; ///< Commas, semicolons and colons
+        std::uint64_t open     = 0; ///< Opening parentheses
+        std::uint64_t close    = 0; ///< Closing parentheses
+        std::uint64_t tag      = 0; ///< Less-than signs
+    };
+
+    /**
+     * @brief Classify 64 characters at once for text statistics.
+     *
+     * @since 0.5.3
+     *
+     * Use SSE2 where available, and a scalar loop otherwise.
+     *
+     * @param data The first of 64 readable characters.
+     *
+     * @return TextMasks The class masks of the characters.
+     */
+    LIPSUM_API TextMasks ClassifyText64(const char* data);
+
     /**
      * @brief Log a warning.
      *
@@ -312,6 +424,51 @@ namespace lipsum::internal
         }
     }
 
+    /**
+     * @brief Append a number to a string.
+     *
+     * @since 0.5.3
+     *
+     * Append param to str without a temporary string. Integers are converted
+     * with std::to_chars() in the given base, and floating-point values with
+     * std::snprintf(), matching the output of lipsum::internal::ToString().
+     *
+     * @tparam T The type being appended. Must be a uniform-distribution type,
+     * i.e. ints (excluding chars and bool) and floats.
+     *
+     * @param str The string to append to.
+     * @param param The number being appended.
+     * @param base The base used for integers. By default 10.
+     */
+    template <UniformDistributionType T>
+    void AppendNumber(std::string& str, T param, int base = 10)
+    {
+        constexpr std::size_t NUMBER_BUFFER_SIZE = 64;
+
+        std::array<char, NUMBER_BUFFER_SIZE> buffer{};
+        if constexpr (std::is_integral_v<T>)
+        {
+            auto result = std::to_chars(buffer.data(),
+                                        buffer.data() + buffer.size(),
+                                        param,
+                                        base);
+            str.append(buffer.data(), result.ptr);
+        }
+        else
+        {
+            int len = std::snprintf(buffer.data(),
+                                    buffer.size(),
+                                    "%f",
+                                    static_cast<double>(param));
+            if (len > 0)
+            {
+                str.append(buffer.data(),
+                           std::min(static_cast<std::size_t>(len),
+                                    buffer.size() - 1));
+            }
+        }
+    }
+
 #else
     template <typename T> std::string ToString(const T& param)
     {
@@ -0,0 +1,104 @@
+/**
+ * @file lipsum/core/mappedfile.hpp
+ *
+ * @brief Declaration of lipsum::internal::MappedFile
+ *
+ * This declares lipsum::internal::MappedFile, a read-only view of a whole
+ * file. This file is under the BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum::internal
+{
+    /**
+     * @brief Read-only view of a whole file
+     *
+     * @since 0.5.3
+     *
+     * Map a file into memory with mmap() or MapViewOfFile(), so that reading
+     * it neither copies it nor allocates. If the file cannot be mapped (for
+     * example, if it is empty or a pipe), read it into memory instead. Not
+     * available in minimum builds.
+     */
+    class LIPSUM_API MappedFile
+    {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * @since 0.5.3
+         *
+         * Create a view of no file.
+         */
+        MappedFile() = default;
+
+        /**
+         * @brief Destructor for MappedFile
+         *
+         * @since 0.5.3
+         *
+         * Unmap the file, invalidating every view returned by data().
+         */
+        ~MappedFile();
+
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Open and map a file.
+         *
+         * @since 0.5.3
+         *
+         * Unmap the previous file, if any, then map path.
+         *
+         * @param path The path of the file.
+         *
+         * @return bool Whether the file could be opened.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Unmap the file.
+         *
+         * @since 0.5.3
+         */
+        void close();
+
+        /**
+         * @brief Get the contents of the file.
+         *
+         * @since 0.5.3
+         *
+         * @return std::string_view The contents, valid until the file is
+         * closed.
+         */
+        [[nodiscard]] std::string_view data() const;
+
+    private:
+        /**
+         * @brief Read a file into m_Fallback.
+         *
+         * @since 0.5.3
+         *
+         * @param path The path of the file.
+         *
+         * @return bool Whether the file could be opened.
+         */
+        bool read_fallback(const std::string& path);
+
+        const char* m_Data = nullptr; ///< Start of the mapping
+        std::size_t m_Size = 0;       ///< Size of the mapping
+#    ifdef _WIN32
+        HANDLE m_Mapping = nullptr; ///< Handle of the file mapping
+#    endif
+        std::string m_Fallback; ///< Contents of files that were not mapped
+    };
+} // namespace lipsum::internal
+#endif
@@ -0,0 +1,134 @@
+/**
+ * @file lipsum/core/mappedfile.inl
+ *
+ * @brief Definition of lipsum::internal::MappedFile
+ *
+ * This defines lipsum::internal::MappedFile. This file is under the BSD
+ * Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "internal.hpp"
+#include "mappedfile.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum::internal
+{
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    bool MappedFile::open(const std::string& path)
+    {
+        close();
+#    ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(),
+                                  GENERIC_READ,
+                                  FILE_SHARE_READ,
+                                  nullptr,
+                                  OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL,
+                                  nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(file, &size) == 0 || size.QuadPart <= 0 ||
+            static_cast<unsigned long long>(size.QuadPart) >
+                    std::numeric_limits<std::size_t>::max())
+        {
+            CloseHandle(file);
+            return read_fallback(path);
+        }
+        m_Mapping =
+                CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (m_Mapping == nullptr)
+        {
+            return read_fallback(path);
+        }
+        void* view = MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == nullptr)
+        {
+            CloseHandle(m_Mapping);
+            m_Mapping = nullptr;
+            return read_fallback(path);
+        }
+        m_Data = static_cast<const char*>(view);
+        m_Size = static_cast<std::size_t>(size.QuadPart);
+        return true;
+#    else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+        struct stat info{};
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) ||
+            info.st_size <= 0)
+        {
+            ::close(fd);
+            return read_fallback(path);
+        }
+        auto  size = static_cast<std::size_t>(info.st_size);
+        void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED)
+        {
+            return read_fallback(path);
+        }
+#        ifdef MADV_SEQUENTIAL
+        madvise(view, size, MADV_SEQUENTIAL);
+#        endif
+        m_Data = static_cast<const char*>(view);
+        m_Size = size;
+        return true;
+#    endif
+    }
+
+    void MappedFile::close()
+    {
+        if (m_Data != nullptr)
+        {
+#    ifdef _WIN32
+            UnmapViewOfFile(m_Data);
+            CloseHandle(m_Mapping);
+            m_Mapping = nullptr;
+#    else
+            munmap(const_cast<char*>(m_Data), m_Size);
+#    endif
+        }
+        m_Data = nullptr;
+        m_Size = 0;
+        m_Fallback.clear();
+        m_Fallback.shrink_to_fit();
+    }
+
+    std::string_view MappedFile::data() const
+    {
+        if (m_Data != nullptr)
+        {
+            return {m_Data, m_Size};
+        }
+        return m_Fallback;
+    }
+
+    bool MappedFile::read_fallback(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        m_Fallback.assign(std::istreambuf_iterator<char>(file),
+                          std::istreambuf_iterator<char>());
+        return true;
+    }
+} // namespace lipsum::internal
+#endif
@@ -0,0 +1,418 @@
+/**
+ * @file lipsum/core/markovsource.hpp
+ *
+ * @brief Markov-chain generation for lipsum-cpp
+ *
+ * This declares lipsum::MarkovSource. This file is under the BSD Zero-Clause
+ * License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core.hpp"
+#include "engine.hpp"
+#include "escapedwords.hpp"
+#include "mappedfile.hpp"
+#include "weightedtable.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum
+{
+    namespace internal
+    {
+        /**
+         * @brief A transition of a Markov chain
+         *
+         * @since 0.5.3
+         *
+         * The transitions of a state double as its alias table, so that
+         * picking one reads a single record.
+         */
+        struct MarkovEdge
+        {
+            std::uint32_t threshold; ///< Chance of keeping it, * 2^32
+            std::uint32_t alias;     ///< Transition of the state used otherwise
+            std::uint32_t word;      ///< Index of the word it emits
+            std::uint32_t next;      ///< State it leads to
+        };
+
+        /**
+         * @brief Magic bytes that start every compiled Markov model file
+         *
+         * @since 0.5.3
+         */
+        inline constexpr std::string_view MARKOV_FILE_MAGIC{"LPSMMKV\0", 8};
+
+        /**
+         * @brief Version of the compiled Markov model file layout
+         *
+         * @since 0.5.3
+         */
+        inline constexpr std::uint32_t MARKOV_FILE_VERSION = 1;
+
+        /**
+         * @brief Size of the header of compiled Markov model files
+         *
+         * @since 0.5.3
+         *
+         * The header holds, in order: MARKOV_FILE_MAGIC, the version and the
+         * order as 32-bit integers, then the number of words, the size of the
+         * word blob, the number of states and the number of transitions as
+         * 64-bit integers. Every integer in the file is little-endian.
+         */
+        inline constexpr std::size_t MARKOV_FILE_HEADER_SIZE = 48;
+
+        static_assert(sizeof(MarkovEdge) == 16,
+                      "Markov model files store 16-byte transitions");
+
+        /**
+         * @brief Where the parts of a compiled Markov model file are
+         *
+         * @since 0.5.3
+         *
+         * After the header come the word count + 1 offsets of the words in
+         * the blob as 64-bit integers, the state count + 1 offsets of the
+         * transitions of each state as 32-bit integers padded to a multiple
+         * of 8 bytes, the transitions as the four 32-bit members of
+         * MarkovEdge, then the blob. Every part starts 8-byte aligned, so a
+         * mapped file can be used in place.
+         */
+        struct MarkovFileLayout
+        {
+            std::size_t wordOffsetsAt  = 0; ///< Start of the word offsets
+            std::size_t stateOffsetsAt = 0; ///< Start of the state offsets
+            std::size_t edgesAt        = 0; ///< Start of the transitions
+            std::size_t blobAt         = 0; ///< Start of the word blob
+            std::size_t fileSize       = 0; ///< Size of the whole file
+        };
+
+        /**
+         * @brief Compute the layout of a compiled Markov model file.
+         *
+         * @since 0.5.3
+         *
+         * @param words The number of words.
+         * @param blobSize The size of the word blob.
+         * @param states The number of states.
+         * @param edges The number of transitions.
+         *
+         * @return MarkovFileLayout The layout.
+         */
+        LIPSUM_API MarkovFileLayout MarkovFileLayoutOf(std::uint64_t words,
+                                                       std::uint64_t blobSize,
+                                                       std::uint64_t states,
+                                                       std::uint64_t edges);
+    } // namespace internal
+
+    /**
+     * @brief Class for Markov-chain generation
+     *
+     * @since 0.5.3
+     *
+     * This class picks each word based on the words before it, following the
+     * n-grams of a corpus, so that generated text reads like the corpus
+     * instead of a shuffled word list. Each state of the chain is the last
+     * order words of a sentence (fewer at the start of one), and its
+     * transitions are stored back to back with those of the other states
+     * (compressed sparse rows), each state with its own alias table, so
+     * picking the next word takes constant time. A state with no transitions
+     * ends a sentence, and the chain starts over from START_STATE.
+     *
+     * A trained model can be saved to a file, which load() maps into memory
+     * and uses in place. Models are read-only once loaded, so one model can
+     * be shared between threads, each keeping its own state. Not available in
+     * minimum builds.
+     *
+     * @sa lipsum::Generator::load_markov
+     */
+    class LIPSUM_API MarkovSource
+    {
+    public:
+        /**
+         * @brief State at the start of every sentence
+         *
+         * @since 0.5.3
+         */
+        static constexpr std::uint32_t START_STATE = 0;
+
+        /**
+         * @brief Highest supported order
+         *
+         * @since 0.5.3
+         */
+        static constexpr unsigned int MAX_ORDER = 8;
+
+        /**
+         * @brief Default constructor
+         *
+         * @since 0.5.3
+         *
+         * Create an empty model.
+         */
+        MarkovSource() = default;
+
+        /**
+         * @brief Constructor with a path
+         *
+         * @since 0.5.3
+         *
+         * @param path A path to a corpus or a compiled model.
+         * @param order The number of words each word depends on, if path is a
+         * corpus. By default 2.
+         *
+         * @sa lipsum::MarkovSource::load
+         */
+        explicit MarkovSource(const std::string& path, unsigned int order = 2);
+
+        MarkovSource(const MarkovSource&)            = delete;
+        MarkovSource& operator=(const MarkovSource&) = delete;
+
+        /**
+         * @brief Load a model.
+         *
+         * @since 0.5.3
+         *
+         * If path is a compiled model written by save(), map it into memory
+         * and use it in place where possible. Otherwise, train a model of the
+         * specified order on the text of the file with train(). On failure,
+         * print a warning and leave the model empty.
+         *
+         * @param path A path to a corpus or a compiled model.
+         * @param order The number of words each word depends on, if path is a
+         * corpus. By default 2.
+         *
+         * @return bool Whether a model was loaded.
+         */
+        bool load(const std::string& path, unsigned int order = 2);
+
+        /**
+         * @brief Train a model on a corpus.
+         *
+         * @since 0.5.3
+         *
+         * Split text into lowercase words like lipsum::Source::load(), and
+         * into sentences at '.', '!', and '?', then count every transition
+         * from the last order words of a sentence to the next word. On
+         * failure, print a warning and leave the model empty.
+         *
+         * @param text The corpus.
+         * @param order The number of words each word depends on, from 1 to
+         * MAX_ORDER. By default 2.
+         *
+         * @return bool Whether text contained any words.
+         */
+        bool train(std::string_view text, unsigned int order = 2);
+
+        /**
+         * @brief Save the model as a compiled model file.
+         *
+         * @since 0.5.3
+         *
+         * The file is the same on every platform.
+         *
+         * @param path The path of the file to write.
+         *
+         * @return bool Whether the file could be written.
+         */
+        bool save(const std::string& path) const;
+
+        /**
+         * @brief Pick the next word.
+         *
+         * @since 0.5.3
+         *
+         * Follow a random transition out of state, weighted by how many times
+         * it appeared in the corpus, and move state along it. If state ends a
+         * sentence or is out of range, start over from START_STATE. The model
+         * must not be empty.
+         *
+         * @param gen The generator to use.
+         * @param state The current state, updated to the next one.
+         *
+         * @return std::string_view The word, valid while the model is.
+         */
+        [[nodiscard]] std::string_view next_word(std::mt19937&  gen,
+                                                 std::uint32_t& state) const;
+
+        /**
+         * @brief Pick the next word.
+         *
+         * @since 0.5.3
+         *
+         * @overload
+         *
+         * @param gen The generator to use.
+         * @param state The current state, updated to the next one.
+         *
+         * @return std::string_view The word, valid while the model is.
+         */
+        [[nodiscard]] std::string_view next_word(Engine&        gen,
+                                                 std::uint32_t& state) const;
+
+        /**
+         * @brief Get a word by its index.
+         *
+         * @since 0.5.3
+         *
+         * @param idx The index of the word, from 0 to size() - 1.
+         *
+         * @return std::string_view The word.
+         */
+        [[nodiscard]] std::string_view word_at(std::size_t idx) const;
+
+        /**
+         * @brief Get the escaped form of a word.
+         *
+         * @since 0.5.3
+         *
+         * Same as lipsum::Source::escaped_word(), for the words of the model.
+         *
+         * @param word A word returned by this model.
+         *
+         * @return std::string_view The escaped form, valid while the model
+         * is, or word itself if it needs no escaping.
+         */
+        [[nodiscard]] std::string_view
+        escaped_word(std::string_view word) const;
+
+        /**
+         * @brief Check if any word needs escaping.
+         *
+         * @since 0.5.3
+         *
+         * @return bool Whether escaped_word() changes any word of the model.
+         */
+        [[nodiscard]] bool needs_escaping() const;
+
+        /**
+         * @brief Get the XML name made from a word.
+         *
+         * @since 0.5.3
+         *
+         * Same as lipsum::Source::xml_name(), for the words of the model.
+         *
+         * @param word A word returned by this model.
+         *
+         * @return std::string_view The name, valid while the model is, or
+         * word itself if it is already a name.
+         */
+        [[nodiscard]] std::string_view xml_name(std::string_view word) const;
+
+        /**
+         * @brief Get the number of words.
+         *
+         * @since 0.5.3
+         *
+         * @return std::size_t The number of unique words, or 0 if the model
+         * is empty.
+         */
+        [[nodiscard]] std::size_t size() const;
+
+        /**
+         * @brief Get the number of states.
+         *
+         * @since 0.5.3
+         *
+         * @return std::size_t The number of states.
+         */
+        [[nodiscard]] std::size_t state_count() const;
+
+        /**
+         * @brief Get the number of transitions.
+         *
+         * @since 0.5.3
+         *
+         * @return std::size_t The number of distinct transitions.
+         */
+        [[nodiscard]] std::size_t edge_count() const;
+
+        /**
+         * @brief Get the order.
+         *
+         * @since 0.5.3
+         *
+         * @return unsigned int The number of words each word depends on.
+         */
+        [[nodiscard]] unsigned int order() const;
+
+    private:
+        /**
+         * @brief Pick the next word.
+         *
+         * @since 0.5.3
+         *
+         * @tparam G The engine type.
+         *
+         * @param gen The generator to use.
+         * @param state The current state, updated to the next one.
+         *
+         * @return std::string_view The word.
+         */
+        template <internal::FullRangeEngine G>
+        std::string_view next_word_with(G& gen, std::uint32_t& state) const;
+
+        /**
+         * @brief Load a compiled model file.
+         *
+         * @since 0.5.3
+         *
+         * If owner is given, the file is little-endian, and data is 8-byte
+         * aligned, use data in place and keep owner alive. Otherwise, copy it.
+         *
+         * @param data The whole file.
+         * @param owner The mapping data points into, or nullptr.
+         * @param name The name reported in warnings.
+         *
+         * @return bool Whether data is a valid model.
+         */
+        bool load_model(std::string_view                            data,
+                        std::shared_ptr<const internal::MappedFile> owner,
+                        const std::string&                          name);
+
+        /**
+         * @brief Empty the model.
+         *
+         * @since 0.5.3
+         */
+        void clear();
+
+        /**
+         * @brief Point the views at the owned storage.
+         *
+         * @since 0.5.3
+         */
+        void use_owned();
+
+        /**
+         * @brief Escape the words that need it, and make XML names of the
+         * words that are not names, once the model is loaded.
+         *
+         * @since 0.5.3
+         */
+        void escape_words();
+
+        std::string                m_OwnedBlob; ///< Words, back to back
+        std::vector<std::uint64_t> m_OwnedWordOffsets; ///< Start of each word
+        std::vector<std::uint32_t>
+                m_OwnedStateOffsets; ///< First transition of each state
+        std::vector<internal::MarkovEdge>
+                m_OwnedEdges; ///< Transitions of the states
+        std::shared_ptr<const internal::MappedFile>
+                m_Mapped; ///< Compiled model used in place, if any
+
+        const char*          m_Blob         = nullptr; ///< View of the words
+        const std::uint64_t* m_WordOffsets  = nullptr; ///< View of offsets
+        const std::uint32_t* m_StateOffsets = nullptr; ///< View of states
+        const internal::MarkovEdge* m_Edges = nullptr; ///< View of edges
+        std::size_t  m_WordCount  = 0; ///< Number of words
+        std::size_t  m_StateCount = 0; ///< Number of states
+        std::size_t  m_EdgeCount  = 0; ///< Number of transitions
+        unsigned int m_Order      = 0; ///< Words each word depends on
+        internal::EscapedWords m_Escaped;  ///< Words that need escaping
+        internal::EscapedWords m_XmlNames; ///< Words that are not XML names
+    };
+} // namespace lipsum
+#endif
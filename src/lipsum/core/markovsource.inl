@@ -0,0 +1,572 @@
+/**
+ * @file lipsum/core/markovsource.inl
+ *
+ * @brief Markov-chain generation for lipsum-cpp
+ *
+ * This defines lipsum::MarkovSource. This file is under the BSD Zero-Clause
+ * License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "internal.hpp"
+#include "markovsource.hpp"
+#include "sourcefile.hpp"
+#include "tokenizer.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum
+{
+    namespace internal
+    {
+        MarkovFileLayout MarkovFileLayoutOf(std::uint64_t words,
+                                            std::uint64_t blobSize,
+                                            std::uint64_t states,
+                                            std::uint64_t edges)
+        {
+            MarkovFileLayout layout;
+            layout.wordOffsetsAt  = MARKOV_FILE_HEADER_SIZE;
+            layout.stateOffsetsAt = layout.wordOffsetsAt +
+                                    ((words + 1) * sizeof(std::uint64_t));
+            // round up to keep the transitions 8-byte aligned
+            layout.edgesAt  = layout.stateOffsetsAt +
+                             (((states + 1) * sizeof(std::uint32_t) + 7) &
+                              ~std::size_t{7});
+            layout.blobAt   = layout.edgesAt + (edges * sizeof(MarkovEdge));
+            layout.fileSize = layout.blobAt + blobSize;
+            return layout;
+        }
+    } // namespace internal
+
+    MarkovSource::MarkovSource(const std::string& path, unsigned int order)
+    {
+        load(path, order);
+    }
+
+    bool MarkovSource::load(const std::string& path, unsigned int order)
+    {
+        LPSM_VERBOSE_LOG(Info, "Loading Markov model ", path);
+        auto file = std::make_shared<internal::MappedFile>();
+        if (!file->open(path))
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::MarkovSource::load(): Could not open "
+                              "file ",
+                              path);
+            clear();
+            return false;
+        }
+        if (file->data().starts_with(internal::MARKOV_FILE_MAGIC))
+        {
+            return load_model(file->data(), file, path);
+        }
+        return train(file->data(), order);
+    }
+
+    bool MarkovSource::train(std::string_view text, unsigned int order)
+    {
+        clear();
+        if (order == 0 || order > MAX_ORDER)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::MarkovSource::train(): Order ",
+                              order,
+                              " is not between 1 and ",
+                              MAX_ORDER);
+            return false;
+        }
+
+        // number every word, and mark sentence ends between them
+        std::vector<std::uint32_t> tokens;
+        {
+            std::vector<std::uint32_t> counts;
+            internal::WordSet words(m_OwnedBlob, m_OwnedWordOffsets, counts);
+            const char*       previousEnd = text.data();
+            internal::ForEachWord(
+                    text,
+                    [&](std::string_view word)
+                    {
+                        std::string_view gap(
+                                previousEnd,
+                                static_cast<std::size_t>(word.data() -
+                                                         previousEnd));
+                        if (gap.find_first_of(".!?") != std::string_view::npos)
+                        {
+                            tokens.push_back(internal::WORD_SET_NONE);
+                        }
+                        tokens.push_back(words.insert(word));
+                        previousEnd = word.data() + word.size();
+                    });
+        }
+        if (tokens.empty())
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::MarkovSource::train(): No words found");
+            clear();
+            return false;
+        }
+
+        struct Transition
+        {
+            std::uint32_t state; // state the transition leaves
+            std::uint32_t word;  // word the transition emits
+            std::uint32_t next;  // state the transition leads to
+        };
+
+        // a state is the last order words of its sentence, keyed by their
+        // indices; states are numbered as they first appear
+        std::unordered_map<std::string, std::uint32_t> states;
+        std::vector<Transition>                        transitions;
+        std::vector<std::uint32_t>                     context;
+        std::string                                    key;
+        states.emplace(std::string(), START_STATE);
+        transitions.reserve(tokens.size());
+        std::uint32_t state = START_STATE;
+        for (std::uint32_t word : tokens)
+        {
+            if (word == internal::WORD_SET_NONE)
+            {
+                state = START_STATE;
+                context.clear();
+                continue;
+            }
+            if (context.size() == order)
+            {
+                context.erase(context.begin());
+            }
+            context.push_back(word);
+            key.assign(reinterpret_cast<const char*>(context.data()),
+                       context.size() * sizeof(std::uint32_t));
+            auto next = states
+                                .try_emplace(key,
+                                             static_cast<std::uint32_t>(
+                                                     states.size()))
+                                .first->second;
+            transitions.push_back({state, word, next});
+            state = next;
+        }
+        if (states.size() > std::numeric_limits<std::uint32_t>::max() ||
+            transitions.size() > std::numeric_limits<std::uint32_t>::max())
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::MarkovSource::train(): Corpus too large");
+            clear();
+            return false;
+        }
+
+        // group the transitions by state; a state and a word always lead to
+        // the same next state, so equal pairs are repeats of one transition
+        std::sort(transitions.begin(),
+                  transitions.end(),
+                  [](const Transition& a, const Transition& b)
+                  {
+                      return a.state != b.state ? a.state < b.state
+                                                : a.word < b.word;
+                  });
+        m_OwnedStateOffsets.assign(states.size() + 1, 0);
+        std::vector<double> weights;
+        for (std::size_t i = 0; i < transitions.size();)
+        {
+            std::size_t end = i + 1;
+            while (end < transitions.size() &&
+                   transitions[end].state == transitions[i].state &&
+                   transitions[end].word == transitions[i].word)
+            {
+                ++end;
+            }
+            ++m_OwnedStateOffsets[transitions[i].state + 1];
+            m_OwnedEdges.push_back(
+                    {0, 0, transitions[i].word, transitions[i].next});
+            weights.push_back(static_cast<double>(end - i));
+            i = end;
+        }
+        for (std::size_t i = 1; i < m_OwnedStateOffsets.size(); ++i)
+        {
+            m_OwnedStateOffsets[i] += m_OwnedStateOffsets[i - 1];
+        }
+
+        std::vector<internal::AliasColumn> columns;
+        std::vector<std::uint32_t>         small;
+        std::vector<std::uint32_t>         large;
+        for (std::size_t i = 0; i < states.size(); ++i)
+        {
+            std::uint32_t begin = m_OwnedStateOffsets[i];
+            std::uint32_t count = m_OwnedStateOffsets[i + 1] - begin;
+            if (count == 0)
+            {
+                continue;
+            }
+            columns.resize(count);
+            internal::BuildAliasColumns(weights.data() + begin,
+                                        count,
+                                        columns.data(),
+                                        small,
+                                        large);
+            for (std::uint32_t j = 0; j < count; ++j)
+            {
+                m_OwnedEdges[begin + j].threshold = columns[j].threshold;
+                m_OwnedEdges[begin + j].alias     = columns[j].alias;
+            }
+        }
+
+        m_WordCount  = m_OwnedWordOffsets.size() - 1;
+        m_StateCount = states.size();
+        m_EdgeCount  = m_OwnedEdges.size();
+        m_Order      = order;
+        use_owned();
+        escape_words();
+        return true;
+    }
+
+    bool MarkovSource::save(const std::string& path) const
+    {
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::MarkovSource::save(): Could not open "
+                              "file ",
+                              path);
+            return false;
+        }
+        std::uint64_t blobSize =
+                m_WordCount != 0 ? m_WordOffsets[m_WordCount] : 0;
+        internal::MarkovFileLayout layout = internal::MarkovFileLayoutOf(
+                m_WordCount, blobSize, m_StateCount, m_EdgeCount);
+        std::string head;
+        head.reserve(layout.blobAt);
+        head.append(internal::MARKOV_FILE_MAGIC);
+        internal::AppendLittleEndian(head, internal::MARKOV_FILE_VERSION);
+        internal::AppendLittleEndian<std::uint32_t>(head, m_Order);
+        internal::AppendLittleEndian<std::uint64_t>(head, m_WordCount);
+        internal::AppendLittleEndian(head, blobSize);
+        internal::AppendLittleEndian<std::uint64_t>(head, m_StateCount);
+        internal::AppendLittleEndian<std::uint64_t>(head, m_EdgeCount);
+        for (std::size_t i = 0; i <= m_WordCount && m_WordCount != 0; ++i)
+        {
+            internal::AppendLittleEndian(head, m_WordOffsets[i]);
+        }
+        head.resize(layout.stateOffsetsAt, '\0');
+        for (std::size_t i = 0; i <= m_StateCount && m_StateCount != 0; ++i)
+        {
+            internal::AppendLittleEndian(head, m_StateOffsets[i]);
+        }
+        head.resize(layout.edgesAt, '\0');
+        for (std::size_t i = 0; i < m_EdgeCount; ++i)
+        {
+            internal::AppendLittleEndian(head, m_Edges[i].threshold);
+            internal::AppendLittleEndian(head, m_Edges[i].alias);
+            internal::AppendLittleEndian(head, m_Edges[i].word);
+            internal::AppendLittleEndian(head, m_Edges[i].next);
+        }
+        file.write(head.data(), static_cast<std::streamsize>(head.size()));
+        file.write(m_Blob, static_cast<std::streamsize>(blobSize));
+        file.flush();
+        if (!file)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::MarkovSource::save(): Could not write "
+                              "file ",
+                              path);
+            return false;
+        }
+        return true;
+    }
+
+    template <internal::FullRangeEngine G>
+    std::string_view MarkovSource::next_word_with(G&             gen,
+                                                  std::uint32_t& state) const
+    {
+        if (state >= m_StateCount)
+        {
+            state = START_STATE;
+        }
+        std::uint32_t begin = m_StateOffsets[state];
+        std::uint32_t count = m_StateOffsets[state + 1] - begin;
+        if (count == 0)
+        {
+            // the corpus ended a sentence here, so start a new one
+            begin = m_StateOffsets[START_STATE];
+            count = m_StateOffsets[START_STATE + 1] - begin;
+        }
+        const internal::MarkovEdge* edges = m_Edges + begin;
+        const internal::MarkovEdge& edge =
+                edges[internal::AliasPick(gen, edges, count)];
+        state = edge.next;
+        return word_at(edge.word);
+    }
+
+    std::string_view MarkovSource::next_word(std::mt19937&  gen,
+                                             std::uint32_t& state) const
+    {
+        return next_word_with(gen, state);
+    }
+
+    std::string_view MarkovSource::next_word(Engine&        gen,
+                                             std::uint32_t& state) const
+    {
+        return next_word_with(gen, state);
+    }
+
+    std::string_view MarkovSource::word_at(std::size_t idx) const
+    {
+        return {m_Blob + m_WordOffsets[idx],
+                static_cast<std::size_t>(m_WordOffsets[idx + 1] -
+                                         m_WordOffsets[idx])};
+    }
+
+    std::string_view MarkovSource::escaped_word(std::string_view word) const
+    {
+        return m_Escaped.find(word, m_Blob);
+    }
+
+    bool MarkovSource::needs_escaping() const
+    {
+        return m_Escaped.size() != 0;
+    }
+
+    std::string_view MarkovSource::xml_name(std::string_view word) const
+    {
+        return m_XmlNames.find(word, m_Blob);
+    }
+
+    std::size_t MarkovSource::size() const
+    {
+        return m_WordCount;
+    }
+
+    std::size_t MarkovSource::state_count() const
+    {
+        return m_StateCount;
+    }
+
+    std::size_t MarkovSource::edge_count() const
+    {
+        return m_EdgeCount;
+    }
+
+    unsigned int MarkovSource::order() const
+    {
+        return m_Order;
+    }
+
+    bool MarkovSource::load_model(
+            std::string_view                            data,
+            std::shared_ptr<const internal::MappedFile> owner,
+            const std::string&                          name)
+    {
+        clear();
+        const char* base  = data.data();
+        const char* error = nullptr;
+
+        std::uint32_t    order    = 0;
+        std::uint64_t    words    = 0;
+        std::uint64_t    blobSize = 0;
+        std::uint64_t    states   = 0;
+        std::uint64_t    edges    = 0;
+        internal::MarkovFileLayout layout;
+        if (data.size() < internal::MARKOV_FILE_HEADER_SIZE ||
+            !data.starts_with(internal::MARKOV_FILE_MAGIC))
+        {
+            error = "not a compiled Markov model";
+        }
+        else if (internal::ReadLittleEndian<std::uint32_t>(base + 8) !=
+                 internal::MARKOV_FILE_VERSION)
+        {
+            error = "unsupported version";
+        }
+        else
+        {
+            order    = internal::ReadLittleEndian<std::uint32_t>(base + 12);
+            words    = internal::ReadLittleEndian<std::uint64_t>(base + 16);
+            blobSize = internal::ReadLittleEndian<std::uint64_t>(base + 24);
+            states   = internal::ReadLittleEndian<std::uint64_t>(base + 32);
+            edges    = internal::ReadLittleEndian<std::uint64_t>(base + 40);
+
+            // compare against the file size first, so the layout cannot
+            // overflow
+            std::uint64_t room =
+                    data.size() - internal::MARKOV_FILE_HEADER_SIZE;
+            constexpr std::uint64_t MAX_INDEX =
+                    std::numeric_limits<std::uint32_t>::max();
+            if (order == 0 || order > MAX_ORDER || words == 0 || states == 0 ||
+                edges == 0 || states > MAX_INDEX || edges > MAX_INDEX)
+            {
+                error = "invalid header";
+            }
+            else if (words >= room / sizeof(std::uint64_t) ||
+                     states >= room / sizeof(std::uint32_t) ||
+                     edges > room / sizeof(internal::MarkovEdge) ||
+                     blobSize > room)
+            {
+                error = "truncated file";
+            }
+            else
+            {
+                layout = internal::MarkovFileLayoutOf(
+                        words, blobSize, states, edges);
+                if (layout.fileSize > data.size())
+                {
+                    error = "truncated file";
+                }
+            }
+        }
+
+        // check every offset and index once, so picking never has to
+        if (error == nullptr)
+        {
+            std::uint64_t previous = 0;
+            for (std::uint64_t i = 0; i <= words && error == nullptr; ++i)
+            {
+                auto offset = internal::ReadLittleEndian<std::uint64_t>(
+                        base + layout.wordOffsetsAt +
+                        (i * sizeof(std::uint64_t)));
+                if ((i == 0 && offset != 0) || offset < previous ||
+                    (i == words && offset != blobSize))
+                {
+                    error = "invalid word offsets";
+                }
+                previous = offset;
+            }
+        }
+        if (error == nullptr &&
+            internal::ReadLittleEndian<std::uint32_t>(
+                    base + layout.stateOffsetsAt) != 0)
+        {
+            error = "invalid state offsets";
+        }
+        if (error == nullptr)
+        {
+            std::uint32_t begin = 0;
+            for (std::uint64_t i = 1; i <= states && error == nullptr; ++i)
+            {
+                auto end = internal::ReadLittleEndian<std::uint32_t>(
+                        base + layout.stateOffsetsAt +
+                        (i * sizeof(std::uint32_t)));
+                if (end < begin || end > edges || (i == 1 && end == 0) ||
+                    (i == states && end != edges))
+                {
+                    error = "invalid state offsets";
+                    break;
+                }
+                for (std::uint32_t e = begin; e < end; ++e)
+                {
+                    const char* edge = base + layout.edgesAt +
+                                       (e * sizeof(internal::MarkovEdge));
+                    if (internal::ReadLittleEndian<std::uint32_t>(edge + 4) >=
+                                end - begin ||
+                        internal::ReadLittleEndian<std::uint32_t>(edge + 8) >=
+                                words ||
+                        internal::ReadLittleEndian<std::uint32_t>(edge + 12) >=
+                                states)
+                    {
+                        error = "invalid transitions";
+                        break;
+                    }
+                }
+                begin = end;
+            }
+        }
+        if (error != nullptr)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::MarkovSource::load(): ",
+                              error,
+                              " in ",
+                              name);
+            return false;
+        }
+
+        m_WordCount  = words;
+        m_StateCount = states;
+        m_EdgeCount  = edges;
+        m_Order      = order;
+        bool inPlace = owner != nullptr &&
+                       std::endian::native == std::endian::little &&
+                       reinterpret_cast<std::uintptr_t>(base) %
+                                       alignof(std::uint64_t) ==
+                               0;
+        if (inPlace)
+        {
+            // the layout keeps every part aligned within the file
+            m_Mapped       = std::move(owner);
+            m_Blob         = base + layout.blobAt;
+            m_WordOffsets  = reinterpret_cast<const std::uint64_t*>(
+                    base + layout.wordOffsetsAt);
+            m_StateOffsets = reinterpret_cast<const std::uint32_t*>(
+                    base + layout.stateOffsetsAt);
+            m_Edges        = reinterpret_cast<const internal::MarkovEdge*>(
+                    base + layout.edgesAt);
+            escape_words();
+            return true;
+        }
+
+        m_OwnedBlob.assign(base + layout.blobAt, blobSize);
+        m_OwnedWordOffsets.resize(words + 1);
+        for (std::size_t i = 0; i <= words; ++i)
+        {
+            m_OwnedWordOffsets[i] = internal::ReadLittleEndian<std::uint64_t>(
+                    base + layout.wordOffsetsAt + (i * sizeof(std::uint64_t)));
+        }
+        m_OwnedStateOffsets.resize(states + 1);
+        for (std::size_t i = 0; i <= states; ++i)
+        {
+            m_OwnedStateOffsets[i] = internal::ReadLittleEndian<std::uint32_t>(
+                    base + layout.stateOffsetsAt + (i * sizeof(std::uint32_t)));
+        }
+        m_OwnedEdges.resize(edges);
+        for (std::size_t i = 0; i < edges; ++i)
+        {
+            const char* edge = base + layout.edgesAt +
+                               (i * sizeof(internal::MarkovEdge));
+            m_OwnedEdges[i]  = {
+                    internal::ReadLittleEndian<std::uint32_t>(edge),
+                    internal::ReadLittleEndian<std::uint32_t>(edge + 4),
+                    internal::ReadLittleEndian<std::uint32_t>(edge + 8),
+                    internal::ReadLittleEndian<std::uint32_t>(edge + 12)};
+        }
+        use_owned();
+        escape_words();
+        return true;
+    }
+
+    void MarkovSource::clear()
+    {
+        m_OwnedBlob.clear();
+        m_OwnedWordOffsets.clear();
+        m_OwnedStateOffsets.clear();
+        m_OwnedEdges.clear();
+        m_Mapped.reset();
+        m_Blob         = nullptr;
+        m_WordOffsets  = nullptr;
+        m_StateOffsets = nullptr;
+        m_Edges        = nullptr;
+        m_WordCount    = 0;
+        m_StateCount   = 0;
+        m_EdgeCount    = 0;
+        m_Order        = 0;
+        m_Escaped.clear();
+        m_XmlNames.clear();
+    }
+
+    void MarkovSource::use_owned()
+    {
+        m_Blob         = m_OwnedBlob.data();
+        m_WordOffsets  = m_OwnedWordOffsets.data();
+        m_StateOffsets = m_OwnedStateOffsets.data();
+        m_Edges        = m_OwnedEdges.data();
+    }
+
+    void MarkovSource::escape_words()
+    {
+        m_Escaped.build(m_Blob, m_WordOffsets, m_WordCount);
+        m_XmlNames.build(m_Blob,
+                         m_WordOffsets,
+                         m_WordCount,
+                         internal::EscapedWords::Form::XmlName);
+    }
+} // namespace lipsum
+#endif
@@ -0,0 +1,66 @@
+/**
+ * @file lipsum/core/parallel.hpp
+ *
+ * @brief Parallel loops of lipsum-cpp
+ *
+ * This declares lipsum::internal::ParallelFor(), which spreads independent
+ * tasks over threads, and related helpers. This file is under the BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum::internal
+{
+    /**
+     * @brief Size of a cache line, in bytes
+     *
+     * @since 0.5.3
+     *
+     * Data written by different threads is aligned to it so that the
+     * threads do not keep taking the same cache line from each other.
+     */
+    constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    /**
+     * @brief Run a task for every index of a range on several threads.
+     *
+     * @since 0.5.3
+     *
+     * Split the indices from 0 to count - 1 into one contiguous run per
+     * thread. Each thread takes indices from the front of its own run, and
+     * once it runs out, steals the back half of the run of another thread,
+     * so that threads given slow tasks do not hold the others up. The
+     * calling thread is one of the threads. Without thread support, or with
+     * one thread, run every task in order on the calling thread.
+     *
+     * @param count The number of tasks, below 2^32.
+     * @param threads The number of threads, or 0 for one per hardware thread.
+     * @param task The task, called with the index and the number of the
+     * thread running it, from 0 to threads - 1. Tasks on different threads
+     * run at the same time, and must not throw.
+     */
+    LIPSUM_API void ParallelFor(
+            std::size_t                                           count,
+            unsigned int                                          threads,
+            const std::function<void(std::size_t, unsigned int)>& task);
+
+    /**
+     * @brief Get the number of threads to use.
+     *
+     * @since 0.5.3
+     *
+     * @param threads The number of threads asked for, or 0 for one per
+     * hardware thread.
+     *
+     * @return unsigned int threads, 0 replaced by the number of hardware
+     * threads, or 1 without thread support.
+     */
+    LIPSUM_API unsigned int ThreadCount(unsigned int threads);
+} // namespace lipsum::internal
+#endif
@@ -0,0 +1,140 @@
+/**
+ * @file lipsum/core/parallel.inl
+ *
+ * @brief Parallel loops of lipsum-cpp
+ *
+ * This defines lipsum::internal::ParallelFor(). This file is under the BSD
+ * Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "internal.hpp"
+#include "parallel.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum::internal
+{
+    void ParallelFor(
+            std::size_t                                           count,
+            unsigned int                                          threads,
+            const std::function<void(std::size_t, unsigned int)>& task)
+    {
+        threads = static_cast<unsigned int>(
+                std::min<std::size_t>(ThreadCount(threads), count));
+        if (threads <= 1)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                task(i, 0);
+            }
+            return;
+        }
+#    ifdef LPSM_HAS_THREADS
+        // each run packs its first index in the upper half and its end in
+        // the lower half, so both ends move with one compare-and-swap
+        struct alignas(CACHE_LINE_SIZE) Run
+        {
+            std::atomic<std::uint64_t> bounds;
+        };
+        auto pack = [](std::uint64_t begin, std::uint64_t end)
+        {
+            return (begin << 32) | end;
+        };
+        std::vector<Run> runs(threads);
+        for (unsigned int i = 0; i < threads; ++i)
+        {
+            runs[i].bounds.store(pack(count * i / threads,
+                                      count * (i + 1) / threads),
+                                 std::memory_order_relaxed);
+        }
+
+        auto popFront = [&runs, &pack](unsigned int self, std::size_t& idx)
+        {
+            std::uint64_t bounds = runs[self].bounds.load();
+            for (;;)
+            {
+                std::uint64_t begin = bounds >> 32;
+                std::uint64_t end   = bounds & 0xFFFFFFFF;
+                if (begin >= end)
+                {
+                    return false;
+                }
+                if (runs[self].bounds.compare_exchange_weak(
+                            bounds, pack(begin + 1, end)))
+                {
+                    idx = begin;
+                    return true;
+                }
+            }
+        };
+        // indices never return to a run once taken, so a run cannot go back
+        // to bounds a thief has already seen
+        auto steal = [&runs, &pack, threads](unsigned int self)
+        {
+            for (unsigned int i = 1; i < threads; ++i)
+            {
+                Run&          victim = runs[(self + i) % threads];
+                std::uint64_t bounds = victim.bounds.load();
+                for (;;)
+                {
+                    std::uint64_t begin = bounds >> 32;
+                    std::uint64_t end   = bounds & 0xFFFFFFFF;
+                    if (begin >= end)
+                    {
+                        break;
+                    }
+                    std::uint64_t half = (end - begin + 1) / 2;
+                    if (victim.bounds.compare_exchange_weak(
+                                bounds, pack(begin, end - half)))
+                    {
+                        runs[self].bounds.store(pack(end - half, end));
+                        return true;
+                    }
+                }
+            }
+            return false;
+        };
+        auto work = [&task, &popFront, &steal](unsigned int self)
+        {
+            std::size_t idx = 0;
+            do
+            {
+                while (popFront(self, idx))
+                {
+                    task(idx, self);
+                }
+            } while (steal(self));
+        };
+
+        std::vector<std::future<void>> helpers;
+        helpers.reserve(threads - 1);
+        for (unsigned int i = 1; i < threads; ++i)
+        {
+            helpers.push_back(std::async(std::launch::async, work, i));
+        }
+        work(0);
+        for (auto& helper : helpers)
+        {
+            helper.get();
+        }
+#    endif
+    }
+
+    unsigned int ThreadCount([[maybe_unused]] unsigned int threads)
+    {
+#    ifdef LPSM_HAS_THREADS
+        if (threads == 0)
+        {
+            threads = std::max(1U, std::thread::hardware_concurrency());
+        }
+        return threads;
+#    else
+        return 1;
+#    endif
+    }
+} // namespace lipsum::internal
+#endif
@@ -4,13 +4,14 @@
  * @brief File containing all of the words used by lipsum::Source
  *
  * This file contains constexpr arrays of strings,
- * each a word in the original samples.
+ * each a word in the original samples, and of
+ * how many times each word appears in them.
  *
  * @author LambBread from github.com
  */
 #pragma once
 
-static constexpr std::array<const char*, 167> LIPSUM_VEC = {
+inline constexpr std::array<const char*, 167> LIPSUM_VEC = {
         "lorem",        "ipsum",       "dolor",       "sit",
         "amet",         "consectetur", "adipiscing",  "elit",
         "suspendisse",  "vel",         "condimentum", "neque",
@@ -55,7 +56,7 @@ static constexpr std::array<const char*, 167> LIPSUM_VEC = {
         "fringilla",    "fusce",       "feugiat",
 };
 #ifndef LIPSUM_MIN_BUILD
-static constexpr std::array<const char*, 207> CAT_IPSUM = {
+inline constexpr std::array<const char*, 207> CAT_IPSUM = {
         "found",       "somthing",  "move",      "i",         "bite",
         "it",          "tail",      "chew",      "ipad",      "power",
         "cord",        "reaches",   "under",     "door",      "into",
@@ -99,7 +100,7 @@ static constexpr std::array<const char*, 207> CAT_IPSUM = {
         "by",          "feathery",  "shove",     "bum",       "owner's",
         "camera",      "lens",
 };
-static constexpr std::array<const char*, 110> DOG_IPSUM = {
+inline constexpr std::array<const char*, 110> DOG_IPSUM = {
         "doggo",        "ipsum",     "most",
         "angery",       "pupper",    "i",
         "have",         "ever",      "seen",
@@ -138,7 +139,7 @@ static constexpr std::array<const char*, 110> DOG_IPSUM = {
         "floof",        "vvv",       "shooberino",
         "puggorino",    "boofers",
 };
-static constexpr std::array<const char*, 136> CORPO_IPSUM = {
+inline constexpr std::array<const char*, 136> CORPO_IPSUM = {
         "what",
         "if",
         "and",
@@ -276,4 +277,66 @@ static constexpr std::array<const char*, 136> CORPO_IPSUM = {
         "priority",
         "quarter",
 };
+inline constexpr std::array<std::uint32_t, 167> LIPSUM_COUNTS = {
+        10, 18, 16, 24, 24, 12, 4, 15, 14, 22, 8, 12,
+        11, 5, 9, 23, 6, 4, 11, 34, 9, 6, 9, 3,
+        23, 9, 5, 4, 11, 19, 13, 10, 6, 20, 8, 9,
+        8, 17, 10, 15, 10, 18, 10, 13, 19, 9, 15, 12,
+        11, 10, 34, 8, 7, 12, 14, 9, 5, 8, 12, 5,
+        8, 7, 8, 9, 12, 23, 12, 10, 9, 6, 7, 8,
+        5, 11, 6, 6, 13, 4, 8, 8, 10, 10, 14, 11,
+        11, 12, 16, 6, 8, 12, 15, 17, 8, 16, 8, 8,
+        9, 13, 8, 3, 12, 9, 6, 6, 11, 11, 10, 1,
+        8, 5, 10, 23, 11, 6, 13, 17, 7, 21, 9, 18,
+        5, 15, 6, 12, 7, 6, 5, 5, 9, 7, 8, 9,
+        6, 5, 4, 11, 10, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 8, 4, 6, 8, 6, 5, 7, 5, 5, 6,
+        4, 3, 3, 3, 5, 4, 3, 2, 5, 2, 4,
+};
+inline constexpr std::array<std::uint32_t, 207> CAT_COUNTS = {
+        1, 1, 1, 3, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 12, 1, 15, 1, 2, 7, 2,
+        2, 2, 2, 1, 1, 1, 1, 1, 2, 1, 1, 1,
+        1, 1, 1, 1, 3, 2, 3, 1, 1, 1, 3, 1,
+        2, 3, 5, 1, 1, 1, 1, 1, 2, 3, 3, 1,
+        1, 1, 1, 5, 3, 1, 1, 1, 2, 2, 1, 2,
+        3, 1, 1, 1, 4, 1, 1, 1, 1, 1, 1, 1,
+        1, 3, 1, 6, 7, 2, 1, 1, 1, 1, 1, 1,
+        1, 2, 2, 2, 1, 1, 1, 2, 1, 1, 1, 1,
+        1, 1, 2, 2, 1, 1, 1, 1, 2, 1, 1, 1,
+        1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 2, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 1, 2,
+        1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1,
+        1, 1, 2, 1, 1, 1, 1, 2, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1,
+};
+inline constexpr std::array<std::uint32_t, 110> DOG_COUNTS = {
+        20, 1, 2, 4, 12, 3, 2, 2, 2, 6, 5, 1,
+        5, 14, 5, 9, 7, 5, 3, 3, 6, 2, 3, 1,
+        6, 6, 6, 9, 12, 4, 3, 3, 2, 2, 7, 2,
+        2, 6, 6, 3, 3, 13, 5, 6, 2, 6, 14, 6,
+        10, 6, 3, 4, 4, 3, 3, 3, 2, 6, 3, 3,
+        3, 11, 2, 3, 1, 3, 3, 7, 5, 1, 1, 1,
+        3, 3, 2, 5, 2, 2, 3, 3, 3, 3, 3, 3,
+        2, 2, 2, 4, 1, 3, 3, 1, 5, 3, 3, 3,
+        3, 3, 1, 1, 2, 2, 1, 2, 2, 2, 2, 2,
+        1, 1,
+};
+inline constexpr std::array<std::uint32_t, 136> CORPO_COUNTS = {
+        2, 4, 6, 1, 1, 4, 18, 2, 28, 2, 2, 1,
+        1, 1, 1, 2, 1, 1, 12, 3, 3, 4, 1, 1,
+        2, 2, 1, 1, 1, 2, 1, 9, 2, 1, 1, 1,
+        1, 2, 1, 2, 1, 1, 1, 2, 3, 3, 1, 2,
+        2, 4, 1, 2, 2, 1, 2, 8, 1, 1, 1, 2,
+        2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2,
+        2, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1,
+        2, 1, 2, 1, 2, 2, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        2, 2, 1, 1, 1, 1, 2, 1, 1, 1, 2, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1,
+};
 #endif
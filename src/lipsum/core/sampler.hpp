@@ -0,0 +1,378 @@
+/**
+ * @file lipsum/core/sampler.hpp
+ *
+ * @brief Bounded sampling of lipsum-cpp
+ *
+ * This defines the functions lipsum-cpp uses to turn engine output into
+ * numbers in a range. Unlike the standard distributions, whose algorithms are
+ * left to the implementation, they give the same numbers for the same engine
+ * output on every standard library and platform. This file is under the BSD
+ * Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core.hpp"
+#include "engine.hpp"
+
+namespace lipsum
+{
+    namespace internal
+    {
+        /**
+         * @brief An engine that lipsum-cpp can sample from
+         *
+         * @since 0.5.3
+         *
+         * A std::uniform_random_bit_generator whose output covers all 32 or
+         * all 64 bits, such as std::mt19937 and lipsum::Engine.
+         */
+        template <typename G>
+        concept FullRangeEngine =
+                std::uniform_random_bit_generator<G> && (G::min() == 0) &&
+                (G::max() == 0xFFFFFFFFULL ||
+                 G::max() == 0xFFFFFFFFFFFFFFFFULL);
+
+        /**
+         * @brief Draw 32 random bits.
+         *
+         * @since 0.5.3
+         *
+         * Take the upper half of the output of 64-bit engines.
+         *
+         * @tparam G The engine type.
+         *
+         * @param gen The engine to use.
+         *
+         * @return std::uint32_t The random bits.
+         */
+        template <FullRangeEngine G>
+        constexpr std::uint32_t Next32(G& gen)
+        {
+            if constexpr (G::max() == 0xFFFFFFFFULL)
+            {
+                return static_cast<std::uint32_t>(gen());
+            }
+            else
+            {
+                return static_cast<std::uint32_t>(
+                        static_cast<std::uint64_t>(gen()) >> 32);
+            }
+        }
+
+        /**
+         * @brief Draw 64 random bits.
+         *
+         * @since 0.5.3
+         *
+         * Join two draws of 32-bit engines, first draw in the upper half.
+         *
+         * @tparam G The engine type.
+         *
+         * @param gen The engine to use.
+         *
+         * @return std::uint64_t The random bits.
+         */
+        template <FullRangeEngine G>
+        constexpr std::uint64_t Next64(G& gen)
+        {
+            if constexpr (G::max() == 0xFFFFFFFFULL)
+            {
+                std::uint64_t high = static_cast<std::uint32_t>(gen());
+                return (high << 32) | static_cast<std::uint32_t>(gen());
+            }
+            else
+            {
+                return static_cast<std::uint64_t>(gen());
+            }
+        }
+
+        /**
+         * @brief Draw a number from 0 to range - 1.
+         *
+         * @since 0.5.3
+         *
+         * Use Lemire's nearly divisionless method: multiply a 32-bit draw by
+         * range and keep the upper half, only computing a remainder (and
+         * redrawing) in the rare case where the lower half falls in the biased
+         * zone. See https://arxiv.org/abs/1805.10941.
+         *
+         * @tparam G The engine type.
+         *
+         * @param gen The engine to use.
+         * @param range The number of possible results. Must not be 0.
+         *
+         * @return std::uint32_t The random number.
+         */
+        template <FullRangeEngine G>
+        constexpr std::uint32_t UniformBelow(G& gen, std::uint32_t range)
+        {
+            std::uint64_t product = static_cast<std::uint64_t>(Next32(gen)) *
+                                    range;
+            auto low = static_cast<std::uint32_t>(product);
+            if (low < range)
+            {
+                std::uint32_t threshold = (0U - range) % range;
+                while (low < threshold)
+                {
+                    product = static_cast<std::uint64_t>(Next32(gen)) * range;
+                    low     = static_cast<std::uint32_t>(product);
+                }
+            }
+            return static_cast<std::uint32_t>(product >> 32);
+        }
+
+        /**
+         * @brief Draw a number from 0 to range - 1.
+         *
+         * @since 0.5.3
+         *
+         * @overload
+         *
+         * 64-bit version of UniformBelow(G&, std::uint32_t), used for ranges
+         * that do not fit in 32 bits.
+         *
+         * @tparam G The engine type.
+         *
+         * @param gen The engine to use.
+         * @param range The number of possible results. Must not be 0.
+         *
+         * @return std::uint64_t The random number.
+         */
+        template <FullRangeEngine G>
+        constexpr std::uint64_t UniformBelow(G& gen, std::uint64_t range)
+        {
+            std::uint64_t high = 0;
+            std::uint64_t low  = Mul128(Next64(gen), range, high);
+            if (low < range)
+            {
+                std::uint64_t threshold = (0ULL - range) % range;
+                while (low < threshold)
+                {
+                    low = Mul128(Next64(gen), range, high);
+                }
+            }
+            return high;
+        }
+
+        /**
+         * @brief Draw an index below a count.
+         *
+         * @since 0.5.3
+         *
+         * Take a single 32-bit draw while count fits in 32 bits, as
+         * UniformBelow(G&, std::uint32_t) does, and a 64-bit draw beyond.
+         *
+         * @tparam G The engine type.
+         *
+         * @param gen The engine to use.
+         * @param count The number of possible results. Must not be 0.
+         *
+         * @return std::size_t The random index.
+         */
+        template <FullRangeEngine G>
+        constexpr std::size_t UniformIndex(G& gen, std::size_t count)
+        {
+            if (count > std::numeric_limits<std::uint32_t>::max())
+            {
+                return static_cast<std::size_t>(
+                        UniformBelow(gen, static_cast<std::uint64_t>(count)));
+            }
+            return UniformBelow(gen, static_cast<std::uint32_t>(count));
+        }
+
+        /**
+         * @brief Draw an integer from min to max, inclusive.
+         *
+         * @since 0.5.3
+         *
+         * If min is greater than max, swap them. Ranges that fit in 32 bits
+         * take a single 32-bit draw in the common case.
+         *
+         * @tparam T The integer type.
+         * @tparam G The engine type.
+         *
+         * @param gen The engine to use.
+         * @param min The minimum value.
+         * @param max The maximum value.
+         *
+         * @return T The random integer.
+         */
+        template <std::integral T, FullRangeEngine G>
+        constexpr T UniformInt(G& gen, T min, T max)
+        {
+            if (min > max)
+            {
+                std::swap(min, max);
+            }
+            using Unsigned = std::make_unsigned_t<T>;
+            Unsigned      difference = static_cast<Unsigned>(max) -
+                                  static_cast<Unsigned>(min);
+            auto          span       = static_cast<std::uint64_t>(difference);
+            std::uint64_t offset;
+            if (span < 0xFFFFFFFFULL)
+            {
+                auto range = static_cast<std::uint32_t>(span + 1);
+                offset     = UniformBelow(gen, range);
+            }
+            else if (span == 0xFFFFFFFFULL)
+            {
+                offset = Next32(gen);
+            }
+            else if (span < 0xFFFFFFFFFFFFFFFFULL)
+            {
+                offset = UniformBelow(gen, span + 1);
+            }
+            else
+            {
+                offset = Next64(gen);
+            }
+            auto result = static_cast<Unsigned>(static_cast<Unsigned>(min) +
+                                                static_cast<Unsigned>(offset));
+            return static_cast<T>(result);
+        }
+
+        /**
+         * @brief Draw a floating-point number from min to max.
+         *
+         * @since 0.5.3
+         *
+         * Scale 53 random bits to [0, 1), then to [min, max).
+         *
+         * @tparam T The floating-point type.
+         * @tparam G The engine type.
+         *
+         * @param gen The engine to use.
+         * @param min The minimum value.
+         * @param max The maximum value.
+         *
+         * @return T The random number.
+         */
+        template <std::floating_point T, FullRangeEngine G>
+        constexpr T UniformReal(G& gen, T min, T max)
+        {
+            constexpr double TWO_POW_MINUS_53 = 1.0 / 9007199254740992.0;
+
+            double unit = static_cast<double>(Next64(gen) >> 11) *
+                          TWO_POW_MINUS_53;
+            return static_cast<T>(static_cast<double>(min) +
+                                  (unit * (static_cast<double>(max) -
+                                           static_cast<double>(min))));
+        }
+
+        /**
+         * @brief Pool of random bits for coin flips and small ranges
+         *
+         * @since 0.5.3
+         *
+         * Store one 32-bit draw and hand it out a few bits at a time, so that a
+         * coin flip costs one bit instead of a whole draw.
+         */
+        class BitPool
+        {
+        public:
+            /**
+             * @brief Largest range drawn from the pool by below()
+             *
+             * @since 0.5.3
+             */
+            static constexpr std::uint32_t MAX_POOLED_RANGE = 64;
+
+            /**
+             * @brief Flip a coin.
+             *
+             * @since 0.5.3
+             *
+             * @tparam G The engine type.
+             *
+             * @param gen The engine to refill the pool from.
+             *
+             * @return bool The random bit.
+             */
+            template <FullRangeEngine G>
+            constexpr bool flip(G& gen)
+            {
+                return take(gen, 1) != 0;
+            }
+
+            /**
+             * @brief Draw a number from 0 to range - 1.
+             *
+             * @since 0.5.3
+             *
+             * Take just enough bits for range and redraw if the result is too
+             * large. range must be from 1 to MAX_POOLED_RANGE.
+             *
+             * @tparam G The engine type.
+             *
+             * @param gen The engine to refill the pool from.
+             * @param range The number of possible results.
+             *
+             * @return std::uint32_t The random number.
+             */
+            template <FullRangeEngine G>
+            constexpr std::uint32_t below(G& gen, std::uint32_t range)
+            {
+                auto          bits = static_cast<unsigned>(
+                        std::bit_width(range - 1));
+                std::uint32_t value;
+                do
+                {
+                    value = take(gen, bits);
+                } while (value >= range);
+                return value;
+            }
+
+            /**
+             * @brief Drop the remaining bits.
+             *
+             * @since 0.5.3
+             *
+             * Called when the engine is reseeded, so that the next draws only
+             * depend on the new seed.
+             */
+            constexpr void reset()
+            {
+                m_Bits  = 0;
+                m_Count = 0;
+            }
+
+        private:
+            /**
+             * @brief Take bits from the pool, refilling it if needed.
+             *
+             * @since 0.5.3
+             *
+             * @tparam G The engine type.
+             *
+             * @param gen The engine to refill the pool from.
+             * @param bits The number of bits, from 0 to 32.
+             *
+             * @return std::uint32_t The bits.
+             */
+            template <FullRangeEngine G>
+            constexpr std::uint32_t take(G& gen, unsigned bits)
+            {
+                if (bits == 0)
+                {
+                    return 0;
+                }
+                if (m_Count < bits)
+                {
+                    m_Bits  = Next32(gen);
+                    m_Count = 32;
+                }
+                std::uint32_t value = m_Bits & (0xFFFFFFFFU >> (32 - bits));
+                m_Bits              = bits < 32 ? m_Bits >> bits : 0;
+                m_Count            -= bits;
+                return value;
+            }
+
+            std::uint32_t m_Bits  = 0; ///< The unused bits
+            unsigned      m_Count = 0; ///< The number of unused bits
+        };
+    } // namespace internal
+} // namespace lipsum
@@ -12,6 +12,10 @@
 #pragma once
 
 #include "core.hpp"
+#include "engine.hpp"
+#include "escapedwords.hpp"
+#include "mappedfile.hpp"
+#include "weightedtable.hpp"
 
 namespace lipsum
 {
@@ -21,7 +25,9 @@ namespace lipsum
      * @since 0.4.0
      *
      * This class is for multi-source generation which exposes a function to
-     * generate a random word.
+     * generate a random word. Every source, built-in or custom, is resolved
+     * once in load() into a contiguous word arena and an offset table, so
+     * picking a word never allocates or compares source names.
      */
     class LIPSUM_API Source
     {
@@ -31,10 +37,10 @@ namespace lipsum
          *
          * @since 0.4.0
          *
-         * Default constructor which leaves the m_Words object empty, using the
-         * standard lorem-ipsum from sample.inl instead.
+         * Default constructor which loads the standard lorem-ipsum from
+         * sample.inl.
          */
-        Source() = default;
+        Source();
 
         /**
          * @brief Constructor with a path
@@ -42,7 +48,7 @@ namespace lipsum
          * @since 0.4.0
          *
          * Constructor which reads from the file specified or enables the
-         * specified built-in source, and filling object m_Words with unique
+         * specified built-in source, and filling the word arena with unique
          * words if applicable.
          *
          * @param path A path to the source file.
@@ -50,39 +56,454 @@ namespace lipsum
         Source(const std::string& path);
 
         /**
-         * @brief Load a source and fill the vector.
+         * @brief Load a source and fill the word arena.
          *
          * @since 0.4.1
          *
-         * Read from the file specified and fill object m_Words with the unique
-         * words from it. Formerly known as lpsm::Source::Load(). If path is
-         * "default"/"lorem", use default lorem-ipsum source. If path is "cat",
-         * use cat-ipsum. If path is "dog"/"doggo", use dog-ipsum. If path is
-         * "corpo"/"corporate", use corporate-ipsum.
+         * Read from the file specified and fill the word arena with the unique
+         * words from it, in order of first appearance. Formerly known as
+         * lpsm::Source::Load(). If path is "default"/"lorem", use default
+         * lorem-ipsum source. If path is "cat", use cat-ipsum. If path is
+         * "dog"/"doggo", use dog-ipsum. If path is "corpo"/"corporate", use
+         * corporate-ipsum. If path is "-", read standard input. If the file
+         * cannot be opened or contains no words, fall back to the default
+         * lorem-ipsum source.
+         *
+         * Files are mapped into memory rather than read, and split into words
+         * with lipsum::internal::TokenizeWordsParallel(), so loading only
+         * allocates for the unique words. Compiled source files written by
+         * save() are recognized by their header and used in place, without
+         * splitting or copying anything.
          *
          * @param path A path to the source file.
+         * @param threads The maximum number of threads used to split large
+         * files, or 0 for one per hardware thread. By default 1.
+         */
+        void load([[maybe_unused]] const std::string& path,
+                  [[maybe_unused]] unsigned int       threads = 1);
+
+#ifndef LIPSUM_MIN_BUILD
+        /**
+         * @brief Load a source from memory.
+         *
+         * @since 0.5.3
+         *
+         * Same as load(), but split text instead of a file. text is not needed
+         * after the call. Not available in minimum builds.
+         *
+         * @param text The text of the source.
+         * @param name The name reported for the source. By default "buffer".
+         * @param threads The maximum number of threads, or 0 for one per
+         * hardware thread. By default 1.
+         */
+        void load_buffer(std::string_view   text,
+                         const std::string& name    = "buffer",
+                         unsigned int       threads = 1);
+
+        /**
+         * @brief Load a source from a stream.
+         *
+         * @since 0.5.3
+         *
+         * Same as load(), but read stream, such as std::cin, until it ends. The
+         * stream is read in blocks, so only the unique words are kept in
+         * memory. Not available in minimum builds.
+         *
+         * @param stream The stream to read.
+         * @param name The name reported for the source. By default "stream".
+         */
+        void load_stream(std::istream&      stream,
+                         const std::string& name = "stream");
+
+        /**
+         * @brief Save the source as a compiled source file.
+         *
+         * @since 0.5.3
+         *
+         * Write the words, in order, and their weights, if any, to a .lpsmsrc
+         * file, which load() maps into memory and uses without splitting any
+         * text. The file is the same on every platform. Not available in
+         * minimum builds.
+         *
+         * @param path The path of the file to write.
+         *
+         * @return bool Whether the file could be written.
+         */
+        bool save(const std::string& path) const;
+
+        /**
+         * @brief Check if the words have weights.
+         *
+         * @since 0.5.3
+         *
+         * Sources loaded from text and built-in sources weigh each word by
+         * how many times it appears. Compiled source files may have been
+         * saved without weights. Not available in minimum builds.
+         *
+         * @return bool Whether the words have weights.
+         */
+        [[nodiscard]] bool has_weights() const;
+
+        /**
+         * @brief Get the weight of a word by its index.
+         *
+         * @since 0.5.3
+         *
+         * Not available in minimum builds.
+         *
+         * @param idx The index of the word, from 0 to size() - 1.
+         *
+         * @return std::uint32_t The weight of the word, or 1 if the words
+         * have no weights.
+         */
+        [[nodiscard]] std::uint32_t weight_at(std::size_t idx) const;
+
+        /**
+         * @brief Select a random word by its weight.
+         *
+         * @since 0.5.3
+         *
+         * Select a word with a chance proportional to its weight, such as the
+         * number of times it appears in the source text, so that generated
+         * text follows the word frequencies of the source. Picks come from an
+         * alias table built once per load, so each takes constant time. If
+         * the words have no weights, same as random_word_view(). Not
+         * available in minimum builds.
+         *
+         * @param gen The generator to use.
+         *
+         * @return std::string_view The random word.
+         */
+        [[nodiscard]] std::string_view
+        weighted_word_view(std::mt19937& gen) const;
+
+        /**
+         * @brief Select a random word by its weight.
+         *
+         * @since 0.5.3
+         *
+         * @overload
+         *
+         * @param gen The generator to use.
+         *
+         * @return std::string_view The random word.
          */
-        void load([[maybe_unused]] const std::string& path);
+        [[nodiscard]] std::string_view weighted_word_view(Engine& gen) const;
+#endif
 
         /**
          * @brief Select a random word.
          *
          * @since 0.4.0
          *
-         * Select a random word from m_Words unless m_Words is empty, in which
-         * it uses a built-in source from sample.inl as a fallback. Formerly
-         * known as lpsm::Source::RandomWord().
+         * Select a random word from the word arena and copy it into a new
+         * string. Formerly known as lpsm::Source::RandomWord().
          *
          * @param gen The generator to use.
          *
          * @return std::string The random word.
+         *
+         * @sa lipsum::Source::random_word_view()
          */
         [[nodiscard]] std::string random_word(std::mt19937& gen) const;
 
+        /**
+         * @brief Select a random word.
+         *
+         * @since 0.5.3
+         *
+         * @overload
+         *
+         * @param gen The generator to use.
+         *
+         * @return std::string The random word.
+         */
+        [[nodiscard]] std::string random_word(Engine& gen) const;
+
+        /**
+         * @brief Select a random word without copying it.
+         *
+         * @since 0.5.3
+         *
+         * Select a random word from the word arena. The returned view points
+         * into the source and stays valid until the source is reloaded or
+         * destroyed.
+         *
+         * @param gen The generator to use.
+         *
+         * @return std::string_view The random word.
+         */
+        [[nodiscard]] std::string_view
+        random_word_view(std::mt19937& gen) const;
+
+        /**
+         * @brief Select a random word without copying it.
+         *
+         * @since 0.5.3
+         *
+         * @overload
+         *
+         * @param gen The generator to use.
+         *
+         * @return std::string_view The random word.
+         */
+        [[nodiscard]] std::string_view random_word_view(Engine& gen) const;
+
+        /**
+         * @brief Get a word by its index.
+         *
+         * @since 0.5.3
+         *
+         * Get the word at index idx of the word arena. The returned view
+         * points into the source and stays valid until the source is reloaded
+         * or destroyed.
+         *
+         * @param idx The index of the word, from 0 to size() - 1.
+         *
+         * @return std::string_view The word.
+         */
+        [[nodiscard]] std::string_view word_at(std::size_t idx) const;
+
+        /**
+         * @brief Get the number of words.
+         *
+         * @since 0.5.3
+         *
+         * @return std::size_t The number of unique words in the source.
+         */
+        [[nodiscard]] std::size_t size() const;
+
+        /**
+         * @brief Get the name of the loaded source.
+         *
+         * @since 0.5.3
+         *
+         * @return const std::string& The built-in name or the path the words
+         * came from, or "default" if loading fell back to the default
+         * lorem-ipsum source.
+         */
+        [[nodiscard]] const std::string& name() const;
+
+        /**
+         * @brief Get the mean size of the words.
+         *
+         * @since 0.5.3
+         *
+         * Measured once per load, with max_word_length(), so that
+         * lipsum::Generator::predicted_size() does not go through the words.
+         *
+         * @param weighted Whether each word counts as many times as its
+         * weight, as when words follow their frequencies. Ignored if the words
+         * have no weights, and in minimum builds. By default false.
+         *
+         * @return double The mean size of the words, in bytes.
+         */
+        [[nodiscard]] double
+        mean_word_length([[maybe_unused]] bool weighted = false) const;
+
+        /**
+         * @brief Get the size of the longest word.
+         *
+         * @since 0.5.3
+         *
+         * Measured once per load.
+         *
+         * @return std::size_t The size of the longest word, in bytes.
+         */
+        [[nodiscard]] std::size_t max_word_length() const;
+
+#ifndef LIPSUM_MIN_BUILD
+        /**
+         * @brief Get the escaped form of a word.
+         *
+         * @since 0.5.3
+         *
+         * Get word with its HTML entities handled, as
+         * lipsum::internal::HandleHTMLEntity() does, so that HTML and XML can
+         * hold it. The escaped forms are made once per load, so this only
+         * looks word up. Not available in minimum builds.
+         *
+         * @param word A word returned by this source.
+         *
+         * @return std::string_view The escaped form, which stays valid until
+         * the source is reloaded or destroyed, or word itself if it needs no
+         * escaping.
+         */
+        [[nodiscard]] std::string_view
+        escaped_word(std::string_view word) const;
+
+        /**
+         * @brief Check if any word needs escaping.
+         *
+         * @since 0.5.3
+         *
+         * Not available in minimum builds.
+         *
+         * @return bool Whether escaped_word() changes any word of the source.
+         */
+        [[nodiscard]] bool needs_escaping() const;
+
+        /**
+         * @brief Get the XML name made from a word.
+         *
+         * @since 0.5.3
+         *
+         * Get word with the characters an XML name cannot hold replaced, as
+         * lipsum::internal::XmlNameInto() does, so that it can name an
+         * element or an attribute. The names are made once per load, so this
+         * only looks word up. Not available in minimum builds.
+         *
+         * @param word A word returned by this source.
+         *
+         * @return std::string_view The name, which stays valid until the
+         * source is reloaded or destroyed, or word itself if it is already
+         * a name.
+         */
+        [[nodiscard]] std::string_view xml_name(std::string_view word) const;
+#endif
+
     private:
-        std::string currentLoaded; ///< If not using a custom list, which
-                                   ///< built-in source to use.
-        std::vector<std::string>
-                m_Words; ///< The internal list of words stored.
+        /**
+         * @brief Load a built-in source into the word arena.
+         *
+         * @since 0.5.3
+         *
+         * @tparam N The number of words in the built-in source.
+         *
+         * @param words The built-in source from sample.inl.
+         */
+        template <std::size_t N>
+        void load_builtin(const std::array<const char*, N>& words);
+
+#ifndef LIPSUM_MIN_BUILD
+        /**
+         * @brief Load a built-in source and its word counts.
+         *
+         * @since 0.5.3
+         *
+         * @overload
+         *
+         * @tparam N The number of words in the built-in source.
+         *
+         * @param words The built-in source from sample.inl.
+         * @param counts The number of times each word appears.
+         */
+        template <std::size_t N>
+        void load_builtin(const std::array<const char*, N>&   words,
+                          const std::array<std::uint32_t, N>& counts);
+#endif
+
+        /**
+         * @brief Load the default lorem-ipsum source.
+         *
+         * @since 0.5.3
+         */
+        void load_default();
+
+        /**
+         * @brief Empty the source.
+         *
+         * @since 0.5.3
+         *
+         * Clear the word arena, and drop the compiled source file the words
+         * were read from, if any.
+         */
+        void clear();
+
+        /**
+         * @brief Append a word to the word arena.
+         *
+         * @since 0.5.3
+         *
+         * @param word The word to append.
+         */
+        void push_word(std::string_view word);
+
+        /**
+         * @brief Finish loading a source.
+         *
+         * @since 0.5.3
+         *
+         * Fall back to the default source if no words were loaded, and build
+         * the alias table of the weights otherwise.
+         *
+         * @param name The name of the source that was loaded.
+         */
+        void finish_load(const std::string& name);
+
+        /**
+         * @brief Measure the sizes of the words.
+         *
+         * @since 0.5.3
+         *
+         * Set the mean and maximum sizes of the words once they are all
+         * loaded, and escape the words that need it.
+         */
+        void measure_words();
+
+#ifndef LIPSUM_MIN_BUILD
+        /**
+         * @brief Load a compiled source file.
+         *
+         * @since 0.5.3
+         *
+         * If owner is given, the file is little-endian, and data is 8-byte
+         * aligned, read the words from data in place and keep owner alive.
+         * Otherwise, copy them into the word arena. If data is not a valid
+         * compiled source file, fall back to the default source.
+         *
+         * @param data The whole file.
+         * @param owner The mapping data points into, or nullptr if data is
+         * not needed after the call.
+         * @param name The name of the source that was loaded.
+         */
+        void load_compiled(std::string_view                            data,
+                           std::shared_ptr<const internal::MappedFile> owner,
+                           const std::string&                          name);
+
+        /**
+         * @brief Get the weights of the words.
+         *
+         * @since 0.5.3
+         *
+         * @return const std::uint32_t* The weights, or nullptr if the words
+         * have no weights.
+         */
+        [[nodiscard]] const std::uint32_t* weights_data() const;
+
+        /**
+         * @brief Build m_Table from the weights of the words.
+         *
+         * @since 0.5.3
+         */
+        void build_table();
+#endif
+
+        std::string currentLoaded; ///< The name of the loaded built-in
+                                   ///< source, or the path of the file.
+        std::string m_Arena;       ///< All words stored back to back.
+        std::vector<std::uint64_t>
+                m_Offsets; ///< Start of each word in m_Arena, followed by
+                           ///< the size of m_Arena.
+        std::size_t m_MaxLength  = 0;   ///< Size of the longest word.
+        double      m_MeanLength = 0.0; ///< Mean size of the words.
+#ifndef LIPSUM_MIN_BUILD
+        std::vector<std::uint32_t> m_Weights; ///< Weight of each word, if any.
+        WeightedTable              m_Table;   ///< Alias table of the weights.
+        double m_WeightedMeanLength = 0.0; ///< Mean size of the words by
+                                           ///< weight.
+        std::shared_ptr<const internal::MappedFile>
+                m_Mapped; ///< Compiled source file the words are read from in
+                          ///< place, if any. Shared, so copies stay valid.
+        const char*          m_MappedBlob    = nullptr; ///< Words in m_Mapped.
+        const std::uint64_t* m_MappedOffsets = nullptr; ///< Offsets in
+                                                        ///< m_Mapped.
+        const std::uint32_t* m_MappedWeights = nullptr; ///< Weights in
+                                                        ///< m_Mapped, if any.
+        std::size_t          m_MappedCount   = 0; ///< Words in m_Mapped.
+        internal::EscapedWords m_Escaped;  ///< Words that need escaping.
+        internal::EscapedWords m_XmlNames; ///< Words that are not XML
+                                           ///< names.
+#endif
     };
 } // namespace lipsum
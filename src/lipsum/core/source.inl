@@ -12,100 +12,519 @@
 #pragma once
 
 #include "internal.hpp"
+#include "mappedfile.hpp"
 #include "sample.inl"
-
-#define LPSM_SOURCE_CUSTOM_IPSUM(ipsum, name)                                  \
-    if (currentLoaded == name)                                                 \
-    {                                                                          \
-        std::uniform_int_distribution<size_t> dist(0, ipsum.size() - 1);       \
-        return {ipsum.at(dist(gen))};                                          \
-    }
+#include "sampler.hpp"
+#include "sourcefile.hpp"
+#include "tokenizer.hpp"
 
 namespace lipsum
 {
+    Source::Source()
+    {
+        load_default();
+    }
+
     Source::Source(const std::string& path)
     {
         load(path);
     }
 
     std::string Source::random_word(std::mt19937& gen) const
+    {
+        return std::string(random_word_view(gen));
+    }
+
+    std::string Source::random_word(Engine& gen) const
+    {
+        return std::string(random_word_view(gen));
+    }
+
+    std::string_view Source::random_word_view(std::mt19937& gen) const
+    {
+        return word_at(internal::UniformIndex(gen, size()));
+    }
+
+    std::string_view Source::random_word_view(Engine& gen) const
+    {
+        return word_at(internal::UniformIndex(gen, size()));
+    }
+
+    std::string_view Source::word_at(std::size_t idx) const
     {
 #ifndef LIPSUM_MIN_BUILD
-        if (m_Words.empty())
+        if (m_Mapped)
         {
-            LPSM_SOURCE_CUSTOM_IPSUM(CAT_IPSUM, "cat")
-            LPSM_SOURCE_CUSTOM_IPSUM(DOG_IPSUM, "dog")
-            LPSM_SOURCE_CUSTOM_IPSUM(CORPO_IPSUM, "corpo")
-            std::uniform_int_distribution<size_t> dist(0,
-                                                       LIPSUM_VEC.size() - 1);
-            return {LIPSUM_VEC.at(dist(gen))};
+            return {m_MappedBlob + m_MappedOffsets[idx],
+                    static_cast<std::size_t>(m_MappedOffsets[idx + 1] -
+                                             m_MappedOffsets[idx])};
         }
+#endif
+        return {m_Arena.data() + m_Offsets[idx],
+                static_cast<std::size_t>(m_Offsets[idx + 1] -
+                                         m_Offsets[idx])};
+    }
 
-        std::uniform_int_distribution<size_t> dist(0, m_Words.size() - 1);
-        return m_Words.at(dist(gen));
+    std::size_t Source::size() const
+    {
+#ifndef LIPSUM_MIN_BUILD
+        if (m_Mapped)
+        {
+            return m_MappedCount;
+        }
+#endif
+        return m_Offsets.size() - 1;
+    }
+
+    const std::string& Source::name() const
+    {
+        return currentLoaded;
+    }
+
+    double Source::mean_word_length([[maybe_unused]] bool weighted) const
+    {
+#ifndef LIPSUM_MIN_BUILD
+        if (weighted)
+        {
+            return m_WeightedMeanLength;
+        }
+#endif
+        return m_MeanLength;
+    }
+
+    std::size_t Source::max_word_length() const
+    {
+        return m_MaxLength;
+    }
+
+#ifndef LIPSUM_MIN_BUILD
+    std::string_view Source::escaped_word(std::string_view word) const
+    {
+        return m_Escaped.find(word, m_Mapped ? m_MappedBlob : m_Arena.data());
+    }
+
+    bool Source::needs_escaping() const
+    {
+        return m_Escaped.size() != 0;
+    }
+
+    std::string_view Source::xml_name(std::string_view word) const
+    {
+        return m_XmlNames.find(word, m_Mapped ? m_MappedBlob : m_Arena.data());
+    }
+#endif
+
+    template <std::size_t N>
+    void Source::load_builtin(const std::array<const char*, N>& words)
+    {
+        clear();
+        m_Offsets.reserve(N + 1);
+        for (const char* word : words)
+        {
+            push_word(word);
+        }
+        measure_words();
+    }
+
+#ifndef LIPSUM_MIN_BUILD
+    template <std::size_t N>
+    void Source::load_builtin(const std::array<const char*, N>&   words,
+                              const std::array<std::uint32_t, N>& counts)
+    {
+        load_builtin(words);
+        m_Weights.assign(counts.begin(), counts.end());
+        build_table();
+        measure_words();
+    }
+#endif
+
+    void Source::load_default()
+    {
+        currentLoaded = "default";
+#ifndef LIPSUM_MIN_BUILD
+        load_builtin(LIPSUM_VEC, LIPSUM_COUNTS);
 #else
-        std::uniform_int_distribution<size_t> dist(0, LIPSUM_VEC.size() - 1);
-        return {LIPSUM_VEC.at(dist(gen))};
+        load_builtin(LIPSUM_VEC);
 #endif
     }
 
-    void Source::load([[maybe_unused]] const std::string& path)
+    void Source::clear()
+    {
+        m_Arena.clear();
+        m_Offsets.assign(1, 0);
+#ifndef LIPSUM_MIN_BUILD
+        m_Weights.clear();
+        m_Table = WeightedTable();
+        m_Mapped.reset();
+        m_MappedBlob    = nullptr;
+        m_MappedOffsets = nullptr;
+        m_MappedWeights = nullptr;
+        m_MappedCount   = 0;
+        m_Escaped.clear();
+        m_XmlNames.clear();
+#endif
+    }
+
+    void Source::push_word(std::string_view word)
+    {
+        m_Arena.append(word);
+        m_Offsets.push_back(m_Arena.size());
+    }
+
+    void Source::load([[maybe_unused]] const std::string& path,
+                      [[maybe_unused]] unsigned int       threads)
     {
         LPSM_VERBOSE_LOG(Info, "Loading source ", path);
-        m_Words.clear();
 #ifndef LIPSUM_MIN_BUILD
         if (path == "default" || path == "lorem")
         {
-            currentLoaded = "default";
+            load_default();
             return;
         }
         if (path == "cat")
         {
             currentLoaded = "cat";
+            load_builtin(CAT_IPSUM, CAT_COUNTS);
             return;
         }
         if (path == "dog" || path == "doggo")
         {
             currentLoaded = "dog";
+            load_builtin(DOG_IPSUM, DOG_COUNTS);
             return;
         }
         if (path == "corpo" || path == "corporate")
         {
             currentLoaded = "corpo";
+            load_builtin(CORPO_IPSUM, CORPO_COUNTS);
             return;
         }
-        std::ifstream                   file(path);
-        std::unordered_set<std::string> unique;
-        std::string                     word;
-        char                            letter;
-        if (!file.is_open())
+        if (path == "-")
+        {
+            load_stream(std::cin, path);
+            return;
+        }
+        auto file = std::make_shared<internal::MappedFile>();
+        if (!file->open(path))
         {
             internal::LogWarn(internal::LogType::Warn,
                               "lpsm::Source::load(): Could not open file ",
                               path,
                               "; falling back to standard lorem-ipsum source");
+            load_default();
+            return;
+        }
+        if (internal::IsSourceFile(file->data()))
+        {
+            load_compiled(file->data(), file, path);
             return;
         }
-        while (file.get(letter))
+        load_buffer(file->data(), path, threads);
+#else
+        load_default();
+#endif
+    }
+
+#ifndef LIPSUM_MIN_BUILD
+    void Source::load_buffer(std::string_view   text,
+                             const std::string& name,
+                             unsigned int       threads)
+    {
+        if (internal::IsSourceFile(text))
+        {
+            load_compiled(text, nullptr, name);
+            return;
+        }
+        currentLoaded = name;
+        clear();
+        {
+            internal::WordSet words(m_Arena, m_Offsets, m_Weights);
+            internal::TokenizeWordsParallel(text, words, threads);
+        }
+        finish_load(name);
+    }
+
+    void Source::load_stream(std::istream& stream, const std::string& name)
+    {
+        constexpr std::size_t BLOCK_SIZE = 1024 * 1024;
+
+        currentLoaded = name;
+        clear();
         {
-            if (LPSM_SAFE_CCTYPE(bool, std::isalnum, letter) || letter == '_' ||
-                letter == '-' || letter == '\'')
+            internal::WordSet words(m_Arena, m_Offsets, m_Weights);
+            std::string       block;
+            std::size_t       carried = 0;
+            while (stream)
             {
-                word += LPSM_SAFE_CCTYPE(char, std::tolower, letter);
+                block.resize(carried + BLOCK_SIZE);
+                stream.read(block.data() + carried,
+                            static_cast<std::streamsize>(BLOCK_SIZE));
+                auto got = static_cast<std::size_t>(stream.gcount());
+                block.resize(carried + got);
+                // hold back a word that may continue in the next block
+                std::size_t end = block.size();
+                if (stream)
+                {
+                    while (end > 0 && internal::IsWordChar(block[end - 1]))
+                    {
+                        --end;
+                    }
+                }
+                internal::TokenizeWords(std::string_view(block).substr(0, end),
+                                        words);
+                block.erase(0, end);
+                carried = block.size();
             }
-            else if (!word.empty())
+        }
+        finish_load(name);
+    }
+
+    bool Source::save(const std::string& path) const
+    {
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::Source::save(): Could not open file ",
+                              path);
+            return false;
+        }
+        std::size_t count    = size();
+        bool        weighted = has_weights();
+        std::string head;
+        head.reserve(internal::SOURCE_FILE_HEADER_SIZE +
+                     ((count + 1) * sizeof(std::uint64_t)));
+        head.append(internal::SOURCE_FILE_MAGIC);
+        internal::AppendLittleEndian(head, internal::SOURCE_FILE_VERSION);
+        internal::AppendLittleEndian(
+                head, weighted ? internal::SOURCE_FILE_HAS_WEIGHTS : 0U);
+        internal::AppendLittleEndian<std::uint64_t>(head, count);
+        std::size_t blobSizeAt = head.size();
+        internal::AppendLittleEndian<std::uint64_t>(head, 0);
+        std::uint64_t offset = 0;
+        internal::AppendLittleEndian(head, offset);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            offset += word_at(i).size();
+            internal::AppendLittleEndian(head, offset);
+        }
+        // the blob size is only known once every offset is
+        std::string blobSize;
+        internal::AppendLittleEndian(blobSize, offset);
+        head.replace(blobSizeAt, blobSize.size(), blobSize);
+        if (weighted)
+        {
+            for (std::size_t i = 0; i < count; ++i)
             {
-                unique.insert(word);
-                word.clear();
+                internal::AppendLittleEndian(head, weight_at(i));
             }
+            head.resize(internal::SourceFileLayoutOf(count, offset, true)
+                                .blobAt,
+                        '\0');
         }
-        if (!word.empty())
+        file.write(head.data(), static_cast<std::streamsize>(head.size()));
+        for (std::size_t i = 0; i < count; ++i)
         {
-            unique.insert(word);
+            std::string_view word = word_at(i);
+            file.write(word.data(), static_cast<std::streamsize>(word.size()));
+        }
+        file.flush();
+        if (!file)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::Source::save(): Could not write file ",
+                              path);
+            return false;
+        }
+        return true;
+    }
+
+    bool Source::has_weights() const
+    {
+        return weights_data() != nullptr;
+    }
+
+    std::uint32_t Source::weight_at(std::size_t idx) const
+    {
+        const std::uint32_t* weights = weights_data();
+        return weights != nullptr ? weights[idx] : 1;
+    }
+
+    std::string_view Source::weighted_word_view(std::mt19937& gen) const
+    {
+        if (m_Table.size() == 0)
+        {
+            return random_word_view(gen);
+        }
+        return word_at(m_Table.sample(gen));
+    }
+
+    std::string_view Source::weighted_word_view(Engine& gen) const
+    {
+        if (m_Table.size() == 0)
+        {
+            return random_word_view(gen);
+        }
+        return word_at(m_Table.sample(gen));
+    }
+
+    const std::uint32_t* Source::weights_data() const
+    {
+        if (m_Mapped)
+        {
+            return m_MappedWeights;
+        }
+        return m_Weights.empty() ? nullptr : m_Weights.data();
+    }
+
+    void Source::build_table()
+    {
+        const std::uint32_t* weights = weights_data();
+        if (weights == nullptr)
+        {
+            m_Table = WeightedTable();
+            return;
+        }
+        m_Table = WeightedTable(weights, size());
+    }
+
+    void Source::load_compiled(
+            std::string_view                            data,
+            std::shared_ptr<const internal::MappedFile> owner,
+            const std::string&                          name)
+    {
+        currentLoaded = name;
+        clear();
+        internal::SourceFileLayout layout;
+        const char* error = internal::ReadSourceFileHeader(data, layout);
+        if (error == nullptr && !internal::CheckSourceOffsets(data, layout))
+        {
+            error = "invalid word offsets";
+        }
+        if (error != nullptr)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::Source::load(): ",
+                              error,
+                              " in ",
+                              name,
+                              "; falling back to standard lorem-ipsum source");
+            load_default();
+            return;
+        }
+
+        const char* base    = data.data();
+        bool        inPlace = owner != nullptr &&
+                       std::endian::native == std::endian::little &&
+                       reinterpret_cast<std::uintptr_t>(base) %
+                                       alignof(std::uint64_t) ==
+                               0;
+        if (inPlace)
+        {
+            // the header guarantees every part is aligned within the file
+            m_Mapped        = std::move(owner);
+            m_MappedBlob    = base + layout.blobAt;
+            m_MappedOffsets = reinterpret_cast<const std::uint64_t*>(
+                    base + layout.offsetsAt);
+            m_MappedCount   = layout.count;
+            if (layout.hasWeights)
+            {
+                m_MappedWeights = reinterpret_cast<const std::uint32_t*>(
+                        base + layout.weightsAt);
+            }
+        }
+        else
+        {
+            m_Arena.assign(base + layout.blobAt, layout.blobSize);
+            m_Offsets.resize(layout.count + 1);
+            for (std::size_t i = 0; i <= layout.count; ++i)
+            {
+                m_Offsets[i] = internal::ReadLittleEndian<std::uint64_t>(
+                        base + layout.offsetsAt + (i * sizeof(std::uint64_t)));
+            }
+            if (layout.hasWeights)
+            {
+                m_Weights.resize(layout.count);
+                for (std::size_t i = 0; i < layout.count; ++i)
+                {
+                    m_Weights[i] = internal::ReadLittleEndian<std::uint32_t>(
+                            base + layout.weightsAt +
+                            (i * sizeof(std::uint32_t)));
+                }
+            }
+        }
+        finish_load(name);
+    }
+#endif
+
+    void Source::finish_load(const std::string& name)
+    {
+        if (size() == 0)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::Source::load(): No words found in ",
+                              name,
+                              "; falling back to standard lorem-ipsum source");
+            load_default();
+            return;
+        }
+#ifndef LIPSUM_MIN_BUILD
+        build_table();
+#endif
+        measure_words();
+    }
+
+    void Source::measure_words()
+    {
+        std::size_t count = size();
+        double      total = 0.0;
+        m_MaxLength       = 0;
+#ifndef LIPSUM_MIN_BUILD
+        const std::uint32_t* weights       = weights_data();
+        double               weightedTotal = 0.0;
+        double               weightSum     = 0.0;
+#endif
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::size_t length = word_at(i).size();
+            m_MaxLength        = std::max(m_MaxLength, length);
+            total += static_cast<double>(length);
+#ifndef LIPSUM_MIN_BUILD
+            if (weights != nullptr)
+            {
+                weightedTotal += static_cast<double>(length) * weights[i];
+                weightSum += weights[i];
+            }
+#endif
+        }
+
+        m_MeanLength = (count == 0 ? 0.0 : total / static_cast<double>(count));
+#ifndef LIPSUM_MIN_BUILD
+        m_WeightedMeanLength =
+                (weightSum > 0.0 ? weightedTotal / weightSum : m_MeanLength);
+        if (m_Mapped)
+        {
+            m_Escaped.build(m_MappedBlob, m_MappedOffsets, count);
+            m_XmlNames.build(m_MappedBlob,
+                             m_MappedOffsets,
+                             count,
+                             internal::EscapedWords::Form::XmlName);
+        }
+        else
+        {
+            m_Escaped.build(m_Arena.data(), m_Offsets.data(), count);
+            m_XmlNames.build(m_Arena.data(),
+                             m_Offsets.data(),
+                             count,
+                             internal::EscapedWords::Form::XmlName);
         }
-        std::copy(unique.begin(), unique.end(), std::back_inserter(m_Words));
-#else
-        currentLoaded = "default";
 #endif
+        LPSM_VERBOSE_LOG(Trace,
+                         "Measured ",
+                         count,
+                         " words: mean size ",
+                         m_MeanLength,
+                         ", longest ",
+                         m_MaxLength);
     }
 } // namespace lipsum
@@ -0,0 +1,201 @@
+/**
+ * @file lipsum/core/sourcefile.hpp
+ *
+ * @brief Compiled source files of lipsum-cpp
+ *
+ * This declares the layout of compiled .lpsmsrc source files, which
+ * lipsum::Source can load without splitting any text. This file is under the
+ * BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum::internal
+{
+    /**
+     * @brief Magic bytes that start every compiled source file
+     *
+     * @since 0.5.3
+     */
+    inline constexpr std::string_view SOURCE_FILE_MAGIC{"LPSMSRC\0", 8};
+
+    /**
+     * @brief Version of the compiled source file layout
+     *
+     * @since 0.5.3
+     */
+    inline constexpr std::uint32_t SOURCE_FILE_VERSION = 1;
+
+    /**
+     * @brief Flag set in compiled source files that store word weights
+     *
+     * @since 0.5.3
+     */
+    inline constexpr std::uint32_t SOURCE_FILE_HAS_WEIGHTS = 1U << 0;
+
+    /**
+     * @brief Size of the header of compiled source files
+     *
+     * @since 0.5.3
+     *
+     * The header holds, in order: SOURCE_FILE_MAGIC, the version and the flags
+     * as 32-bit integers, then the word count and the size of the word blob as
+     * 64-bit integers. Every integer in the file is little-endian.
+     */
+    inline constexpr std::size_t SOURCE_FILE_HEADER_SIZE = 32;
+
+    /**
+     * @brief Where the parts of a compiled source file are
+     *
+     * @since 0.5.3
+     *
+     * After the header come the word count + 1 offsets of the words in the
+     * blob as 64-bit integers, then, if SOURCE_FILE_HAS_WEIGHTS is set, one
+     * 32-bit weight per word padded to a multiple of 8 bytes, then the blob.
+     * Every part starts 8-byte aligned, so a mapped file can be used in place.
+     */
+    struct SourceFileLayout
+    {
+        std::uint64_t count      = 0;     ///< Number of words
+        std::uint64_t blobSize   = 0;     ///< Size of the word blob
+        bool          hasWeights = false; ///< Whether weights are stored
+        std::size_t   offsetsAt  = 0;     ///< Start of the offset table
+        std::size_t   weightsAt  = 0;     ///< Start of the weights, if any
+        std::size_t   blobAt     = 0;     ///< Start of the word blob
+        std::size_t   fileSize   = 0;     ///< Size of the whole file
+    };
+
+    /**
+     * @brief Check if data starts like a compiled source file.
+     *
+     * @since 0.5.3
+     *
+     * @param data The data.
+     *
+     * @return bool Whether data starts with SOURCE_FILE_MAGIC.
+     */
+    LIPSUM_API bool IsSourceFile(std::string_view data);
+
+    /**
+     * @brief Compute the layout of a compiled source file.
+     *
+     * @since 0.5.3
+     *
+     * @param count The number of words.
+     * @param blobSize The size of the word blob.
+     * @param hasWeights Whether weights are stored.
+     *
+     * @return SourceFileLayout The layout.
+     */
+    LIPSUM_API SourceFileLayout SourceFileLayoutOf(std::uint64_t count,
+                                                   std::uint64_t blobSize,
+                                                   bool          hasWeights);
+
+    /**
+     * @brief Read and check the header of a compiled source file.
+     *
+     * @since 0.5.3
+     *
+     * Check the magic bytes, version, and that every part fits in data.
+     * The offsets themselves are checked by CheckSourceOffsets().
+     *
+     * @param data The whole file.
+     * @param layout The layout read from the header.
+     *
+     * @return const char* nullptr if the header is valid, or the reason it
+     * is not.
+     */
+    LIPSUM_API const char* ReadSourceFileHeader(std::string_view  data,
+                                                SourceFileLayout& layout);
+
+    /**
+     * @brief Check the offset table of a compiled source file.
+     *
+     * @since 0.5.3
+     *
+     * Check that the offsets start at 0, never decrease, and end at the size
+     * of the blob, so that every word lies inside the blob.
+     *
+     * @param data The whole file.
+     * @param layout The layout read from the header.
+     *
+     * @return bool Whether the offsets are valid.
+     */
+    LIPSUM_API bool CheckSourceOffsets(std::string_view        data,
+                                       const SourceFileLayout& layout);
+
+    /**
+     * @brief Reverse the bytes of an integer.
+     *
+     * @since 0.5.3
+     *
+     * @tparam T The unsigned integer type.
+     *
+     * @param value The integer.
+     *
+     * @return T The integer with its bytes reversed.
+     */
+    template <typename T>
+    constexpr T ByteSwap(T value)
+    {
+        T result = 0;
+        for (std::size_t i = 0; i < sizeof(T); ++i)
+        {
+            result = static_cast<T>((result << 8) | (value & 0xFF));
+            value  = static_cast<T>(value >> 8);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Read a little-endian integer.
+     *
+     * @since 0.5.3
+     *
+     * @tparam T The unsigned integer type.
+     *
+     * @param data The first byte of the integer.
+     *
+     * @return T The integer.
+     */
+    template <typename T>
+    T ReadLittleEndian(const char* data)
+    {
+        T value = 0;
+        std::memcpy(&value, data, sizeof(T));
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            value = ByteSwap(value);
+        }
+        return value;
+    }
+
+    /**
+     * @brief Append a little-endian integer to a buffer.
+     *
+     * @since 0.5.3
+     *
+     * @tparam T The unsigned integer type.
+     *
+     * @param buffer The buffer.
+     * @param value The integer.
+     */
+    template <typename T>
+    void AppendLittleEndian(std::string& buffer, T value)
+    {
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            value = ByteSwap(value);
+        }
+        std::array<char, sizeof(T)> bytes{};
+        std::memcpy(bytes.data(), &value, sizeof(T));
+        buffer.append(bytes.data(), sizeof(T));
+    }
+} // namespace lipsum::internal
+#endif
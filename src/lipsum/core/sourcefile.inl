@@ -0,0 +1,102 @@
+/**
+ * @file lipsum/core/sourcefile.inl
+ *
+ * @brief Compiled source files of lipsum-cpp
+ *
+ * This defines the functions that read the layout of compiled .lpsmsrc source
+ * files. This file is under the BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "internal.hpp"
+#include "sourcefile.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum::internal
+{
+    bool IsSourceFile(std::string_view data)
+    {
+        return data.starts_with(SOURCE_FILE_MAGIC);
+    }
+
+    SourceFileLayout SourceFileLayoutOf(std::uint64_t count,
+                                        std::uint64_t blobSize,
+                                        bool          hasWeights)
+    {
+        SourceFileLayout layout;
+        layout.count      = count;
+        layout.blobSize   = blobSize;
+        layout.hasWeights = hasWeights;
+        layout.offsetsAt  = SOURCE_FILE_HEADER_SIZE;
+        layout.weightsAt  = layout.offsetsAt +
+                           ((count + 1) * sizeof(std::uint64_t));
+        std::size_t weightsSize = 0;
+        if (hasWeights)
+        {
+            // round up to keep the blob 8-byte aligned
+            weightsSize = ((count * sizeof(std::uint32_t)) + 7) &
+                          ~std::size_t{7};
+        }
+        layout.blobAt   = layout.weightsAt + weightsSize;
+        layout.fileSize = layout.blobAt + blobSize;
+        return layout;
+    }
+
+    const char* ReadSourceFileHeader(std::string_view  data,
+                                     SourceFileLayout& layout)
+    {
+        if (data.size() < SOURCE_FILE_HEADER_SIZE || !IsSourceFile(data))
+        {
+            return "not a compiled source file";
+        }
+        const char* header = data.data() + SOURCE_FILE_MAGIC.size();
+        if (ReadLittleEndian<std::uint32_t>(header) != SOURCE_FILE_VERSION)
+        {
+            return "unsupported version";
+        }
+        auto flags    = ReadLittleEndian<std::uint32_t>(header + 4);
+        auto count    = ReadLittleEndian<std::uint64_t>(header + 8);
+        auto blobSize = ReadLittleEndian<std::uint64_t>(header + 16);
+
+        // compare against the file size first, so the layout cannot overflow
+        std::uint64_t room = data.size() - SOURCE_FILE_HEADER_SIZE;
+        if (count >= room / sizeof(std::uint64_t) || blobSize > room)
+        {
+            return "truncated file";
+        }
+        layout = SourceFileLayoutOf(
+                count, blobSize, (flags & SOURCE_FILE_HAS_WEIGHTS) != 0);
+        if (layout.fileSize > data.size())
+        {
+            return "truncated file";
+        }
+        return nullptr;
+    }
+
+    bool CheckSourceOffsets(std::string_view        data,
+                            const SourceFileLayout& layout)
+    {
+        const char*   table    = data.data() + layout.offsetsAt;
+        std::uint64_t previous = ReadLittleEndian<std::uint64_t>(table);
+        if (previous != 0)
+        {
+            return false;
+        }
+        for (std::uint64_t i = 1; i <= layout.count; ++i)
+        {
+            auto offset = ReadLittleEndian<std::uint64_t>(
+                    table + (i * sizeof(std::uint64_t)));
+            if (offset < previous)
+            {
+                return false;
+            }
+            previous = offset;
+        }
+        return previous == layout.blobSize;
+    }
+} // namespace lipsum::internal
+#endif
@@ -0,0 +1,174 @@
+/**
+ * @file lipsum/core/sourceregistry.hpp
+ *
+ * @brief Shared sources of lipsum-cpp
+ *
+ * This declares lipsum::SourceRegistry. This file is under the BSD Zero-Clause
+ * License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core.hpp"
+#include "source.hpp"
+
+namespace lipsum
+{
+    /**
+     * @brief Thread-safe cache of loaded sources
+     *
+     * @since 0.5.3
+     *
+     * This class hands out read-only sources shared between every generator
+     * that uses them, keyed by path or built-in name, and loads each source
+     * only once, however many threads ask for it at the same time. Sources
+     * stay loaded until they are erased from the registry and the last
+     * generator using them is destroyed, and a file is not read again when
+     * it changes until it is erased. lipsum::Generator uses global() for the
+     * default source, and for others only when given a source from it.
+     */
+    class LIPSUM_API SourceRegistry
+    {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * @since 0.5.3
+         *
+         * Create an empty registry. Most programs should use global() instead.
+         */
+        SourceRegistry() = default;
+
+        SourceRegistry(const SourceRegistry&)            = delete;
+        SourceRegistry& operator=(const SourceRegistry&) = delete;
+
+        /**
+         * @brief Get the registry of the process.
+         *
+         * @since 0.5.3
+         *
+         * @return SourceRegistry& The registry lipsum::Generator uses.
+         */
+        static SourceRegistry& global();
+
+        /**
+         * @brief Get a source, loading it if needed.
+         *
+         * @since 0.5.3
+         *
+         * Return the source loaded from path, loading it with
+         * lipsum::Source::load() the first time it is asked for. Other
+         * threads asking for the same source wait for that load instead of
+         * loading it again; sources with other paths load in parallel. The
+         * aliases of built-in sources, such as "lorem" and "default", share
+         * one source. If path cannot be loaded, the default source is
+         * returned and nothing is kept under path, so a later get() tries
+         * again.
+         *
+         * @param path A path to the source file or the name of a built-in
+         * source.
+         * @param threads The maximum number of threads used to split large
+         * files, if the source is loaded. By default 1.
+         *
+         * @return std::shared_ptr<const Source> The source, never nullptr.
+         *
+         * @sa lipsum::Source::load
+         */
+        std::shared_ptr<const Source> get(const std::string& path,
+                                          unsigned int       threads = 1);
+
+        /**
+         * @brief Add a source that was loaded elsewhere.
+         *
+         * @since 0.5.3
+         *
+         * Store source under name, replacing any source stored there, so that
+         * get() returns it. Useful for sources loaded with
+         * lipsum::Source::load_buffer() or lipsum::Source::load_stream().
+         *
+         * @param name The name to store the source under.
+         * @param source The source.
+         *
+         * @return std::shared_ptr<const Source> The stored source.
+         */
+        std::shared_ptr<const Source> insert(const std::string& name,
+                                             Source             source);
+
+        /**
+         * @brief Drop a source from the registry.
+         *
+         * @since 0.5.3
+         *
+         * The next get() loads the source again. Generators already using the
+         * source keep it.
+         *
+         * @param path The path or name the source is stored under.
+         *
+         * @return bool Whether a source was stored under path.
+         */
+        bool erase(const std::string& path);
+
+        /**
+         * @brief Drop every source from the registry.
+         *
+         * @since 0.5.3
+         *
+         * Generators already using the sources keep them.
+         */
+        void clear();
+
+        /**
+         * @brief Get the number of sources in the registry.
+         *
+         * @since 0.5.3
+         *
+         * @return std::size_t The number of sources, loaded or loading.
+         */
+        [[nodiscard]] std::size_t size() const;
+
+    private:
+        /**
+         * @brief A source in the registry
+         *
+         * @since 0.5.3
+         *
+         * Each entry has its own lock, held while the source loads, so that
+         * loading one source does not block getting another.
+         */
+        struct Entry
+        {
+            std::mutex                    lock;   ///< Held while loading
+            std::shared_ptr<const Source> source; ///< The source, once loaded
+        };
+
+        /**
+         * @brief Map the aliases of built-in sources to one name.
+         *
+         * @since 0.5.3
+         *
+         * @param path A path to the source file or the name of a built-in
+         * source.
+         *
+         * @return std::string The name the source is stored under.
+         */
+        static std::string key_of(const std::string& path);
+
+        /**
+         * @brief Find or create the entry of a source.
+         *
+         * @since 0.5.3
+         *
+         * @param key The name the source is stored under.
+         *
+         * @return std::shared_ptr<Entry> The entry.
+         */
+        std::shared_ptr<Entry> entry_of(const std::string& key);
+
+        mutable std::mutex m_Lock; ///< Guards m_Entries
+        std::unordered_map<std::string, std::shared_ptr<Entry>>
+                m_Entries; ///< Every source, by key_of() its path
+    };
+} // namespace lipsum
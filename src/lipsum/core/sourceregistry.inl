@@ -0,0 +1,124 @@
+/**
+ * @file lipsum/core/sourceregistry.inl
+ *
+ * @brief Shared sources of lipsum-cpp
+ *
+ * This defines lipsum::SourceRegistry. This file is under the BSD Zero-Clause
+ * License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "internal.hpp"
+#include "sourceregistry.hpp"
+
+namespace lipsum
+{
+    SourceRegistry& SourceRegistry::global()
+    {
+        static SourceRegistry registry;
+        return registry;
+    }
+
+    std::shared_ptr<const Source>
+    SourceRegistry::get(const std::string& path,
+                        [[maybe_unused]] unsigned int threads)
+    {
+        std::string            key   = key_of(path);
+        std::shared_ptr<Entry> entry = entry_of(key);
+
+        // only the entry is locked while loading, and only the first caller
+        // loads; the rest wait here and find the source ready
+        std::lock_guard<std::mutex> guard(entry->lock);
+        if (!entry->source)
+        {
+            LPSM_VERBOSE_LOG(Info, "Loading shared source ", key);
+            auto source = std::make_shared<Source>();
+            source->load(key, threads);
+            if (key != "default" && source->name() == "default")
+            {
+                // the load failed and fell back to lorem ipsum; keep only the
+                // fallback, under its own key, so that the next get() of path
+                // tries again
+                LPSM_VERBOSE_LOG(Info, "Not keeping failed source ", key);
+                {
+                    std::lock_guard<std::mutex> mapGuard(m_Lock);
+                    auto found = m_Entries.find(key);
+                    if (found != m_Entries.end() && found->second == entry)
+                    {
+                        m_Entries.erase(found);
+                    }
+                }
+                return get("default", threads);
+            }
+            entry->source = std::move(source);
+        }
+        return entry->source;
+    }
+
+    std::shared_ptr<const Source>
+    SourceRegistry::insert(const std::string& name, Source source)
+    {
+        auto shared   = std::make_shared<const Source>(std::move(source));
+        auto entry    = std::make_shared<Entry>();
+        entry->source = shared;
+        std::lock_guard<std::mutex> guard(m_Lock);
+        m_Entries[key_of(name)] = std::move(entry);
+        return shared;
+    }
+
+    bool SourceRegistry::erase(const std::string& path)
+    {
+        std::lock_guard<std::mutex> guard(m_Lock);
+        return m_Entries.erase(key_of(path)) != 0;
+    }
+
+    void SourceRegistry::clear()
+    {
+        std::lock_guard<std::mutex> guard(m_Lock);
+        m_Entries.clear();
+    }
+
+    std::size_t SourceRegistry::size() const
+    {
+        std::lock_guard<std::mutex> guard(m_Lock);
+        return m_Entries.size();
+    }
+
+    std::string
+    SourceRegistry::key_of([[maybe_unused]] const std::string& path)
+    {
+#ifndef LIPSUM_MIN_BUILD
+        if (path == "lorem")
+        {
+            return "default";
+        }
+        if (path == "doggo")
+        {
+            return "dog";
+        }
+        if (path == "corporate")
+        {
+            return "corpo";
+        }
+        return path;
+#else
+        return "default";
+#endif
+    }
+
+    std::shared_ptr<SourceRegistry::Entry>
+    SourceRegistry::entry_of(const std::string& key)
+    {
+        std::lock_guard<std::mutex> guard(m_Lock);
+        std::shared_ptr<Entry>&     entry = m_Entries[key];
+        if (!entry)
+        {
+            entry = std::make_shared<Entry>();
+        }
+        return entry;
+    }
+} // namespace lipsum
@@ -13,18 +13,37 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
 #include <cctype>
+#include <cmath>
 #include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <random>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
 #include <vector>
 #ifndef LIPSUM_MIN_BUILD
+#    include <cerrno>
 #    include <charconv>
+#    include <coroutine>
+#    include <cstdio>
+#    include <exception>
 #    include <fstream>
-#    include <type_traits>
+#    include <ranges>
 #    include <unordered_set>
 #    ifdef __EMSCRIPTEN__
 #        include <emscripten/console.h>
@@ -36,6 +55,20 @@
 #        ifndef NOMINMAX
 #            define NOMINMAX
 #        endif
+#        include <io.h>
 #        include <windows.h>
+#    else
+#        include <fcntl.h>
+#        include <sys/mman.h>
+#        include <sys/stat.h>
+#        include <unistd.h>
 #    endif
 #endif
+#ifdef LPSM_HAS_THREADS
+#    include <condition_variable>
+#    include <future>
+#    include <thread>
+#endif
+#ifdef LPSM_HAS_SSE2
+#    include <emmintrin.h>
+#endif
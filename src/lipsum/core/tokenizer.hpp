@@ -0,0 +1,307 @@
+/**
+ * @file lipsum/core/tokenizer.hpp
+ *
+ * @brief Word tokenizer of lipsum-cpp
+ *
+ * This declares the functions lipsum::Source uses to split text into unique,
+ * lowercase words. This file is under the BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum::internal
+{
+    /**
+     * @brief Smallest chunk of text given its own thread
+     *
+     * @since 0.5.3
+     *
+     * Used by TokenizeWordsParallel(); smaller texts are not worth the cost
+     * of starting and merging threads.
+     */
+    inline constexpr std::size_t TOKENIZER_MIN_CHUNK = 4 * 1024 * 1024;
+
+    /**
+     * @brief Bytes of text expected per unique word
+     *
+     * @since 0.5.3
+     *
+     * Used by TokenizeWordsParallel() to size the hash table of a WordSet up
+     * front. Natural-language text has far fewer unique words than this, so
+     * the table rarely needs to grow.
+     */
+    inline constexpr std::size_t TOKENIZER_BYTES_PER_WORD = 256;
+
+    /**
+     * @brief Check if a character belongs in a word.
+     *
+     * @since 0.5.3
+     *
+     * Letters and digits (ASCII only, regardless of locale), underscores,
+     * hyphens, and apostrophes belong in words.
+     *
+     * @param letter The character.
+     *
+     * @return bool Whether letter belongs in a word.
+     */
+    constexpr bool IsWordChar(char letter)
+    {
+        return (letter >= '0' && letter <= '9') ||
+               (letter >= 'a' && letter <= 'z') ||
+               (letter >= 'A' && letter <= 'Z') || letter == '_' ||
+               letter == '-' || letter == '\'';
+    }
+
+    /**
+     * @brief Classify 64 characters at once.
+     *
+     * @since 0.5.3
+     *
+     * Use SSE2 where available, and a scalar loop otherwise.
+     *
+     * @param data The first of 64 readable characters.
+     *
+     * @return std::uint64_t A mask with bit i set if data[i] belongs in a
+     * word.
+     */
+    LIPSUM_API std::uint64_t WordMask64(const char* data);
+
+    /**
+     * @brief Index WordSet returns for empty words
+     *
+     * @since 0.5.3
+     */
+    inline constexpr std::uint32_t WORD_SET_NONE = 0xFFFFFFFF;
+
+    /**
+     * @brief Set of unique words stored in a word arena
+     *
+     * @since 0.5.3
+     *
+     * Append each new word to an arena and an offset table, in the layout of
+     * lipsum::Source, and count the words already seen instead of storing them
+     * again. Duplicates are found with an open-addressing hash table of word
+     * indices, so the words themselves are only stored once, in the arena.
+     */
+    class LIPSUM_API WordSet
+    {
+    public:
+        /**
+         * @brief Constructor for WordSet
+         *
+         * @since 0.5.3
+         *
+         * Clear arena, offsets and counts and start filling them.
+         *
+         * @param arena The arena the words are appended to.
+         * @param offsets The start of each word in arena, followed by the size
+         * of arena.
+         * @param counts The number of times each word was added.
+         */
+        WordSet(std::string&                arena,
+                std::vector<std::uint64_t>& offsets,
+                std::vector<std::uint32_t>& counts);
+
+        /**
+         * @brief Add a word, lowercasing it.
+         *
+         * @since 0.5.3
+         *
+         * @param word The word.
+         *
+         * @return std::uint32_t The index of the word, or WORD_SET_NONE if
+         * word is empty.
+         */
+        std::uint32_t insert(std::string_view word);
+
+        /**
+         * @brief Add a word that is already lowercase.
+         *
+         * @since 0.5.3
+         *
+         * @param word The word.
+         * @param count The number of times to count it. By default 1.
+         *
+         * @return std::uint32_t The index of the word, or WORD_SET_NONE if
+         * word is empty.
+         */
+        std::uint32_t insert_lowercase(std::string_view word,
+                                       std::uint32_t    count = 1);
+
+        /**
+         * @brief Make room for a number of unique words.
+         *
+         * @since 0.5.3
+         *
+         * Size the hash table so that it does not grow before holding count
+         * words.
+         *
+         * @param count The expected number of unique words.
+         */
+        void reserve(std::size_t count);
+
+        /**
+         * @brief Get the number of unique words.
+         *
+         * @since 0.5.3
+         *
+         * @return std::size_t The number of unique words.
+         */
+        [[nodiscard]] std::size_t size() const;
+
+    private:
+        /**
+         * @brief A slot of the hash table
+         *
+         * @since 0.5.3
+         */
+        struct Slot
+        {
+            std::uint32_t hash;  ///< Lower bits of the hash of the word
+            std::uint32_t index; ///< Index of the word plus 1, or 0 if empty
+        };
+
+        /**
+         * @brief Hash a word.
+         *
+         * @since 0.5.3
+         *
+         * @param word The word.
+         *
+         * @return std::uint64_t The hash.
+         */
+        static std::uint64_t hash(std::string_view word);
+
+        /**
+         * @brief Keep or count the word at the end of the arena.
+         *
+         * @since 0.5.3
+         *
+         * Keep the word if it is new, or drop it and add to the count of the
+         * word already seen. Counts stop at the largest 32-bit integer.
+         *
+         * @param start The start of the word in the arena.
+         * @param count The number of times to count the word.
+         *
+         * @return std::uint32_t The index of the word, or WORD_SET_NONE if
+         * the word is empty.
+         */
+        std::uint32_t commit(std::size_t start, std::uint32_t count);
+
+        /**
+         * @brief Resize the hash table and reinsert every word.
+         *
+         * @since 0.5.3
+         *
+         * @param slots The new number of slots, a power of 2.
+         */
+        void rehash(std::size_t slots);
+
+        std::string&                m_Arena;     ///< The word arena
+        std::vector<std::uint64_t>& m_Offsets;   ///< The offset table
+        std::vector<std::uint32_t>& m_Counts;    ///< The word counts
+        std::vector<Slot>           m_Slots;     ///< The hash table
+        unsigned int                m_Shift = 0; ///< 64 - log2(slots)
+    };
+
+    /**
+     * @brief Call a function on every word of a text.
+     *
+     * @since 0.5.3
+     *
+     * Characters are classified 64 at a time with WordMask64(), and word
+     * boundaries are read off the masks.
+     *
+     * @tparam F The function type.
+     *
+     * @param text The text.
+     * @param onWord The function, called in order with each word as a view
+     * into text.
+     */
+    template <typename F>
+    void ForEachWord(std::string_view text, F&& onWord)
+    {
+        constexpr std::size_t BLOCK = 64;
+
+        bool        inWord = false;
+        std::size_t start  = 0;
+        for (std::size_t pos = 0; pos < text.size(); pos += BLOCK)
+        {
+            std::uint64_t mask = 0;
+            if (text.size() - pos >= BLOCK)
+            {
+                mask = WordMask64(text.data() + pos);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < text.size() - pos; ++i)
+                {
+                    mask |= static_cast<std::uint64_t>(
+                                    IsWordChar(text[pos + i]))
+                            << i;
+                }
+            }
+            // a set bit marks a character unlike the one before it
+            std::uint64_t edges =
+                    mask ^ ((mask << 1) | static_cast<std::uint64_t>(inWord));
+            while (edges != 0)
+            {
+                std::size_t at = pos + static_cast<std::size_t>(
+                                               std::countr_zero(edges));
+                edges         &= edges - 1;
+                if (inWord)
+                {
+                    onWord(text.substr(start, at - start));
+                }
+                else
+                {
+                    start = at;
+                }
+                inWord = !inWord;
+            }
+        }
+        if (inWord)
+        {
+            onWord(text.substr(start));
+        }
+    }
+
+    /**
+     * @brief Split text into words.
+     *
+     * @since 0.5.3
+     *
+     * Add every word of text to words, in order, counting repeats, with
+     * ForEachWord().
+     *
+     * @param text The text.
+     * @param words The set to add the words to.
+     */
+    LIPSUM_API void TokenizeWords(std::string_view text, WordSet& words);
+
+    /**
+     * @brief Split text into words on several threads.
+     *
+     * @since 0.5.3
+     *
+     * Cut text into chunks at word boundaries, collect the unique words of
+     * each chunk on its own thread, then merge them in order, so that the
+     * result is the same as TokenizeWords(). Use at most threads threads (0
+     * for one per hardware thread), and at least TOKENIZER_MIN_CHUNK bytes
+     * per thread. Without thread support, same as TokenizeWords().
+     *
+     * @param text The text.
+     * @param words The set to add the words to.
+     * @param threads The maximum number of threads.
+     */
+    LIPSUM_API void TokenizeWordsParallel(std::string_view text,
+                                          WordSet&         words,
+                                          unsigned int     threads);
+} // namespace lipsum::internal
+#endif
@@ -0,0 +1,290 @@
+/**
+ * @file lipsum/core/tokenizer.inl
+ *
+ * @brief Word tokenizer of lipsum-cpp
+ *
+ * This defines the functions lipsum::Source uses to split text into unique,
+ * lowercase words. This file is under the BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "internal.hpp"
+#include "tokenizer.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum::internal
+{
+    std::uint64_t WordMask64(const char* data)
+    {
+        std::uint64_t mask = 0;
+#    ifdef LPSM_HAS_SSE2
+        const __m128i caseBit    = _mm_set1_epi8(0x20);
+        const __m128i beforeA    = _mm_set1_epi8('a' - 1);
+        const __m128i afterZ     = _mm_set1_epi8('z' + 1);
+        const __m128i before0    = _mm_set1_epi8('0' - 1);
+        const __m128i after9     = _mm_set1_epi8('9' + 1);
+        const __m128i underscore = _mm_set1_epi8('_');
+        const __m128i hyphen     = _mm_set1_epi8('-');
+        const __m128i apostrophe = _mm_set1_epi8('\'');
+        for (int block = 0; block < 4; ++block)
+        {
+            __m128i bytes = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(data + (block * 16)));
+            // setting the case bit maps exactly A-Z and a-z to a-z; bytes over
+            // 0x7F are negative and fail every signed range check
+            __m128i folded = _mm_or_si128(bytes, caseBit);
+            __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(folded, beforeA),
+                                           _mm_cmplt_epi8(folded, afterZ));
+            __m128i digit  = _mm_and_si128(_mm_cmpgt_epi8(bytes, before0),
+                                          _mm_cmplt_epi8(bytes, after9));
+            __m128i other  = _mm_or_si128(
+                    _mm_cmpeq_epi8(bytes, underscore),
+                    _mm_or_si128(_mm_cmpeq_epi8(bytes, hyphen),
+                                 _mm_cmpeq_epi8(bytes, apostrophe)));
+            auto bits = static_cast<std::uint32_t>(_mm_movemask_epi8(
+                    _mm_or_si128(letter, _mm_or_si128(digit, other))));
+            mask |= static_cast<std::uint64_t>(bits) << (block * 16);
+        }
+#    else
+        for (int i = 0; i < 64; ++i)
+        {
+            mask |= static_cast<std::uint64_t>(IsWordChar(data[i])) << i;
+        }
+#    endif
+        return mask;
+    }
+
+    WordSet::WordSet(std::string&                arena,
+                     std::vector<std::uint64_t>& offsets,
+                     std::vector<std::uint32_t>& counts)
+        : m_Arena(arena), m_Offsets(offsets), m_Counts(counts)
+    {
+        m_Arena.clear();
+        m_Offsets.assign(1, 0);
+        m_Counts.clear();
+        reserve(0);
+    }
+
+    void WordSet::reserve(std::size_t count)
+    {
+        constexpr std::size_t MIN_SLOTS = 1024;
+
+        std::size_t slots = std::max(MIN_SLOTS, std::bit_ceil(count * 2));
+        if (slots > m_Slots.size())
+        {
+            rehash(slots);
+        }
+    }
+
+    std::uint32_t WordSet::insert(std::string_view word)
+    {
+        std::size_t start = m_Arena.size();
+        m_Arena.append(word);
+        for (std::size_t i = start; i < m_Arena.size(); ++i)
+        {
+            char& letter = m_Arena[i];
+            if (letter >= 'A' && letter <= 'Z')
+            {
+                letter = static_cast<char>(letter - 'A' + 'a');
+            }
+        }
+        return commit(start, 1);
+    }
+
+    std::uint32_t WordSet::insert_lowercase(std::string_view word,
+                                            std::uint32_t    count)
+    {
+        std::size_t start = m_Arena.size();
+        m_Arena.append(word);
+        return commit(start, count);
+    }
+
+    std::size_t WordSet::size() const
+    {
+        return m_Offsets.size() - 1;
+    }
+
+    std::uint64_t WordSet::hash(std::string_view word)
+    {
+        constexpr std::uint64_t MUL_A = 0xFF51AFD7ED558CCDULL;
+        constexpr std::uint64_t MUL_B = 0x9E3779B97F4A7C15ULL;
+
+        std::uint64_t result = word.size() * MUL_A;
+        std::uint64_t chunk;
+        while (word.size() >= sizeof(chunk))
+        {
+            std::memcpy(&chunk, word.data(), sizeof(chunk));
+            result = (result ^ chunk) * MUL_A;
+            result ^= result >> 32;
+            word.remove_prefix(sizeof(chunk));
+        }
+        chunk = 0;
+        for (std::size_t i = 0; i < word.size(); ++i)
+        {
+            chunk |= static_cast<std::uint64_t>(
+                             static_cast<unsigned char>(word[i]))
+                     << (i * 8);
+        }
+        // the slot comes from the upper bits, which the multiply mixes best
+        return (result ^ chunk) * MUL_B;
+    }
+
+    std::uint32_t WordSet::commit(std::size_t start, std::uint32_t count)
+    {
+        std::string_view word(m_Arena.data() + start, m_Arena.size() - start);
+        if (word.empty())
+        {
+            return WORD_SET_NONE;
+        }
+        // keep the load factor under 1/2
+        if ((size() + 1) * 2 > m_Slots.size())
+        {
+            rehash(m_Slots.size() * 2);
+        }
+        std::uint64_t wordHash = hash(word);
+        auto          check    = static_cast<std::uint32_t>(wordHash);
+        std::size_t   mask     = m_Slots.size() - 1;
+        for (std::size_t pos = wordHash >> m_Shift;; pos = (pos + 1) & mask)
+        {
+            Slot& slot = m_Slots[pos];
+            if (slot.index == 0)
+            {
+                slot = {check, static_cast<std::uint32_t>(size() + 1)};
+                m_Offsets.push_back(m_Arena.size());
+                m_Counts.push_back(count);
+                return slot.index - 1;
+            }
+            if (slot.hash == check)
+            {
+                std::size_t      idx = slot.index - 1;
+                std::string_view seen(m_Arena.data() + m_Offsets[idx],
+                                      m_Offsets[idx + 1] - m_Offsets[idx]);
+                if (seen == word)
+                {
+                    std::uint32_t& seenCount = m_Counts[idx];
+                    seenCount += std::min(
+                            std::numeric_limits<std::uint32_t>::max() -
+                                    seenCount,
+                            count);
+                    m_Arena.resize(start);
+                    return static_cast<std::uint32_t>(idx);
+                }
+            }
+        }
+    }
+
+    void WordSet::rehash(std::size_t slots)
+    {
+        m_Slots.assign(slots, Slot{0, 0});
+        m_Shift = static_cast<unsigned int>(64 - std::countr_zero(slots));
+        std::size_t mask = slots - 1;
+        for (std::size_t idx = 0; idx < size(); ++idx)
+        {
+            std::uint64_t wordHash =
+                    hash({m_Arena.data() + m_Offsets[idx],
+                          m_Offsets[idx + 1] - m_Offsets[idx]});
+            std::size_t pos = wordHash >> m_Shift;
+            while (m_Slots[pos].index != 0)
+            {
+                pos = (pos + 1) & mask;
+            }
+            m_Slots[pos] = {static_cast<std::uint32_t>(wordHash),
+                            static_cast<std::uint32_t>(idx + 1)};
+        }
+    }
+
+    void TokenizeWords(std::string_view text, WordSet& words)
+    {
+        ForEachWord(text,
+                    [&words](std::string_view word)
+                    {
+                        words.insert(word);
+                    });
+    }
+
+    void TokenizeWordsParallel(std::string_view              text,
+                               WordSet&                      words,
+                               [[maybe_unused]] unsigned int threads)
+    {
+#    ifdef LPSM_HAS_THREADS
+        if (threads == 0)
+        {
+            threads = std::max(1U, std::thread::hardware_concurrency());
+        }
+        std::size_t chunks = std::min<std::size_t>(
+                threads, text.size() / TOKENIZER_MIN_CHUNK);
+        words.reserve(text.size() / TOKENIZER_BYTES_PER_WORD);
+        if (chunks <= 1)
+        {
+            TokenizeWords(text, words);
+            return;
+        }
+
+        // cut after the word that crosses each even split
+        std::vector<std::string_view> parts;
+        std::size_t                   begin = 0;
+        for (std::size_t i = 1; i <= chunks; ++i)
+        {
+            std::size_t end = std::max(begin, text.size() / chunks * i);
+            if (i == chunks)
+            {
+                end = text.size();
+            }
+            while (end < text.size() && IsWordChar(text[end]))
+            {
+                ++end;
+            }
+            parts.push_back(text.substr(begin, end - begin));
+            begin = end;
+        }
+
+        struct Partial
+        {
+            std::string                arena;
+            std::vector<std::uint64_t> offsets;
+            std::vector<std::uint32_t> counts;
+        };
+        std::vector<Partial>           partials(parts.size());
+        std::vector<std::future<void>> tasks;
+        tasks.reserve(parts.size());
+        for (std::size_t i = 0; i < parts.size(); ++i)
+        {
+            tasks.push_back(std::async(std::launch::async,
+                                       [&parts, &partials, i]()
+                                       {
+                                           WordSet local(partials[i].arena,
+                                                         partials[i].offsets,
+                                                         partials[i].counts);
+                                           local.reserve(
+                                                   parts[i].size() /
+                                                   TOKENIZER_BYTES_PER_WORD);
+                                           TokenizeWords(parts[i], local);
+                                       }));
+        }
+        for (auto& task : tasks)
+        {
+            task.get();
+        }
+
+        // merging in order keeps every word at its first appearance
+        for (Partial& partial : partials)
+        {
+            for (std::size_t idx = 0; idx + 1 < partial.offsets.size(); ++idx)
+            {
+                words.insert_lowercase(
+                        {partial.arena.data() + partial.offsets[idx],
+                         partial.offsets[idx + 1] - partial.offsets[idx]},
+                        partial.counts[idx]);
+            }
+            partial = Partial{};
+        }
+#    else
+        TokenizeWords(text, words);
+#    endif
+    }
+} // namespace lipsum::internal
+#endif
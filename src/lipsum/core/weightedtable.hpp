@@ -0,0 +1,229 @@
+/**
+ * @file lipsum/core/weightedtable.hpp
+ *
+ * @brief Declaration of lipsum::WeightedTable
+ *
+ * This declares lipsum::WeightedTable, which picks random indices with given
+ * weights. This file is under the BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core.hpp"
+#include "sampler.hpp"
+
+namespace lipsum
+{
+    namespace internal
+    {
+        /**
+         * @brief A column of an alias table
+         *
+         * @since 0.5.3
+         *
+         * A 32-bit draw below threshold keeps the index of the column;
+         * otherwise the pick is alias. Full columns are their own alias.
+         */
+        struct AliasColumn
+        {
+            std::uint32_t threshold; ///< Chance of keeping the index, * 2^32
+            std::uint32_t alias;     ///< Index picked otherwise
+        };
+
+        /**
+         * @brief Build an alias table.
+         *
+         * @since 0.5.3
+         *
+         * Fill columns with the alias table of weights, using Vose's method.
+         * The weights must be finite and not negative, with at least one
+         * above 0.
+         *
+         * @param weights The weights, reused as scratch space.
+         * @param count The number of weights and columns.
+         * @param columns The columns to fill.
+         * @param small Scratch space, reused between calls.
+         * @param large Scratch space, reused between calls.
+         */
+        LIPSUM_API void BuildAliasColumns(double*                     weights,
+                                          std::size_t                 count,
+                                          AliasColumn*                columns,
+                                          std::vector<std::uint32_t>& small,
+                                          std::vector<std::uint32_t>& large);
+
+        /**
+         * @brief Pick a random index from an alias table.
+         *
+         * @since 0.5.3
+         *
+         * Both choices come out of a single 32-bit draw: multiplied by the
+         * number of columns, its upper half picks the column, and its lower
+         * half, which is spread evenly over the draws picking that column,
+         * decides. This makes each chance exact to within 2^-32.
+         *
+         * @tparam G The engine type, such as std::mt19937 or lipsum::Engine.
+         * @tparam C The column type, such as AliasColumn, or any type with
+         * the same threshold and alias members.
+         *
+         * @param gen The engine to use.
+         * @param columns The alias table.
+         * @param range The number of columns. Must not be 0.
+         *
+         * @return std::uint32_t The random index.
+         */
+        template <FullRangeEngine G, typename C = AliasColumn>
+        std::uint32_t AliasPick(G& gen, const C* columns, std::uint32_t range)
+        {
+            // Lemire's method, as in UniformBelow()
+            auto product = static_cast<std::uint64_t>(Next32(gen)) * range;
+            auto low     = static_cast<std::uint32_t>(product);
+            if (low < range)
+            {
+                std::uint32_t threshold = (0U - range) % range;
+                while (low < threshold)
+                {
+                    product = static_cast<std::uint64_t>(Next32(gen)) * range;
+                    low     = static_cast<std::uint32_t>(product);
+                }
+            }
+            auto idx = static_cast<std::uint32_t>(product >> 32);
+            const C& column = columns[idx];
+            // the outcome is random, so select without a branch
+            std::uint32_t keep =
+                    0U - static_cast<std::uint32_t>(low < column.threshold);
+            return (idx & keep) | (column.alias & ~keep);
+        }
+    } // namespace internal
+
+    /**
+     * @brief Table for picking random indices by weight
+     *
+     * @since 0.5.3
+     *
+     * This class picks a random index from 0 to size() - 1, with higher
+     * weights being more likely. The weights are turned into an alias table
+     * (Vose's method) once, on construction, so that every pick takes one
+     * bounded draw and one 32-bit draw, whatever the number of weights, and
+     * never allocates. Build tables once per weight set and reuse them.
+     */
+    class LIPSUM_API WeightedTable
+    {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * @since 0.5.3
+         *
+         * Create an empty table, whose picks are always 0.
+         */
+        WeightedTable() = default;
+
+        /**
+         * @brief Constructor with a list of weights
+         *
+         * @since 0.5.3
+         *
+         * Build the alias table from weights. Negative or non-finite weights
+         * raise a warning and are treated as 0. If every weight is 0, raise a
+         * warning and pick every index with equal chances.
+         *
+         * @param weights The weights.
+         */
+        WeightedTable(std::initializer_list<double> weights);
+
+        /**
+         * @brief Constructor with a vector of weights
+         *
+         * @since 0.5.3
+         *
+         * @overload
+         *
+         * @param weights The weights.
+         */
+        explicit WeightedTable(const std::vector<double>& weights);
+
+        /**
+         * @brief Constructor with integer weights
+         *
+         * @since 0.5.3
+         *
+         * @overload
+         *
+         * Used for word counts, which need not be copied into a vector
+         * first.
+         *
+         * @param weights The first weight.
+         * @param count The number of weights.
+         */
+        WeightedTable(const std::uint32_t* weights, std::size_t count);
+
+        /**
+         * @brief Pick a random index.
+         *
+         * @since 0.5.3
+         *
+         * Draw a column of the alias table, then keep its index or take its
+         * alias, from a single 32-bit draw with internal::AliasPick(). Tables
+         * of one or no weights always return 0 without drawing.
+         *
+         * @tparam G The engine type, such as std::mt19937 or lipsum::Engine.
+         *
+         * @param gen The engine to use.
+         *
+         * @return std::size_t The random index.
+         */
+        template <internal::FullRangeEngine G>
+        [[nodiscard]] std::size_t sample(G& gen) const
+        {
+            if (m_Columns.size() <= 1)
+            {
+                return 0;
+            }
+            return internal::AliasPick(
+                    gen,
+                    m_Columns.data(),
+                    static_cast<std::uint32_t>(m_Columns.size()));
+        }
+
+        /**
+         * @brief Get the number of weights.
+         *
+         * @since 0.5.3
+         *
+         * @return std::size_t The number of weights.
+         */
+        [[nodiscard]] std::size_t size() const;
+
+        /**
+         * @brief Get the chance of picking an index.
+         *
+         * @since 0.5.3
+         *
+         * Compute the chance of picking idx from the alias table, which is
+         * its weight divided by the sum of the weights, to within 2^-32 per
+         * column.
+         *
+         * @param idx The index, from 0 to size() - 1.
+         *
+         * @return double The chance, from 0 to 1.
+         */
+        [[nodiscard]] double probability(std::size_t idx) const;
+
+    private:
+        using Column = internal::AliasColumn; ///< A column of the table
+
+        /**
+         * @brief Build the alias table.
+         *
+         * @since 0.5.3
+         *
+         * @param scaled The weights, reused as scratch space.
+         */
+        void build(std::vector<double> scaled);
+
+        std::vector<Column> m_Columns; ///< The alias table
+    };
+} // namespace lipsum
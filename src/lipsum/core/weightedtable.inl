@@ -0,0 +1,165 @@
+/**
+ * @file lipsum/core/weightedtable.inl
+ *
+ * @brief Definition of lipsum::WeightedTable
+ *
+ * This defines the non-template functions of lipsum::WeightedTable. This file
+ * is under the BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "internal.hpp"
+#include "weightedtable.hpp"
+
+namespace lipsum
+{
+    WeightedTable::WeightedTable(std::initializer_list<double> weights)
+    {
+        build(std::vector<double>(weights));
+    }
+
+    WeightedTable::WeightedTable(const std::vector<double>& weights)
+    {
+        build(weights);
+    }
+
+    WeightedTable::WeightedTable(const std::uint32_t* weights,
+                                 std::size_t          count)
+    {
+        build(std::vector<double>(weights, weights + count));
+    }
+
+    std::size_t WeightedTable::size() const
+    {
+        return m_Columns.size();
+    }
+
+    double WeightedTable::probability(std::size_t idx) const
+    {
+        constexpr double TWO_POW_32 = 4294967296.0;
+
+        if (m_Columns.empty())
+        {
+            return 0.0;
+        }
+        double chance = 0.0;
+        for (std::size_t i = 0; i < m_Columns.size(); ++i)
+        {
+            double keep = static_cast<double>(m_Columns[i].threshold) /
+                          TWO_POW_32;
+            if (i == idx)
+            {
+                chance += keep;
+            }
+            if (m_Columns[i].alias == idx)
+            {
+                chance += 1.0 - keep;
+            }
+        }
+        return chance / static_cast<double>(m_Columns.size());
+    }
+
+    void WeightedTable::build(std::vector<double> scaled)
+    {
+        std::size_t count = scaled.size();
+        m_Columns.clear();
+        if (count == 0)
+        {
+            return;
+        }
+
+        // scale by the largest weight first so that the sum cannot overflow
+        double largest   = 0.0;
+        bool   isInvalid = false;
+        for (double& weight : scaled)
+        {
+            if (!std::isfinite(weight) || weight < 0.0)
+            {
+                isInvalid = true;
+                weight    = 0.0;
+            }
+            largest = std::max(largest, weight);
+        }
+        if (isInvalid)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::WeightedTable::WeightedTable(): negative "
+                              "or non-finite weight, treating as 0");
+        }
+        if (largest == 0.0)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::WeightedTable::WeightedTable(): all "
+                              "weights are 0, using equal weights");
+            std::fill(scaled.begin(), scaled.end(), 1.0);
+            largest = 1.0;
+        }
+        for (double& weight : scaled)
+        {
+            weight /= largest;
+        }
+        std::vector<std::uint32_t> small;
+        std::vector<std::uint32_t> large;
+        m_Columns.assign(count, Column{0, 0});
+        internal::BuildAliasColumns(
+                scaled.data(), count, m_Columns.data(), small, large);
+    }
+
+    namespace internal
+    {
+        void BuildAliasColumns(double*                     weights,
+                               std::size_t                 count,
+                               AliasColumn*                columns,
+                               std::vector<std::uint32_t>& small,
+                               std::vector<std::uint32_t>& large)
+        {
+            constexpr double TWO_POW_32 = 4294967296.0;
+
+            double total = 0.0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                total += weights[i];
+            }
+
+            // Vose's alias method: pair every column under the average with
+            // one over it, which fills the rest of the smaller column
+            small.clear();
+            large.clear();
+            double factor = static_cast<double>(count) / total;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                weights[i] *= factor;
+                (weights[i] < 1.0 ? small : large)
+                        .push_back(static_cast<std::uint32_t>(i));
+            }
+            while (!small.empty() && !large.empty())
+            {
+                std::uint32_t less = small.back();
+                std::uint32_t more = large.back();
+                small.pop_back();
+                columns[less] = {
+                        static_cast<std::uint32_t>(weights[less] * TWO_POW_32),
+                        more};
+                weights[more] = (weights[more] + weights[less]) - 1.0;
+                if (weights[more] < 1.0)
+                {
+                    large.pop_back();
+                    small.push_back(more);
+                }
+            }
+            // whatever is left is full, up to rounding
+            for (std::uint32_t idx : small)
+            {
+                columns[idx] = {0, idx};
+            }
+            for (std::uint32_t idx : large)
+            {
+                columns[idx] = {0, idx};
+            }
+        }
+    } // namespace internal
+} // namespace lipsum
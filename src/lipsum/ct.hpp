@@ -0,0 +1,407 @@
+/**
+ * @file lipsum/ct.hpp
+ *
+ * @brief Compile-time generation for lipsum-cpp
+ *
+ * This declares and defines namespace lipsum::ct, which generates words,
+ * sentences and paragraphs in constant expressions. The functions are
+ * constexpr templates, so they are defined here. This file is under the BSD
+ * Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core/argvec2.hpp"
+#include "core/core.hpp"
+#include "core/engine.hpp"
+#include "core/internal.hpp"
+#include "core/sample.inl"
+#include "core/sampler.hpp"
+
+namespace lipsum
+{
+    namespace ct
+    {
+        /**
+         * @brief Settings used by the lipsum::ct functions
+         *
+         * @since 0.5.3
+         *
+         * The settings of lipsum::GeneratorSettings that words, sentences and
+         * paragraphs use, with the same defaults. Passed as a template
+         * argument, so it must be constant.
+         */
+        struct Settings
+        {
+            ArgVec2 word{4, 9}; ///< Words in a sentence fragment
+            ArgVec2 frag{1, 3}; ///< Fragments in a sentence
+            ArgVec2 sent{5, 8}; ///< Sentences in a paragraph
+        };
+    } // namespace ct
+
+    namespace internal
+    {
+        /**
+         * @brief Text built in a constant expression
+         *
+         * @since 0.5.3
+         *
+         * Characters past N are counted but dropped, so that generating into
+         * a CtBuffer<0> measures the text, and generating again with the same
+         * seed into a buffer of that size writes it.
+         *
+         * @tparam N The number of characters kept.
+         */
+        template <std::size_t N> struct CtBuffer
+        {
+            /**
+             * @brief Append a character.
+             *
+             * @since 0.5.3
+             *
+             * @param chr The character.
+             */
+            constexpr void push_back(char chr)
+            {
+                if (size < N)
+                {
+                    data[size] = chr;
+                }
+                ++size;
+            }
+
+            /**
+             * @brief Append a string.
+             *
+             * @since 0.5.3
+             *
+             * @param str The string.
+             */
+            constexpr void append(std::string_view str)
+            {
+                for (char chr : str)
+                {
+                    push_back(chr);
+                }
+            }
+
+            /**
+             * @brief Capitalize a character, if it was kept.
+             *
+             * @since 0.5.3
+             *
+             * Only ASCII letters are changed, as std::toupper() is not
+             * constexpr.
+             *
+             * @param idx The index of the character.
+             */
+            constexpr void capitalize(std::size_t idx)
+            {
+                if (idx < N && data[idx] >= 'a' && data[idx] <= 'z')
+                {
+                    data[idx] = static_cast<char>(data[idx] - 'a' + 'A');
+                }
+            }
+
+            std::array<char, N> data{};   ///< The characters kept
+            std::size_t         size = 0; ///< The number of characters
+        };
+
+        /**
+         * @brief Append words separated by spaces in a constant expression.
+         *
+         * @since 0.5.3
+         *
+         * Words are picked uniformly from the default lorem-ipsum source.
+         *
+         * @tparam B The buffer type.
+         *
+         * @param out The buffer to append to.
+         * @param gen The engine to use.
+         * @param num The number of words.
+         */
+        template <typename B>
+        constexpr void CtWordsInto(B& out, Pcg32& gen, int num)
+        {
+            for (int i = 0; i < num; ++i)
+            {
+                if (i != 0)
+                {
+                    out.push_back(' ');
+                }
+                out.append(LIPSUM_VEC.at(UniformBelow(
+                        gen,
+                        static_cast<std::uint32_t>(LIPSUM_VEC.size()))));
+            }
+        }
+
+        /**
+         * @brief Append a single sentence in a constant expression.
+         *
+         * @since 0.5.3
+         *
+         * Fragments are joined with commas and the sentence ends with a
+         * period, as in minimum builds of lipsum::Generator.
+         *
+         * @tparam B The buffer type.
+         *
+         * @param out The buffer to append to.
+         * @param gen The engine to use.
+         * @param settings The ranges used.
+         */
+        template <typename B>
+        constexpr void
+        CtSentenceInto(B& out, Pcg32& gen, const ct::Settings& settings)
+        {
+            std::size_t start = out.size;
+            int         frags = UniformInt(gen,
+                                   settings.frag.min,
+                                   settings.frag.max);
+            for (int i = 0; i < frags; ++i)
+            {
+                CtWordsInto(out,
+                            gen,
+                            UniformInt(gen,
+                                       settings.word.min,
+                                       settings.word.max));
+                if (i != frags - 1)
+                {
+                    out.append(", ");
+                }
+            }
+            out.push_back('.');
+            out.capitalize(start);
+        }
+
+        /**
+         * @brief Append sentences, each followed by a space, in a constant
+         * expression.
+         *
+         * @since 0.5.3
+         *
+         * @tparam B The buffer type.
+         *
+         * @param out The buffer to append to.
+         * @param gen The engine to use.
+         * @param num The number of sentences.
+         * @param useLipsum Whether the first sentence is "Lorem ipsum dolor
+         * sit amet...".
+         * @param settings The ranges used.
+         */
+        template <typename B>
+        constexpr void CtSentencesInto(B&                  out,
+                                       Pcg32&              gen,
+                                       int                 num,
+                                       bool                useLipsum,
+                                       const ct::Settings& settings)
+        {
+            for (int i = 0; i < num; ++i)
+            {
+                if (i == 0 && useLipsum)
+                {
+                    out.append(LIPSUM_DEFAULT_SENTENCE);
+                }
+                else
+                {
+                    CtSentenceInto(out, gen, settings);
+                }
+                out.push_back(' ');
+            }
+        }
+
+        /**
+         * @brief Append paragraphs in a constant expression.
+         *
+         * @since 0.5.3
+         *
+         * Each paragraph is a tab, sentences separated by spaces and a
+         * newline.
+         *
+         * @tparam B The buffer type.
+         *
+         * @param out The buffer to append to.
+         * @param gen The engine to use.
+         * @param num The number of paragraphs.
+         * @param useLipsum Whether the first paragraph starts with "Lorem
+         * ipsum dolor sit amet...".
+         * @param settings The ranges used.
+         */
+        template <typename B>
+        constexpr void CtParagraphsInto(B&                  out,
+                                        Pcg32&              gen,
+                                        int                 num,
+                                        bool                useLipsum,
+                                        const ct::Settings& settings)
+        {
+            for (int i = 0; i < num; ++i)
+            {
+                out.push_back('\t');
+                int sents = UniformInt(gen,
+                                       settings.sent.min,
+                                       settings.sent.max);
+                for (int j = 0; j < sents; ++j)
+                {
+                    if (j != 0)
+                    {
+                        out.push_back(' ');
+                    }
+                    if (j == 0 && i == 0 && useLipsum)
+                    {
+                        out.append(LIPSUM_DEFAULT_SENTENCE);
+                    }
+                    else
+                    {
+                        CtSentenceInto(out, gen, settings);
+                    }
+                }
+                out.push_back('\n');
+            }
+        }
+
+        /**
+         * @brief Generate text into an array in a constant expression.
+         *
+         * @since 0.5.3
+         *
+         * Generate the text once to measure it and once more, from the same
+         * seed, to write it.
+         *
+         * @tparam Seed The seed of the engine.
+         * @tparam Fill A constexpr function appending the text to a CtBuffer
+         * from a lipsum::Pcg32.
+         *
+         * @return std::array<char, N> The text, where N is its size.
+         */
+        template <std::uint64_t Seed, auto Fill> constexpr auto CtGenerate()
+        {
+            constexpr std::size_t SIZE = []()
+            {
+                CtBuffer<0> measure;
+                Pcg32       gen(Seed);
+                Fill(measure, gen);
+                return measure.size;
+            }();
+
+            CtBuffer<SIZE> out;
+            Pcg32          gen(Seed);
+            Fill(out, gen);
+            return out.data;
+        }
+    } // namespace internal
+
+    namespace ct
+    {
+        /**
+         * @brief Generate words at compile time.
+         *
+         * @since 0.5.3
+         *
+         * Generate num words from the default lorem-ipsum source, separated by
+         * spaces, as lipsum::Generator::word() does. The text only depends on
+         * the template arguments and is the same on every compiler, but is not
+         * the text lipsum::Generator generates from the same seed. Large texts
+         * may need a higher constexpr evaluation limit from the compiler.
+         *
+         * @tparam Seed The seed.
+         * @tparam Num The number of words. By default 1.
+         *
+         * @return std::array<char, N> The words, without a null terminator,
+         * where N is their size.
+         */
+        template <std::uint64_t Seed, int Num = 1> constexpr auto word()
+        {
+            static_assert(Num >= 0, "lpsm::ct::word(): expected Num >= 0");
+            return internal::CtGenerate<Seed,
+                                        [](auto& out, Pcg32& gen)
+                                        {
+                                            internal::CtWordsInto(out,
+                                                                  gen,
+                                                                  Num);
+                                        }>();
+        }
+
+        /**
+         * @brief Generate sentences at compile time.
+         *
+         * @since 0.5.3
+         *
+         * Generate sentences, each followed by a space, as
+         * lipsum::Generator::sentence() does in minimum builds: fragments are
+         * joined with commas and sentences end with periods.
+         *
+         * @tparam Seed The seed.
+         * @tparam Num The number of sentences. By default 1.
+         * @tparam UseLipsum Whether the first sentence is "Lorem ipsum dolor
+         * sit amet...". By default true.
+         * @tparam S The ranges used. By default those of
+         * lipsum::GeneratorSettings.
+         *
+         * @return std::array<char, N> The sentences, without a null
+         * terminator, where N is their size.
+         *
+         * @sa lipsum::ct::word()
+         */
+        template <std::uint64_t Seed,
+                  int           Num       = 1,
+                  bool          UseLipsum = true,
+                  Settings      S         = Settings{}>
+        constexpr auto sentence()
+        {
+            static_assert(Num >= 0, "lpsm::ct::sentence(): expected Num >= 0");
+            return internal::CtGenerate<Seed,
+                                        [](auto& out, Pcg32& gen)
+                                        {
+                                            internal::CtSentencesInto(
+                                                    out,
+                                                    gen,
+                                                    Num,
+                                                    UseLipsum,
+                                                    S);
+                                        }>();
+        }
+
+        /**
+         * @brief Generate paragraphs at compile time.
+         *
+         * @since 0.5.3
+         *
+         * Generate paragraphs, each a tab, sentences separated by spaces and
+         * a newline, as lipsum::Generator::paragraph() does in minimum
+         * builds.
+         *
+         * @tparam Seed The seed.
+         * @tparam Num The number of paragraphs. By default 1.
+         * @tparam UseLipsum Whether the first paragraph starts with "Lorem
+         * ipsum dolor sit amet...". By default true.
+         * @tparam S The ranges used. By default those of
+         * lipsum::GeneratorSettings.
+         *
+         * @return std::array<char, N> The paragraphs, without a null
+         * terminator, where N is their size.
+         *
+         * @sa lipsum::ct::word()
+         */
+        template <std::uint64_t Seed,
+                  int           Num       = 1,
+                  bool          UseLipsum = true,
+                  Settings      S         = Settings{}>
+        constexpr auto paragraph()
+        {
+            static_assert(Num >= 0,
+                          "lpsm::ct::paragraph(): expected Num >= 0");
+            return internal::CtGenerate<Seed,
+                                        [](auto& out, Pcg32& gen)
+                                        {
+                                            internal::CtParagraphsInto(
+                                                    out,
+                                                    gen,
+                                                    Num,
+                                                    UseLipsum,
+                                                    S);
+                                        }>();
+        }
+    } // namespace ct
+} // namespace lipsum
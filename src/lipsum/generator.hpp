@@ -15,8 +15,15 @@
 
 #include "core/argvec2.hpp"
 #include "core/core.hpp"
+#include "core/format.hpp"
+#include "core/markovsource.hpp"
+#include "core/sampler.hpp"
 #include "core/source.hpp"
+#include "core/sourceregistry.hpp"
+#include "core/weightedtable.hpp"
+#include "chunkstream.hpp"
 #include "generatorsettings.hpp"
+#include "sink.hpp"
 
 namespace lipsum
 {
@@ -81,6 +88,30 @@ namespace lipsum
         JavaScript
     };
 
+    /**
+     * @brief Kinds of text used by lipsum::Generator::predicted_size()
+     *
+     * @since 0.5.3
+     *
+     * Each kind stands for the lipsum::Generator function of the same name,
+     * such as word() or fmt_text().
+     */
+    enum class OutputType : int
+    {
+        Word = 0,
+        Sentence,
+        Paragraph,
+        Text,
+        FmtParagraph,
+        FmtText,
+        Xml,
+        Json,
+        Csv
+    };
+
+    class ParallelGenerator;
+    class TextView;
+
     /**
      * @brief Main class of lipsum-cpp
      *
@@ -125,6 +156,24 @@ namespace lipsum
          */
         Generator(const std::string& path, int seed);
 
+        /**
+         * @brief Constructor for Generator
+         *
+         * @since 0.5.3
+         *
+         * Use the specified shared source and the specified seed. Generators
+         * sharing a source do not copy it, so many of them, for example one
+         * per thread, are cheap to construct and small in memory.
+         *
+         * @param source The source, such as one from
+         * lipsum::SourceRegistry::get(). If nullptr, use the default
+         * lorem-ipsum source.
+         * @param seed The seed specified.
+         *
+         * @sa lipsum::SourceRegistry
+         */
+        Generator(std::shared_ptr<const Source> source, int seed);
+
         /**
          * Destructor for Generator
          *
@@ -141,7 +190,9 @@ namespace lipsum
          *
          * Load the specified lorem ipsum source into m_Source. If path is
          * invalid, it will print a warning and default to the standard
-         * lorem-ipsum source.
+         * lorem-ipsum source. The source is loaded for this generator
+         * alone; to share one between generators, pass a source from
+         * lipsum::SourceRegistry::get() instead.
          *
          * @param path The filepath or name of the lorem ipsum source.
          *
@@ -156,7 +207,10 @@ namespace lipsum
          *
          * Reload the specified lorem ipsum source into m_Source. If path
          * is invalid, it will print a warning and default to the standard
-         * lorem-ipsum source.
+         * lorem-ipsum source. The file is read again on every call, so
+         * changes to it are picked up; to share one source between
+         * generators, pass a source from lipsum::SourceRegistry::get()
+         * instead.
          *
          * @param path The filepath or name of the lorem ipsum source.
          *
@@ -164,6 +218,29 @@ namespace lipsum
          */
         void load_source(const std::string& path);
 
+        /**
+         * @brief Switch to a shared source
+         *
+         * @since 0.5.3
+         *
+         * @overload
+         *
+         * @param source The source, such as one from
+         * lipsum::SourceRegistry::get(). If nullptr, use the default
+         * lorem-ipsum source.
+         */
+        void load_source(std::shared_ptr<const Source> source);
+
+        /**
+         * @brief Get the source
+         *
+         * @since 0.5.3
+         *
+         * @return const std::shared_ptr<const Source>& The source used for
+         * generation, never nullptr.
+         */
+        [[nodiscard]] const std::shared_ptr<const Source>& source() const;
+
         /**
          * @brief Reload a seed
          *
@@ -175,6 +252,34 @@ namespace lipsum
          */
         void load_seed(int seed);
 
+        /**
+         * @brief Switch to an independent stream
+         *
+         * @since 0.5.3
+         *
+         * Reseed m_Gen with both seed and stream (lipsum::Engine::seed()), so
+         * that generators given the same seed and different streams produce
+         * unrelated text, and the same seed and stream always produce the
+         * same text. Used to split one seed between many generators.
+         *
+         * @param seed The root seed.
+         * @param stream The index of the stream.
+         */
+        void load_stream(std::uint64_t seed, std::uint64_t stream);
+
+        /**
+         * @brief Switch the random engine
+         *
+         * @since 0.5.3
+         *
+         * Replace the engine of m_Gen with the one specified, seeded with the
+         * last seed loaded. EngineType::MT19937 is the default; the other
+         * engines are faster but give different text for the same seed.
+         *
+         * @param type The engine specified.
+         */
+        void load_engine(EngineType type);
+
         /**
          * @brief Change a setting
          *
@@ -204,6 +309,84 @@ namespace lipsum
         void
         change_setting(const std::string& setting, int minValue, int maxValue);
 
+#ifndef LIPSUM_MIN_BUILD
+        /**
+         * @brief Change a weighted setting
+         *
+         * @since 0.5.3
+         *
+         * Replace the weights of a weighted choice. Valid setting names
+         * include "separator", "endMark", "fmtSentence", and "tld". Not
+         * available in minimum builds.
+         *
+         * @param setting The name of the setting.
+         * @param value The new weights for the setting.
+         *
+         * @sa lipsum::GeneratorSettings::change_weights
+         */
+        void change_weights(const std::string&   setting,
+                            const WeightedTable& value);
+
+        /**
+         * @brief Pick words by how often they appear
+         *
+         * @since 0.5.3
+         *
+         * If enabled, pick each word with a chance proportional to the number
+         * of times it appears in the source, instead of picking every word
+         * with equal chances. Off by default. Not available in minimum
+         * builds.
+         *
+         * @param enabled Whether to follow the word frequencies of the source.
+         *
+         * @sa lipsum::Source::weighted_word_view
+         */
+        void use_word_frequencies(bool enabled);
+
+        /**
+         * @brief Generate words with a Markov chain
+         *
+         * @since 0.5.3
+         *
+         * If model is given, pick every word that would come from the source
+         * with model instead, following the word before it. Each sentence
+         * starts a new chain, so sentences begin like the sentences of the
+         * corpus the model was trained on. Empty models are ignored with a
+         * warning. Not available in minimum builds.
+         *
+         * @param model The model, shared with other generators. If nullptr,
+         * go back to picking words from the source.
+         *
+         * @sa lipsum::MarkovSource
+         */
+        void load_markov(std::shared_ptr<const MarkovSource> model);
+
+        /**
+         * @brief Get the Markov model
+         *
+         * @since 0.5.3
+         *
+         * @return const std::shared_ptr<const MarkovSource>& The model used
+         * for generation, or nullptr if words come from the source.
+         */
+        [[nodiscard]] const std::shared_ptr<const MarkovSource>&
+        markov() const;
+#endif
+
+        /**
+         * @brief Choose a random index based off weights
+         *
+         * @since 0.5.3
+         *
+         * Pick a random index of table with m_Gen, so that picks from
+         * user-defined tables follow the seed of the generator.
+         *
+         * @param table The weights.
+         *
+         * @return std::size_t The random index.
+         */
+        std::size_t weighted_random_idx(const WeightedTable& table);
+
         /*
          * CORE
          */
@@ -222,6 +405,36 @@ namespace lipsum
          */
         std::string word(int num = 1);
 
+        /**
+         * @brief Append words to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as word(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         * @param num The number of words. By default 1.
+         *
+         * @sa lipsum::Generator::word()
+         */
+        void word_into(std::string& out, int num = 1);
+
+        /**
+         * @brief Write words to a sink.
+         *
+         * @since 0.5.3
+         *
+         * Same as word(), but writes to sink one word at a time, so the output
+         * never has to fit in memory.
+         *
+         * @param sink The sink to write to.
+         * @param num The number of words. By default 1.
+         *
+         * @sa lipsum::Generator::word()
+         */
+        void word_to(Sink& sink, int num = 1);
+
         /**
          * @brief Generate a sentence fragment.
          *
@@ -234,6 +447,20 @@ namespace lipsum
          */
         std::string fragment();
 
+        /**
+         * @brief Append a sentence fragment to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as fragment(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         *
+         * @sa lipsum::Generator::fragment()
+         */
+        void fragment_into(std::string& out);
+
         /**
          * @brief Generate sentences.
          *
@@ -254,6 +481,41 @@ namespace lipsum
          */
         std::string sentence(int num = 1, bool useLipsum = true);
 
+        /**
+         * @brief Append sentences to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as sentence(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         * @param num The number of sentences. By default 1.
+         * @param useLipsum Whether "Lorem ipsum..." should start the
+         * sentence(s). By default true.
+         *
+         * @sa lipsum::Generator::sentence()
+         */
+        void
+        sentence_into(std::string& out, int num = 1, bool useLipsum = true);
+
+        /**
+         * @brief Write sentences to a sink.
+         *
+         * @since 0.5.3
+         *
+         * Same as sentence(), but writes to sink one sentence at a time, so the
+         * output never has to fit in memory.
+         *
+         * @param sink The sink to write to.
+         * @param num The number of sentences. By default 1.
+         * @param useLipsum Whether "Lorem ipsum..." should start the
+         * sentence(s). By default true.
+         *
+         * @sa lipsum::Generator::sentence()
+         */
+        void sentence_to(Sink& sink, int num = 1, bool useLipsum = true);
+
         /**
          * @brief Generate paragraphs.
          *
@@ -272,6 +534,41 @@ namespace lipsum
          */
         std::string paragraph(int num = 1, bool useLipsum = true);
 
+        /**
+         * @brief Append paragraphs to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as paragraph(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         * @param num The number of paragraphs. By default 1.
+         * @param useLipsum Whether "Lorem ipsum..." should start the
+         * paragraph(s). By default true.
+         *
+         * @sa lipsum::Generator::paragraph()
+         */
+        void
+        paragraph_into(std::string& out, int num = 1, bool useLipsum = true);
+
+        /**
+         * @brief Write paragraphs to a sink.
+         *
+         * @since 0.5.3
+         *
+         * Same as paragraph(), but writes to sink one paragraph at a time, so
+         * the output never has to fit in memory.
+         *
+         * @param sink The sink to write to.
+         * @param num The number of paragraphs. By default 1.
+         * @param useLipsum Whether "Lorem ipsum..." should start the
+         * paragraph(s). By default true.
+         *
+         * @sa lipsum::Generator::paragraph()
+         */
+        void paragraph_to(Sink& sink, int num = 1, bool useLipsum = true);
+
         /**
          * @brief Generate a random number of random paragraphs.
          *
@@ -287,6 +584,89 @@ namespace lipsum
          */
         std::string text(bool useLipsum = true);
 
+        /**
+         * @brief Append a random number of random paragraphs to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as text(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         * @param useLipsum Whether "Lorem ipsum..." should start the
+         * paragraph(s). By default true.
+         *
+         * @sa lipsum::Generator::text()
+         */
+        void text_into(std::string& out, bool useLipsum = true);
+
+        /**
+         * @brief Write a random number of random paragraphs to a sink.
+         *
+         * @since 0.5.3
+         *
+         * Same as text(), but writes to sink one paragraph at a time, so the
+         * output never has to fit in memory.
+         *
+         * @param sink The sink to write to.
+         * @param useLipsum Whether "Lorem ipsum..." should start the
+         * paragraph(s). By default true.
+         *
+         * @sa lipsum::Generator::text()
+         */
+        void text_to(Sink& sink, bool useLipsum = true);
+
+#ifndef LIPSUM_MIN_BUILD
+        /**
+         * @brief Get a lazy range of words.
+         *
+         * @since 0.5.3
+         *
+         * Each word is generated when it is first read, so only the words
+         * read are paid for. Reading n words draws the same words as
+         * word(n). The generator must outlive the range.
+         *
+         * @return TextView An endless std::ranges input view of words.
+         *
+         * @sa lipsum::TextView
+         */
+        [[nodiscard]] TextView words();
+
+        /**
+         * @brief Get a lazy range of sentences.
+         *
+         * @since 0.5.3
+         *
+         * Reading n sentences draws the same sentences as sentence(n),
+         * without the space after each. The generator must outlive the range.
+         *
+         * @param useLipsum Whether the first sentence is "Lorem ipsum dolor
+         * sit amet...". By default true.
+         *
+         * @return TextView An endless std::ranges input view of sentences.
+         *
+         * @sa lipsum::TextView
+         */
+        [[nodiscard]] TextView sentences(bool useLipsum = true);
+
+        /**
+         * @brief Get a lazy range of paragraphs.
+         *
+         * @since 0.5.3
+         *
+         * Reading n paragraphs draws the same paragraphs as paragraph(n).
+         * The generator must outlive the range.
+         *
+         * @param useLipsum Whether the first paragraph starts with "Lorem
+         * ipsum dolor sit amet...". By default true.
+         *
+         * @return TextView An endless std::ranges input view of paragraphs.
+         *
+         * @sa lipsum::TextView
+         */
+        [[nodiscard]] TextView paragraphs(bool useLipsum = true);
+#endif
+
         /*
          * MISC
          */
@@ -311,6 +691,28 @@ namespace lipsum
         std::string
         scramble(int length = 16, char minChar = ' ', char maxChar = '~');
 
+        /**
+         * @brief Append a random character scramble to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as scramble(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         * @param length The number of characters. By default 16.
+         * @param minChar The lowest-valued ASCII character that can appear. By
+         * default a space.
+         * @param maxChar The highest-valued ASCII character than can appear. By
+         * default a tilde.
+         *
+         * @sa lipsum::Generator::scramble()
+         */
+        void scramble_into(std::string& out,
+                           int          length  = 16,
+                           char         minChar = ' ',
+                           char         maxChar = '~');
+
         /**
          * @brief Generate a URL.
          *
@@ -326,6 +728,20 @@ namespace lipsum
          */
         std::string url();
 
+        /**
+         * @brief Append a URL to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as url(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         *
+         * @sa lipsum::Generator::url()
+         */
+        void url_into(std::string& out);
+
         /**
          * @brief Generate a plain URL.
          *
@@ -338,6 +754,20 @@ namespace lipsum
          */
         std::string plain_url();
 
+        /**
+         * @brief Append a plain URL to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as plain_url(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         *
+         * @sa lipsum::Generator::plain_url()
+         */
+        void plain_url_into(std::string& out);
+
         /**
          * @brief Generate an email.
          *
@@ -350,6 +780,20 @@ namespace lipsum
          */
         std::string email();
 
+        /**
+         * @brief Append an email to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as email(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         *
+         * @sa lipsum::Generator::email()
+         */
+        void email_into(std::string& out);
+
         /**
          * @brief Generate a slug.
          *
@@ -364,6 +808,21 @@ namespace lipsum
          */
         std::string slug(char separator = '-');
 
+        /**
+         * @brief Append a slug to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as slug(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         * @param separator The separator character. By default a hyphen.
+         *
+         * @sa lipsum::Generator::slug()
+         */
+        void slug_into(std::string& out, char separator = '-');
+
         /**
          * @brief Generate a case slug.
          *
@@ -378,6 +837,22 @@ namespace lipsum
          */
         std::string case_slug(CaseSlugCase case_ = CaseSlugCase::CamelCase);
 
+        /**
+         * @brief Append a case slug to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as case_slug(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         * @param case_ The case. By default camel case.
+         *
+         * @sa lipsum::Generator::case_slug()
+         */
+        void case_slug_into(std::string& out,
+                            CaseSlugCase case_ = CaseSlugCase::CamelCase);
+
         /**
          * @brief Generate a code block.
          *
@@ -392,6 +867,21 @@ namespace lipsum
          */
         std::string code(CodeLanguage lang = CodeLanguage::Cpp);
 
+        /**
+         * @brief Append a code block to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as code(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         * @param lang The language chosen. By default C++.
+         *
+         * @sa lipsum::Generator::code()
+         */
+        void code_into(std::string& out, CodeLanguage lang = CodeLanguage::Cpp);
+
         /**
          * @brief Generate an IP address.
          *
@@ -411,6 +901,24 @@ namespace lipsum
          */
         std::string ip_addr(bool useIpv6 = false, bool usePort = false);
 
+        /**
+         * @brief Append an IP address to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as ip_addr(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         * @param useIpv6 Whether to use IPv6. By default false (IPv4).
+         * @param usePort Whether to add a port. By default false.
+         *
+         * @sa lipsum::Generator::ip_addr()
+         */
+        void ip_addr_into(std::string& out,
+                          bool         useIpv6 = false,
+                          bool         usePort = false);
+
         /**
          * @brief Generate a phone number.
          *
@@ -422,6 +930,20 @@ namespace lipsum
          */
         std::string phone_number();
 
+        /**
+         * @brief Append a phone number to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as phone_number(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         *
+         * @sa lipsum::Generator::phone_number()
+         */
+        void phone_number_into(std::string& out);
+
         /*
          * FORMATS
          */
@@ -446,6 +968,50 @@ namespace lipsum
         std::string
         fmt_paragraph(int num = 1, bool useLipsum = true, bool useHtml = false);
 
+        /**
+         * @brief Append Markdown or HTML paragraphs to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as fmt_paragraph(), but appends to out instead of returning a
+         * new string.
+         *
+         * @param out The buffer to append to.
+         * @param num The number of paragraphs. By default 1.
+         * @param useLipsum Whether "Lorem ipsum..." should start the paragraph.
+         * By default true.
+         * @param useHtml Whether HTML should be outputted instead of Markdown.
+         * By default false.
+         *
+         * @sa lipsum::Generator::fmt_paragraph()
+         */
+        void fmt_paragraph_into(std::string& out,
+                                int          num       = 1,
+                                bool         useLipsum = true,
+                                bool         useHtml   = false);
+
+        /**
+         * @brief Write Markdown or HTML paragraphs to a sink.
+         *
+         * @since 0.5.3
+         *
+         * Same as fmt_paragraph(), but writes to sink one paragraph at a time,
+         * so the output never has to fit in memory.
+         *
+         * @param sink The sink to write to.
+         * @param num The number of paragraphs. By default 1.
+         * @param useLipsum Whether "Lorem ipsum..." should start the paragraph.
+         * By default true.
+         * @param useHtml Whether HTML should be outputted instead of Markdown.
+         * By default false.
+         *
+         * @sa lipsum::Generator::fmt_paragraph()
+         */
+        void fmt_paragraph_to(Sink& sink,
+                              int   num       = 1,
+                              bool  useLipsum = true,
+                              bool  useHtml   = false);
+
         /**
          * @brief Generate a Markdown or HTML document.
          *
@@ -473,6 +1039,72 @@ namespace lipsum
          */
         std::string fmt_text(int numElements = 15, bool useHtml = false);
 
+        /**
+         * @brief Append a Markdown or HTML document to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as fmt_text(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         * @param numElements The number of elements (paragraph, list, heading)
+         * in the document. By default 15.
+         * @param useHtml Whether HTML should be outputted instead of Markdown.
+         * By default false.
+         *
+         * @sa lipsum::Generator::fmt_text()
+         */
+        void fmt_text_into(std::string& out,
+                           int          numElements = 15,
+                           bool         useHtml     = false);
+
+        /**
+         * @brief Write a Markdown or HTML document to a sink.
+         *
+         * @since 0.5.3
+         *
+         * Same as fmt_text(), but writes to sink one element at a time, so the
+         * output never has to fit in memory.
+         *
+         * @param sink The sink to write to.
+         * @param numElements The number of elements (paragraph, list, heading)
+         * in the document. By default 15.
+         * @param useHtml Whether HTML should be outputted instead of Markdown.
+         * By default false.
+         *
+         * @sa lipsum::Generator::fmt_text()
+         */
+        void
+        fmt_text_to(Sink& sink, int numElements = 15, bool useHtml = false);
+
+#ifndef LIPSUM_MIN_BUILD
+        /**
+         * @brief Stream a Markdown or HTML document in chunks.
+         *
+         * @since 0.5.3
+         *
+         * Same as fmt_text(), but generated by a coroutine that pauses each
+         * time chunkSize bytes are ready, so the consumer pulls the document
+         * a chunk at a time.
+         *
+         * @param numElements The number of elements (paragraph, list, heading)
+         * in the document. By default 15.
+         * @param useHtml Whether HTML should be outputted instead of Markdown.
+         * By default false.
+         * @param chunkSize The size a chunk reaches before it is yielded. By
+         * default Sink::DEFAULT_CAPACITY.
+         *
+         * @return ChunkStream The chunks of the document.
+         *
+         * @sa lipsum::Generator::fmt_text()
+         */
+        [[nodiscard]] ChunkStream
+        fmt_text_stream(int         numElements = 15,
+                        bool        useHtml     = false,
+                        std::size_t chunkSize   = Sink::DEFAULT_CAPACITY);
+#endif
+
         /**
          * @brief Generate a Markdown or HTML header.
          *
@@ -494,6 +1126,24 @@ namespace lipsum
          */
         std::string fmt_header(int level = 1, bool useHtml = false);
 
+        /**
+         * @brief Append a Markdown or HTML header to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as fmt_header(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         * @param level The level of the heading. By default 1.
+         * @param useHtml Whether HTML should be outputted instead of Markdown.
+         * By default false.
+         *
+         * @sa lipsum::Generator::fmt_header()
+         */
+        void
+        fmt_header_into(std::string& out, int level = 1, bool useHtml = false);
+
         /**
          * @brief Generate an emphasized Markdown or HTML sentence.
          *
@@ -515,6 +1165,26 @@ namespace lipsum
          */
         std::string fmt_emphasis(bool isBold = true, bool useHtml = false);
 
+        /**
+         * @brief Append an emphasized Markdown or HTML sentence to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as fmt_emphasis(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         * @param isBold Whether the sentence is bold or italic. By default
+         * true. (bold)
+         * @param useHtml Whether HTML should be outputted instead of Markdown.
+         * By default false.
+         *
+         * @sa lipsum::Generator::fmt_emphasis()
+         */
+        void fmt_emphasis_into(std::string& out,
+                               bool         isBold  = true,
+                               bool         useHtml = false);
+
         /**
          * @brief Generate a Markdown or HTML link.
          *
@@ -537,6 +1207,22 @@ namespace lipsum
          */
         std::string fmt_link(bool useHtml = false);
 
+        /**
+         * @brief Append a Markdown or HTML link to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as fmt_link(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         * @param useHtml Whether HTML should be outputted instead of Markdown.
+         * By default false.
+         *
+         * @sa lipsum::Generator::fmt_link()
+         */
+        void fmt_link_into(std::string& out, bool useHtml = false);
+
         /**
          * @brief Generate a Markdown or HTML list.
          *
@@ -561,6 +1247,25 @@ namespace lipsum
          */
         std::string fmt_list(bool ordered = false, bool useHtml = false);
 
+        /**
+         * @brief Append a Markdown or HTML list to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as fmt_list(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         * @param ordered Whether the list is ordered. By default false.
+         * @param useHtml Whether HTML should be outputted instead of Markdown.
+         * By default false.
+         *
+         * @sa lipsum::Generator::fmt_list()
+         */
+        void fmt_list_into(std::string& out,
+                           bool         ordered = false,
+                           bool         useHtml = false);
+
         /**
          * @brief Generate an XML document.
          *
@@ -583,6 +1288,62 @@ namespace lipsum
          */
         std::string xml(int choices = 30);
 
+        /**
+         * @brief Append an XML document to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as xml(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         * @param choices The number of choices (start element, end element, add
+         * data element) that are made. By default 30.
+         *
+         * @sa lipsum::Generator::xml()
+         */
+        void xml_into(std::string& out, int choices = 30);
+
+        /**
+         * @brief Write an XML document to a sink.
+         *
+         * @since 0.5.3
+         *
+         * Same as xml(), but writes to sink one choice at a time, so the output
+         * never has to fit in memory.
+         *
+         * @param sink The sink to write to.
+         * @param choices The number of choices (start element, end element, add
+         * data element) that are made. By default 30.
+         *
+         * @sa lipsum::Generator::xml()
+         */
+        void xml_to(Sink& sink, int choices = 30);
+
+#ifndef LIPSUM_MIN_BUILD
+        /**
+         * @brief Stream an XML document in chunks.
+         *
+         * @since 0.5.3
+         *
+         * Same as xml(), but generated by a coroutine that pauses each time
+         * chunkSize bytes are ready. The stack of open elements stays in the
+         * coroutine between chunks.
+         *
+         * @param choices The number of choices (start element, end element, add
+         * data element) that are made. By default 30.
+         * @param chunkSize The size a chunk reaches before it is yielded. By
+         * default Sink::DEFAULT_CAPACITY.
+         *
+         * @return ChunkStream The chunks of the document.
+         *
+         * @sa lipsum::Generator::xml()
+         */
+        [[nodiscard]] ChunkStream
+        xml_stream(int         choices   = 30,
+                   std::size_t chunkSize = Sink::DEFAULT_CAPACITY);
+#endif
+
         /**
          * @brief Generate a JSON object or array.
          *
@@ -599,6 +1360,67 @@ namespace lipsum
          */
         std::string json(int maxDepth = 3, bool isObject = true);
 
+        /**
+         * @brief Append a JSON object or array to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as json(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         * @param maxDepth The maximum level of recursion. By default 3.
+         * @param isObject Whether to output an object (true) or an array
+         * (false). By default true.
+         *
+         * @sa lipsum::Generator::json()
+         */
+        void
+        json_into(std::string& out, int maxDepth = 3, bool isObject = true);
+
+        /**
+         * @brief Write a JSON object or array to a sink.
+         *
+         * @since 0.5.3
+         *
+         * Same as json(), but writes to sink one member at a time, so the
+         * output never has to fit in memory.
+         *
+         * @param sink The sink to write to.
+         * @param maxDepth The maximum level of recursion. By default 3.
+         * @param isObject Whether to output an object (true) or an array
+         * (false). By default true.
+         *
+         * @sa lipsum::Generator::json()
+         */
+        void json_to(Sink& sink, int maxDepth = 3, bool isObject = true);
+
+#ifndef LIPSUM_MIN_BUILD
+        /**
+         * @brief Stream a JSON object or array in chunks.
+         *
+         * @since 0.5.3
+         *
+         * Same as json(), but generated by a coroutine that pauses each time
+         * chunkSize bytes are ready. The stack of open objects and arrays
+         * stays in the coroutine between chunks.
+         *
+         * @param maxDepth The maximum level of recursion. By default 3.
+         * @param isObject Whether to output an object (true) or an array
+         * (false). By default true.
+         * @param chunkSize The size a chunk reaches before it is yielded. By
+         * default Sink::DEFAULT_CAPACITY.
+         *
+         * @return ChunkStream The chunks of the document.
+         *
+         * @sa lipsum::Generator::json()
+         */
+        [[nodiscard]] ChunkStream
+        json_stream(int         maxDepth  = 3,
+                    bool        isObject  = true,
+                    std::size_t chunkSize = Sink::DEFAULT_CAPACITY);
+#endif
+
         /**
          * @brief Generate a JSON value.
          *
@@ -614,6 +1436,21 @@ namespace lipsum
          */
         std::string json_value(int maxDepth = 3);
 
+        /**
+         * @brief Append a JSON value to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as json_value(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         * @param maxDepth The maximum level of recursion. By default 3.
+         *
+         * @sa lipsum::Generator::json_value()
+         */
+        void json_value_into(std::string& out, int maxDepth = 3);
+
         /**
          * @brief Generate a CSV document.
          *
@@ -629,99 +1466,1260 @@ namespace lipsum
          */
         std::string csv();
 
-    private:
         /**
-         * @brief Generate a single sentence.
+         * @brief Append a CSV document to a buffer.
          *
-         * @since 0.5.0
+         * @since 0.5.3
          *
-         * Generate a single sentence. This function is private. It works by
-         * picking a random number of sentence fragments and joining them with
-         * random punctuation marks (weighted towards commas, but semicolons,
-         * colons, and dashes can appear). It ends the sentence with a period,
-         * exclamation mark, or comma. It then capitalizes the first letter of
-         * the sentence. If in minimum build mode, only use commas and periods.
+         * Same as csv(), but appends to out instead of returning a new
+         * string.
          *
-         * @param wordArg The minimum and maximum possible number of words in a
-         * sentence fragment.
-         * @param frag The minimum and maximum possible number of sentence
-         * fragments in the sentence.
+         * @param out The buffer to append to.
          *
-         * @return std::string The sentence.
+         * @sa lipsum::Generator::csv()
          */
-        std::string single_sentence(const ArgVec2& wordArg,
-                                    const ArgVec2& frag);
+        void csv_into(std::string& out);
 
+#ifndef LIPSUM_MIN_BUILD
         /**
-         * @brief Generate a single paragraph.
+         * @brief Generate words by index.
          *
-         * @since 0.5.0
+         * @since 0.5.3
+         *
+         * The random-access functions (word_at(), sentence_at(),
+         * paragraph_at(), json_at() and csv_at()) see each kind of text as an
+         * endless list of units, where the unit at an index only depends on
+         * the last seed loaded, the settings and the source. Each unit is
+         * generated from its own stream of the seed, so any unit is generated
+         * without the ones before it, and generating units first to first +
+         * num - 1 gives the same text whether it is done in one call or
+         * split over many, on any number of processes. The engine is left on
+         * the stream of the last unit. With EngineType::Philox4x32, moving to
+         * a unit costs about as much as a draw; the other engines are
+         * reseeded for every unit.
+         *
+         * Words are separated by spaces, with none before the word at index
+         * 0.
+         *
+         * @param first The index of the first word, below 2^56.
+         * @param num The number of words. By default 1.
+         *
+         * @return std::string The words.
+         */
+        std::string word_at(std::uint64_t first, int num = 1);
+
+        /**
+         * @brief Append words by index to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * Same as word_at(), but appends to out instead of returning a new
+         * string.
+         *
+         * @param out The buffer to append to.
+         * @param first The index of the first word, below 2^56.
+         * @param num The number of words. By default 1.
+         *
+         * @sa lipsum::Generator::word_at()
+         */
+        void word_at_into(std::string& out, std::uint64_t first, int num = 1);
+
+        /**
+         * @brief Generate sentences by index.
+         *
+         * @since 0.5.3
+         *
+         * @param first The index of the first sentence, below 2^56.
+         * @param num The number of sentences. By default 1.
+         * @param useLipsum Whether the sentence at index 0 is "Lorem ipsum
+         * dolor sit amet...". By default true.
+         *
+         * @return std::string The sentences.
+         *
+         * @sa lipsum::Generator::word_at()
+         */
+        std::string
+        sentence_at(std::uint64_t first, int num = 1, bool useLipsum = true);
+
+        /**
+         * @brief Append sentences by index to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * @param out The buffer to append to.
+         * @param first The index of the first sentence, below 2^56.
+         * @param num The number of sentences. By default 1.
+         * @param useLipsum Whether the sentence at index 0 is "Lorem ipsum
+         * dolor sit amet...". By default true.
+         *
+         * @sa lipsum::Generator::sentence_at()
+         */
+        void sentence_at_into(std::string&  out,
+                              std::uint64_t first,
+                              int           num       = 1,
+                              bool          useLipsum = true);
+
+        /**
+         * @brief Generate paragraphs by index.
+         *
+         * @since 0.5.3
+         *
+         * @param first The index of the first paragraph, below 2^56.
+         * @param num The number of paragraphs. By default 1.
+         * @param useLipsum Whether the paragraph at index 0 starts with
+         * "Lorem ipsum dolor sit amet...". By default true.
+         *
+         * @return std::string The paragraphs.
+         *
+         * @sa lipsum::Generator::word_at()
+         */
+        std::string
+        paragraph_at(std::uint64_t first, int num = 1, bool useLipsum = true);
+
+        /**
+         * @brief Append paragraphs by index to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * @param out The buffer to append to.
+         * @param first The index of the first paragraph, below 2^56.
+         * @param num The number of paragraphs. By default 1.
+         * @param useLipsum Whether the paragraph at index 0 starts with
+         * "Lorem ipsum dolor sit amet...". By default true.
+         *
+         * @sa lipsum::Generator::paragraph_at()
+         */
+        void paragraph_at_into(std::string&  out,
+                               std::uint64_t first,
+                               int           num       = 1,
+                               bool          useLipsum = true);
+
+        /**
+         * @brief Generate a JSON object by index.
+         *
+         * @since 0.5.3
+         *
+         * @param index The index of the object, below 2^56.
+         * @param maxDepth The maximum depth of the object. By default 3.
+         *
+         * @return std::string The object.
+         *
+         * @sa lipsum::Generator::word_at()
+         */
+        std::string json_at(std::uint64_t index, int maxDepth = 3);
+
+        /**
+         * @brief Append a JSON object by index to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * @param out The buffer to append to.
+         * @param index The index of the object, below 2^56.
+         * @param maxDepth The maximum depth of the object. By default 3.
+         *
+         * @sa lipsum::Generator::json_at()
+         */
+        void
+        json_at_into(std::string& out, std::uint64_t index, int maxDepth = 3);
+
+        /**
+         * @brief Generate CSV rows by index.
+         *
+         * @since 0.5.3
+         *
+         * Every row of a seed has the same columns. The header row comes
+         * before the row at index 0.
+         *
+         * @param first The index of the first row, below 2^56.
+         * @param numRows The number of rows, not counting the header row.
+         *
+         * @return std::string The rows.
+         *
+         * @sa lipsum::Generator::word_at()
+         */
+        std::string csv_at(std::uint64_t first, int numRows);
+
+        /**
+         * @brief Append CSV rows by index to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * @param out The buffer to append to.
+         * @param first The index of the first row, below 2^56.
+         * @param numRows The number of rows, not counting the header row.
+         *
+         * @sa lipsum::Generator::csv_at()
+         */
+        void csv_at_into(std::string& out, std::uint64_t first, int numRows);
+
+        /*
+         * BYTE BUDGETS
+         */
+
+        /**
+         * @brief Generate paragraphs of an exact size.
+         *
+         * @since 0.5.3
+         *
+         * Generate paragraphs as paragraph() does, in one pass, keeping count
+         * of their size. Once less than a sentence is left, the last sentence
+         * is built from words picked to land exactly on bytes, and the
+         * paragraph is closed. If bytes is too small for even one word, or the
+         * source has no words of the lengths needed, the last sentence is
+         * padded with spaces. Below 2 bytes, which a tab and a newline take,
+         * return an empty string.
+         *
+         * @param bytes The size of the text, in bytes.
+         * @param useLipsum Whether to start with "Lorem ipsum dolor sit
+         * amet..." if there is room for it. By default true.
+         *
+         * @return std::string Text of exactly bytes bytes.
+         */
+        std::string paragraph_bytes(std::size_t bytes, bool useLipsum = true);
+
+        /**
+         * @brief Append paragraphs of an exact size to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * @param out The buffer to append to.
+         * @param bytes The size of the text, in bytes.
+         * @param useLipsum Whether to start with "Lorem ipsum dolor sit
+         * amet..." if there is room for it. By default true.
+         *
+         * @sa lipsum::Generator::paragraph_bytes()
+         */
+        void paragraph_bytes_into(std::string& out,
+                                  std::size_t  bytes,
+                                  bool         useLipsum = true);
+
+        /**
+         * @brief Write paragraphs of an exact size to a sink.
+         *
+         * @since 0.5.3
+         *
+         * @param sink The sink to write to.
+         * @param bytes The size of the text, in bytes.
+         * @param useLipsum Whether to start with "Lorem ipsum dolor sit
+         * amet..." if there is room for it. By default true.
+         *
+         * @sa lipsum::Generator::paragraph_bytes()
+         */
+        void paragraph_bytes_to(Sink&       sink,
+                                std::size_t bytes,
+                                bool        useLipsum = true);
+
+        /**
+         * @brief Generate a Markdown or HTML document of an exact size.
+         *
+         * @since 0.5.3
+         *
+         * Generate elements as fmt_text() does, and end with a paragraph whose
+         * last sentence lands exactly on bytes. If bytes is too small for a
+         * paragraph ("\n\n", or "<p></p>\n\n" in HTML), return an empty
+         * string.
+         *
+         * @param bytes The size of the document, in bytes.
+         * @param useHtml Whether HTML should be outputted instead of Markdown.
+         * By default false.
+         *
+         * @return std::string A document of exactly bytes bytes.
+         *
+         * @sa lipsum::Generator::paragraph_bytes()
+         */
+        std::string fmt_text_bytes(std::size_t bytes, bool useHtml = false);
+
+        /**
+         * @brief Append a Markdown or HTML document of an exact size to a
+         * buffer.
+         *
+         * @since 0.5.3
+         *
+         * @param out The buffer to append to.
+         * @param bytes The size of the document, in bytes.
+         * @param useHtml Whether HTML should be outputted instead of Markdown.
+         * By default false.
+         *
+         * @sa lipsum::Generator::fmt_text_bytes()
+         */
+        void fmt_text_bytes_into(std::string& out,
+                                 std::size_t  bytes,
+                                 bool         useHtml = false);
+
+        /**
+         * @brief Write a Markdown or HTML document of an exact size to a sink.
+         *
+         * @since 0.5.3
+         *
+         * @param sink The sink to write to.
+         * @param bytes The size of the document, in bytes.
+         * @param useHtml Whether HTML should be outputted instead of Markdown.
+         * By default false.
+         *
+         * @sa lipsum::Generator::fmt_text_bytes()
+         */
+        void fmt_text_bytes_to(Sink&       sink,
+                               std::size_t bytes,
+                               bool        useHtml = false);
+
+        /**
+         * @brief Generate a JSON object of an exact size.
+         *
+         * @since 0.5.3
+         *
+         * Generate members as json() does, and end with a member whose string
+         * value lands exactly on bytes. If the key of that member does not
+         * fit, spaces are added before the closing brace instead. If bytes is
+         * below 2, which "{}" takes, return an empty string.
+         *
+         * @param bytes The size of the object, in bytes.
+         * @param maxDepth The maximum level of recursion. By default 3.
+         *
+         * @return std::string An object of exactly bytes bytes.
+         *
+         * @sa lipsum::Generator::paragraph_bytes()
+         */
+        std::string json_bytes(std::size_t bytes, int maxDepth = 3);
+
+        /**
+         * @brief Append a JSON object of an exact size to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * @param out The buffer to append to.
+         * @param bytes The size of the object, in bytes.
+         * @param maxDepth The maximum level of recursion. By default 3.
+         *
+         * @sa lipsum::Generator::json_bytes()
+         */
+        void
+        json_bytes_into(std::string& out, std::size_t bytes, int maxDepth = 3);
+
+        /**
+         * @brief Write a JSON object of an exact size to a sink.
+         *
+         * @since 0.5.3
+         *
+         * @param sink The sink to write to.
+         * @param bytes The size of the object, in bytes.
+         * @param maxDepth The maximum level of recursion. By default 3.
+         *
+         * @sa lipsum::Generator::json_bytes()
+         */
+        void json_bytes_to(Sink& sink, std::size_t bytes, int maxDepth = 3);
+#endif
+
+        /**
+         * @brief Predict the size of generated text.
+         *
+         * @since 0.5.3
+         *
+         * Estimate the size of the text a function would generate with the
+         * current settings, without generating anything: the mean size of
+         * each part, from the mean word size measured when the source was
+         * loaded and the ranges and weights of the settings, plus a margin of
+         * four times the spread of the size around that mean, and the size of
+         * the longest word. The spread shrinks relative to the size as num
+         * grows, so large requests get a few percent at most. The functions
+         * returning a new string reserve this once, and nearly always fit in
+         * it instead of growing the string as they go. In minimum builds, the
+         * formats are predicted to be empty.
+         *
+         * @param type The kind of text.
+         * @param num The number of words, sentences or paragraphs, the number
+         * of elements for OutputType::FmtText, the number of choices for
+         * OutputType::Xml, or the maximum depth for OutputType::Json. Ignored
+         * for OutputType::Text and OutputType::Csv. By default 1.
+         * @param useHtml Whether OutputType::FmtParagraph and
+         * OutputType::FmtText are in HTML rather than Markdown. By default
+         * false.
+         *
+         * @return std::size_t The predicted size, in bytes, or 0 for empty
+         * text.
+         */
+        [[nodiscard]] std::size_t
+        predicted_size(OutputType  type,
+                       std::size_t num     = 1,
+                       bool        useHtml = false) const;
+
+    private:
+        friend class ParallelGenerator;
+        friend class TextView;
+
+        /**
+         * @brief Type of a CSV column
+         *
+         * @since 0.5.3
+         */
+        enum class CsvType : int
+        {
+            Int = 0,
+            Float,
+            Sentence,
+            Word,
+            Email,
+            Scramble,
+            IP,
+            Phone
+        };
+
+        /**
+         * @brief Pick a random word from the source.
+         *
+         * @since 0.5.3
+         *
+         * Follow the Markov model if load_markov() was given one, pick by
+         * word frequency if use_word_frequencies() is enabled, and pick
+         * uniformly otherwise. While m_EscapeWords is set, return the
+         * escaped form of the word. This function is private.
+         *
+         * @return std::string_view The word, valid while m_Source and
+         * m_Markov are.
+         */
+        std::string_view source_word();
+
+#ifndef LIPSUM_MIN_BUILD
+        /**
+         * @brief Get the escaped form of a word from source_word().
+         *
+         * @since 0.5.3
+         *
+         * Look the word up in the Markov model if there is one, and in the
+         * source otherwise. This function is private.
+         *
+         * @param word A word returned by source_word().
+         *
+         * @return std::string_view The escaped form, or word if it needs no
+         * escaping.
+         */
+        [[nodiscard]] std::string_view
+        escaped_word(std::string_view word) const;
+
+        /**
+         * @brief Get the XML name made from a word from source_word().
+         *
+         * @since 0.5.3
+         *
+         * Look the word up in the Markov model if there is one, and in the
+         * source otherwise. This function is private.
+         *
+         * @param word A word returned by source_word() while words are not
+         * escaped.
+         *
+         * @return std::string_view The name, or word if it is already a
+         * name.
+         */
+        [[nodiscard]] std::string_view xml_name(std::string_view word) const;
+#endif
+
+        /**
+         * @brief Append a single sentence to a buffer.
+         *
+         * @since 0.5.0
+         *
+         * Append a single sentence to out. This function is private. Formerly
+         * known as single_sentence(), which returned a new string. It works by
+         * picking a random number of sentence fragments and joining them with
+         * random punctuation marks (weighted towards commas, but semicolons,
+         * colons, and dashes can appear). It ends the sentence with a period,
+         * exclamation mark, or comma. It then capitalizes the first letter of
+         * the sentence. If in minimum build mode, only use commas and periods.
+         *
+         * @param out The buffer to append to.
+         * @param wordArg The minimum and maximum possible number of words in a
+         * sentence fragment.
+         * @param frag The minimum and maximum possible number of sentence
+         * fragments in the sentence.
+         */
+        void single_sentence_into(std::string&   out,
+                                  const ArgVec2& wordArg,
+                                  const ArgVec2& frag);
+
+        /**
+         * @brief Append a single paragraph to a buffer.
+         *
+         * @since 0.5.0
+         *
+         * Append a single paragraph to out. This function is private. Formerly
+         * known as single_paragraph(), which returned a new string. It works by
+         * starting the paragraph with a single tab character and picking a
+         * random number of sentences. It loops that number of times, and if
+         * useLipsum is true and it is the first line, add the default
+         * lorem-ipsum sentence. Else, add a random sentence. It then will add a
+         * space. Once the loop is done, remove the last character appended,
+         * and finally end with a newline.
+         *
+         * @param out The buffer to append to.
+         * @param useLipsum Whether "Lorem ipsum..." should start the paragraph.
+         */
+        void single_paragraph_into(std::string& out, bool useLipsum);
+
+#ifndef LIPSUM_MIN_BUILD
+        /**
+         * @brief Append a single Markdown or HTML paragraph to a buffer.
+         *
+         * @since 0.5.0
+         *
+         * Append a single paragraph in Markdown or HTML format to out. This
+         * function is private. Formerly known as single_md_paragraph() and
+         * single_fmt_paragraph(). It works by
+         * first choosing a random number of sentences, and opening the
+         * paragraph as Format does. It then loops that number of times,
+         * choosing an internal value fmtRoll with a 1 in 15 chance of being 1.
+         * If fmtRoll is 1, choose whether to add a link and whether an
+         * emphasized sentence will be bold or italic. If useLipsum is true and
+         * it is currently on the first line, add the default lorem-ipsum
+         * sentence. Else, if fmtRoll is 1 and a link is being added, append a
+         * link. Else, if fmtRoll is 1 and a link is not being added, append an
+         * emphasized sentence. Else, append a normal sentence. Then, append a
+         * space. Finally, close the paragraph, which ends with two new line
+         * characters. Since 0.5.3, the format is a template argument instead
+         * of the useHtml argument. Not available in minimum builds.
+         *
+         * @tparam Format The markup format, such as internal::HtmlFormat.
+         *
+         * @param out The buffer to append to.
+         * @param useLipsum Whether "Lorem ipsum..." should start the paragraph.
+         */
+        template <internal::FormatPolicy Format>
+        void single_fmt_paragraph_into(std::string& out, bool useLipsum);
+#endif
+
+        /**
+         * @brief Append a random JSON string to a buffer.
+         *
+         * @since 0.5.0
+         *
+         * Append a random word, surrounded by quotes. This function is
+         * private. If doing a minimum build, append nothing.
+         *
+         * @param out The buffer to append to.
+         */
+        void json_string_into(std::string& out);
+
+        /**
+         * @brief Append a random JSON number to a buffer.
+         *
+         * @since 0.5.0
+         *
+         * Append a random number from -1000 to 1000, converted to a string.
+         * This function is private. If doing a minimum build, append nothing.
+         *
+         * @param out The buffer to append to.
+         */
+        void json_number_into(std::string& out);
+
+        /**
+         * @brief Append a Markdown or HTML document, committing each element.
+         *
+         * @since 0.5.3
+         *
+         * Implementation of fmt_text_into() and fmt_text_to(). If sink is not
+         * null, out must be its buffer, and sink is committed after every
+         * element. This function is private.
+         *
+         * @param out The buffer to append to.
+         * @param sink The sink to commit to, or null.
+         * @param numElements The number of elements in the document.
+         * @param useHtml Whether HTML should be outputted instead of Markdown.
+         */
+        void fmt_text_chunked(std::string& out,
+                              Sink*        sink,
+                              int          numElements,
+                              bool         useHtml);
+
+        /**
+         * @brief Append an XML document, committing each choice.
+         *
+         * @since 0.5.3
+         *
+         * Implementation of xml_into() and xml_to(). If sink is not null, out
+         * must be its buffer, and sink is committed after every choice. This
+         * function is private.
+         *
+         * @param out The buffer to append to.
+         * @param sink The sink to commit to, or null.
+         * @param choices The number of choices that are made.
+         */
+        void xml_chunked(std::string& out, Sink* sink, int choices);
+
+        /**
+         * @brief Append a JSON object or array, committing each member.
+         *
+         * @since 0.5.3
+         *
+         * Implementation of json_into() and json_to(). Nested objects and
+         * arrays are kept on a stack instead of the call stack, so any depth
+         * is safe. If sink is not null, out must be its buffer, and sink is
+         * committed after every member. This function is private.
+         *
+         * @param out The buffer to append to.
+         * @param sink The sink to commit to, or null.
+         * @param maxDepth The maximum level of recursion.
+         * @param isObject Whether to output an object (true) or an array
+         * (false).
+         */
+        void json_chunked(std::string& out,
+                          Sink*        sink,
+                          int          maxDepth,
+                          bool         isObject);
+
+        /**
+         * @brief Append the elements after the start of a document.
+         *
+         * @since 0.5.3
+         *
+         * Append random paragraphs, headers and lists, never two headers in
+         * a row, as in fmt_text_into() after its first header and paragraph.
+         * If sink is not null, out must be its buffer, and sink is committed
+         * after every element. This function is private.
+         *
+         * @param out The buffer to append to.
+         * @param sink The sink to commit to, or null.
+         * @param numElements The number of elements.
+         * @param useHtml Whether HTML should be outputted instead of Markdown.
+         * @param endsText Whether the last element ends the document, which
+         * makes it a paragraph.
+         * @param lastKind The kind of the element before, as returned by
+         * fmt_element_into(); 1 keeps the first element from being a header.
+         */
+        void fmt_elements_chunked(std::string& out,
+                                  Sink*        sink,
+                                  int          numElements,
+                                  bool         useHtml,
+                                  bool         endsText,
+                                  int          lastKind);
+
+#ifndef LIPSUM_MIN_BUILD
+        /**
+         * @brief Append one element after the start of a document.
+         *
+         * @since 0.5.3
+         *
+         * Append a random paragraph, header or list, as in
+         * fmt_elements_chunked(). This function is private.
+         *
+         * @tparam Format The markup format.
+         *
+         * @param out The buffer to append to.
+         * @param lastKind The kind of the element before, as returned by the
+         * previous call, or 0.
+         * @param isLast Whether the element ends the document, which makes it
+         * a paragraph.
+         *
+         * @return int The kind of the element: 0 for a paragraph, 1 for a
+         * header and 2 for a list.
+         */
+        template <internal::FormatPolicy Format>
+        int fmt_element_into(std::string& out, int lastKind, bool isLast);
+
+        /**
+         * @brief Append a document in a format, committing each element.
+         *
+         * @since 0.5.3
+         *
+         * Same as fmt_text_chunked(), which calls it once it knows the
+         * format. This function is private.
+         *
+         * @tparam Format The markup format.
+         *
+         * @param out The buffer to append to.
+         * @param sink The sink to commit to, or null.
+         * @param numElements The number of elements in the document.
+         */
+        template <internal::FormatPolicy Format>
+        void fmt_text_chunked(std::string& out, Sink* sink, int numElements);
+
+        /**
+         * @brief Append the elements after the start of a document in a
+         * format.
+         *
+         * @since 0.5.3
+         *
+         * Same as fmt_elements_chunked(), which calls it once it knows the
+         * format. This function is private.
+         *
+         * @tparam Format The markup format.
+         *
+         * @param out The buffer to append to.
+         * @param sink The sink to commit to, or null.
+         * @param numElements The number of elements.
+         * @param endsText Whether the last element ends the document, which
+         * makes it a paragraph.
+         * @param lastKind The kind of the element before.
+         */
+        template <internal::FormatPolicy Format>
+        void fmt_elements_chunked(std::string& out,
+                                  Sink*        sink,
+                                  int          numElements,
+                                  bool         endsText,
+                                  int          lastKind);
+
+        /**
+         * @brief Append a header in a format.
+         *
+         * @since 0.5.3
+         *
+         * Same as the public fmt_header_into(). This function is private.
+         *
+         * @tparam Format The markup format.
+         *
+         * @param out The buffer to append to.
+         * @param level The header level, from 1 to 6.
+         */
+        template <internal::FormatPolicy Format>
+        void fmt_header_into(std::string& out, int level);
+
+        /**
+         * @brief Append an emphasized sentence in a format.
+         *
+         * @since 0.5.3
+         *
+         * Same as the public fmt_emphasis_into(). This function is private.
+         *
+         * @tparam Format The markup format.
+         *
+         * @param out The buffer to append to.
+         * @param isBold Whether the sentence is bold (true) or italic (false).
+         */
+        template <internal::FormatPolicy Format>
+        void fmt_emphasis_into(std::string& out, bool isBold);
+
+        /**
+         * @brief Append a link in a format.
+         *
+         * @since 0.5.3
+         *
+         * Same as the public fmt_link_into(). This function is private.
+         *
+         * @tparam Format The markup format.
+         *
+         * @param out The buffer to append to.
+         */
+        template <internal::FormatPolicy Format>
+        void fmt_link_into(std::string& out);
+
+        /**
+         * @brief Append a list in a format.
+         *
+         * @since 0.5.3
+         *
+         * Same as the public fmt_list_into(). This function is private.
+         *
+         * @tparam Format The markup format.
+         *
+         * @param out The buffer to append to.
+         * @param ordered Whether the list is ordered.
+         */
+        template <internal::FormatPolicy Format>
+        void fmt_list_into(std::string& out, bool ordered);
+
+        /**
+         * @brief Yield a document in a format in chunks.
+         *
+         * @since 0.5.3
+         *
+         * Implementation of fmt_text_stream(). This function is private.
+         *
+         * @tparam Format The markup format.
+         *
+         * @param numElements The number of elements in the document.
+         * @param chunkSize The size a chunk reaches before it is yielded.
+         *
+         * @return ChunkStream The chunks.
+         */
+        template <internal::FormatPolicy Format>
+        ChunkStream fmt_text_chunks(int numElements, std::size_t chunkSize);
+
+        /**
+         * @brief Append the prolog and root start tag of an XML document.
          *
-         * Generate a single paragraph. This function is private. It works by
-         * starting the paragraph with a single tab character and picking a
-         * random number of sentences. It loops that number of times, and if
-         * useLipsum is true and it is the first line, add the default
-         * lorem-ipsum sentence. Else, add a random sentence. It then will add a
-         * space. Once the loop is done, if the string is not empty, remove the
-         * last trailing space, and finally end with a newline.
+         * @since 0.5.3
          *
-         * @param useLipsum Whether "Lorem ipsum..." should start the paragraph.
+         * This function is private.
+         *
+         * @param out The buffer to append to.
          *
-         * @return std::string The paragraph.
+         * @return std::string_view The name of the root element.
          */
-        std::string single_paragraph(bool useLipsum);
+        std::string_view xml_start_into(std::string& out);
 
         /**
-         * @brief Generate a single Markdown or HTML paragraph.
+         * @brief Make one choice of an XML document.
          *
-         * @since 0.5.0
+         * @since 0.5.3
          *
-         * Generate a single paragraph in Markdown or HTML format. This function
-         * is private. Formerly known as single_md_paragraph(). It works by
-         * first choosing a random number of sentences, and if useHtml is true,
-         * start an HTML paragraph tag. It then loops that number of times,
-         * choosing an internal value fmtRoll with a 1 in 15 chance of being 1.
-         * If fmtRoll is 1, choose whether to add a link and whether an
-         * emphasized sentence will be bold or italic. If useLipsum is true and
-         * it is currently on the first line, add the default lorem-ipsum
-         * sentence. Else, if fmtRoll is 1 and a link is being added, append a
-         * link. Else, if fmtRoll is 1 and a link is not being added, append an
-         * emphasized sentence. Else, append a normal sentence. Then, append a
-         * space. If useHtml is true, close the HTML paragraph tag. Finally, end
-         * with two new line characters. If doing a minimum build, return an
-         * empty string.
+         * Start an element, add a data element or end the last open element.
+         * This function is private.
          *
-         * @param useLipsum Whether "Lorem ipsum..." should start the paragraph.
-         * @param useHtml Whether HTML should be outputted instead of Markdown.
+         * @param out The buffer to append to.
+         * @param tagStack The names of the open elements, updated.
+         */
+        void xml_choice_into(std::string&                   out,
+                             std::vector<std::string_view>& tagStack);
+
+        /**
+         * @brief Append an XML end tag.
+         *
+         * @since 0.5.3
+         *
+         * This function is private.
          *
-         * @return std::string The random Markdown paragraph.
+         * @param out The buffer to append to.
+         * @param name The name of the element.
          */
-        std::string single_fmt_paragraph(bool useLipsum, bool useHtml);
+        static void xml_end_tag_into(std::string& out, std::string_view name);
 
         /**
-         * @brief Generate a random JSON string.
+         * @brief An open JSON object or array
          *
-         * @since 0.5.0
+         * @since 0.5.3
+         */
+        struct JsonLevel
+        {
+            int  count;    ///< The number of members
+            int  next;     ///< The index of the next member
+            int  maxDepth; ///< The maximum level of recursion left
+            bool isObject; ///< Whether it is an object or an array
+        };
+
+        /**
+         * @brief Open a JSON object or array.
+         *
+         * @since 0.5.3
          *
-         * Generate a random word, surrounded by quotes. This function is
-         * private. If doing a minimum build, return an empty string.
+         * Pick the number of members, append the opening bracket and push the
+         * level. This function is private.
          *
-         * @return std::string The random JSON string.
+         * @param out The buffer to append to.
+         * @param stack The open levels.
+         * @param maxDepth The maximum level of recursion.
+         * @param isObject Whether to open an object (true) or an array
+         * (false).
          */
-        std::string json_string();
+        void json_open_into(std::string&            out,
+                            std::vector<JsonLevel>& stack,
+                            int                     maxDepth,
+                            bool                    isObject);
 
         /**
-         * @brief Generate a random JSON number.
+         * @brief Append the next member of the innermost JSON level.
          *
-         * @since 0.5.0
+         * @since 0.5.3
          *
-         * Generate a random number from -1000 to 1000, converted to a string.
-         * This function is private. If doing a minimum build, return an empty
-         * string.
+         * Append the next member of the level at the top of stack, opening a
+         * new level if its value is an object or an array, or close the level
+         * if it has no members left. The draws are the same as writing the
+         * members recursively. This function is private.
+         *
+         * @param out The buffer to append to.
+         * @param stack The open levels, which must not be empty.
+         */
+        void json_step_into(std::string& out, std::vector<JsonLevel>& stack);
+
+        /**
+         * @brief Append the key of a member of a JSON object.
+         *
+         * @since 0.5.3
+         *
+         * This function is private.
+         *
+         * @param out The buffer to append to.
+         * @param index The index of the member, appended to the key so that
+         * keys are unique.
+         */
+        void json_key_into(std::string& out, int index);
+
+        /**
+         * @brief Pick the kind of a JSON value.
+         *
+         * @since 0.5.3
+         *
+         * If maxDepth is greater than or equal to 50, print a warning. This
+         * function is private.
+         *
+         * @param maxDepth The maximum level of recursion left.
+         *
+         * @return int 0 for a string, 1 for a number, 2 for a boolean, 3 for
+         * null, 4 for an array and 5 for an object. Only 0 to 3 if maxDepth
+         * is 0 or less.
+         */
+        int json_value_kind(int maxDepth);
+
+        /**
+         * @brief Append a JSON string, number, boolean or null.
+         *
+         * @since 0.5.3
+         *
+         * This function is private.
+         *
+         * @param out The buffer to append to.
+         * @param kind The kind of the value, from 0 to 3, as returned by
+         * json_value_kind().
+         */
+        void json_scalar_into(std::string& out, int kind);
+
+        /**
+         * @brief Coroutine appending a JSON object or array.
+         *
+         * @since 0.5.3
+         *
+         * Implementation of json_stream(). Append to out and yield it each
+         * time it holds chunkSize bytes, clearing it when resumed. This
+         * function is private.
+         *
+         * @param out The buffer to append to.
+         * @param chunkSize The size a chunk reaches before it is yielded.
+         * @param maxDepth The maximum level of recursion.
+         * @param isObject Whether to output an object (true) or an array
+         * (false).
+         *
+         * @return ChunkStream The chunks.
+         */
+        ChunkStream json_chunks(std::string& out,
+                                std::size_t  chunkSize,
+                                int          maxDepth,
+                                bool         isObject);
+#endif
+
+#ifndef LIPSUM_MIN_BUILD
+        /**
+         * @brief Kind of unit generated by index
+         *
+         * @since 0.5.3
+         *
+         * Stored in the upper bits of the stream of a unit, so that units of
+         * different kinds at the same index do not share a stream.
+         */
+        enum class UnitType : std::uint64_t
+        {
+            Word = 1,
+            Sentence,
+            Paragraph,
+            Json,
+            CsvHeader,
+            CsvRow
+        };
+
+        /**
+         * @brief Number of bits of a stream that hold the unit index
+         *
+         * @since 0.5.3
+         */
+        static constexpr unsigned int UNIT_INDEX_BITS = 56;
+
+        /**
+         * @brief Move to the stream of a unit.
+         *
+         * @since 0.5.3
+         *
+         * Reseed m_Gen with the root seed and a stream made of type and index,
+         * and forget state carried between draws. This function is private.
+         *
+         * @param type The kind of unit.
+         * @param index The index of the unit, below 2^56.
+         */
+        void load_unit(UnitType type, std::uint64_t index);
+
+        /**
+         * @brief Largest size of a sentence fitted by dynamic programming
+         *
+         * @since 0.5.3
+         *
+         * fit_sentence_into() picks random words until at most this many
+         * bytes are left, then only words that keep the rest reachable. Byte
+         * budgets stop generating whole units once less than this is left.
+         */
+        static constexpr std::size_t FIT_WINDOW = 64;
+
+        /**
+         * @brief Longest word considered when fitting a sentence
+         *
+         * @since 0.5.3
+         */
+        static constexpr std::size_t FIT_MAX_LENGTH = 32;
+
+        /**
+         * @brief Most words kept for each length when fitting a sentence
+         *
+         * @since 0.5.3
+         */
+        static constexpr std::size_t FIT_WORDS_PER_LENGTH = 256;
+
+        /**
+         * @brief Words of the source by length, for fitting sentences
+         *
+         * @since 0.5.3
+         *
+         * Built from m_Source the first time a sentence is fitted to it, from
+         * the escaped forms of the words if they are escaped.
+         */
+        struct FitTable
+        {
+            std::shared_ptr<const Source> source; ///< Source it was built for
+            bool escaped = false; ///< Whether it holds escaped words
+
+            std::array<std::vector<std::uint32_t>, FIT_MAX_LENGTH + 1>
+                    words; ///< Indices of the words of each length
+
+            std::array<bool, FIT_WINDOW + 1>
+                    reach; ///< Whether a sentence of each size can be made
+        };
+
+        /**
+         * @brief Get the fit table of the current source.
+         *
+         * @since 0.5.3
+         *
+         * Rebuild it if the source changed, or if m_EscapeWords changed and
+         * the source has words that need escaping. This function is private.
+         *
+         * @return const FitTable& The table.
+         */
+        const FitTable& fit_table();
+
+        /**
+         * @brief Append a sentence of an exact size.
+         *
+         * @since 0.5.3
+         *
+         * Append capitalized words separated by spaces or commas and ended by
+         * a period, landing exactly on length: random words while more than
+         * FIT_WINDOW bytes are left, then words of the lengths that keep the
+         * rest reachable. If no sentence of that size can be made, end the
+         * sentence early and pad it with spaces. This function is private.
          *
-         * @return std::string The random JSON number.
+         * @param out The buffer to append to.
+         * @param length The size of the sentence, in bytes.
          */
-        std::string json_number();
+        void fit_sentence_into(std::string& out, std::size_t length);
+
+        /**
+         * @brief Append paragraphs of an exact size, committing each one.
+         *
+         * @since 0.5.3
+         *
+         * Implementation of paragraph_bytes_into() and paragraph_bytes_to().
+         * If sink is not null, out must be its buffer. This function is
+         * private.
+         *
+         * @param out The buffer to append to.
+         * @param sink The sink to commit to, or null.
+         * @param bytes The size of the text, in bytes.
+         * @param useLipsum Whether to start with "Lorem ipsum dolor sit
+         * amet...".
+         */
+        void paragraph_bytes_chunked(std::string& out,
+                                     Sink*        sink,
+                                     std::size_t  bytes,
+                                     bool         useLipsum);
+
+        /**
+         * @brief Append a Markdown or HTML document of an exact size,
+         * committing each element.
+         *
+         * @since 0.5.3
+         *
+         * Implementation of fmt_text_bytes_into() and fmt_text_bytes_to(). If
+         * sink is not null, out must be its buffer. This function is private.
+         *
+         * @tparam Format The markup format.
+         *
+         * @param out The buffer to append to.
+         * @param sink The sink to commit to, or null.
+         * @param bytes The size of the document, in bytes.
+         */
+        template <internal::FormatPolicy Format>
+        void fmt_text_bytes_chunked(std::string& out,
+                                    Sink*        sink,
+                                    std::size_t  bytes);
+
+        /**
+         * @brief Append a JSON object of an exact size, committing each
+         * member.
+         *
+         * @since 0.5.3
+         *
+         * Implementation of json_bytes_into() and json_bytes_to(). If sink is
+         * not null, out must be its buffer. This function is private.
+         *
+         * @param out The buffer to append to.
+         * @param sink The sink to commit to, or null.
+         * @param bytes The size of the object, in bytes.
+         * @param maxDepth The maximum level of recursion.
+         */
+        void json_bytes_chunked(std::string& out,
+                                Sink*        sink,
+                                std::size_t  bytes,
+                                int          maxDepth);
+#endif
+
+        /**
+         * @brief Fewest units for which the _into functions reserve
+         *
+         * @since 0.5.3
+         *
+         * word_into(), sentence_into(), paragraph_into() and
+         * fmt_paragraph_into() are also called for a few units at a time
+         * while generating other text, where predicting the size would cost
+         * more than it saves.
+         */
+        static constexpr int RESERVE_MIN_UNITS = 64;
+
+        /**
+         * @brief Predict the mean size of generated text.
+         *
+         * @since 0.5.3
+         *
+         * Same as predicted_size(), without the margin. This function is
+         * private.
+         *
+         * @param type The kind of text.
+         * @param num The number of units, as in predicted_size().
+         * @param useHtml Whether formatted text is in HTML.
+         *
+         * @return double The mean size, in bytes.
+         */
+        [[nodiscard]] double
+        mean_size(OutputType type, std::size_t num, bool useHtml) const;
+
+        /**
+         * @brief Get the mean size of a word.
+         *
+         * @since 0.5.3
+         *
+         * Weighted by frequency if use_word_frequencies() is enabled. This
+         * function is private.
+         *
+         * @return double The mean size, in bytes.
+         */
+        [[nodiscard]] double mean_word_size() const;
+
+        /**
+         * @brief Predict the mean size of a single sentence.
+         *
+         * @since 0.5.3
+         *
+         * This function is private.
+         *
+         * @param wordArg The range of the number of words in a fragment.
+         * @param frag The range of the number of fragments.
+         *
+         * @return double The mean size, in bytes.
+         *
+         * @sa lipsum::Generator::single_sentence_into()
+         */
+        [[nodiscard]] double mean_sentence_size(const ArgVec2& wordArg,
+                                                const ArgVec2& frag) const;
+
+        /**
+         * @brief Predict the mean size of a sentence of formatted text.
+         *
+         * @since 0.5.3
+         *
+         * Account for the sentences made links or emphasized, and for the
+         * space after each sentence. This function is private.
+         *
+         * @param useHtml Whether the text is in HTML.
+         *
+         * @return double The mean size, in bytes.
+         */
+        [[nodiscard]] double mean_fmt_sentence_size(bool useHtml) const;
+
+        /**
+         * @brief Predict the mean size of a URL.
+         *
+         * @since 0.5.3
+         *
+         * This function is private.
+         *
+         * @param plain Whether the URL has no scheme and no slug, as with
+         * plain_url_into().
+         *
+         * @return double The mean size, in bytes.
+         *
+         * @sa lipsum::Generator::url_into()
+         */
+        [[nodiscard]] double mean_url_size(bool plain) const;
+
+        /**
+         * @brief Predict the mean size of a JSON object.
+         *
+         * @since 0.5.3
+         *
+         * This function is private.
+         *
+         * @param maxDepth The maximum level of recursion.
+         *
+         * @return double The mean size, in bytes.
+         *
+         * @sa lipsum::Generator::json_into()
+         */
+        [[nodiscard]] double mean_json_size(std::size_t maxDepth) const;
+
+        /**
+         * @brief Predict the mean size of a CSV document.
+         *
+         * @since 0.5.3
+         *
+         * This function is private.
+         *
+         * @return double The mean size, in bytes.
+         *
+         * @sa lipsum::Generator::csv_into()
+         */
+        [[nodiscard]] double mean_csv_size() const;
+
+        /**
+         * @brief Most bytes reserved ahead of generating text
+         *
+         * @since 0.5.3
+         *
+         * Predicted sizes are means, which for deep JSON grow far beyond
+         * anything generated in practice, so they are only trusted up to
+         * here; longer text grows the buffer as it is appended.
+         */
+        static constexpr std::size_t MAX_RESERVE = 64 * 1024 * 1024;
+
+        /**
+         * @brief Make room in a buffer for more text.
+         *
+         * @since 0.5.3
+         *
+         * Reserve room for extra more bytes, at most MAX_RESERVE, at least
+         * doubling the capacity if it must grow, so that appending to the
+         * same buffer many times stays linear on every standard library.
+         * This function is private.
+         *
+         * @param out The buffer.
+         * @param extra The number of bytes to make room for.
+         */
+        static void reserve_more(std::string& out, std::size_t extra);
+
+        /**
+         * @brief Append the header row of a CSV document.
+         *
+         * @since 0.5.3
+         *
+         * Pick the number of columns and the type of each, and append a row of
+         * random words naming them. This function is private.
+         *
+         * @param out The buffer to append to.
+         * @param cols The types of the columns, replaced.
+         */
+        void csv_header_into(std::string& out, std::vector<CsvType>& cols);
+
+        /**
+         * @brief Append a row of a CSV document.
+         *
+         * @since 0.5.3
+         *
+         * This function is private.
+         *
+         * @param out The buffer to append to.
+         * @param cols The types of the columns.
+         */
+        void csv_row_into(std::string& out, const std::vector<CsvType>& cols);
 
         /**
          * @brief Generate a random number.
@@ -729,8 +2727,10 @@ namespace lipsum
          * @since 0.5.0
          *
          * Generate a random number between min and max, inclusive. If T is an
-         * integer, use std::uniform_int_distribution. Else, use
-         * std::uniform_real_distribution. This function is private.
+         * integer, use internal::UniformInt(), or the bit pool for ranges of at
+         * most internal::BitPool::MAX_POOLED_RANGE values. Else, use
+         * internal::UniformReal(). The results are the same on every standard
+         * library. This function is private.
          *
          * @tparam T The type of the random number. Must be a
          * uniform-distribution type, i.e. ints (excluding chars and bool) and
@@ -752,13 +2752,20 @@ namespace lipsum
             }
             if constexpr (std::is_integral_v<T>)
             {
-                std::uniform_int_distribution<T> dist(min, max);
-                return dist(m_Gen);
+                using Unsigned = std::make_unsigned_t<T>;
+                Unsigned span  = static_cast<Unsigned>(max) -
+                                static_cast<Unsigned>(min);
+                if (span < internal::BitPool::MAX_POOLED_RANGE)
+                {
+                    auto range = static_cast<std::uint32_t>(span) + 1;
+                    return static_cast<T>(
+                            min + static_cast<T>(m_Bits.below(m_Gen, range)));
+                }
+                return internal::UniformInt(m_Gen, min, max);
             }
             else
             {
-                std::uniform_real_distribution<T> dist(min, max);
-                return dist(m_Gen);
+                return internal::UniformReal(m_Gen, min, max);
             }
         }
 
@@ -790,21 +2797,6 @@ namespace lipsum
          */
         bool random_number(bool min, bool max);
 
-        /**
-         * @brief Choose a random index based off weights
-         *
-         * @since 0.5.0
-         *
-         * This function chooses a random index of weights, with higher valued
-         * weights being more likely. To do this, it passes the weights into an
-         * std::discrete_distribution.
-         *
-         * @param weights The weights.
-         *
-         * @return int The random index.
-         */
-        int weighted_random_idx(const std::vector<int>& weights);
-
         /**
          * @brief Pick a random TLD.
          *
@@ -812,25 +2804,44 @@ namespace lipsum
          *
          * This function picks a random TLD out of .com, .org, .net, .edu, .io,
          * .ca, and .co.uk, each with chances of 70%, 10%, 7%, 5%, 5%, 2%, and
-         * 1% respectively. This function is private. If doing a minimum build,
-         * choose .com.
+         * 1% respectively, and appends it to out. This function is private. If
+         * doing a minimum build, choose .com.
          *
-         * @return std::string The random TLD.
+         * @param out The buffer to append to.
          */
-        std::string tld();
+        void tld_into(std::string& out);
 
         GeneratorSettings m_Settings; ///< Settings for generation
 
-        std::mt19937 m_Gen; ///< Random number generator
+        Engine m_Gen; ///< Random number generator
+
+        internal::BitPool m_Bits; ///< Spare bits of m_Gen for small draws
+
+#ifndef LIPSUM_MIN_BUILD
+        bool m_UseFrequencies = false; ///< Whether words follow frequencies
+
+        std::shared_ptr<const MarkovSource>
+                m_Markov; ///< Markov model used for words, if any
+
+        std::uint32_t m_MarkovState =
+                MarkovSource::START_STATE; ///< Current state of m_Markov
+
+        std::shared_ptr<const FitTable>
+                m_FitTable; ///< Words by length, for byte budgets
+
+        bool m_EscapeWords = false; ///< Whether words are escaped for HTML
+                                    ///< and XML
+#endif
 
         /**
          * @brief Source used for generation.
          *
          * The source passed into functions. By default the
-         * lorem-ipsum source "lorem" from sample.inl.
+         * lorem-ipsum source "lorem" from sample.inl. Shared with every other
+         * generator using the same source, and never nullptr.
          *
          * @since 0.4.1
          */
-        Source m_Source;
+        std::shared_ptr<const Source> m_Source;
     };
 } // namespace lipsum
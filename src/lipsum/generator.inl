@@ -13,47 +13,34 @@
 #pragma once
 
 #include "core/internal.hpp"
+#include "generatorat.inl"
+#include "generatorbytes.inl"
 #include "generatorcore.inl"
 #include "generatorformats.inl"
+#include "generatorsize.inl"
 
 #ifndef LIPSUM_MIN_BUILD
-static std::string ClearApostrAndCh(char letter, const std::string& str)
+static void ClearApostrAndCh(std::string& str,
+                             std::size_t  start,
+                             char         let1,
+                             char         let2 = '\'')
 {
-    std::string ret;
-    ret.reserve(str.size());
-    for (const char& let : str)
+    auto isCleared = [&](char let)
     {
-        if (let != '\'' && let != letter)
-        {
-            ret.push_back(let);
-        }
-    }
-    return ret;
-}
-
-static std::string
-ClearApostrAndCh(char let1, char let2, const std::string& str)
-{
-    std::string ret;
-    ret.reserve(str.size());
-    for (const char& let : str)
-    {
-        if (let != '\'' && let != let1 && let != let2)
-        {
-            ret.push_back(let);
-        }
-    }
-    return ret;
+        return let == '\'' || let == let1 || let == let2;
+    };
+    str.erase(std::remove_if(str.begin() + static_cast<std::ptrdiff_t>(start),
+                             str.end(),
+                             isCleared),
+              str.end());
 }
 
-static std::string CapitalizeStr(const std::string& str)
+static void CapitalizeStr(std::string& str, std::size_t start)
 {
-    std::string ret = str;
-    for (auto& letter : ret)
+    for (std::size_t i = start; i < str.size(); ++i)
     {
-        letter = LPSM_SAFE_CCTYPE(char, std::toupper, letter);
+        str[i] = LPSM_SAFE_CCTYPE(char, std::toupper, str[i]);
     }
-    return ret;
 }
 #endif
 
@@ -66,9 +53,19 @@ namespace lipsum
 
     std::string Generator::word(int num)
     {
-
         std::string ret;
+        if (num > 0)
+        {
+            reserve_more(ret,
+                         predicted_size(OutputType::Word,
+                                        static_cast<std::size_t>(num)));
+        }
+        word_into(ret, num);
+        return ret;
+    }
 
+    void Generator::word_into(std::string& out, int num)
+    {
         if (num < 0)
         {
             internal::LogWarn(internal::LogType::Warn,
@@ -76,29 +73,72 @@ namespace lipsum
                               "got ",
                               num);
         }
+        if (num >= RESERVE_MIN_UNITS)
+        {
+            reserve_more(out,
+                         predicted_size(OutputType::Word,
+                                        static_cast<std::size_t>(num)));
+        }
 
         for (int i = 0; i < num; ++i)
         {
-            ret += m_Source.random_word(m_Gen) += " ";
+            if (i != 0)
+            {
+                out += ' ';
+            }
+            out += source_word();
+        }
+    }
+
+    void Generator::word_to(Sink& sink, int num)
+    {
+        if (num < 0)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::Generator::word_to(): expected num >= 0, "
+                              "got ",
+                              num);
         }
 
-        if (!ret.empty())
+        for (int i = 0; i < num; ++i)
         {
-            ret.pop_back();
+            if (i != 0)
+            {
+                sink.buffer() += ' ';
+            }
+            sink.buffer() += source_word();
+            sink.commit();
         }
-        return ret;
     }
 
     std::string Generator::fragment()
+    {
+        std::string ret;
+        fragment_into(ret);
+        return ret;
+    }
+
+    void Generator::fragment_into(std::string& out)
     {
         int numWords = m_Settings.word.roll(m_Gen);
-        return word(numWords);
+        word_into(out, numWords);
     }
 
     std::string Generator::sentence(int num, bool useLipsum)
     {
-        std::string result;
+        std::string ret;
+        if (num > 0)
+        {
+            reserve_more(ret,
+                         predicted_size(OutputType::Sentence,
+                                        static_cast<std::size_t>(num)));
+        }
+        sentence_into(ret, num, useLipsum);
+        return ret;
+    }
 
+    void Generator::sentence_into(std::string& out, int num, bool useLipsum)
+    {
         if (num < 0)
         {
             internal::LogWarn(internal::LogType::Warn,
@@ -106,26 +146,59 @@ namespace lipsum
                               ">= 0, got ",
                               num);
         }
+        if (num >= RESERVE_MIN_UNITS)
+        {
+            reserve_more(out,
+                         predicted_size(OutputType::Sentence,
+                                        static_cast<std::size_t>(num)));
+        }
 
         for (int i = 0; i < num; ++i)
         {
             if (i == 0 && useLipsum)
             {
-                result += GenerateDefaultLipsumSentence() + " ";
+                out += internal::LIPSUM_DEFAULT_SENTENCE;
             }
             else
             {
-                result += single_sentence(m_Settings.word, m_Settings.frag) +=
-                        " ";
+                single_sentence_into(out, m_Settings.word, m_Settings.frag);
             }
+            out += ' ';
+        }
+    }
+
+    void Generator::sentence_to(Sink& sink, int num, bool useLipsum)
+    {
+        if (num < 0)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::Generator::sentence_to(): expected num "
+                              ">= 0, got ",
+                              num);
+        }
+
+        for (int i = 0; i < num; ++i)
+        {
+            sentence_into(sink.buffer(), 1, i == 0 && useLipsum);
+            sink.commit();
         }
-        return result;
     }
 
     std::string Generator::paragraph(int num, bool useLipsum)
     {
-        std::string result;
+        std::string ret;
+        if (num > 0)
+        {
+            reserve_more(ret,
+                         predicted_size(OutputType::Paragraph,
+                                        static_cast<std::size_t>(num)));
+        }
+        paragraph_into(ret, num, useLipsum);
+        return ret;
+    }
 
+    void Generator::paragraph_into(std::string& out, int num, bool useLipsum)
+    {
         if (num < 0)
         {
             internal::LogWarn(internal::LogType::Warn,
@@ -133,28 +206,80 @@ namespace lipsum
                               ">= 0, got ",
                               num);
         }
+        if (num >= RESERVE_MIN_UNITS)
+        {
+            reserve_more(out,
+                         predicted_size(OutputType::Paragraph,
+                                        static_cast<std::size_t>(num)));
+        }
 
         for (int i = 0; i < num; ++i)
         {
             if (i == 0 && useLipsum)
             {
-                result += single_paragraph(USELIPSUM);
+                single_paragraph_into(out, USELIPSUM);
             }
             else
             {
-                result += single_paragraph(NO_USELIPSUM);
+                single_paragraph_into(out, NO_USELIPSUM);
             }
         }
-        return result;
+    }
+
+    void Generator::paragraph_to(Sink& sink, int num, bool useLipsum)
+    {
+        if (num < 0)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::Generator::paragraph_to(): expected num "
+                              ">= 0, got ",
+                              num);
+        }
+
+        for (int i = 0; i < num; ++i)
+        {
+            paragraph_into(sink.buffer(), 1, i == 0 && useLipsum);
+            sink.commit();
+        }
     }
 
     std::string Generator::text(bool useLipsum)
+    {
+        std::string ret;
+        reserve_more(ret, predicted_size(OutputType::Text));
+        text_into(ret, useLipsum);
+        return ret;
+    }
+
+    void Generator::text_into(std::string& out, bool useLipsum)
+    {
+        int num = m_Settings.para.roll(m_Gen);
+        paragraph_into(out, num, useLipsum);
+    }
+
+    void Generator::text_to(Sink& sink, bool useLipsum)
     {
         int num = m_Settings.para.roll(m_Gen);
-        return paragraph(num, useLipsum);
+        paragraph_to(sink, num, useLipsum);
     }
 
 #ifndef LIPSUM_MIN_BUILD
+    TextView Generator::words()
+    {
+        return TextView(*this, TextUnit::Word, NO_USELIPSUM);
+    }
+
+    TextView Generator::sentences(bool useLipsum)
+    {
+        return TextView(*this, TextUnit::Sentence, useLipsum);
+    }
+
+    TextView Generator::paragraphs(bool useLipsum)
+    {
+        return TextView(*this, TextUnit::Paragraph, useLipsum);
+    }
+#endif
+
     /*
      * MISC
      */
@@ -162,6 +287,76 @@ namespace lipsum
     std::string Generator::scramble(int length, char minChar, char maxChar)
     {
         std::string ret;
+        if (length > 0)
+        {
+            ret.reserve(length);
+        }
+        scramble_into(ret, length, minChar, maxChar);
+        return ret;
+    }
+
+    std::string Generator::url()
+    {
+        std::string ret;
+        url_into(ret);
+        return ret;
+    }
+
+    std::string Generator::plain_url()
+    {
+        std::string ret;
+        plain_url_into(ret);
+        return ret;
+    }
+
+    std::string Generator::email()
+    {
+        std::string ret;
+        email_into(ret);
+        return ret;
+    }
+
+    std::string Generator::slug(char separator)
+    {
+        std::string ret;
+        slug_into(ret, separator);
+        return ret;
+    }
+
+    std::string Generator::case_slug(CaseSlugCase case_)
+    {
+        std::string ret;
+        case_slug_into(ret, case_);
+        return ret;
+    }
+
+    std::string Generator::code(CodeLanguage lang)
+    {
+        std::string ret;
+        code_into(ret, lang);
+        return ret;
+    }
+
+    std::string Generator::ip_addr(bool useIpv6, bool usePort)
+    {
+        std::string ret;
+        ip_addr_into(ret, useIpv6, usePort);
+        return ret;
+    }
+
+    std::string Generator::phone_number()
+    {
+        std::string ret;
+        phone_number_into(ret);
+        return ret;
+    }
+
+#ifndef LIPSUM_MIN_BUILD
+    void Generator::scramble_into(std::string& out,
+                                  int          length,
+                                  char         minChar,
+                                  char         maxChar)
+    {
         if (length < 0)
         {
             internal::LogWarn(internal::LogType::Warn,
@@ -170,54 +365,57 @@ namespace lipsum
                               "got ",
                               length);
         }
-        else
-        {
-            ret.reserve(length);
-        }
         for (int i = 0; i < length; ++i)
         {
-            ret.push_back(random_number(minChar, maxChar));
+            out.push_back(random_number(minChar, maxChar));
         }
-        return ret;
     }
 
-    std::string Generator::url()
+    void Generator::url_into(std::string& out)
     {
-        return std::string("https://") + plain_url() + std::string("/#") +
-               slug('-');
+        out += "https://";
+        plain_url_into(out);
+        out += "/#";
+        slug_into(out, '-');
     }
 
-    std::string Generator::plain_url()
+    void Generator::plain_url_into(std::string& out)
     {
-        return std::string("lpsmcpp-") + m_Source.random_word(m_Gen) + tld();
+        out += "lpsmcpp-";
+        out += source_word();
+        tld_into(out);
     }
 
-    std::string Generator::email()
+    void Generator::email_into(std::string& out)
     {
-        return m_Source.random_word(m_Gen) + std::string(".") +
-               m_Source.random_word(m_Gen) + std::string("@") + plain_url();
+        out += source_word();
+        out += '.';
+        out += source_word();
+        out += '@';
+        plain_url_into(out);
     }
 
-    std::string Generator::slug(char separator)
+    void Generator::slug_into(std::string& out, char separator)
     {
-        std::string result;
+        std::size_t start    = out.size();
         int         numWords = m_Settings.wordURL.roll(m_Gen);
-        result               = word(numWords);
-        std::replace(result.begin(), result.end(), ' ', separator);
-        return result;
+        word_into(out, numWords);
+        std::replace(out.begin() + static_cast<std::ptrdiff_t>(start),
+                     out.end(),
+                     ' ',
+                     separator);
     }
 
-    std::string Generator::case_slug(CaseSlugCase case_)
+    void Generator::case_slug_into(std::string& out, CaseSlugCase case_)
     {
-        std::string ret;
-        std::string innerWord;
+        std::size_t start    = out.size();
         int         numWords = -2;
         switch (case_)
         {
             case CaseSlugCase::CamelCase:
             {
                 numWords = m_Settings.wordURL.roll(m_Gen);
-                ret += m_Source.random_word(m_Gen);
+                out += source_word();
                 --numWords;
                 [[fallthrough]];
             }
@@ -229,43 +427,49 @@ namespace lipsum
                 }
                 for (int i = 0; i < numWords; ++i)
                 {
-                    innerWord       = ClearApostrAndCh('-',
-                                                 '_',
-                                                 m_Source.random_word(m_Gen));
-                    innerWord.at(0) = LPSM_SAFE_CCTYPE(char,
-                                                       std::toupper,
-                                                       innerWord.at(0));
-                    ret += innerWord;
+                    std::size_t wordStart = out.size();
+                    out += source_word();
+                    ClearApostrAndCh(out, wordStart, '-', '_');
+                    if (out.size() > wordStart)
+                    {
+                        out[wordStart] = LPSM_SAFE_CCTYPE(char,
+                                                          std::toupper,
+                                                          out[wordStart]);
+                    }
                 }
                 break;
             }
             case CaseSlugCase::SnakeCase:
             {
-                ret = ClearApostrAndCh('-', slug('_'));
+                slug_into(out, '_');
+                ClearApostrAndCh(out, start, '-');
                 break;
             }
             case CaseSlugCase::ShoutyCase:
             {
-                ret = CapitalizeStr(ClearApostrAndCh('-', slug('_')));
+                slug_into(out, '_');
+                ClearApostrAndCh(out, start, '-');
+                CapitalizeStr(out, start);
                 break;
             }
             case CaseSlugCase::KebabCase:
             {
-                ret = ClearApostrAndCh('_', slug('-'));
+                slug_into(out, '-');
+                ClearApostrAndCh(out, start, '_');
                 break;
             }
             case CaseSlugCase::TrainCase:
             {
-                ret = CapitalizeStr(ClearApostrAndCh('_', slug('-')));
+                slug_into(out, '-');
+                ClearApostrAndCh(out, start, '_');
+                CapitalizeStr(out, start);
                 break;
             }
         }
-        return ret;
     }
 
-    std::string Generator::code(CodeLanguage lang)
+    void Generator::code_into(std::string& out, CodeLanguage lang)
     {
-        std::string              ret;
         std::vector<std::string> varNames;
         std::string              mainNamespace =
                 scramble(m_Settings.wordURL.roll(m_Gen), 'a', 'z');
@@ -278,129 +482,150 @@ namespace lipsum
                               numStatements);
         }
 
-        auto varBlock = [&](CaseSlugCase       varCase,
-                            CaseSlugCase       funcCase,
-                            const std::string& varDeclarer,
-                            const std::string& namespSep)
+        auto commentLine = [&](std::string_view prefix)
+        {
+            out += prefix;
+            single_sentence_into(out, m_Settings.wordFmt, m_Settings.fragFmt);
+            out += '\n';
+        };
+
+        auto varBlock = [&](CaseSlugCase     varCase,
+                            CaseSlugCase     funcCase,
+                            std::string_view varDeclarer,
+                            std::string_view namespSep)
         {
             for (int i = 0; i < numStatements; ++i)
             {
                 varNames.push_back(case_slug(varCase));
-                ret += varDeclarer + varNames.back() + std::string(" = ") +
-                       mainNamespace + namespSep + case_slug(funcCase) +
-                       "();\n";
+                out += varDeclarer;
+                out += varNames.back();
+                out += " = ";
+                out += mainNamespace;
+                out += namespSep;
+                case_slug_into(out, funcCase);
+                out += "();\n";
             }
         };
 
         auto cppBlock = [&]()
         {
-            ret += std::string("#include <") + mainNamespace +
-                   std::string("/") + mainNamespace + ".hpp>\n";
-            ret += "#include <iostream>\nint main()\n{\n";
-            ret += std::string("    // ") +
-                   single_sentence(m_Settings.wordFmt, m_Settings.fragFmt) +
-                   "\n";
+            out += "#include <";
+            out += mainNamespace;
+            out += '/';
+            out += mainNamespace;
+            out += ".hpp>\n";
+            out += "#include <iostream>\nint main()\n{\n";
+            commentLine("    // ");
             varBlock(CaseSlugCase::CamelCase,
                      CaseSlugCase::PascalCase,
                      "    auto ",
                      "::");
-            ret += "    std::cout";
-            for (int i = 0; i < numStatements; ++i)
+            out += "    std::cout";
+            for (const auto& varName : varNames)
             {
-                ret += std::string(" << ") + varNames.at(i) + " << ' '";
+                out += " << ";
+                out += varName;
+                out += " << ' '";
             }
-            ret += " << '\\n';\n    return 0;\n}";
+            out += " << '\\n';\n    return 0;\n}";
         };
 
         auto pyBlock = [&]()
         {
-            ret += std::string("import ") + mainNamespace + "\n";
-            ret += "if __name__ == \"__main__\":\n";
-            ret += std::string("    # ") +
-                   single_sentence(m_Settings.wordFmt, m_Settings.fragFmt) +
-                   "\n";
-            // pyVars();
+            out += "import ";
+            out += mainNamespace;
+            out += '\n';
+            out += "if __name__ == \"__main__\":\n";
+            commentLine("    # ");
             varBlock(CaseSlugCase::SnakeCase,
                      CaseSlugCase::SnakeCase,
                      "    ",
                      ".");
-            ret += "    print(f\"";
-            for (int i = 0; i < numStatements; ++i)
+            out += "    print(f\"";
+            for (const auto& varName : varNames)
             {
-                ret += std::string("{") + varNames.at(i) + std::string("} ");
+                out += '{';
+                out += varName;
+                out += "} ";
             }
-            ret += "\")\n";
+            out += "\")\n";
         };
 
         auto rsBlock = [&]()
         {
-            ret += std::string("use ") + mainNamespace + ";\n";
-            ret += "fn main()\n{\n";
-            ret += std::string("    // ") +
-                   single_sentence(m_Settings.wordFmt, m_Settings.fragFmt) +
-                   "\n";
-            // rsVars();
+            out += "use ";
+            out += mainNamespace;
+            out += ";\n";
+            out += "fn main()\n{\n";
+            commentLine("    // ");
             varBlock(CaseSlugCase::SnakeCase,
                      CaseSlugCase::SnakeCase,
                      "    let ",
                      "::");
-            ret += "    println!(\"";
+            out += "    println!(\"";
             for (int i = 0; i < numStatements; ++i)
             {
-                ret += std::string("{} ");
+                out += "{} ";
             }
-            ret += "\"";
-            for (int i = 0; i < numStatements; ++i)
+            out += '"';
+            for (const auto& varName : varNames)
             {
-                ret += std::string(", ") + varNames.at(i);
+                out += ", ";
+                out += varName;
             }
-            ret += ");\n}";
+            out += ");\n}";
         };
 
         auto cBlock = [&]()
         {
-            ret += std::string("#include <") + mainNamespace +
-                   std::string("/") + mainNamespace + ".h>\n";
-            ret += "#include <stdio.h>\n";
-            ret += "int main(void)\n{\n";
-            ret += std::string("    // ") +
-                   single_sentence(m_Settings.wordFmt, m_Settings.fragFmt) +
-                   "\n";
+            out += "#include <";
+            out += mainNamespace;
+            out += '/';
+            out += mainNamespace;
+            out += ".h>\n";
+            out += "#include <stdio.h>\n";
+            out += "int main(void)\n{\n";
+            commentLine("    // ");
             varBlock(CaseSlugCase::CamelCase,
                      CaseSlugCase::PascalCase,
                      "    int ",
                      "_");
-            ret += "    printf(\"";
+            out += "    printf(\"";
             for (int i = 0; i < numStatements; ++i)
             {
-                ret += std::string("%d ");
+                out += "%d ";
             }
-            ret += "\"";
-            for (int i = 0; i < numStatements; ++i)
+            out += '"';
+            for (const auto& varName : varNames)
             {
-                ret += std::string(", ") + varNames.at(i);
+                out += ", ";
+                out += varName;
             }
-            ret += ");\n}";
+            out += ");\n}";
         };
 
         auto jsBlock = [&]()
         {
-            ret += std::string("import * as ") + mainNamespace +
-                   std::string(" from \"./") + mainNamespace + ".js\";\n";
-            ret += std::string("// ") +
-                   single_sentence(m_Settings.wordFmt, m_Settings.fragFmt) +
-                   "\n";
+            out += "import * as ";
+            out += mainNamespace;
+            out += " from \"./";
+            out += mainNamespace;
+            out += ".js\";\n";
+            commentLine("// ");
             varBlock(CaseSlugCase::CamelCase,
                      CaseSlugCase::CamelCase,
                      "const ",
                      ".");
-            ret += "console.log(";
-            ret += varNames.front();
-            for (int i = 1; i < numStatements; ++i)
+            out += "console.log(";
+            for (std::size_t i = 0; i < varNames.size(); ++i)
             {
-                ret += std::string(", \" \", ") + varNames.at(i);
+                if (i != 0)
+                {
+                    out += ", \" \", ";
+                }
+                out += varNames[i];
             }
-            ret += ");\n";
+            out += ");\n";
         };
 
         switch (lang)
@@ -431,87 +656,81 @@ namespace lipsum
                 break;
             }
         }
-        return ret;
     }
 
-    std::string Generator::ip_addr(bool useIpv6, bool usePort)
+    void Generator::ip_addr_into(std::string& out, bool useIpv6, bool usePort)
     {
-        std::ostringstream ret;
-        std::string port = internal::ToString(random_number(1023, 65535));
+        constexpr int HEX_BASE = 16;
+
+        int port = random_number(1023, 65535);
         if (useIpv6)
         {
-            ret << (usePort ? "[" : "");
-            ret << std::hex;
+            if (usePort)
+            {
+                out += '[';
+            }
             for (int i = 0; i < 7; ++i)
             {
-                ret << random_number(0, 65535) << ":";
+                internal::AppendNumber(out, random_number(0, 65535), HEX_BASE);
+                out += ':';
             }
-            ret << random_number(0, 65535);
-            ret << (usePort ? "]" : "");
+            internal::AppendNumber(out, random_number(0, 65535), HEX_BASE);
             if (usePort)
             {
-                ret << ":" << port;
+                out += "]:";
+                internal::AppendNumber(out, port);
             }
-            return ret.str();
+            return;
         }
-        ret << random_number(0, 255) << ".";
-        ret << random_number(0, 255) << ".";
-        ret << random_number(0, 255) << ".";
-        ret << random_number(0, 255);
+        for (int i = 0; i < 3; ++i)
+        {
+            internal::AppendNumber(out, random_number(0, 255));
+            out += '.';
+        }
+        internal::AppendNumber(out, random_number(0, 255));
         if (usePort)
         {
-            ret << ":";
-            ret << port;
+            out += ':';
+            internal::AppendNumber(out, port);
         }
-        return ret.str();
     }
 
-    std::string Generator::phone_number()
+    void Generator::phone_number_into(std::string& out)
     {
-        std::string ret = "(+1) ";
-        ret += internal::ToString(random_number(0, 999));
-        ret += "-";
-        ret += internal::ToString(random_number(0, 999));
-        ret += "-";
-        ret += internal::ToString(random_number(0, 9999));
-        return ret;
+        out += "(+1) ";
+        internal::AppendNumber(out, random_number(0, 999));
+        out += '-';
+        internal::AppendNumber(out, random_number(0, 999));
+        out += '-';
+        internal::AppendNumber(out, random_number(0, 9999));
     }
 #else
-    std::string Generator::phone_number()
+    void Generator::phone_number_into(std::string&)
     {
-        return "";
     }
-    std::string Generator::scramble(int, char, char)
+    void Generator::scramble_into(std::string&, int, char, char)
     {
-        return "";
     }
-    std::string Generator::url()
+    void Generator::url_into(std::string&)
     {
-        return "";
     }
-    std::string Generator::plain_url()
+    void Generator::plain_url_into(std::string&)
     {
-        return "";
     }
-    std::string Generator::email()
+    void Generator::email_into(std::string&)
     {
-        return "";
     }
-    std::string Generator::slug(char)
+    void Generator::slug_into(std::string&, char)
     {
-        return "";
     }
-    std::string Generator::case_slug(CaseSlugCase)
+    void Generator::case_slug_into(std::string&, CaseSlugCase)
     {
-        return "";
     }
-    std::string Generator::code(CodeLanguage)
+    void Generator::code_into(std::string&, CodeLanguage)
     {
-        return "";
     }
-    std::string Generator::ip_addr(bool, bool)
+    void Generator::ip_addr_into(std::string&, bool, bool)
     {
-        return "";
     }
 #endif
 
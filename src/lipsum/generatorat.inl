@@ -0,0 +1,191 @@
+/**
+ * @file lipsum/generatorat.inl
+ *
+ * @brief Definition of lipsum::Generator functions for random access
+ *
+ * This defines the functions in lipsum::Generator that generate text by
+ * index. This file is under the BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+
+#pragma once
+
+#include "core/internal.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum
+{
+
+    /*
+     * RANDOM ACCESS
+     */
+
+    std::string Generator::word_at(std::uint64_t first, int num)
+    {
+        std::string ret;
+        word_at_into(ret, first, num);
+        return ret;
+    }
+
+    void Generator::word_at_into(std::string& out, std::uint64_t first, int num)
+    {
+        if (num < 0)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::Generator::word_at(): expected num >= 0, "
+                              "got ",
+                              num);
+        }
+
+        for (int i = 0; i < num; ++i)
+        {
+            std::uint64_t index = first + static_cast<std::uint64_t>(i);
+            load_unit(UnitType::Word, index);
+            if (index != 0)
+            {
+                out += ' ';
+            }
+            out += source_word();
+        }
+    }
+
+    std::string
+    Generator::sentence_at(std::uint64_t first, int num, bool useLipsum)
+    {
+        std::string ret;
+        sentence_at_into(ret, first, num, useLipsum);
+        return ret;
+    }
+
+    void Generator::sentence_at_into(std::string&  out,
+                                     std::uint64_t first,
+                                     int           num,
+                                     bool          useLipsum)
+    {
+        if (num < 0)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::Generator::sentence_at(): expected num "
+                              ">= 0, got ",
+                              num);
+        }
+
+        for (int i = 0; i < num; ++i)
+        {
+            std::uint64_t index = first + static_cast<std::uint64_t>(i);
+            load_unit(UnitType::Sentence, index);
+            if (index == 0 && useLipsum)
+            {
+                out += internal::LIPSUM_DEFAULT_SENTENCE;
+            }
+            else
+            {
+                single_sentence_into(out, m_Settings.word, m_Settings.frag);
+            }
+            out += ' ';
+        }
+    }
+
+    std::string
+    Generator::paragraph_at(std::uint64_t first, int num, bool useLipsum)
+    {
+        std::string ret;
+        paragraph_at_into(ret, first, num, useLipsum);
+        return ret;
+    }
+
+    void Generator::paragraph_at_into(std::string&  out,
+                                      std::uint64_t first,
+                                      int           num,
+                                      bool          useLipsum)
+    {
+        if (num < 0)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::Generator::paragraph_at(): expected num "
+                              ">= 0, got ",
+                              num);
+        }
+
+        for (int i = 0; i < num; ++i)
+        {
+            std::uint64_t index = first + static_cast<std::uint64_t>(i);
+            load_unit(UnitType::Paragraph, index);
+            single_paragraph_into(out, index == 0 && useLipsum);
+        }
+    }
+
+    std::string Generator::json_at(std::uint64_t index, int maxDepth)
+    {
+        std::string ret;
+        json_at_into(ret, index, maxDepth);
+        return ret;
+    }
+
+    void Generator::json_at_into(std::string&  out,
+                                 std::uint64_t index,
+                                 int           maxDepth)
+    {
+        load_unit(UnitType::Json, index);
+        json_into(out, maxDepth, OBJECT);
+    }
+
+    std::string Generator::csv_at(std::uint64_t first, int numRows)
+    {
+        std::string ret;
+        csv_at_into(ret, first, numRows);
+        return ret;
+    }
+
+    void
+    Generator::csv_at_into(std::string& out, std::uint64_t first, int numRows)
+    {
+        if (numRows < 0)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::Generator::csv_at(): expected numRows "
+                              ">= 0, got ",
+                              numRows);
+        }
+
+        // the columns come from the header, so it is rolled even when it is
+        // not written
+        std::vector<CsvType> cols;
+        load_unit(UnitType::CsvHeader, 0);
+        if (first == 0)
+        {
+            csv_header_into(out, cols);
+        }
+        else
+        {
+            std::string header;
+            csv_header_into(header, cols);
+        }
+
+        for (int i = 0; i < numRows; ++i)
+        {
+            load_unit(UnitType::CsvRow, first + static_cast<std::uint64_t>(i));
+            csv_row_into(out, cols);
+        }
+    }
+
+    /*
+     * PRIVATE
+     */
+
+    void Generator::load_unit(UnitType type, std::uint64_t index)
+    {
+        constexpr std::uint64_t INDEX_MASK =
+                (std::uint64_t{1} << UNIT_INDEX_BITS) - 1;
+
+        m_Gen.seed(m_Gen.root_seed(),
+                   (static_cast<std::uint64_t>(type) << UNIT_INDEX_BITS) |
+                           (index & INDEX_MASK));
+        m_Bits.reset();
+        m_MarkovState = MarkovSource::START_STATE;
+    }
+} // namespace lipsum
+#endif
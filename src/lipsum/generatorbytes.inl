@@ -0,0 +1,468 @@
+/**
+ * @file lipsum/generatorbytes.inl
+ *
+ * @brief Definition of lipsum::Generator functions for byte budgets
+ *
+ * This defines the functions in lipsum::Generator that generate text of an
+ * exact size. This file is under the BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+
+#pragma once
+
+#include "core/internal.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum
+{
+
+    /*
+     * BYTE BUDGETS
+     */
+
+    std::string Generator::paragraph_bytes(std::size_t bytes, bool useLipsum)
+    {
+        std::string ret;
+        ret.reserve(bytes);
+        paragraph_bytes_into(ret, bytes, useLipsum);
+        return ret;
+    }
+
+    void Generator::paragraph_bytes_into(std::string& out,
+                                         std::size_t  bytes,
+                                         bool         useLipsum)
+    {
+        paragraph_bytes_chunked(out, nullptr, bytes, useLipsum);
+    }
+
+    void Generator::paragraph_bytes_to(Sink&       sink,
+                                       std::size_t bytes,
+                                       bool        useLipsum)
+    {
+        paragraph_bytes_chunked(sink.buffer(), &sink, bytes, useLipsum);
+    }
+
+    std::string Generator::fmt_text_bytes(std::size_t bytes, bool useHtml)
+    {
+        std::string ret;
+        ret.reserve(bytes);
+        fmt_text_bytes_into(ret, bytes, useHtml);
+        return ret;
+    }
+
+    void Generator::fmt_text_bytes_into(std::string& out,
+                                        std::size_t  bytes,
+                                        bool         useHtml)
+    {
+        if (useHtml)
+        {
+            fmt_text_bytes_chunked<internal::HtmlFormat>(out, nullptr, bytes);
+        }
+        else
+        {
+            fmt_text_bytes_chunked<internal::MarkdownFormat>(out,
+                                                             nullptr,
+                                                             bytes);
+        }
+    }
+
+    void
+    Generator::fmt_text_bytes_to(Sink& sink, std::size_t bytes, bool useHtml)
+    {
+        if (useHtml)
+        {
+            fmt_text_bytes_chunked<internal::HtmlFormat>(sink.buffer(),
+                                                         &sink,
+                                                         bytes);
+        }
+        else
+        {
+            fmt_text_bytes_chunked<internal::MarkdownFormat>(sink.buffer(),
+                                                             &sink,
+                                                             bytes);
+        }
+    }
+
+    std::string Generator::json_bytes(std::size_t bytes, int maxDepth)
+    {
+        std::string ret;
+        ret.reserve(bytes);
+        json_bytes_into(ret, bytes, maxDepth);
+        return ret;
+    }
+
+    void Generator::json_bytes_into(std::string& out,
+                                    std::size_t  bytes,
+                                    int          maxDepth)
+    {
+        json_bytes_chunked(out, nullptr, bytes, maxDepth);
+    }
+
+    void Generator::json_bytes_to(Sink& sink, std::size_t bytes, int maxDepth)
+    {
+        json_bytes_chunked(sink.buffer(), &sink, bytes, maxDepth);
+    }
+
+    /*
+     * PRIVATE
+     */
+
+    const Generator::FitTable& Generator::fit_table()
+    {
+        bool escaped = m_EscapeWords && m_Source->needs_escaping();
+        if (m_FitTable && m_FitTable->source == m_Source &&
+            m_FitTable->escaped == escaped)
+        {
+            return *m_FitTable;
+        }
+
+        LPSM_VERBOSE_LOG(Trace, "Indexing the words of the source by length");
+        auto table     = std::make_shared<FitTable>();
+        table->source  = m_Source;
+        table->escaped = escaped;
+        for (std::size_t i = 0; i < m_Source->size(); ++i)
+        {
+            std::string_view word = m_Source->word_at(i);
+            std::size_t      length =
+                    (escaped ? m_Source->escaped_word(word) : word).size();
+            if (length != 0 && length <= FIT_MAX_LENGTH &&
+                table->words[length].size() < FIT_WORDS_PER_LENGTH)
+            {
+                table->words[length].push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+
+        // a sentence is words each followed by a space, a comma and a space,
+        // or, for the last one, a period
+        table->reach.fill(false);
+        for (std::size_t size = 1; size <= FIT_WINDOW; ++size)
+        {
+            for (std::size_t length = 1;
+                 length <= FIT_MAX_LENGTH && length < size;
+                 ++length)
+            {
+                if (table->words[length].empty())
+                {
+                    continue;
+                }
+                std::size_t rest = size - length;
+                if (rest == 1 || table->reach[rest - 1] ||
+                    (rest > 2 && table->reach[rest - 2]))
+                {
+                    table->reach[size] = true;
+                    break;
+                }
+            }
+        }
+
+        m_FitTable = std::move(table);
+        return *m_FitTable;
+    }
+
+    void Generator::fit_sentence_into(std::string& out, std::size_t length)
+    {
+        const FitTable& table = fit_table();
+        std::size_t     start = out.size();
+        std::size_t     left  = length;
+        m_MarkovState         = MarkovSource::START_STATE;
+
+        // random words, each followed by a space, while the rest is too
+        // large to plan; give up on sources of only long words
+        constexpr int MAX_REJECTED = 16;
+        int           rejected     = 0;
+        while (left > FIT_WINDOW && rejected < MAX_REJECTED)
+        {
+            std::string_view word = source_word();
+            if (word.size() + 1 > left - FIT_WINDOW / 2)
+            {
+                ++rejected;
+                continue;
+            }
+            out += word;
+            out += ' ';
+            left -= word.size() + 1;
+        }
+
+        // then only words after which the rest can still be filled
+        std::array<std::size_t, FIT_MAX_LENGTH> lengths{};
+        while (left <= FIT_WINDOW && table.reach[left])
+        {
+            std::size_t count      = 0;
+            std::size_t separators = 1;
+            for (; count == 0 && separators <= 2; ++separators)
+            {
+                for (std::size_t size = 1;
+                     size <= FIT_MAX_LENGTH && size + separators <= left;
+                     ++size)
+                {
+                    std::size_t rest = left - size - separators;
+                    if (!table.words[size].empty() &&
+                        ((separators == 1 && rest == 0) ||
+                         (rest != 0 && table.reach[rest])))
+                    {
+                        lengths[count++] = size;
+                    }
+                }
+            }
+            --separators;
+
+            std::size_t size = lengths[random_number<std::size_t>(0,
+                                                                  count - 1)];
+            const std::vector<std::uint32_t>& words = table.words[size];
+            std::string_view                  word  = m_Source->word_at(
+                    words[random_number<std::size_t>(0, words.size() - 1)]);
+            out += (table.escaped ? m_Source->escaped_word(word) : word);
+            left -= size + separators;
+            if (left == 0)
+            {
+                out += '.';
+                break;
+            }
+            out += (separators == 2 ? ", " : " ");
+        }
+
+        if (left != 0)
+        {
+            // no sentence of this size: end it here and pad it
+            if (out.size() > start)
+            {
+                out.back() = '.';
+            }
+            out.append(left, ' ');
+            LPSM_VERBOSE_LOG(Trace, "Padded a sentence with ", left, " spaces");
+        }
+        if (out.size() > start)
+        {
+            out[start] = LPSM_SAFE_CCTYPE(char, std::toupper, out[start]);
+        }
+    }
+
+    void Generator::paragraph_bytes_chunked(std::string& out,
+                                            Sink*        sink,
+                                            std::size_t  bytes,
+                                            bool         useLipsum)
+    {
+        // a tab, a space before the last sentence and a newline
+        constexpr std::size_t PARAGRAPH_FRAME = 3;
+
+        if (bytes < 2)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::Generator::paragraph_bytes(): expected "
+                              "bytes >= 2, got ",
+                              bytes);
+            return;
+        }
+
+        std::size_t left  = bytes;
+        bool        first = useLipsum;
+        while (true)
+        {
+            out += '\t';
+            --left;
+            int  sents  = m_Settings.sent.roll(m_Gen);
+            bool isLast = left < FIT_WINDOW + 1;
+            for (int i = 0; i < sents && !isLast; ++i)
+            {
+                std::size_t before = out.size();
+                if (i != 0)
+                {
+                    out += ' ';
+                }
+                if (i == 0 && first)
+                {
+                    out += internal::LIPSUM_DEFAULT_SENTENCE;
+                }
+                else
+                {
+                    single_sentence_into(out, m_Settings.word, m_Settings.frag);
+                }
+
+                // keep room for a fitted sentence after this one
+                std::size_t size = out.size() - before;
+                if (size + FIT_WINDOW + PARAGRAPH_FRAME > left)
+                {
+                    out.resize(before);
+                    isLast = true;
+                    break;
+                }
+                left -= size;
+            }
+
+            if (isLast)
+            {
+                if (out.back() != '\t')
+                {
+                    out += ' ';
+                    --left;
+                }
+                fit_sentence_into(out, left - 1);
+                out += '\n';
+                if (sink != nullptr)
+                {
+                    sink->commit();
+                }
+                return;
+            }
+
+            out += '\n';
+            --left;
+            first = false;
+            if (sink != nullptr)
+            {
+                sink->commit();
+            }
+        }
+    }
+
+    template <internal::FormatPolicy Format>
+    void Generator::fmt_text_bytes_chunked(std::string& out,
+                                           Sink*        sink,
+                                           std::size_t  bytes)
+    {
+        // the last paragraph: a space after its sentence and its tags, which
+        // end with a blank line
+        constexpr std::size_t PARAGRAPH_FRAME =
+                Format::PARAGRAPH_OPEN.size() + Format::PARAGRAPH_CLOSE.size() +
+                1;
+
+        if (bytes < PARAGRAPH_FRAME - 1)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::Generator::fmt_text_bytes(): expected "
+                              "bytes >= ",
+                              PARAGRAPH_FRAME - 1,
+                              ", got ",
+                              bytes);
+            return;
+        }
+
+        // a header and a paragraph, as in fmt_text(), then random elements
+        std::size_t left     = bytes;
+        int         lastKind = 0;
+        for (int i = 0; left >= FIT_WINDOW + PARAGRAPH_FRAME; ++i)
+        {
+            std::size_t before = out.size();
+            if (i == 0)
+            {
+                fmt_header_into<Format>(out, 1);
+                lastKind = 1;
+            }
+            else if (i == 1)
+            {
+                single_fmt_paragraph_into<Format>(out, NO_USELIPSUM);
+                lastKind = 0;
+            }
+            else
+            {
+                lastKind = fmt_element_into<Format>(out, lastKind, false);
+            }
+
+            std::size_t size = out.size() - before;
+            if (size + FIT_WINDOW + PARAGRAPH_FRAME > left)
+            {
+                out.resize(before);
+                break;
+            }
+            left -= size;
+            if (sink != nullptr)
+            {
+                sink->commit();
+            }
+        }
+
+        out += Format::PARAGRAPH_OPEN;
+        bool escape = std::exchange(m_EscapeWords, Format::ESCAPES_WORDS);
+        // an empty paragraph if there is no room for its space
+        if (left >= PARAGRAPH_FRAME)
+        {
+            fit_sentence_into(out, left - PARAGRAPH_FRAME);
+            out += ' ';
+        }
+        m_EscapeWords = escape;
+        out += Format::PARAGRAPH_CLOSE;
+        if (sink != nullptr)
+        {
+            sink->commit();
+        }
+    }
+
+    void Generator::json_bytes_chunked(std::string& out,
+                                       Sink*        sink,
+                                       std::size_t  bytes,
+                                       int          maxDepth)
+    {
+        // a key is a word and a number; keep room for a long one in the last
+        // member
+        constexpr std::size_t KEY_ROOM = FIT_MAX_LENGTH + 16;
+
+        if (bytes < 2)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::Generator::json_bytes(): expected bytes "
+                              ">= 2, got ",
+                              bytes);
+            return;
+        }
+
+        auto commit = [sink]()
+        {
+            if (sink != nullptr)
+            {
+                sink->commit();
+            }
+        };
+
+        // the braces
+        std::size_t left = bytes - 2;
+        int         i    = 0;
+        out += '{';
+        for (; left >= FIT_WINDOW + KEY_ROOM; ++i)
+        {
+            std::size_t before = out.size();
+            if (i != 0)
+            {
+                out += ',';
+            }
+            json_key_into(out, i);
+            json_value_into(out, maxDepth - 1);
+
+            std::size_t size = out.size() - before;
+            if (size + FIT_WINDOW + KEY_ROOM > left)
+            {
+                out.resize(before);
+                break;
+            }
+            left -= size;
+            commit();
+        }
+
+        // a last member with a string value, or spaces if its key does not
+        // fit
+        std::size_t before = out.size();
+        if (i != 0)
+        {
+            out += ',';
+        }
+        json_key_into(out, i);
+        std::size_t size = out.size() - before;
+        if (size + 2 <= left)
+        {
+            left -= size + 2;
+            out += '"';
+            fit_sentence_into(out, left);
+            out += '"';
+        }
+        else
+        {
+            out.resize(before);
+            out.append(left, ' ');
+        }
+        out += '}';
+        commit();
+    }
+} // namespace lipsum
+#endif
@@ -67,11 +67,58 @@ namespace lipsum
         }
     }
 
+#ifndef LIPSUM_MIN_BUILD
+    void GeneratorSettings::change_weights(const std::string&   setting,
+                                           const WeightedTable& value)
+    {
+        auto assignSetting = [&](const char*    name,
+                                 WeightedTable& target) -> bool
+        {
+            if (setting != name)
+            {
+                return false;
+            }
+            if (value.size() != target.size())
+            {
+                internal::LogWarn(internal::LogType::Warn,
+                                  "lpsm::GeneratorSettings::change_weights(): "
+                                  "setting ",
+                                  setting,
+                                  " expects ",
+                                  target.size(),
+                                  " weights, got ",
+                                  value.size(),
+                                  ", ignoring");
+                return true;
+            }
+            target = value;
+            return true;
+        };
+        bool isChecked = false;
+        LPSM_VERBOSE_LOG(Trace, "Changing weights of setting ", setting);
+
+        LPSM_ASSIGN_CHECK(separator);
+        LPSM_ASSIGN_CHECK(endMark);
+        LPSM_ASSIGN_CHECK(fmtSentence);
+        LPSM_ASSIGN_CHECK(tld);
+        if (!isChecked)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::GeneratorSettings::change_weights(): "
+                              "unknown "
+                              "setting ",
+                              setting,
+                              ", ignoring");
+        }
+    }
+#endif
+
     /*
      * SETUP
      */
 
     Generator::Generator()
+        : m_Source(SourceRegistry::global().get("default"))
     {
         m_Gen.seed(std::random_device{}());
         LPSM_VERBOSE_LOG(Info, "Creating a lpsm::Generator");
@@ -83,6 +130,7 @@ namespace lipsum
     }
 
     Generator::Generator(int seed)
+        : m_Source(SourceRegistry::global().get("default"))
     {
         m_Gen.seed(seed);
         LPSM_VERBOSE_LOG(Info, "Creating a lpsm::Generator with seed ", seed);
@@ -105,18 +153,68 @@ namespace lipsum
                          path);
     }
 
+    Generator::Generator(std::shared_ptr<const Source> source, int seed)
+    {
+        load_source(std::move(source));
+        m_Gen.seed(seed);
+        LPSM_VERBOSE_LOG(Info,
+                         "Creating a lpsm::Generator with seed ",
+                         seed,
+                         " and a shared source");
+    }
+
     void Generator::load_source(const std::string& path)
     {
-        m_Source.load(path);
+        // loaded afresh, not through the registry, so that a changed file is
+        // read again
+        auto source = std::make_shared<Source>();
+        source->load(path);
+        m_Source = std::move(source);
         LPSM_VERBOSE_LOG(Trace, "Loading source ", path);
     }
 
+    void Generator::load_source(std::shared_ptr<const Source> source)
+    {
+        if (!source)
+        {
+            source = SourceRegistry::global().get("default");
+        }
+        m_Source = std::move(source);
+        LPSM_VERBOSE_LOG(Trace, "Loading a shared source");
+    }
+
+    const std::shared_ptr<const Source>& Generator::source() const
+    {
+        return m_Source;
+    }
+
     void Generator::load_seed(int seed)
     {
         m_Gen.seed(seed);
+        m_Bits.reset();
+#ifndef LIPSUM_MIN_BUILD
+        m_MarkovState = MarkovSource::START_STATE;
+#endif
         LPSM_VERBOSE_LOG(Trace, "Loading seed ", seed);
     }
 
+    void Generator::load_stream(std::uint64_t seed, std::uint64_t stream)
+    {
+        m_Gen.seed(seed, stream);
+        m_Bits.reset();
+#ifndef LIPSUM_MIN_BUILD
+        m_MarkovState = MarkovSource::START_STATE;
+#endif
+        LPSM_VERBOSE_LOG(Trace, "Loading seed ", seed, " stream ", stream);
+    }
+
+    void Generator::load_engine(EngineType type)
+    {
+        m_Gen.set_type(type);
+        m_Bits.reset();
+        LPSM_VERBOSE_LOG(Trace, "Loading engine ", Engine::name(type));
+    }
+
     void Generator::change_setting(const std::string& setting,
                                    const ArgVec2&     value)
     {
@@ -130,10 +228,85 @@ namespace lipsum
         change_setting(setting, ArgVec2(minValue, maxValue));
     }
 
+#ifndef LIPSUM_MIN_BUILD
+    void Generator::change_weights(const std::string&   setting,
+                                   const WeightedTable& value)
+    {
+        m_Settings.change_weights(setting, value);
+    }
+
+    void Generator::use_word_frequencies(bool enabled)
+    {
+        m_UseFrequencies = enabled;
+        LPSM_VERBOSE_LOG(Trace, "Using word frequencies: ", enabled);
+    }
+
+    void Generator::load_markov(std::shared_ptr<const MarkovSource> model)
+    {
+        if (model && model->size() == 0)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::Generator::load_markov(): Markov model is "
+                              "empty; ignoring");
+            return;
+        }
+        m_Markov      = std::move(model);
+        m_MarkovState = MarkovSource::START_STATE;
+        LPSM_VERBOSE_LOG(Trace, "Using Markov model: ", m_Markov != nullptr);
+    }
+
+    const std::shared_ptr<const MarkovSource>& Generator::markov() const
+    {
+        return m_Markov;
+    }
+#endif
+
     /*
      * PRIVATE
      */
 
+    std::string_view Generator::source_word()
+    {
+#ifndef LIPSUM_MIN_BUILD
+        std::string_view word;
+        if (m_Markov)
+        {
+            word = m_Markov->next_word(m_Gen, m_MarkovState);
+        }
+        else if (m_UseFrequencies)
+        {
+            word = m_Source->weighted_word_view(m_Gen);
+        }
+        else
+        {
+            word = m_Source->random_word_view(m_Gen);
+        }
+        return (m_EscapeWords ? escaped_word(word) : word);
+#else
+        return m_Source->random_word_view(m_Gen);
+#endif
+    }
+
+#ifndef LIPSUM_MIN_BUILD
+    std::string_view Generator::escaped_word(std::string_view word) const
+    {
+        if (m_Markov)
+        {
+            return m_Markov->escaped_word(word);
+        }
+        return m_Source->escaped_word(word);
+    }
+
+    std::string_view Generator::xml_name(std::string_view word) const
+    {
+        if (m_Markov)
+        {
+            return m_Markov->xml_name(word);
+        }
+        return m_Source->xml_name(word);
+    }
+#endif
+
     char Generator::random_number(char min, char max)
     {
         return static_cast<char>(
@@ -142,189 +315,121 @@ namespace lipsum
 
     bool Generator::random_number(bool min, bool max)
     {
-        int choice = random_number(0, 1);
-        return choice == 0 ? min : max;
+        return m_Bits.flip(m_Gen) ? max : min;
     }
 
-    int Generator::weighted_random_idx(const std::vector<int>& weights)
+    std::size_t Generator::weighted_random_idx(const WeightedTable& table)
     {
-        std::discrete_distribution<> dist(weights.begin(), weights.end());
-        return dist(m_Gen);
+        return table.sample(m_Gen);
     }
 
 #ifndef LIPSUM_MIN_BUILD
-    std::string Generator::tld()
-    {
-        std::vector<std::string>      tlds    = {{".com"},
-                                                 {".org"},
-                                                 {".net"},
-                                                 {".edu"},
-                                                 {".io"},
-                                                 {".ca"},
-                                                 {".co.uk"}};
-        static const std::vector<int> weights = {70, 10, 7, 5, 5, 2, 1};
-        int                           idx     = weighted_random_idx(weights);
-        return tlds.at(idx);
-    }
-
-    std::string Generator::single_sentence(const ArgVec2& wordArg,
-                                           const ArgVec2& frag)
-    {
-        static const std::vector<int>         weights        = {88, 7, 3, 2};
-        static const std::vector<int>         weightsEndMark = {80, 15, 5};
-        static const std::vector<std::string> mapped         = {", ",
-                                                                "; ",
-                                                                ": ",
-                                                                " - "};
-        static const std::vector<std::string> mappedEndMark  = {".", "?", "!"};
-        std::string                           result;
-        int                                   words;
-        int                                   frags = frag.roll(m_Gen);
-        for (int i = 0; i < frags; ++i)
-        {
-            words = wordArg.roll(m_Gen);
-            result += word(words);
-            int check = weighted_random_idx(weights);
-            // don't do if only one fragment
-            if (i != frags - 1)
-            {
-                result += mapped.at(check);
-            }
-        }
-        result += mappedEndMark.at(weighted_random_idx(weightsEndMark));
-        result.at(0) = LPSM_SAFE_CCTYPE(char, std::toupper, result.at(0));
-        return result;
+    void Generator::tld_into(std::string& out)
+    {
+        static constexpr std::array<std::string_view, 7> TLDS = {
+                ".com", ".org", ".net", ".edu", ".io", ".ca", ".co.uk"};
+
+        out += TLDS.at(m_Settings.tld.sample(m_Gen));
     }
 
-    std::string Generator::single_fmt_paragraph(bool useLipsum, bool useHtml)
+    void Generator::single_sentence_into(std::string&   out,
+                                         const ArgVec2& wordArg,
+                                         const ArgVec2& frag)
     {
-        std::string   ret;
-        int           sents = m_Settings.sent.roll(m_Gen);
-        int           fmtRoll;
-        bool          addLink;
-        bool          isBold;
-        constexpr int FMT_PARA_CHANCE_FMT = 14;
+        static constexpr std::array<std::string_view, 4> MAPPED = {
+                ", ", "; ", ": ", " - "};
+        static constexpr std::array<char, 3> MAPPED_END_MARK = {'.', '?', '!'};
 
-        // 1 in 15
-        static const std::vector<int> weights = {FMT_PARA_CHANCE_FMT, 1};
+        m_MarkovState = MarkovSource::START_STATE;
 
-        if (useHtml)
-        {
-            ret += "<p>";
-        }
-        for (int i = 0; i < sents; ++i)
+        std::size_t start = out.size();
+        int         words;
+        int         frags = frag.roll(m_Gen);
+        for (int i = 0; i < frags; ++i)
         {
-            fmtRoll = weighted_random_idx(weights);
-            if (fmtRoll == 1)
-            {
-                addLink = LPSM_FLIP_COIN;
-                isBold  = LPSM_FLIP_COIN;
-            }
-            if (i == 0 && useLipsum)
-            {
-                ret += GenerateDefaultLipsumSentence();
-            }
-            else if ((fmtRoll == 1) && addLink)
-            {
-                ret += fmt_link(useHtml);
-            }
-            else if ((fmtRoll == 1) && !addLink)
-            {
-                ret += fmt_emphasis(isBold, useHtml);
-            }
-            else
+            words = wordArg.roll(m_Gen);
+            word_into(out, words);
+            std::size_t check = m_Settings.separator.sample(m_Gen);
+            // don't do if only one fragment
+            if (i != frags - 1)
             {
-                ret += single_sentence(m_Settings.word, m_Settings.frag);
+                out += MAPPED.at(check);
             }
-            ret += " ";
         }
-        if (useHtml)
-        {
-            ret += "</p>";
-        }
-        ret += "\n\n";
-        return ret;
+        out += MAPPED_END_MARK.at(m_Settings.endMark.sample(m_Gen));
+        out[start] = LPSM_SAFE_CCTYPE(char, std::toupper, out[start]);
     }
 
-    std::string Generator::json_string()
+    void Generator::json_string_into(std::string& out)
     {
-        return std::string("\"") + m_Source.random_word(m_Gen) + "\"";
+        out += '"';
+        out += source_word();
+        out += '"';
     }
 
-    std::string Generator::json_number()
+    void Generator::json_number_into(std::string& out)
     {
         constexpr int JSON_NUMBER_MIN = -1000;
         constexpr int JSON_NUMBER_MAX = 1000;
-        return internal::ToString(
-                random_number(JSON_NUMBER_MIN, JSON_NUMBER_MAX));
+        internal::AppendNumber(out,
+                               random_number(JSON_NUMBER_MIN, JSON_NUMBER_MAX));
     }
 #else
-    std::string Generator::tld()
+    void Generator::tld_into(std::string& out)
     {
-        return ".com";
+        out += ".com";
     }
 
-    std::string Generator::single_sentence(const ArgVec2& wordArg,
-                                           const ArgVec2& frag)
+    void Generator::single_sentence_into(std::string&   out,
+                                         const ArgVec2& wordArg,
+                                         const ArgVec2& frag)
     {
-        std::string result;
+        std::size_t start = out.size();
         int         words;
         int         frags = frag.roll(m_Gen);
         for (int i = 0; i < frags; ++i)
         {
             words = wordArg.roll(m_Gen);
-            result += word(words);
+            word_into(out, words);
             if (i != frags - 1)
             {
-                result += ", ";
+                out += ", ";
             }
         }
-        result += ".";
-        result.at(0) = LPSM_SAFE_CCTYPE(char, std::toupper, result.at(0));
-        return result;
+        out += '.';
+        out[start] = LPSM_SAFE_CCTYPE(char, std::toupper, out[start]);
     }
 
     // placeholder
 
-    std::string Generator::single_fmt_paragraph(bool, bool)
+    void Generator::json_string_into(std::string&)
     {
-        return "";
     }
 
-    std::string Generator::json_string()
+    void Generator::json_number_into(std::string&)
     {
-        return "";
-    }
-
-    std::string Generator::json_number()
-    {
-        return "";
     }
 #endif
 
-    std::string Generator::single_paragraph(bool useLipsum)
+    void Generator::single_paragraph_into(std::string& out, bool useLipsum)
     {
-        std::string result = "\t";
-        int         sents  = m_Settings.sent.roll(m_Gen);
+        int sents = m_Settings.sent.roll(m_Gen);
+        out += '\t';
         for (int i = 0; i < sents; ++i)
         {
             if (i == 0 && useLipsum)
             {
-                result += GenerateDefaultLipsumSentence() + " ";
+                out += internal::LIPSUM_DEFAULT_SENTENCE;
             }
             else
             {
-                result +=
-                        single_sentence(m_Settings.word, m_Settings.frag) + " ";
+                single_sentence_into(out, m_Settings.word, m_Settings.frag);
             }
+            out += ' ';
         }
 
-        if (!result.empty())
-        {
-            // remove trailing space
-            result.pop_back();
-        }
-        result += "\n";
-        return result;
+        // remove trailing space
+        out.pop_back();
+        out += '\n';
     }
 } // namespace lipsum
@@ -18,8 +18,6 @@
 namespace lipsum
 {
 
-#ifndef LIPSUM_MIN_BUILD
-
     /*
      * FORMATS
      */
@@ -27,295 +25,685 @@ namespace lipsum
     std::string Generator::fmt_paragraph(int num, bool useLipsum, bool useHtml)
     {
         std::string ret;
+        if (num > 0)
+        {
+            reserve_more(ret,
+                         predicted_size(OutputType::FmtParagraph,
+                                        static_cast<std::size_t>(num),
+                                        useHtml));
+        }
+        fmt_paragraph_into(ret, num, useLipsum, useHtml);
+        return ret;
+    }
 
+    void Generator::fmt_paragraph_to(Sink& sink,
+                                     int   num,
+                                     bool  useLipsum,
+                                     bool  useHtml)
+    {
         if (num < 0)
         {
             internal::LogWarn(internal::LogType::Warn,
-                              "lpsm::Generator::fmt_paragraph(): expected "
+                              "lpsm::Generator::fmt_paragraph_to(): expected "
                               "num >= 0, got ",
                               num);
         }
 
         for (int i = 0; i < num; ++i)
         {
-            if (i == 0 && useLipsum)
-            {
-                ret += single_fmt_paragraph(USELIPSUM, useHtml);
-            }
-            else
-            {
-                ret += single_fmt_paragraph(NO_USELIPSUM, useHtml);
-            }
+            fmt_paragraph_into(sink.buffer(), 1, i == 0 && useLipsum, useHtml);
+            sink.commit();
         }
-        return ret;
     }
 
     std::string Generator::fmt_text(int numElements, bool useHtml)
     {
         std::string ret;
-        if (numElements < 0)
+        fmt_text_into(ret, numElements, useHtml);
+        return ret;
+    }
+
+    void
+    Generator::fmt_text_into(std::string& out, int numElements, bool useHtml)
+    {
+        if (numElements > 0)
         {
-            internal::LogWarn(internal::LogType::Warn,
-                              "lpsm::Generator::fmt_text(): cannot generate "
-                              "negative number of elements.");
-            return ret;
+            reserve_more(out,
+                         predicted_size(OutputType::FmtText,
+                                        static_cast<std::size_t>(numElements),
+                                        useHtml));
         }
-        if (numElements >= 1)
+        fmt_text_chunked(out, nullptr, numElements, useHtml);
+    }
+
+    void Generator::fmt_text_to(Sink& sink, int numElements, bool useHtml)
+    {
+        fmt_text_chunked(sink.buffer(), &sink, numElements, useHtml);
+    }
+
+    std::string Generator::fmt_header(int level, bool useHtml)
+    {
+        std::string ret;
+        fmt_header_into(ret, level, useHtml);
+        return ret;
+    }
+
+    std::string Generator::fmt_emphasis(bool isBold, bool useHtml)
+    {
+        std::string ret;
+        fmt_emphasis_into(ret, isBold, useHtml);
+        return ret;
+    }
+
+    std::string Generator::fmt_link(bool useHtml)
+    {
+        std::string ret;
+        fmt_link_into(ret, useHtml);
+        return ret;
+    }
+
+    std::string Generator::fmt_list(bool ordered, bool useHtml)
+    {
+        std::string ret;
+        fmt_list_into(ret, ordered, useHtml);
+        return ret;
+    }
+
+    std::string Generator::xml(int choices)
+    {
+        std::string ret;
+        xml_into(ret, choices);
+        return ret;
+    }
+
+    void Generator::xml_into(std::string& out, int choices)
+    {
+        reserve_more(out,
+                     predicted_size(OutputType::Xml,
+                                    static_cast<std::size_t>(
+                                            std::max(choices, 0))));
+        xml_chunked(out, nullptr, choices);
+    }
+
+    void Generator::xml_to(Sink& sink, int choices)
+    {
+        xml_chunked(sink.buffer(), &sink, choices);
+    }
+
+    std::string Generator::json(int maxDepth, bool isObject)
+    {
+        std::string ret;
+        json_into(ret, maxDepth, isObject);
+        return ret;
+    }
+
+    void Generator::json_into(std::string& out, int maxDepth, bool isObject)
+    {
+        // the mean size grows exponentially with depth, but most documents
+        // are far smaller, so reserve no more than a sink would hold
+        reserve_more(out,
+                     std::min(predicted_size(OutputType::Json,
+                                             static_cast<std::size_t>(
+                                                     std::max(maxDepth, 0))),
+                              Sink::DEFAULT_CAPACITY));
+        json_chunked(out, nullptr, maxDepth, isObject);
+    }
+
+    void Generator::json_to(Sink& sink, int maxDepth, bool isObject)
+    {
+        json_chunked(sink.buffer(), &sink, maxDepth, isObject);
+    }
+
+    std::string Generator::json_value(int maxDepth)
+    {
+        std::string ret;
+        json_value_into(ret, maxDepth);
+        return ret;
+    }
+
+    std::string Generator::csv()
+    {
+        std::string ret;
+        csv_into(ret);
+        return ret;
+    }
+
+#ifndef LIPSUM_MIN_BUILD
+
+    void Generator::fmt_paragraph_into(std::string& out,
+                                       int          num,
+                                       bool         useLipsum,
+                                       bool         useHtml)
+    {
+        if (num < 0)
         {
-            ret += fmt_header(1, useHtml);
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::Generator::fmt_paragraph(): expected "
+                              "num >= 0, got ",
+                              num);
         }
-        if (numElements >= 2)
+        if (num >= RESERVE_MIN_UNITS)
         {
-            ret += single_fmt_paragraph(NO_USELIPSUM, useHtml);
+            reserve_more(out,
+                         predicted_size(OutputType::FmtParagraph,
+                                        static_cast<std::size_t>(num),
+                                        useHtml));
         }
 
-        numElements -= 2;
-        int  lastRand = 0;
-        int  rand     = 0;
-        bool ordered;
-        while (numElements > 0)
+        if (useHtml)
         {
-            rand = random_number<int>(0, 2);
-            if ((lastRand == 1 && rand == 1) || numElements == 1)
-            {
-                rand = 0;
-            }
-            ordered = LPSM_FLIP_COIN;
-            switch (rand)
+            for (int i = 0; i < num; ++i)
             {
-                case 0:
-                {
-                    ret += single_fmt_paragraph(NO_USELIPSUM, useHtml);
-                    break;
-                }
-                case 1:
-                {
-                    ret += fmt_header(m_Settings.level.roll(m_Gen), useHtml);
-                    break;
-                }
-                case 2:
-                {
-                    ret += fmt_list(ordered, useHtml);
-                    break;
-                }
+                single_fmt_paragraph_into<internal::HtmlFormat>(
+                        out,
+                        i == 0 && useLipsum);
             }
-            --numElements;
-            lastRand = rand;
+            return;
+        }
+        for (int i = 0; i < num; ++i)
+        {
+            single_fmt_paragraph_into<internal::MarkdownFormat>(
+                    out,
+                    i == 0 && useLipsum);
         }
-        return ret;
     }
 
-    std::string Generator::fmt_header(int level, bool useHtml)
+    void Generator::fmt_text_chunked(std::string& out,
+                                     Sink*        sink,
+                                     int          numElements,
+                                     bool         useHtml)
     {
-        if (level > 6 || level < 1)
+        if (useHtml)
         {
-            internal::LogWarn(internal::LogType::Warn,
-                              "lpsm::Generator::fmt_header(): invalid header "
-                              "level ",
-                              level,
-                              ", expected from 1 to 6");
+            fmt_text_chunked<internal::HtmlFormat>(out, sink, numElements);
         }
-        std::string ret;
-        int         numWords = m_Settings.wordURL.roll(m_Gen);
-        std::string words    = word(numWords);
-        if (!words.empty())
+        else
         {
-            words.at(0) = LPSM_SAFE_CCTYPE(char, std::toupper, words.at(0));
+            fmt_text_chunked<internal::MarkdownFormat>(out, sink, numElements);
         }
-        if (!useHtml)
+    }
+
+    void Generator::fmt_elements_chunked(std::string& out,
+                                         Sink*        sink,
+                                         int          numElements,
+                                         bool         useHtml,
+                                         bool         endsText,
+                                         int          lastKind)
+    {
+        if (useHtml)
         {
-            for (int i = 0; i < level; ++i)
-            {
-                ret += "#";
-            }
-            ret += " ";
-            ret += words += "\n\n";
+            fmt_elements_chunked<internal::HtmlFormat>(out,
+                                                       sink,
+                                                       numElements,
+                                                       endsText,
+                                                       lastKind);
         }
         else
         {
-            ret += std::string("<h") + internal::ToString(level) + ">";
-            ret += words +=
-                    std::string("</h") + internal::ToString(level) + ">\n\n";
+            fmt_elements_chunked<internal::MarkdownFormat>(out,
+                                                           sink,
+                                                           numElements,
+                                                           endsText,
+                                                           lastKind);
         }
-        return ret;
     }
 
-    std::string Generator::fmt_emphasis(bool isBold, bool useHtml)
+    void Generator::fmt_header_into(std::string& out, int level, bool useHtml)
     {
-        std::string ret;
-        std::string sent =
-                single_sentence(m_Settings.wordFmt, m_Settings.fragFmt);
+        if (useHtml)
+        {
+            fmt_header_into<internal::HtmlFormat>(out, level);
+        }
+        else
+        {
+            fmt_header_into<internal::MarkdownFormat>(out, level);
+        }
+    }
 
-        if (!useHtml)
+    void Generator::fmt_emphasis_into(std::string& out,
+                                      bool         isBold,
+                                      bool         useHtml)
+    {
+        if (useHtml)
         {
-            ret += (isBold ? "**" : "*");
+            fmt_emphasis_into<internal::HtmlFormat>(out, isBold);
         }
         else
         {
-            ret += (isBold ? "<strong>" : "<em>");
+            fmt_emphasis_into<internal::MarkdownFormat>(out, isBold);
         }
+    }
 
-        ret += sent;
+    void Generator::fmt_link_into(std::string& out, bool useHtml)
+    {
+        if (useHtml)
+        {
+            fmt_link_into<internal::HtmlFormat>(out);
+        }
+        else
+        {
+            fmt_link_into<internal::MarkdownFormat>(out);
+        }
+    }
 
-        if (!useHtml)
+    void Generator::fmt_list_into(std::string& out, bool ordered, bool useHtml)
+    {
+        if (useHtml)
         {
-            ret += (isBold ? "**" : "*");
+            fmt_list_into<internal::HtmlFormat>(out, ordered);
         }
         else
         {
-            ret += (isBold ? "</strong>" : "</em>");
+            fmt_list_into<internal::MarkdownFormat>(out, ordered);
         }
-        return ret;
     }
 
-    std::string Generator::fmt_link(bool useHtml)
+    /*
+     * FORMAT POLICIES
+     */
+
+    template <internal::FormatPolicy Format>
+    void Generator::fmt_text_chunked(std::string& out,
+                                     Sink*        sink,
+                                     int          numElements)
+    {
+        if (numElements < 0)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::Generator::fmt_text(): cannot generate "
+                              "negative number of elements.");
+            return;
+        }
+        auto commit = [sink]()
+        {
+            if (sink != nullptr)
+            {
+                sink->commit();
+            }
+        };
+        if (numElements >= 1)
+        {
+            fmt_header_into<Format>(out, 1);
+            commit();
+        }
+        if (numElements >= 2)
+        {
+            single_fmt_paragraph_into<Format>(out, NO_USELIPSUM);
+            commit();
+        }
+
+        fmt_elements_chunked<Format>(out, sink, numElements - 2, true, 0);
+    }
+
+    template <internal::FormatPolicy Format>
+    void Generator::fmt_elements_chunked(std::string& out,
+                                         Sink*        sink,
+                                         int          numElements,
+                                         bool         endsText,
+                                         int          lastKind)
     {
-        std::string link = url();
-        std::string sentence =
-                single_sentence(m_Settings.wordFmt, m_Settings.fragFmt);
-        if (!useHtml)
+        while (numElements > 0)
         {
-            return std::string("[") + sentence + std::string("](") + link + ")";
+            lastKind = fmt_element_into<Format>(out,
+                                                lastKind,
+                                                numElements == 1 && endsText);
+            if (sink != nullptr)
+            {
+                sink->commit();
+            }
+            --numElements;
         }
-        return std::string("<a href=\"") + link + std::string("\">") +
-               sentence + "</a>";
     }
 
-    std::string Generator::fmt_list(bool ordered, bool useHtml)
+    template <internal::FormatPolicy Format>
+    int Generator::fmt_element_into(std::string& out, int lastKind, bool isLast)
     {
-        std::string ret;
-        int         points = m_Settings.point.roll(m_Gen);
-        if (useHtml)
+        int kind = random_number<int>(0, 2);
+        if ((lastKind == 1 && kind == 1) || isLast)
         {
-            ret += (ordered ? "<ol>" : "<ul>");
+            kind = 0;
         }
-        for (int i = 0; i < points; ++i)
+        bool ordered = LPSM_FLIP_COIN;
+        switch (kind)
         {
-            if (!useHtml)
+            case 0:
             {
-                if (ordered)
-                {
-                    ret += internal::ToString(i + 1) + ". ";
-                }
-                else
-                {
-                    ret += "- ";
-                }
+                single_fmt_paragraph_into<Format>(out, NO_USELIPSUM);
+                break;
+            }
+            case 1:
+            {
+                fmt_header_into<Format>(out, m_Settings.level.roll(m_Gen));
+                break;
+            }
+            case 2:
+            {
+                fmt_list_into<Format>(out, ordered);
+                break;
+            }
+        }
+        return kind;
+    }
+
+    template <internal::FormatPolicy Format>
+    void Generator::single_fmt_paragraph_into(std::string& out, bool useLipsum)
+    {
+        int         sents = m_Settings.sent.roll(m_Gen);
+        std::size_t fmtRoll;
+        bool        addLink = false;
+        bool        isBold  = false;
+
+        bool escape = std::exchange(m_EscapeWords, Format::ESCAPES_WORDS);
+
+        out += Format::PARAGRAPH_OPEN;
+        for (int i = 0; i < sents; ++i)
+        {
+            fmtRoll = m_Settings.fmtSentence.sample(m_Gen);
+            if (fmtRoll == 1)
+            {
+                addLink = LPSM_FLIP_COIN;
+                isBold  = LPSM_FLIP_COIN;
+            }
+            if (i == 0 && useLipsum)
+            {
+                out += internal::LIPSUM_DEFAULT_SENTENCE;
+            }
+            else if ((fmtRoll == 1) && addLink)
+            {
+                fmt_link_into<Format>(out);
+            }
+            else if ((fmtRoll == 1) && !addLink)
+            {
+                fmt_emphasis_into<Format>(out, isBold);
             }
             else
             {
-                ret += "<li>";
+                single_sentence_into(out, m_Settings.word, m_Settings.frag);
             }
-            ret += single_sentence(m_Settings.wordFmt, m_Settings.fragFmt);
-            ret += (useHtml ? "</li>" : "\n");
+            out += ' ';
         }
-        if (useHtml)
+        out += Format::PARAGRAPH_CLOSE;
+        m_EscapeWords = escape;
+    }
+
+    template <internal::FormatPolicy Format>
+    void Generator::fmt_header_into(std::string& out, int level)
+    {
+        if (level > 6 || level < 1)
         {
-            ret += (ordered ? "</ol>\n" : "</ul>\n");
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::Generator::fmt_header(): invalid header "
+                              "level ",
+                              level,
+                              ", expected from 1 to 6");
         }
-        ret += "\n";
-        return ret;
+        Format::open_header_into(out, level);
+
+        bool escape = std::exchange(m_EscapeWords, Format::ESCAPES_WORDS);
+
+        std::size_t start    = out.size();
+        int         numWords = m_Settings.wordURL.roll(m_Gen);
+        word_into(out, numWords);
+        if (out.size() > start)
+        {
+            out[start] = LPSM_SAFE_CCTYPE(char, std::toupper, out[start]);
+        }
+        m_EscapeWords = escape;
+
+        Format::close_header_into(out, level);
     }
 
-    std::string Generator::xml(int choices)
+    template <internal::FormatPolicy Format>
+    void Generator::fmt_emphasis_into(std::string& out, bool isBold)
     {
-        std::string ret = R"(<?xml version="1.0" encoding="UTF-8"?>)";
-        std::vector<std::string> tagStack;
-        std::string              root = m_Source.random_word(m_Gen);
-        ret += std::string("<") + root + ">";
+        bool escape = std::exchange(m_EscapeWords, Format::ESCAPES_WORDS);
+        out += (isBold ? Format::BOLD_OPEN : Format::ITALIC_OPEN);
+        single_sentence_into(out, m_Settings.wordFmt, m_Settings.fragFmt);
+        out += (isBold ? Format::BOLD_CLOSE : Format::ITALIC_CLOSE);
+        m_EscapeWords = escape;
+    }
 
-        int choice;
+    template <internal::FormatPolicy Format>
+    void Generator::fmt_link_into(std::string& out)
+    {
+        bool escape = std::exchange(m_EscapeWords, Format::ESCAPES_WORDS);
+        out += Format::LINK_OPEN;
+        if constexpr (Format::URL_FIRST)
+        {
+            url_into(out);
+            out += Format::LINK_MIDDLE;
+            single_sentence_into(out, m_Settings.wordFmt, m_Settings.fragFmt);
+        }
+        else
+        {
+            single_sentence_into(out, m_Settings.wordFmt, m_Settings.fragFmt);
+            out += Format::LINK_MIDDLE;
+            url_into(out);
+        }
+        out += Format::LINK_CLOSE;
+        m_EscapeWords = escape;
+    }
 
-        for (int i = 0; i < choices; ++i)
+    template <internal::FormatPolicy Format>
+    void Generator::fmt_list_into(std::string& out, bool ordered)
+    {
+        int  points = m_Settings.point.roll(m_Gen);
+        bool escape = std::exchange(m_EscapeWords, Format::ESCAPES_WORDS);
+        if (ordered)
         {
-            choice = random_number<int>(0, 2);
-            switch (choice)
+            out += Format::ORDERED_LIST_OPEN;
+            for (int i = 0; i < points; ++i)
             {
-                case 0:
+                if constexpr (Format::NUMBERED_ITEMS)
                 {
-                    std::string toAdd       = m_Source.random_word(m_Gen);
-                    std::string attrib      = m_Source.random_word(m_Gen);
-                    std::string attribValue = m_Source.random_word(m_Gen);
-                    bool        useAttrib   = LPSM_FLIP_COIN;
-                    if (useAttrib)
-                    {
-                        ret += std::string("<") + toAdd + std::string(" ") +
-                               attrib + std::string("=\"") + attribValue +
-                               std::string("\">");
-                    }
-                    else
-                    {
-                        ret += std::string("<") + toAdd + ">";
-                    }
-                    tagStack.push_back(toAdd);
-                    break;
+                    internal::AppendNumber(out, i + 1);
                 }
+                out += Format::ORDERED_ITEM_OPEN;
+                single_sentence_into(out,
+                                     m_Settings.wordFmt,
+                                     m_Settings.fragFmt);
+                out += Format::ITEM_CLOSE;
+            }
+            out += Format::ORDERED_LIST_CLOSE;
+            m_EscapeWords = escape;
+            return;
+        }
 
-                case 1:
-                {
-                    std::string toAdd = m_Source.random_word(m_Gen);
-                    ret += std::string("<") + toAdd + std::string(">") +
-                           single_sentence(m_Settings.word, m_Settings.frag) +
-                           std::string("</") + toAdd + ">";
-                    // ret += toAdd += "";
-                    break;
-                }
+        out += Format::UNORDERED_LIST_OPEN;
+        for (int i = 0; i < points; ++i)
+        {
+            out += Format::ITEM_OPEN;
+            single_sentence_into(out, m_Settings.wordFmt, m_Settings.fragFmt);
+            out += Format::ITEM_CLOSE;
+        }
+        out += Format::UNORDERED_LIST_CLOSE;
+        m_EscapeWords = escape;
+    }
 
-                default:
-                {
-                    if (!tagStack.empty())
-                    {
-                        ret += std::string("</") + tagStack.back() + ">";
-                        tagStack.pop_back();
-                    }
-                    break;
-                }
+    void Generator::xml_chunked(std::string& out, Sink* sink, int choices)
+    {
+        std::vector<std::string_view> tagStack;
+        std::string_view              root = xml_start_into(out);
+
+        auto commit = [sink]()
+        {
+            if (sink != nullptr)
+            {
+                sink->commit();
             }
+        };
+        commit();
+
+        for (int i = 0; i < choices; ++i)
+        {
+            xml_choice_into(out, tagStack);
+            commit();
         }
 
         while (!tagStack.empty())
         {
-            ret += std::string("</") + tagStack.back() + ">";
+            xml_end_tag_into(out, tagStack.back());
             tagStack.pop_back();
+            commit();
         }
 
-        ret += std::string("</") + root + ">";
+        xml_end_tag_into(out, root);
+        commit();
+    }
 
-        return ret;
+    std::string_view Generator::xml_start_into(std::string& out)
+    {
+        std::string_view root = xml_name(source_word());
+        out += R"(<?xml version="1.0" encoding="UTF-8"?>)";
+        out += '<';
+        out += root;
+        out += '>';
+        return root;
     }
 
-    std::string Generator::json(int maxDepth, bool isObject)
+    void Generator::xml_choice_into(std::string&                   out,
+                                    std::vector<std::string_view>& tagStack)
     {
-        int         count = m_Settings.jsonLength.roll(m_Gen);
-        std::string ret   = (isObject ? "{" : "[");
-        for (int i = 0; i < count; ++i)
+        int choice = random_number<int>(0, 2);
+        switch (choice)
         {
-            if (i > 0)
+            case 0:
             {
-                ret += ",";
+                std::string_view toAdd       = xml_name(source_word());
+                std::string_view attrib      = xml_name(source_word());
+                std::string_view attribValue = source_word();
+                bool             useAttrib   = LPSM_FLIP_COIN;
+                out += '<';
+                out += toAdd;
+                if (useAttrib)
+                {
+                    out += ' ';
+                    out += attrib;
+                    out += "=\"";
+                    out += escaped_word(attribValue);
+                    out += '"';
+                }
+                out += '>';
+                tagStack.push_back(toAdd);
+                break;
             }
 
-            if (isObject)
+            case 1:
             {
-
-                std::string key = std::string("\"") +
-                                  m_Source.random_word(m_Gen) +
-                                  internal::ToString(i) + "\"";
-                ret += key + std::string(":") + json_value(maxDepth - 1);
+                std::string_view toAdd = xml_name(source_word());
+                out += '<';
+                out += toAdd;
+                out += '>';
+                bool escape = std::exchange(m_EscapeWords, true);
+                single_sentence_into(out, m_Settings.word, m_Settings.frag);
+                m_EscapeWords = escape;
+                xml_end_tag_into(out, toAdd);
+                break;
             }
-            else
+
+            default:
             {
+                if (!tagStack.empty())
+                {
+                    xml_end_tag_into(out, tagStack.back());
+                    tagStack.pop_back();
+                }
+                break;
+            }
+        }
+    }
 
-                ret += json_value(maxDepth - 1);
+    void Generator::xml_end_tag_into(std::string& out, std::string_view name)
+    {
+        out += "</";
+        out += name;
+        out += '>';
+    }
+
+    void Generator::json_chunked(std::string& out,
+                                 Sink*        sink,
+                                 int          maxDepth,
+                                 bool         isObject)
+    {
+        std::vector<JsonLevel> stack;
+        json_open_into(out, stack, maxDepth, isObject);
+        while (!stack.empty())
+        {
+            json_step_into(out, stack);
+            if (sink != nullptr)
+            {
+                sink->commit();
             }
         }
-        ret += (isObject ? "}" : "]");
-        return ret;
     }
 
-    std::string Generator::json_value(int maxDepth)
+    void Generator::json_value_into(std::string& out, int maxDepth)
+    {
+        int kind = json_value_kind(maxDepth);
+        if (kind <= 3)
+        {
+            json_scalar_into(out, kind);
+        }
+        else
+        {
+            json_chunked(out, nullptr, maxDepth, kind == 4 ? ARRAY : OBJECT);
+        }
+    }
+
+    void Generator::json_open_into(std::string&            out,
+                                   std::vector<JsonLevel>& stack,
+                                   int                     maxDepth,
+                                   bool                    isObject)
+    {
+        int count = m_Settings.jsonLength.roll(m_Gen);
+        out += (isObject ? '{' : '[');
+        stack.push_back({count, 0, maxDepth, isObject});
+    }
+
+    void Generator::json_step_into(std::string&            out,
+                                   std::vector<JsonLevel>& stack)
+    {
+        JsonLevel& level = stack.back();
+        if (level.next == level.count)
+        {
+            out += (level.isObject ? '}' : ']');
+            stack.pop_back();
+            return;
+        }
+
+        int index = level.next++;
+        if (index > 0)
+        {
+            out += ',';
+        }
+        if (level.isObject)
+        {
+            json_key_into(out, index);
+        }
+
+        // level is not used past here, as opening a level may move it
+        int depth = level.maxDepth - 1;
+        int kind  = json_value_kind(depth);
+        if (kind <= 3)
+        {
+            json_scalar_into(out, kind);
+        }
+        else
+        {
+            json_open_into(out, stack, depth, kind == 4 ? ARRAY : OBJECT);
+        }
+    }
+
+    void Generator::json_key_into(std::string& out, int index)
+    {
+        out += '"';
+        out += source_word();
+        internal::AppendNumber(out, index);
+        out += "\":";
+    }
+
+    int Generator::json_value_kind(int maxDepth)
     {
-        int           choice;
         constexpr int JSON_VALUE_WARN_DEPTH = 50;
         LPSM_VERBOSE_LOG(Trace, "Creating a JSON value at depth ", maxDepth);
         if (maxDepth >= JSON_VALUE_WARN_DEPTH)
@@ -328,205 +716,302 @@ namespace lipsum
                               JSON_VALUE_WARN_DEPTH,
                               ".");
         }
-        if (maxDepth <= 0)
-        {
-            choice = random_number(0, 3);
-            switch (choice)
-            {
-                case 0:
-                {
-                    return json_string();
-                }
-                case 1:
-                {
-                    return json_number();
-                }
-                case 2:
-                {
-                    return LPSM_FLIP_COIN ? "true" : "false";
-                }
-                default:
-                {
-                    return "null";
-                }
-            }
-        }
 
-        choice = random_number(0, 5);
-        switch (choice)
-        {
+        // scalars only once the depth limit is reached
+        return (maxDepth <= 0 ? random_number(0, 3) : random_number(0, 5));
+    }
 
+    void Generator::json_scalar_into(std::string& out, int kind)
+    {
+        switch (kind)
+        {
             case 0:
             {
-                return json_string();
+                json_string_into(out);
+                break;
             }
             case 1:
             {
-                return json_number();
+                json_number_into(out);
+                break;
             }
             case 2:
             {
-                return LPSM_FLIP_COIN ? "true" : "false";
+                out += (LPSM_FLIP_COIN ? "true" : "false");
+                break;
             }
-            case 3:
+            default:
             {
-                return "null";
+                out += "null";
+                break;
             }
-            case 4:
+        }
+    }
+
+    /*
+     * STREAMS
+     */
+
+    ChunkStream Generator::fmt_text_stream(int         numElements,
+                                           bool        useHtml,
+                                           std::size_t chunkSize)
+    {
+        if (useHtml)
+        {
+            return fmt_text_chunks<internal::HtmlFormat>(numElements,
+                                                         chunkSize);
+        }
+        return fmt_text_chunks<internal::MarkdownFormat>(numElements,
+                                                         chunkSize);
+    }
+
+    template <internal::FormatPolicy Format>
+    ChunkStream Generator::fmt_text_chunks(int         numElements,
+                                           std::size_t chunkSize)
+    {
+        if (numElements < 0)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::Generator::fmt_text_stream(): cannot "
+                              "generate negative number of elements.");
+            co_return;
+        }
+
+        std::string out;
+        out.reserve(chunkSize);
+        if (numElements >= 1)
+        {
+            fmt_header_into<Format>(out, 1);
+        }
+        if (numElements >= 2)
+        {
+            single_fmt_paragraph_into<Format>(out, NO_USELIPSUM);
+        }
+
+        int lastKind = 0;
+        for (int i = 2; i < numElements; ++i)
+        {
+            lastKind = fmt_element_into<Format>(out,
+                                                lastKind,
+                                                i == numElements - 1);
+            if (out.size() >= chunkSize)
             {
-                return json(maxDepth, ARRAY);
+                co_yield out;
+                out.clear();
             }
-            default:
+        }
+        if (!out.empty())
+        {
+            co_yield out;
+        }
+    }
+
+    ChunkStream Generator::xml_stream(int choices, std::size_t chunkSize)
+    {
+        std::string out;
+        out.reserve(chunkSize);
+        std::vector<std::string_view> tagStack;
+        std::string_view              root = xml_start_into(out);
+
+        for (int i = 0; i < choices; ++i)
+        {
+            xml_choice_into(out, tagStack);
+            if (out.size() >= chunkSize)
             {
-                return json(maxDepth, OBJECT);
+                co_yield out;
+                out.clear();
             }
         }
+
+        while (!tagStack.empty())
+        {
+            xml_end_tag_into(out, tagStack.back());
+            tagStack.pop_back();
+            if (out.size() >= chunkSize)
+            {
+                co_yield out;
+                out.clear();
+            }
+        }
+
+        xml_end_tag_into(out, root);
+        co_yield out;
     }
 
-    std::string Generator::csv()
+    ChunkStream
+    Generator::json_stream(int maxDepth, bool isObject, std::size_t chunkSize)
     {
-        constexpr float CSV_NUMBER_MIN = -1000.0F;
-        constexpr float CSV_NUMBER_MAX = 1000.0F;
-        enum class CsvTypes : int
-        {
-            Int = 0,
-            Float,
-            Sentence,
-            Word,
-            Email,
-            Scramble,
-            IP,
-            Phone
-        };
+        std::string out;
+        out.reserve(chunkSize);
+        for (std::string_view chunk :
+             json_chunks(out, chunkSize, maxDepth, isObject))
+        {
+            co_yield chunk;
+        }
+        co_yield out;
+    }
 
-        int                   numRows = m_Settings.csvRows.roll(m_Gen);
-        int                   numCols = m_Settings.csvCols.roll(m_Gen);
-        std::vector<CsvTypes> cols;
-        std::string           ret;
-        cols.reserve(numCols);
-        for (int i = 0; i < numCols; ++i)
+    ChunkStream Generator::json_chunks(std::string& out,
+                                       std::size_t  chunkSize,
+                                       int          maxDepth,
+                                       bool         isObject)
+    {
+        std::vector<JsonLevel> stack;
+        json_open_into(out, stack, maxDepth, isObject);
+        while (!stack.empty())
         {
-            cols.push_back(static_cast<CsvTypes>(random_number<int>(0, 7)));
-            ret += m_Source.random_word(m_Gen) + ",";
+            // yield before a step, not after, so that the closing bracket is
+            // left for json_stream() to yield last
+            if (out.size() >= chunkSize)
+            {
+                co_yield out;
+                out.clear();
+            }
+            json_step_into(out, stack);
         }
-        // remove trailing comma
-        if (!ret.empty())
+    }
+
+    void Generator::csv_into(std::string& out)
+    {
+        reserve_more(out, predicted_size(OutputType::Csv));
+        int                  numRows = m_Settings.csvRows.roll(m_Gen);
+        std::vector<CsvType> cols;
+        csv_header_into(out, cols);
+        for (int i = 0; i < numRows; ++i)
         {
-            ret.pop_back();
+            csv_row_into(out, cols);
         }
-        ret += "\n";
+    }
 
-        auto csvTypeLogic = [&](CsvTypes type)
+    void Generator::csv_header_into(std::string&          out,
+                                    std::vector<CsvType>& cols)
+    {
+        int numCols = m_Settings.csvCols.roll(m_Gen);
+        cols.clear();
+        cols.reserve(numCols);
+        for (int i = 0; i < numCols; ++i)
         {
-            switch (type)
+            cols.push_back(static_cast<CsvType>(random_number<int>(0, 7)));
+            if (i != 0)
             {
-                case CsvTypes::Int:
+                out += ',';
+            }
+            out += source_word();
+        }
+        out += '\n';
+    }
+
+    void Generator::csv_row_into(std::string&                out,
+                                 const std::vector<CsvType>& cols)
+    {
+        constexpr float CSV_NUMBER_MIN = -1000.0F;
+        constexpr float CSV_NUMBER_MAX = 1000.0F;
+
+        for (std::size_t j = 0; j < cols.size(); ++j)
+        {
+            if (j != 0)
+            {
+                out += ',';
+            }
+            switch (cols[j])
+            {
+                case CsvType::Int:
                 {
-                    ret += json_number() + ",";
+                    json_number_into(out);
                     break;
                 }
-                case CsvTypes::Float:
+                case CsvType::Float:
                 {
-                    ret += internal::ToString(
-                                   random_number<float>(CSV_NUMBER_MIN,
-                                                        CSV_NUMBER_MAX)) +
-                           ",";
+                    internal::AppendNumber(
+                            out,
+                            random_number<float>(CSV_NUMBER_MIN,
+                                                 CSV_NUMBER_MAX));
                     break;
                 }
-                case CsvTypes::Sentence:
+                case CsvType::Sentence:
                 {
-                    ret += std::string("\"") +
-                           single_sentence(m_Settings.wordFmt,
-                                           m_Settings.fragFmt) +
-                           "\",";
+                    out += '"';
+                    single_sentence_into(out,
+                                         m_Settings.wordFmt,
+                                         m_Settings.fragFmt);
+                    out += '"';
                     break;
                 }
-                case CsvTypes::Word:
+                case CsvType::Word:
                 {
-                    ret += m_Source.random_word(m_Gen) + ",";
+                    out += source_word();
                     break;
                 }
-                case CsvTypes::Email:
+                case CsvType::Email:
                 {
-                    ret += email() + ",";
+                    email_into(out);
                     break;
                 }
-                case CsvTypes::Scramble:
+                case CsvType::Scramble:
                 {
-                    ret += scramble(16, 'a', 'z') + ",";
+                    scramble_into(out, 16, 'a', 'z');
                     break;
                 }
-                case CsvTypes::IP:
+                case CsvType::IP:
                 {
-                    ret += ip_addr(LPSM_FLIP_COIN, LPSM_FLIP_COIN) + ",";
+                    bool useIpv6 = LPSM_FLIP_COIN;
+                    bool usePort = LPSM_FLIP_COIN;
+                    ip_addr_into(out, useIpv6, usePort);
                     break;
                 }
-                case CsvTypes::Phone:
+                case CsvType::Phone:
                 {
-                    ret += "\"";
-                    ret += phone_number() + "\",";
+                    out += '"';
+                    phone_number_into(out);
+                    out += '"';
                     break;
                 }
             }
-        };
-
-        for (int i = 0; i < numRows; ++i)
-        {
-            for (int j = 0; j < numCols; ++j)
-            {
-                csvTypeLogic(cols.at(j));
-            }
-            // remove trailing comma
-            if (!ret.empty())
-            {
-                ret.pop_back();
-            }
-            ret += "\n";
         }
-        return ret;
+        out += '\n';
     }
 #else
     // placeholders
 
-    std::string Generator::fmt_paragraph(int, bool, bool)
+    void Generator::fmt_paragraph_into(std::string&, int, bool, bool)
     {
-        return "";
     }
-    std::string Generator::fmt_text(int, bool)
+    void Generator::fmt_text_chunked(std::string&, Sink*, int, bool)
     {
-        return "";
     }
-    std::string Generator::fmt_header(int, bool)
+    void Generator::fmt_header_into(std::string&, int, bool)
     {
-        return "";
     }
-    std::string Generator::fmt_emphasis(bool, bool)
+    void Generator::fmt_emphasis_into(std::string&, bool, bool)
     {
-        return "";
     }
-    std::string Generator::fmt_link(bool)
+    void Generator::fmt_link_into(std::string&, bool)
     {
-        return "";
     }
-    std::string Generator::fmt_list(bool, bool)
+    void Generator::fmt_list_into(std::string&, bool, bool)
     {
-        return "";
     }
-    std::string Generator::xml(int)
+    void Generator::xml_chunked(std::string&, Sink*, int)
     {
-        return "";
     }
-    std::string Generator::json(int, bool)
+    void Generator::json_chunked(std::string&, Sink*, int, bool)
     {
-        return "";
     }
-    std::string Generator::json_value(int)
+    void Generator::json_value_into(std::string&, int)
     {
-        return "";
     }
-    std::string Generator::csv()
+    void Generator::csv_into(std::string&)
+    {
+    }
+    void
+    Generator::fmt_elements_chunked(std::string&, Sink*, int, bool, bool, int)
+    {
+    }
+    void Generator::csv_header_into(std::string&, std::vector<CsvType>&)
+    {
+    }
+    void Generator::csv_row_into(std::string&, const std::vector<CsvType>&)
     {
-        return "";
     }
 #endif
 } // namespace lipsum
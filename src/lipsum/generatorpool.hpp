@@ -0,0 +1,249 @@
+/**
+ * @file lipsum/generatorpool.hpp
+ *
+ * @brief Declaration of lipsum::GeneratorPool
+ *
+ * This declares lipsum::GeneratorPool, which hands out ready generators to
+ * many threads. This file is under the BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core/core.hpp"
+#include "core/parallel.hpp"
+#include "generator.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum
+{
+    /**
+     * @brief Class for sharing generators between threads
+     *
+     * @since 0.5.3
+     *
+     * A lipsum::Generator must not be used by two threads at once, and
+     * constructing one per request is slow: it seeds a whole engine, from
+     * std::random_device if no seed is given. This class makes a fixed
+     * number of copies of a prototype generator up front, each seeded with
+     * its own stream of one root seed (lipsum::Generator::load_stream()),
+     * and lends them out. Every copy shares the source, word frequencies and
+     * Markov model of the prototype, and has the same settings.
+     *
+     * Borrowing and returning a generator takes no lock: each thread first
+     * tries the slot it last used, which is on its own cache lines, so
+     * threads do not slow each other down. If every slot is taken, a new
+     * generator is made for the borrower and thrown away on return. Not
+     * available in minimum builds.
+     */
+    class LIPSUM_API GeneratorPool
+    {
+    private:
+        struct Slot;
+
+    public:
+        /**
+         * @brief A borrowed generator
+         *
+         * @since 0.5.3
+         *
+         * Give the generator back to its pool when destroyed. Only movable;
+         * must not outlive the pool.
+         */
+        class LIPSUM_API Lease
+        {
+        public:
+            /**
+             * @brief Move constructor for Lease
+             *
+             * @since 0.5.3
+             *
+             * @param other The lease to take the generator from; left empty.
+             */
+            Lease(Lease&& other) noexcept;
+
+            /**
+             * @brief Move assignment for Lease
+             *
+             * @since 0.5.3
+             *
+             * Give back the generator held, if any, and take the one of
+             * other.
+             *
+             * @param other The lease to take the generator from; left empty.
+             *
+             * @return Lease& This lease.
+             */
+            Lease& operator=(Lease&& other) noexcept;
+
+            Lease(const Lease&)            = delete;
+            Lease& operator=(const Lease&) = delete;
+
+            /**
+             * @brief Destructor for Lease
+             *
+             * @since 0.5.3
+             *
+             * Give the generator back to the pool.
+             */
+            ~Lease();
+
+            /**
+             * @brief Get the generator.
+             *
+             * @since 0.5.3
+             *
+             * @return Generator& The generator.
+             */
+            [[nodiscard]] Generator& operator*() const;
+
+            /**
+             * @brief Use the generator.
+             *
+             * @since 0.5.3
+             *
+             * @return Generator* The generator.
+             */
+            Generator* operator->() const;
+
+            /**
+             * @brief Check whether the generator came from a slot of the
+             * pool.
+             *
+             * @since 0.5.3
+             *
+             * @return bool false if every slot was taken and the generator
+             * was made for this lease alone.
+             */
+            [[nodiscard]] bool pooled() const;
+
+        private:
+            friend class GeneratorPool;
+
+            /**
+             * @brief Constructor for a lease of a slot
+             *
+             * @since 0.5.3
+             *
+             * @param slot The slot, already marked as taken.
+             */
+            explicit Lease(Slot* slot);
+
+            /**
+             * @brief Constructor for a lease of a generator outside the
+             * slots
+             *
+             * @since 0.5.3
+             *
+             * @param owned The generator.
+             */
+            explicit Lease(std::unique_ptr<Generator> owned);
+
+            /**
+             * @brief Give the generator back, if any.
+             *
+             * @since 0.5.3
+             */
+            void release();
+
+            Slot*                      m_Slot;  ///< Slot lent, or nullptr
+            std::unique_ptr<Generator> m_Owned; ///< Generator made for it
+            Generator*                 m_Gen;   ///< Generator lent
+        };
+
+        /**
+         * @brief Constructor with a seed
+         *
+         * @since 0.5.3
+         *
+         * Use a default lipsum::Generator as the prototype.
+         *
+         * @param seed The root seed.
+         * @param capacity The number of generators, or 0 for one per hardware
+         * thread. By default 0.
+         */
+        explicit GeneratorPool(int seed, std::size_t capacity = 0);
+
+        /**
+         * @brief Constructor with a prototype
+         *
+         * @since 0.5.3
+         *
+         * @param seed The root seed.
+         * @param prototype The generator whose settings, source, engine, word
+         * frequencies and Markov model every generator of the pool uses. Its
+         * own seed is ignored.
+         * @param capacity The number of generators, or 0 for one per hardware
+         * thread. By default 0.
+         */
+        GeneratorPool(int              seed,
+                      const Generator& prototype,
+                      std::size_t      capacity = 0);
+
+        GeneratorPool(const GeneratorPool&)            = delete;
+        GeneratorPool& operator=(const GeneratorPool&) = delete;
+
+        /**
+         * @brief Destructor for GeneratorPool
+         *
+         * @since 0.5.3
+         *
+         * Every lease must have been destroyed before.
+         */
+        ~GeneratorPool();
+
+        /**
+         * @brief Borrow a generator.
+         *
+         * @since 0.5.3
+         *
+         * Safe to call from any number of threads at once. The generator
+         * carries on from where its last borrower left it.
+         *
+         * @return Lease The generator, given back when the lease is
+         * destroyed.
+         */
+        [[nodiscard]] Lease acquire();
+
+        /**
+         * @brief Get the number of generators in the pool.
+         *
+         * @since 0.5.3
+         *
+         * @return std::size_t The number of slots.
+         */
+        [[nodiscard]] std::size_t capacity() const;
+
+    private:
+        /**
+         * @brief One generator of the pool and whether it is lent out
+         *
+         * @since 0.5.3
+         *
+         * Aligned to a cache line so that threads using neighbouring slots
+         * do not share one.
+         */
+        struct alignas(internal::CACHE_LINE_SIZE) Slot
+        {
+            /**
+             * @brief Constructor for Slot
+             *
+             * @since 0.5.3
+             *
+             * @param prototype The generator to copy.
+             */
+            explicit Slot(const Generator& prototype);
+
+            std::atomic<bool> taken; ///< Whether it is lent out
+            Generator         gen;   ///< The generator
+        };
+
+        Generator                          m_Prototype; ///< Copied for extras
+        std::uint64_t                      m_Seed;      ///< Root seed
+        std::vector<std::unique_ptr<Slot>> m_Slots;     ///< The slots
+        std::atomic<std::uint64_t>         m_Extras;    ///< Extras made
+    };
+} // namespace lipsum
+#endif
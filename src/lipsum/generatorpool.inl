@@ -0,0 +1,163 @@
+/**
+ * @file lipsum/generatorpool.inl
+ *
+ * @brief Definition of lipsum::GeneratorPool
+ *
+ * This defines lipsum::GeneratorPool. This file is under the BSD
+ * Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core/internal.hpp"
+#include "generatorpool.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum
+{
+    GeneratorPool::Lease::Lease(Lease&& other) noexcept
+        : m_Slot(other.m_Slot), m_Owned(std::move(other.m_Owned)),
+          m_Gen(other.m_Gen)
+    {
+        other.m_Slot = nullptr;
+        other.m_Gen  = nullptr;
+    }
+
+    GeneratorPool::Lease& GeneratorPool::Lease::operator=(
+            Lease&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            m_Slot       = other.m_Slot;
+            m_Owned      = std::move(other.m_Owned);
+            m_Gen        = other.m_Gen;
+            other.m_Slot = nullptr;
+            other.m_Gen  = nullptr;
+        }
+        return *this;
+    }
+
+    GeneratorPool::Lease::~Lease()
+    {
+        release();
+    }
+
+    Generator& GeneratorPool::Lease::operator*() const
+    {
+        return *m_Gen;
+    }
+
+    Generator* GeneratorPool::Lease::operator->() const
+    {
+        return m_Gen;
+    }
+
+    bool GeneratorPool::Lease::pooled() const
+    {
+        return m_Slot != nullptr;
+    }
+
+    GeneratorPool::Lease::Lease(Slot* slot)
+        : m_Slot(slot), m_Owned(), m_Gen(&slot->gen)
+    {
+    }
+
+    GeneratorPool::Lease::Lease(std::unique_ptr<Generator> owned)
+        : m_Slot(nullptr), m_Owned(std::move(owned)), m_Gen(m_Owned.get())
+    {
+    }
+
+    void GeneratorPool::Lease::release()
+    {
+        if (m_Slot != nullptr)
+        {
+            m_Slot->taken.store(false, std::memory_order_release);
+            m_Slot = nullptr;
+        }
+        m_Owned.reset();
+        m_Gen = nullptr;
+    }
+
+    GeneratorPool::GeneratorPool(int seed, std::size_t capacity)
+        : GeneratorPool(seed, Generator(seed), capacity)
+    {
+    }
+
+    GeneratorPool::GeneratorPool(int              seed,
+                                 const Generator& prototype,
+                                 std::size_t      capacity)
+        : m_Prototype(prototype),
+          m_Seed(static_cast<std::uint32_t>(seed)), m_Slots(), m_Extras(0)
+    {
+        if (capacity == 0)
+        {
+            capacity = internal::ThreadCount(0);
+        }
+        LPSM_VERBOSE_LOG(Info,
+                         "Creating a lpsm::GeneratorPool of ",
+                         capacity,
+                         " generators with seed ",
+                         seed);
+        m_Slots.reserve(capacity);
+        for (std::size_t i = 0; i < capacity; ++i)
+        {
+            m_Slots.push_back(std::make_unique<Slot>(m_Prototype));
+            m_Slots.back()->gen.load_stream(m_Seed, i);
+        }
+    }
+
+    GeneratorPool::~GeneratorPool()
+    {
+        LPSM_VERBOSE_LOG(Info, "Destroying a lpsm::GeneratorPool");
+    }
+
+    GeneratorPool::Lease GeneratorPool::acquire()
+    {
+        // the slot this thread took last, so that threads keep to their own
+        // slots once the pool is warm
+#    ifdef LPSM_HAS_THREADS
+        static thread_local std::size_t hint =
+                std::hash<std::thread::id>()(std::this_thread::get_id());
+#    else
+        static std::size_t hint = 0;
+#    endif
+        std::size_t count = m_Slots.size();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::size_t index = (hint + i) % count;
+            Slot&       slot  = *m_Slots[index];
+            // only write to the slot if it looks free, so that probing taken
+            // slots does not take their cache lines from their threads
+            if (!slot.taken.load(std::memory_order_relaxed) &&
+                !slot.taken.exchange(true, std::memory_order_acquire))
+            {
+                hint = index;
+                return Lease(&slot);
+            }
+        }
+
+        LPSM_VERBOSE_LOG(Trace,
+                         "Every generator of the pool is taken, making an "
+                         "extra one");
+        auto extra = std::make_unique<Generator>(m_Prototype);
+        extra->load_stream(
+                m_Seed,
+                count + m_Extras.fetch_add(1, std::memory_order_relaxed));
+        return Lease(std::move(extra));
+    }
+
+    std::size_t GeneratorPool::capacity() const
+    {
+        return m_Slots.size();
+    }
+
+    GeneratorPool::Slot::Slot(const Generator& prototype)
+        : taken(false), gen(prototype)
+    {
+    }
+} // namespace lipsum
+#endif
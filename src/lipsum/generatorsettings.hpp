@@ -13,6 +13,7 @@
 #pragma once
 
 #include "core/argvec2.hpp"
+#include "core/weightedtable.hpp"
 
 namespace lipsum
 {
@@ -122,6 +123,37 @@ namespace lipsum
          */
         ArgVec2 csvCols{5, 8};
 
+        /**
+         * @brief The weights of the separators between sentence fragments:
+         * ", ", "; ", ": ", and " - ".
+         *
+         * @since 0.5.3
+         */
+        WeightedTable separator{88, 7, 3, 2};
+
+        /**
+         * @brief The weights of the end marks of sentences: '.', '?', and '!'.
+         *
+         * @since 0.5.3
+         */
+        WeightedTable endMark{80, 15, 5};
+
+        /**
+         * @brief The weights of plain and formatted (linked or emphasized)
+         * sentences in formatted paragraphs.
+         *
+         * @since 0.5.3
+         */
+        WeightedTable fmtSentence{14, 1};
+
+        /**
+         * @brief The weights of the TLDs of URLs and emails: .com, .org, .net,
+         * .edu, .io, .ca, and .co.uk.
+         *
+         * @since 0.5.3
+         */
+        WeightedTable tld{70, 10, 7, 5, 5, 2, 1};
+
 #endif
 
         /**
@@ -138,5 +170,23 @@ namespace lipsum
          * @param value The new value for the setting.
          */
         void change_setting(const std::string& setting, const ArgVec2& value);
+
+#ifndef LIPSUM_MIN_BUILD
+        /**
+         * @brief Change a weighted setting
+         *
+         * @since 0.5.3
+         *
+         * Replace the weights of a weighted choice. Valid setting names
+         * include "separator", "endMark", "fmtSentence", and "tld". If an
+         * invalid setting name is used, or value does not have one weight per
+         * choice, raise a warning and ignore. Not available in minimum builds.
+         *
+         * @param setting The name of the setting.
+         * @param value The new weights for the setting.
+         */
+        void change_weights(const std::string&   setting,
+                            const WeightedTable& value);
+#endif
     };
 } // namespace lipsum
@@ -0,0 +1,330 @@
+/**
+ * @file lipsum/generatorsize.inl
+ *
+ * @brief Definition of lipsum::Generator functions for output sizes
+ *
+ * This defines the functions in lipsum::Generator that predict the size of
+ * generated text. This file is under the BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+
+#pragma once
+
+#include "core/internal.hpp"
+
+namespace lipsum
+{
+
+    /*
+     * SIZES
+     */
+
+    std::size_t Generator::predicted_size(OutputType  type,
+                                          std::size_t num,
+                                          bool        useHtml) const
+    {
+        // doubles only hold every size_t up to 2^53, which is plenty
+        constexpr double LARGEST_SIZE = 9007199254740992.0;
+
+        // the spread of the size of one word, sentence, paragraph, text,
+        // formatted paragraph, element, XML choice, JSON document and CSV
+        // row around its mean, measured relative to the mean
+        constexpr std::array<double, 9> UNIT_SPREADS = {
+                0.5, 0.5, 0.3, 0.5, 0.5, 0.6, 1.2, 1.0, 0.4};
+        constexpr double DEVIATIONS = 4.0;
+
+        double size = mean_size(type, num, useHtml);
+        if (!(size > 0.0))
+        {
+            return 0;
+        }
+
+        // the sizes of num units spread sqrt(num) times as much as one, so
+        // the mean of a large request is exceeded about half of the time;
+        // leave room for a few spreads more
+        double units = 1.0;
+        if (type != OutputType::Text && type != OutputType::Json &&
+            type != OutputType::Csv)
+        {
+            units = static_cast<double>(std::max<std::size_t>(num, 1));
+        }
+        size += DEVIATIONS * UNIT_SPREADS.at(static_cast<std::size_t>(type)) *
+                size / std::sqrt(units);
+        if (!(size < LARGEST_SIZE))
+        {
+            return std::numeric_limits<std::size_t>::max();
+        }
+        return static_cast<std::size_t>(std::ceil(size)) +
+               m_Source->max_word_length();
+    }
+
+    /*
+     * PRIVATE
+     */
+
+    double Generator::mean_size(OutputType  type,
+                                std::size_t num,
+                                bool        useHtml) const
+    {
+        auto count = static_cast<double>(num);
+        switch (type)
+        {
+            case OutputType::Word:
+            {
+                // words and the spaces between them
+                return (num == 0 ? 0.0
+                                 : count * (mean_word_size() + 1.0) - 1.0);
+            }
+            case OutputType::Sentence:
+            {
+                return count *
+                       (mean_sentence_size(m_Settings.word, m_Settings.frag) +
+                        1.0);
+            }
+            case OutputType::Paragraph:
+            {
+                // a tab, the sentences and the spaces between them, and a
+                // newline
+                double sents = m_Settings.sent.mean();
+                return count *
+                       (sents * (mean_sentence_size(m_Settings.word,
+                                                    m_Settings.frag) +
+                                 1.0) +
+                        1.0);
+            }
+            case OutputType::Text:
+            {
+                return mean_size(OutputType::Paragraph, 1, useHtml) *
+                       m_Settings.para.mean();
+            }
+#ifndef LIPSUM_MIN_BUILD
+            case OutputType::FmtParagraph:
+            {
+                // the sentences, the blank line and the <p> tags
+                double frame = (useHtml ? 9.0 : 2.0);
+                return count * (m_Settings.sent.mean() *
+                                        mean_fmt_sentence_size(useHtml) +
+                                frame);
+            }
+            case OutputType::FmtText:
+            {
+                // the words of a header, and its tags or its marker, and
+                // the blank line after it
+                double words  = m_Settings.wordURL.mean();
+                double header = words * (mean_word_size() + 1.0) + 1.0;
+                header += (useHtml ? 9.0 : m_Settings.level.mean() + 1.0);
+                double firstHeader =
+                        (useHtml ? header
+                                 : header - m_Settings.level.mean() + 1.0);
+
+                // the tags or the marker and newline of each point, and the
+                // blank line after the list
+                double points = m_Settings.point.mean();
+                double list   = (useHtml ? 11.0 : 1.0);
+                list += points *
+                        (mean_sentence_size(m_Settings.wordFmt,
+                                            m_Settings.fragFmt) +
+                         (useHtml ? 9.0 : 3.5));
+
+                double paragraph =
+                        mean_size(OutputType::FmtParagraph, 1, useHtml);
+                if (num < 3)
+                {
+                    return (num >= 1 ? firstHeader : 0.0) +
+                           (num >= 2 ? paragraph : 0.0);
+                }
+
+                // a header never follows a header, so over many elements a
+                // quarter are headers, a third lists and the rest paragraphs,
+                // and the last one is a paragraph
+                constexpr double HEADER_SHARE    = 1.0 / 4.0;
+                constexpr double LIST_SHARE      = 1.0 / 3.0;
+                constexpr double PARAGRAPH_SHARE = 5.0 / 12.0;
+                double element = HEADER_SHARE * header + LIST_SHARE * list +
+                                 PARAGRAPH_SHARE * paragraph;
+                return firstHeader + 2.0 * paragraph + (count - 3.0) * element;
+            }
+            case OutputType::Xml:
+            {
+                // the declaration, and the tags of the root element
+                constexpr double DECLARATION = 38.0;
+                double           word        = mean_word_size();
+                double           size        = DECLARATION + 2.0 * word + 5.0;
+
+                // an element opened, with an attribute half the time, and
+                // closed later; an element with a sentence; or a closing tag
+                // already counted with its opening tag
+                double opened   = 3.0 * word + 7.0;
+                double sentence = 2.0 * word + 5.0 +
+                                  mean_sentence_size(m_Settings.word,
+                                                     m_Settings.frag);
+                return size + count * (opened + sentence) / 3.0;
+            }
+            case OutputType::Json:
+            {
+                return mean_json_size(num);
+            }
+            case OutputType::Csv:
+            {
+                return mean_csv_size();
+            }
+#endif
+            default:
+            {
+                return 0.0;
+            }
+        }
+    }
+
+    double Generator::mean_word_size() const
+    {
+#ifndef LIPSUM_MIN_BUILD
+        return m_Source->mean_word_length(m_UseFrequencies);
+#else
+        return m_Source->mean_word_length();
+#endif
+    }
+
+    double Generator::mean_sentence_size(const ArgVec2& wordArg,
+                                         const ArgVec2& frag) const
+    {
+        double words     = wordArg.mean();
+        double frags     = frag.mean();
+        double separator = 2.0;
+#ifndef LIPSUM_MIN_BUILD
+        static constexpr std::array<double, 4> SEPARATOR_SIZES = {2.0,
+                                                                  2.0,
+                                                                  2.0,
+                                                                  3.0};
+        separator = 0.0;
+        for (std::size_t i = 0; i < SEPARATOR_SIZES.size(); ++i)
+        {
+            separator += m_Settings.separator.probability(i) *
+                         SEPARATOR_SIZES.at(i);
+        }
+#endif
+
+        // each fragment is words and the spaces between them, then a
+        // separator, except after the last one, which gets an end mark
+        double fragment = std::max(words * (mean_word_size() + 1.0) - 1.0,
+                                   0.0);
+        return frags * fragment + std::max(frags - 1.0, 0.0) * separator +
+               1.0;
+    }
+
+#ifndef LIPSUM_MIN_BUILD
+    double Generator::mean_fmt_sentence_size(bool useHtml) const
+    {
+        double plain = mean_sentence_size(m_Settings.word, m_Settings.frag);
+        double fmt = mean_sentence_size(m_Settings.wordFmt, m_Settings.fragFmt);
+
+        // half of the formatted sentences are emphasized, half in bold and
+        // half in italics, and the other half are links
+        double emphasis  = (useHtml ? 13.0 : 3.0);
+        double link      = (useHtml ? 15.0 : 4.0) + mean_url_size(false);
+        double formatted = fmt + (emphasis + link) / 2.0;
+
+        double chance = m_Settings.fmtSentence.probability(1);
+        return (1.0 - chance) * plain + chance * formatted + 1.0;
+    }
+
+    double Generator::mean_url_size(bool plain) const
+    {
+        static constexpr std::array<double, 7> TLD_SIZES = {
+                4.0, 4.0, 4.0, 4.0, 3.0, 3.0, 6.0};
+
+        double tld = 0.0;
+        for (std::size_t i = 0; i < TLD_SIZES.size(); ++i)
+        {
+            tld += m_Settings.tld.probability(i) * TLD_SIZES.at(i);
+        }
+
+        // "https://", then "lpsmcpp-", a word and the TLD, then "/#" and a
+        // slug
+        double word = mean_word_size();
+        double host = 8.0 + word + tld;
+        if (plain)
+        {
+            return host;
+        }
+        double slug = std::max(
+                m_Settings.wordURL.mean() * (word + 1.0) - 1.0, 0.0);
+        return 10.0 + host + slug;
+    }
+
+    double Generator::mean_json_size(std::size_t maxDepth) const
+    {
+        // mean size of a number from -1000 to 1000, of true or false, and of
+        // null
+        constexpr double NUMBER_SIZE  = 3.39;
+        constexpr double BOOLEAN_SIZE = 4.5;
+        constexpr double NULL_SIZE    = 4.0;
+
+        double word    = mean_word_size();
+        double members = m_Settings.jsonLength.mean();
+        double scalar  = (word + 2.0 + NUMBER_SIZE + BOOLEAN_SIZE + NULL_SIZE) /
+                        4.0;
+        // a quoted word, a one-digit index and a colon
+        double key = word + 4.0;
+
+        // the brackets, the values and the commas between them
+        auto array = [members](double value)
+        {
+            return 2.0 + members * value + std::max(members - 1.0, 0.0);
+        };
+
+        // values nested up to maxDepth - 1 levels: four in six are scalars,
+        // one an array and one an object
+        double value = scalar;
+        for (std::size_t depth = 1; depth < maxDepth; ++depth)
+        {
+            value = (4.0 * scalar + 2.0 * array(value) + members * key) / 6.0;
+        }
+        return array(value) + members * key;
+    }
+
+    double Generator::mean_csv_size() const
+    {
+        // mean size of a float from -1000 to 1000 with six decimals, of an
+        // IPv4 or IPv6 address with or without a port, and of a quoted phone
+        // number
+        constexpr double INT_SIZE   = 3.39;
+        constexpr double FLOAT_SIZE = 10.39;
+        constexpr double IP_SIZE    = 29.3;
+        constexpr double PHONE_SIZE = 18.67;
+        constexpr double SCRAMBLE   = 16.0;
+
+        // two words, a period and an at sign before the host
+        double word  = mean_word_size();
+        double email = 2.0 * word + 2.0 + mean_url_size(true);
+        double sentence =
+                mean_sentence_size(m_Settings.wordFmt, m_Settings.fragFmt) +
+                2.0;
+        double cell = (INT_SIZE + FLOAT_SIZE + sentence + word + email +
+                       SCRAMBLE + IP_SIZE + PHONE_SIZE) /
+                      8.0;
+
+        // each cell is followed by a comma or, for the last one, a newline
+        double cols = m_Settings.csvCols.mean();
+        return cols * (word + 1.0) + m_Settings.csvRows.mean() * cols *
+                                             (cell + 1.0);
+    }
+#endif
+
+    void Generator::reserve_more(std::string& out, std::size_t extra)
+    {
+        extra = std::min(extra, MAX_RESERVE);
+        if (extra > out.max_size() - out.size())
+        {
+            return;
+        }
+        std::size_t needed = out.size() + extra;
+        if (needed > out.capacity())
+        {
+            out.reserve(std::max(needed, out.capacity() * 2));
+        }
+    }
+} // namespace lipsum
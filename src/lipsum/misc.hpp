@@ -33,6 +33,25 @@ namespace lipsum
         HTML
     };
 
+    /**
+     * @brief Statistics of a string
+     *
+     * @since 0.5.3
+     *
+     * The counts of lpsm::CountWords(), lpsm::CountSentenceFragments(),
+     * lpsm::CountSentences() and lpsm::CountParagraphs(), as returned together
+     * by lpsm::AnalyzeText(). The counts are 64-bit, so that text larger than
+     * the range of int can be counted with lpsm::TextStatsAccumulator.
+     */
+    struct LIPSUM_API TextStats
+    {
+        std::uint64_t words      = 0; ///< The number of words
+        std::uint64_t fragments  = 0; ///< The number of sentence fragments
+        std::uint64_t sentences  = 0; ///< The number of sentences
+        std::uint64_t paragraphs = 0; ///< The number of paragraphs or
+                                      ///< elements
+    };
+
     /*
      * MISC
      * ----------------
@@ -99,7 +118,8 @@ namespace lipsum
      * @since 0.4.6
      *
      * Count the number of tab characters in a non-formatted string, double
-     * newlines in Markdown/HTML strings, and elements in HTML strings.
+     * newlines in Markdown/HTML strings, and elements in HTML strings, as
+     * found by lpsm::TagScanner::block_elements().
      *
      * @param str The string inputted.
      * @param format The format the string is in. By default non-formatted.
@@ -110,4 +130,27 @@ namespace lipsum
     CountParagraphs(const std::string& str,
                     CountParaMethod    format = CountParaMethod::Plain);
 
+    /**
+     * @brief Count the words, sentence fragments, sentences and paragraphs of
+     * a string.
+     *
+     * @since 0.5.3
+     *
+     * Count all four in one pass over the string, 64 characters at a time,
+     * with the same rules as lpsm::CountWords(),
+     * lpsm::CountSentenceFragments(), lpsm::CountSentences() and
+     * lpsm::CountParagraphs(). Blocks with no parentheses, outside of any, are
+     * counted from character masks; other blocks are walked character by
+     * character. Letters and digits are ASCII only.
+     *
+     * @param str The string inputted.
+     * @param format The format the string is in, for counting paragraphs. By
+     * default non-formatted.
+     *
+     * @return TextStats The counts.
+     */
+    LIPSUM_API TextStats
+    AnalyzeText(std::string_view str,
+                CountParaMethod  format = CountParaMethod::Plain);
+
 } // namespace lipsum
@@ -14,18 +14,9 @@
 #pragma once
 
 #include "core/internal.hpp"
-
-static int
-LipsumMiscInlFind(int count, const std::string& str, const std::string& check)
-{
-    size_t pos = 0;
-    while ((pos = str.find(check, pos)) != std::string::npos)
-    {
-        ++count;
-        pos += check.size();
-    }
-    return count;
-}
+#include "misc.hpp"
+#include "tagscanner.hpp"
+#include "textstats.hpp"
 
 namespace lipsum
 {
@@ -37,152 +28,56 @@ namespace lipsum
 
     std::string GenerateDefaultLipsumSentence()
     {
-        return {"Lorem ipsum dolor sit amet, consectetur adipiscing elit."};
+        return std::string(internal::LIPSUM_DEFAULT_SENTENCE);
     }
 
     int CountWords(const std::string& str)
     {
-        int  count      = 0;
-        int  urlNum     = 0;
-        bool inWord     = false;
-        char lastLetter = '\0';
-        for (const char& letter : str)
-        {
-            if (letter == '(')
-            {
-                ++urlNum;
-            }
-            if (letter == ')')
-            {
-                --urlNum;
-            }
-
-            bool isWordChar =
-                    static_cast<bool>(
-                            std::isalnum(static_cast<unsigned char>(letter))) ||
-                    (letter == '-' && lastLetter != '\n' &&
-                     lastLetter != ' ') ||
-                    (letter == '+' && lastLetter != '\n' &&
-                     lastLetter != ' ') ||
-                    (letter == '\'' && lastLetter != '\n' && lastLetter != ' ');
-            // if not in parens
-            if (urlNum <= 0)
-            {
-                if (isWordChar && !inWord)
-                {
-                    inWord = true;
-                    ++count;
-                }
-                if (!isWordChar)
-                {
-                    inWord = false;
-                }
-            }
-
-            lastLetter = letter;
-        }
+        auto count = static_cast<int>(AnalyzeText(str).words);
         LPSM_VERBOSE_LOG(Trace, "Counting words, got ", count);
         return count;
     }
 
     int CountSentenceFragments(const std::string& str)
     {
-        if (str.empty())
-        {
-            return 0;
-        }
-        int  res        = 0;
-        int  urlNum     = 0;
-        char lastLetter = '\0';
-        for (const char& letter : str)
-        {
-            if (letter == '(')
-            {
-                ++urlNum;
-            }
-            if (letter == ')')
-            {
-                --urlNum;
-            }
-
-            // if not in parens
-            if (urlNum <= 0)
-            {
-                if (letter == ',' || letter == ';' || letter == ':' ||
-                    letter == '.' || letter == '?' || letter == '!')
-                {
-                    ++res;
-                }
-                if (letter == '-' && lastLetter != '\n')
-                {
-                    ++res;
-                }
-            }
-            lastLetter = letter;
-        }
+        auto res = static_cast<int>(AnalyzeText(str).fragments);
         LPSM_VERBOSE_LOG(Trace, "Counting sentence fragments, got ", res);
         return res;
     }
 
     int CountSentences(const std::string& str)
     {
-        int res    = 0;
-        int urlNum = 0;
-        for (const char& letter : str)
-        {
-            if (letter == '(')
-            {
-                ++urlNum;
-            }
-            if (letter == ')')
-            {
-                --urlNum;
-            }
-            if ((letter == '.' || letter == '?' || letter == '!') &&
-                urlNum <= 0)
-            {
-                ++res;
-            }
-        }
+        auto res = static_cast<int>(AnalyzeText(str).sentences);
         LPSM_VERBOSE_LOG(Trace, "Counting sentences, got ", res);
         return res;
     }
 
     int CountParagraphs(const std::string& str, CountParaMethod format)
     {
-        switch (format)
+        if (format == CountParaMethod::HTML)
         {
-            case CountParaMethod::Plain:
-            {
-                return static_cast<int>(
-                        std::count(str.begin(), str.end(), '\t'));
-            }
-            case CountParaMethod::Markdown:
-            {
-                int count = LipsumMiscInlFind(0, str, "\n\n");
-                return count;
-            }
-            case CountParaMethod::HTML:
-            {
-                int count = LipsumMiscInlFind(0, str, "<p>");
-                count     = LipsumMiscInlFind(count, str, "<ol>");
-                count     = LipsumMiscInlFind(count, str, "<ul>");
-                count     = LipsumMiscInlFind(count, str, "<h1>");
-                count     = LipsumMiscInlFind(count, str, "<h2>");
-                count     = LipsumMiscInlFind(count, str, "<h3>");
-                count     = LipsumMiscInlFind(count, str, "<h4>");
-                count     = LipsumMiscInlFind(count, str, "<h5>");
-                count     = LipsumMiscInlFind(count, str, "<h6>");
-                return count;
-            }
-            default:
-            {
-                internal::LogWarn(internal::LogType::Warn,
-                                  "lpsm::CountParagraphs(): unknown format ",
-                                  static_cast<int>(format));
-                return 0;
-            }
+            // no other count needed, so only look at the less-than signs
+            return static_cast<int>(TagScanner::block_elements().count(str));
         }
+        return static_cast<int>(AnalyzeText(str, format).paragraphs);
+    }
+
+    TextStats AnalyzeText(std::string_view str, CountParaMethod format)
+    {
+        TextStatsAccumulator accumulator(format);
+        accumulator.add(str);
+        TextStats stats = accumulator.stats();
+        LPSM_VERBOSE_LOG(Trace,
+                         "Analyzing text, got ",
+                         stats.words,
+                         " words, ",
+                         stats.fragments,
+                         " fragments, ",
+                         stats.sentences,
+                         " sentences and ",
+                         stats.paragraphs,
+                         " paragraphs");
+        return stats;
     }
 
 } // namespace lipsum
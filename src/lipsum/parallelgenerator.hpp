@@ -0,0 +1,342 @@
+/**
+ * @file lipsum/parallelgenerator.hpp
+ *
+ * @brief Declaration of lipsum::ParallelGenerator
+ *
+ * This declares lipsum::ParallelGenerator, which generates bulk text on
+ * several threads. This file is under the BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core/core.hpp"
+#include "generator.hpp"
+#include "sink.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum
+{
+    /**
+     * @brief Class for generating bulk text on several threads
+     *
+     * @since 0.5.3
+     *
+     * This class splits a large request, such as a million paragraphs, into
+     * blocks of a fixed number of items. Each block is generated by a copy of
+     * a prototype lipsum::Generator, reseeded with its own stream of the seed
+     * (lipsum::Generator::load_stream()), so the text of a block only depends
+     * on the seed, the prototype and the position of the block. Threads that
+     * live for the whole request take the next block as soon as they finish
+     * one, a few blocks per thread ahead of the block being written, so slow
+     * blocks hold up no one but the writer, and blocks are written out in
+     * order while the next ones are generated. For a given seed and
+     * prototype, the output is the same byte for byte whatever the number of
+     * threads, including one; it differs from the output of a single
+     * lipsum::Generator with the same seed. Not available in minimum builds.
+     */
+    class LIPSUM_API ParallelGenerator
+    {
+    public:
+        /**
+         * @brief Number of paragraphs in each block
+         *
+         * @since 0.5.3
+         */
+        static constexpr std::size_t PARAGRAPHS_PER_BLOCK = 64;
+
+        /**
+         * @brief Number of Markdown or HTML elements in each block
+         *
+         * @since 0.5.3
+         */
+        static constexpr std::size_t FMT_ELEMENTS_PER_BLOCK = 64;
+
+        /**
+         * @brief Number of CSV rows in each block
+         *
+         * @since 0.5.3
+         */
+        static constexpr std::size_t CSV_ROWS_PER_BLOCK = 1024;
+
+        /**
+         * @brief Constructor with a seed
+         *
+         * @since 0.5.3
+         *
+         * Use a default lipsum::Generator as the prototype.
+         *
+         * @param seed The seed.
+         * @param threads The number of threads, or 0 for one per hardware
+         * thread. By default 0.
+         */
+        explicit ParallelGenerator(int seed, unsigned int threads = 0);
+
+        /**
+         * @brief Constructor with a prototype
+         *
+         * @since 0.5.3
+         *
+         * @param seed The seed.
+         * @param prototype The generator whose settings, source, engine, word
+         * frequencies and Markov model every block uses. Its own seed is
+         * ignored.
+         * @param threads The number of threads, or 0 for one per hardware
+         * thread. By default 0.
+         */
+        ParallelGenerator(int          seed,
+                          Generator    prototype,
+                          unsigned int threads = 0);
+
+        /**
+         * @brief Get the prototype
+         *
+         * @since 0.5.3
+         *
+         * Change settings, sources and the like through the prototype; the
+         * changes apply from the next call on.
+         *
+         * @return Generator& The generator every block is copied from.
+         */
+        [[nodiscard]] Generator& prototype();
+
+        /**
+         * @brief Reload a seed
+         *
+         * @since 0.5.3
+         *
+         * @param seed The seed.
+         */
+        void load_seed(int seed);
+
+        /**
+         * @brief Change the number of threads
+         *
+         * @since 0.5.3
+         *
+         * Only changes how fast text is generated, never the text itself.
+         *
+         * @param threads The number of threads, or 0 for one per hardware
+         * thread.
+         */
+        void set_threads(unsigned int threads);
+
+        /**
+         * @brief Get the number of threads
+         *
+         * @since 0.5.3
+         *
+         * @return unsigned int The number of threads, or 0 for one per
+         * hardware thread.
+         */
+        [[nodiscard]] unsigned int threads() const;
+
+        /**
+         * @brief Generate paragraphs.
+         *
+         * @since 0.5.3
+         *
+         * @param num The number of paragraphs. By default 1.
+         * @param useLipsum Whether to start with "Lorem ipsum dolor sit
+         * amet..." in the first paragraph. By default true.
+         *
+         * @return std::string The paragraphs.
+         *
+         * @sa lipsum::Generator::paragraph()
+         */
+        std::string paragraph(std::size_t num = 1, bool useLipsum = true);
+
+        /**
+         * @brief Append paragraphs to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * @param out The buffer to append to.
+         * @param num The number of paragraphs. By default 1.
+         * @param useLipsum Whether to start with "Lorem ipsum dolor sit
+         * amet..." in the first paragraph. By default true.
+         */
+        void paragraph_into(std::string& out,
+                            std::size_t  num       = 1,
+                            bool         useLipsum = true);
+
+        /**
+         * @brief Write paragraphs to a sink.
+         *
+         * @since 0.5.3
+         *
+         * Only a few blocks per thread are held in memory at once, however
+         * many paragraphs are written.
+         *
+         * @param sink The sink to write to.
+         * @param num The number of paragraphs. By default 1.
+         * @param useLipsum Whether to start with "Lorem ipsum dolor sit
+         * amet..." in the first paragraph. By default true.
+         */
+        void paragraph_to(Sink&       sink,
+                          std::size_t num       = 1,
+                          bool        useLipsum = true);
+
+        /**
+         * @brief Generate a Markdown or HTML document.
+         *
+         * @since 0.5.3
+         *
+         * @param numElements The number of elements. By default 15.
+         * @param useHtml Whether HTML should be outputted instead of Markdown.
+         * By default false.
+         *
+         * @return std::string The document.
+         *
+         * @sa lipsum::Generator::fmt_text()
+         */
+        std::string fmt_text(std::size_t numElements = 15,
+                             bool        useHtml     = false);
+
+        /**
+         * @brief Append a Markdown or HTML document to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * @param out The buffer to append to.
+         * @param numElements The number of elements. By default 15.
+         * @param useHtml Whether HTML should be outputted instead of Markdown.
+         * By default false.
+         */
+        void fmt_text_into(std::string& out,
+                           std::size_t  numElements = 15,
+                           bool         useHtml     = false);
+
+        /**
+         * @brief Write a Markdown or HTML document to a sink.
+         *
+         * @since 0.5.3
+         *
+         * @param sink The sink to write to.
+         * @param numElements The number of elements. By default 15.
+         * @param useHtml Whether HTML should be outputted instead of Markdown.
+         * By default false.
+         */
+        void fmt_text_to(Sink&       sink,
+                         std::size_t numElements = 15,
+                         bool        useHtml     = false);
+
+        /**
+         * @brief Generate a CSV document.
+         *
+         * @since 0.5.3
+         *
+         * The number of columns follows the "csvCols" setting of the
+         * prototype; the number of rows is given.
+         *
+         * @param numRows The number of rows after the header row.
+         *
+         * @return std::string The document.
+         *
+         * @sa lipsum::Generator::csv()
+         */
+        std::string csv(std::size_t numRows);
+
+        /**
+         * @brief Append a CSV document to a buffer.
+         *
+         * @since 0.5.3
+         *
+         * @param out The buffer to append to.
+         * @param numRows The number of rows after the header row.
+         */
+        void csv_into(std::string& out, std::size_t numRows);
+
+        /**
+         * @brief Write a CSV document to a sink.
+         *
+         * @since 0.5.3
+         *
+         * @param sink The sink to write to.
+         * @param numRows The number of rows after the header row.
+         */
+        void csv_to(Sink& sink, std::size_t numRows);
+
+    private:
+        /**
+         * @brief Function that fills one block
+         *
+         * @since 0.5.3
+         *
+         * Called with the generator to use, the buffer to append to, and the
+         * first and end indices of the items of the block.
+         */
+        using BlockFunction = std::function<
+                void(Generator&, std::string&, std::size_t, std::size_t)>;
+
+        /**
+         * @brief Generate items block by block and output them in order.
+         *
+         * @since 0.5.3
+         *
+         * Exactly one of out and sink must be non-null.
+         *
+         * @param out The buffer to append to, or null.
+         * @param sink The sink to write to, or null.
+         * @param count The number of items.
+         * @param perBlock The number of items in each block.
+         * @param fill The function that fills one block.
+         */
+        void generate(std::string*         out,
+                      Sink*                sink,
+                      std::size_t          count,
+                      std::size_t          perBlock,
+                      const BlockFunction& fill);
+
+        /**
+         * @brief Get the function that fills blocks of paragraphs.
+         *
+         * @since 0.5.3
+         *
+         * @param useLipsum Whether the first paragraph starts with "Lorem
+         * ipsum dolor sit amet...".
+         *
+         * @return BlockFunction The function.
+         */
+        static BlockFunction paragraph_blocks(bool useLipsum);
+
+        /**
+         * @brief Get the function that fills blocks of Markdown or HTML.
+         *
+         * @since 0.5.3
+         *
+         * The first block starts with a header and a paragraph, like
+         * lipsum::Generator::fmt_text(), and the last one ends with a
+         * paragraph.
+         *
+         * @param numElements The number of elements in the document.
+         * @param useHtml Whether HTML should be outputted instead of Markdown.
+         *
+         * @return BlockFunction The function.
+         */
+        static BlockFunction fmt_text_blocks(std::size_t numElements,
+                                             bool        useHtml);
+
+        /**
+         * @brief Start a CSV document.
+         *
+         * @since 0.5.3
+         *
+         * Append the header row, picked with stream 0 of the seed (blocks use
+         * the streams after it), and get the function that fills blocks of
+         * rows under it.
+         *
+         * @param out The buffer to append the header row to.
+         *
+         * @return BlockFunction The function.
+         */
+        BlockFunction csv_blocks(std::string& out);
+
+        Generator    m_Prototype; ///< Generator copied for every thread
+        int          m_Seed;      ///< Seed the streams are derived from
+        unsigned int m_Threads;   ///< Number of threads, or 0
+    };
+} // namespace lipsum
+#endif
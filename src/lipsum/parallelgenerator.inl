@@ -0,0 +1,340 @@
+/**
+ * @file lipsum/parallelgenerator.inl
+ *
+ * @brief Definition of lipsum::ParallelGenerator
+ *
+ * This defines lipsum::ParallelGenerator. This file is under the BSD
+ * Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core/internal.hpp"
+#include "core/parallel.hpp"
+#include "parallelgenerator.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum
+{
+    ParallelGenerator::ParallelGenerator(int seed, unsigned int threads)
+        : m_Prototype(seed), m_Seed(seed), m_Threads(threads)
+    {
+        LPSM_VERBOSE_LOG(Info,
+                         "Creating a lpsm::ParallelGenerator with seed ",
+                         seed);
+    }
+
+    ParallelGenerator::ParallelGenerator(int          seed,
+                                         Generator    prototype,
+                                         unsigned int threads)
+        : m_Prototype(std::move(prototype)), m_Seed(seed), m_Threads(threads)
+    {
+        LPSM_VERBOSE_LOG(Info,
+                         "Creating a lpsm::ParallelGenerator with seed ",
+                         seed,
+                         " and a prototype");
+    }
+
+    Generator& ParallelGenerator::prototype()
+    {
+        return m_Prototype;
+    }
+
+    void ParallelGenerator::load_seed(int seed)
+    {
+        m_Seed = seed;
+        LPSM_VERBOSE_LOG(Trace, "Loading seed ", seed);
+    }
+
+    void ParallelGenerator::set_threads(unsigned int threads)
+    {
+        m_Threads = threads;
+    }
+
+    unsigned int ParallelGenerator::threads() const
+    {
+        return m_Threads;
+    }
+
+    std::string ParallelGenerator::paragraph(std::size_t num, bool useLipsum)
+    {
+        std::string ret;
+        paragraph_into(ret, num, useLipsum);
+        return ret;
+    }
+
+    void ParallelGenerator::paragraph_into(std::string& out,
+                                           std::size_t  num,
+                                           bool         useLipsum)
+    {
+        Generator::reserve_more(
+                out,
+                m_Prototype.predicted_size(OutputType::Paragraph, num));
+        generate(&out,
+                 nullptr,
+                 num,
+                 PARAGRAPHS_PER_BLOCK,
+                 paragraph_blocks(useLipsum));
+    }
+
+    void ParallelGenerator::paragraph_to(Sink&       sink,
+                                         std::size_t num,
+                                         bool        useLipsum)
+    {
+        generate(nullptr,
+                 &sink,
+                 num,
+                 PARAGRAPHS_PER_BLOCK,
+                 paragraph_blocks(useLipsum));
+    }
+
+    std::string ParallelGenerator::fmt_text(std::size_t numElements,
+                                            bool        useHtml)
+    {
+        std::string ret;
+        fmt_text_into(ret, numElements, useHtml);
+        return ret;
+    }
+
+    void ParallelGenerator::fmt_text_into(std::string& out,
+                                          std::size_t  numElements,
+                                          bool         useHtml)
+    {
+        Generator::reserve_more(out,
+                                m_Prototype.predicted_size(OutputType::FmtText,
+                                                           numElements,
+                                                           useHtml));
+        generate(&out,
+                 nullptr,
+                 numElements,
+                 FMT_ELEMENTS_PER_BLOCK,
+                 fmt_text_blocks(numElements, useHtml));
+    }
+
+    void ParallelGenerator::fmt_text_to(Sink&       sink,
+                                        std::size_t numElements,
+                                        bool        useHtml)
+    {
+        generate(nullptr,
+                 &sink,
+                 numElements,
+                 FMT_ELEMENTS_PER_BLOCK,
+                 fmt_text_blocks(numElements, useHtml));
+    }
+
+    std::string ParallelGenerator::csv(std::size_t numRows)
+    {
+        std::string ret;
+        csv_into(ret, numRows);
+        return ret;
+    }
+
+    void ParallelGenerator::csv_into(std::string& out, std::size_t numRows)
+    {
+        BlockFunction fill = csv_blocks(out);
+        generate(&out, nullptr, numRows, CSV_ROWS_PER_BLOCK, fill);
+    }
+
+    void ParallelGenerator::csv_to(Sink& sink, std::size_t numRows)
+    {
+        BlockFunction fill = csv_blocks(sink.buffer());
+        sink.commit();
+        generate(nullptr, &sink, numRows, CSV_ROWS_PER_BLOCK, fill);
+    }
+
+    /*
+     * PRIVATE
+     */
+
+    void ParallelGenerator::generate(std::string*         out,
+                                     Sink*                sink,
+                                     std::size_t          count,
+                                     std::size_t          perBlock,
+                                     const BlockFunction& fill)
+    {
+        std::size_t  blocks  = (count + perBlock - 1) / perBlock;
+        unsigned int threads = internal::ThreadCount(m_Threads);
+        if (blocks < threads)
+        {
+            threads = static_cast<unsigned int>(std::max<std::size_t>(blocks,
+                                                                      1));
+        }
+        LPSM_VERBOSE_LOG(Trace,
+                         "Generating ",
+                         blocks,
+                         " blocks on ",
+                         threads,
+                         " threads");
+
+        auto seed     = static_cast<std::uint32_t>(m_Seed);
+        auto fillNext = [&](Generator& gen, std::string& block, std::size_t i)
+        {
+            // stream 0 is left for whole-document choices
+            block.clear();
+            gen.load_stream(seed, i + 1);
+            fill(gen,
+                 block,
+                 i * perBlock,
+                 std::min(count, (i + 1) * perBlock));
+        };
+        auto write = [out, sink](const std::string& block)
+        {
+            if (sink != nullptr)
+            {
+                sink->write(block);
+            }
+            else
+            {
+                out->append(block);
+            }
+        };
+
+#    ifdef LPSM_HAS_THREADS
+        if (threads > 1)
+        {
+            // enough blocks per thread in flight to keep every thread busy
+            // while the oldest one is written
+            constexpr std::size_t BLOCKS_PER_THREAD = 4;
+
+            // the workers live for the whole call and take the next block
+            // as soon as they finish one, never running more than window
+            // blocks ahead of the one being written
+            std::size_t              window = threads * BLOCKS_PER_THREAD;
+            std::vector<std::string> slots(window);
+            std::vector<char>        ready(window, 0);
+            std::size_t              written = 0;
+            std::atomic<std::size_t> next    = 0;
+            std::mutex               lock;
+            std::condition_variable  changed;
+
+            auto work = [&]()
+            {
+                Generator gen = m_Prototype;
+                for (;;)
+                {
+                    std::size_t i = next.fetch_add(1);
+                    if (i >= blocks)
+                    {
+                        return;
+                    }
+                    {
+                        std::unique_lock<std::mutex> guard(lock);
+                        changed.wait(guard,
+                                     [&]() { return i < written + window; });
+                    }
+                    // the block that used this slot has been written
+                    fillNext(gen, slots[i % window], i);
+                    {
+                        std::lock_guard<std::mutex> guard(lock);
+                        ready[i % window] = 1;
+                    }
+                    changed.notify_all();
+                }
+            };
+
+            std::vector<std::future<void>> workers;
+            workers.reserve(threads);
+            for (unsigned int i = 0; i < threads; ++i)
+            {
+                workers.push_back(std::async(std::launch::async, work));
+            }
+            for (std::size_t i = 0; i < blocks; ++i)
+            {
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    changed.wait(guard,
+                                 [&]() { return ready[i % window] != 0; });
+                }
+                write(slots[i % window]);
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    ready[i % window] = 0;
+                    ++written;
+                }
+                changed.notify_all();
+            }
+            for (auto& worker : workers)
+            {
+                worker.get();
+            }
+            return;
+        }
+#    endif
+        Generator   gen = m_Prototype;
+        std::string block;
+        for (std::size_t i = 0; i < blocks; ++i)
+        {
+            fillNext(gen, block, i);
+            write(block);
+        }
+    }
+
+    ParallelGenerator::BlockFunction
+    ParallelGenerator::paragraph_blocks(bool useLipsum)
+    {
+        return [useLipsum](Generator&   gen,
+                           std::string& out,
+                           std::size_t  first,
+                           std::size_t  last)
+        {
+            for (std::size_t i = first; i < last; ++i)
+            {
+                gen.paragraph_into(out, 1, i == 0 && useLipsum);
+            }
+        };
+    }
+
+    ParallelGenerator::BlockFunction
+    ParallelGenerator::fmt_text_blocks(std::size_t numElements, bool useHtml)
+    {
+        return [numElements, useHtml](Generator&   gen,
+                                      std::string& out,
+                                      std::size_t  first,
+                                      std::size_t  last)
+        {
+            // the block before is generated at the same time, so its last
+            // element is unknown; taking it for a header keeps two headers
+            // from meeting across the boundary
+            int lastKind = 1;
+            if (first == 0)
+            {
+                // a header and a paragraph, as in lipsum::Generator::fmt_text()
+                first = std::min<std::size_t>(last, 2);
+                gen.fmt_text_chunked(out,
+                                     nullptr,
+                                     static_cast<int>(first),
+                                     useHtml);
+                lastKind = 0;
+            }
+            gen.fmt_elements_chunked(out,
+                                     nullptr,
+                                     static_cast<int>(last - first),
+                                     useHtml,
+                                     last == numElements,
+                                     lastKind);
+        };
+    }
+
+    ParallelGenerator::BlockFunction
+    ParallelGenerator::csv_blocks(std::string& out)
+    {
+        std::vector<Generator::CsvType> cols;
+        Generator                       header = m_Prototype;
+        header.load_stream(static_cast<std::uint32_t>(m_Seed), 0);
+        header.csv_header_into(out, cols);
+        return [cols = std::move(cols)](Generator&   gen,
+                                        std::string& block,
+                                        std::size_t  first,
+                                        std::size_t  last)
+        {
+            for (std::size_t i = first; i < last; ++i)
+            {
+                gen.csv_row_into(block, cols);
+            }
+        };
+    }
+} // namespace lipsum
+#endif
@@ -0,0 +1,422 @@
+/**
+ * @file lipsum/sink.hpp
+ *
+ * @brief Declaration of lipsum::Sink
+ *
+ * This declares lipsum::Sink and the built-in sinks, which let
+ * lipsum::Generator write its output incrementally. This file is under the BSD
+ * Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core/core.hpp"
+
+namespace lipsum
+{
+    /**
+     * @brief When a lipsum::Sink hands its buffer to its target
+     *
+     * @since 0.5.3
+     *
+     * WhenFull writes the buffer out once it holds at least the capacity of the
+     * sink. EachUnit writes and flushes the buffer after every unit (word,
+     * sentence, paragraph, element...), which is useful for pipes and
+     * interactive output.
+     */
+    enum class FlushPolicy : int
+    {
+        WhenFull = 0,
+        EachUnit
+    };
+
+    /**
+     * @brief Bounded output buffer for streaming generation
+     *
+     * @since 0.5.3
+     *
+     * Base class of every sink. Generator functions ending in _to() append one
+     * unit at a time to buffer() and call commit() after each one, so the
+     * buffer never holds more than its capacity plus a single unit, no matter
+     * how large the whole output is. Derived classes implement write_raw() and
+     * optionally flush_raw(), and must call flush() in their destructor. Once
+     * the target reports an error, good() returns false and further output is
+     * discarded.
+     */
+    class LIPSUM_API Sink
+    {
+    public:
+        /**
+         * @brief Default capacity of a sink, in bytes
+         *
+         * @since 0.5.3
+         */
+        static constexpr std::size_t DEFAULT_CAPACITY = 64 * 1024;
+
+        /**
+         * @brief Constructor for Sink
+         *
+         * @since 0.5.3
+         *
+         * Reserve capacity bytes for the buffer.
+         *
+         * @param capacity The size the buffer may reach before it is written
+         * out. By default DEFAULT_CAPACITY.
+         * @param policy When the buffer is written out. By default
+         * FlushPolicy::WhenFull.
+         */
+        explicit Sink(std::size_t capacity = DEFAULT_CAPACITY,
+                      FlushPolicy policy   = FlushPolicy::WhenFull);
+
+        /**
+         * @brief Destructor for Sink
+         *
+         * @since 0.5.3
+         *
+         * Does not flush; derived classes flush in their own destructor, while
+         * write_raw() can still be called.
+         */
+        virtual ~Sink() = default;
+
+        Sink(const Sink&)            = delete;
+        Sink& operator=(const Sink&) = delete;
+
+        /**
+         * @brief Get the buffer of the sink.
+         *
+         * @since 0.5.3
+         *
+         * Get the buffer that generator functions append to. Call commit()
+         * after appending a unit.
+         *
+         * @return std::string& The buffer.
+         */
+        [[nodiscard]] std::string& buffer();
+
+        /**
+         * @brief Mark the end of a unit.
+         *
+         * @since 0.5.3
+         *
+         * Write the buffer out if the flush policy asks for it.
+         */
+        void commit();
+
+        /**
+         * @brief Append a string and commit it.
+         *
+         * @since 0.5.3
+         *
+         * Append str to the buffer and call commit(). If the buffer is empty
+         * and str does not fit in it, write str out directly.
+         *
+         * @param str The string to write.
+         */
+        void write(std::string_view str);
+
+        /**
+         * @brief Write the buffer out and flush the target.
+         *
+         * @since 0.5.3
+         */
+        void flush();
+
+        /**
+         * @brief Check if the target accepted all output so far.
+         *
+         * @since 0.5.3
+         *
+         * @return bool Whether no write to the target has failed.
+         */
+        [[nodiscard]] bool good() const;
+
+        /**
+         * @brief Get the capacity of the sink.
+         *
+         * @since 0.5.3
+         *
+         * @return std::size_t The capacity, in bytes.
+         */
+        [[nodiscard]] std::size_t capacity() const;
+
+    protected:
+        /**
+         * @brief Write data to the target.
+         *
+         * @since 0.5.3
+         *
+         * @param data The data to write.
+         *
+         * @return bool Whether all of data was written.
+         */
+        virtual bool write_raw(std::string_view data) = 0;
+
+        /**
+         * @brief Flush the target.
+         *
+         * @since 0.5.3
+         *
+         * By default do nothing.
+         *
+         * @return bool Whether the target was flushed.
+         */
+        virtual bool flush_raw();
+
+    private:
+        /**
+         * @brief Write the buffer to the target and clear it.
+         *
+         * @since 0.5.3
+         */
+        void drain();
+
+        /**
+         * @brief Record the result of a write to the target.
+         *
+         * @since 0.5.3
+         *
+         * @param isOk Whether the write succeeded.
+         */
+        void check(bool isOk);
+
+        std::string m_Buffer;      ///< Output not yet written to the target.
+        std::size_t m_Capacity;    ///< Size at which the buffer is written out.
+        FlushPolicy m_Policy;      ///< When the buffer is written out.
+        bool        m_Good = true; ///< Whether every write succeeded.
+    };
+
+    /**
+     * @brief Sink that collects output in a string
+     *
+     * @since 0.5.3
+     *
+     * Collect all output in a string. Unlike the other sinks, its memory use
+     * grows with the output; it is mostly useful for tests and for adapting
+     * code written against lipsum::Sink.
+     */
+    class LIPSUM_API StringSink final : public Sink
+    {
+    public:
+        /**
+         * @brief Constructor for StringSink
+         *
+         * @since 0.5.3
+         *
+         * @param capacity The size the buffer may reach before it is moved to
+         * the string. By default Sink::DEFAULT_CAPACITY.
+         */
+        explicit StringSink(std::size_t capacity = DEFAULT_CAPACITY);
+
+        /**
+         * @brief Destructor for StringSink
+         *
+         * @since 0.5.3
+         */
+        ~StringSink() override;
+
+        /**
+         * @brief Get the output collected so far.
+         *
+         * @since 0.5.3
+         *
+         * Flush the sink and return the collected string.
+         *
+         * @return const std::string& The output.
+         */
+        [[nodiscard]] const std::string& str();
+
+    protected:
+        bool write_raw(std::string_view data) override;
+
+    private:
+        std::string m_Str; ///< The collected output.
+    };
+
+    /**
+     * @brief Sink that writes to a std::ostream
+     *
+     * @since 0.5.3
+     *
+     * Write output to a stream, such as std::cout or a std::ofstream. The
+     * stream must outlive the sink.
+     */
+    class LIPSUM_API StreamSink final : public Sink
+    {
+    public:
+        /**
+         * @brief Constructor for StreamSink
+         *
+         * @since 0.5.3
+         *
+         * @param stream The stream to write to.
+         * @param capacity The size the buffer may reach before it is written
+         * out. By default Sink::DEFAULT_CAPACITY.
+         * @param policy When the buffer is written out. By default
+         * FlushPolicy::WhenFull.
+         */
+        explicit StreamSink(std::ostream& stream,
+                            std::size_t   capacity = DEFAULT_CAPACITY,
+                            FlushPolicy   policy   = FlushPolicy::WhenFull);
+
+        /**
+         * @brief Destructor for StreamSink
+         *
+         * @since 0.5.3
+         *
+         * Flush the remaining output to the stream.
+         */
+        ~StreamSink() override;
+
+    protected:
+        bool write_raw(std::string_view data) override;
+        bool flush_raw() override;
+
+    private:
+        std::ostream& m_Stream; ///< The stream written to.
+    };
+
+    /**
+     * @brief Sink that hands output to a callback
+     *
+     * @since 0.5.3
+     *
+     * Call a function with each chunk of output. The chunk is only valid
+     * during the call.
+     */
+    class LIPSUM_API CallbackSink final : public Sink
+    {
+    public:
+        /**
+         * @brief Type of the callback
+         *
+         * @since 0.5.3
+         *
+         * Returns false to report an error, after which no more output is
+         * handed to it.
+         */
+        using Callback = std::function<bool(std::string_view)>;
+
+        /**
+         * @brief Constructor for CallbackSink
+         *
+         * @since 0.5.3
+         *
+         * @param callback The function called with each chunk.
+         * @param capacity The size the buffer may reach before it is handed to
+         * the callback. By default Sink::DEFAULT_CAPACITY.
+         * @param policy When the buffer is handed to the callback. By default
+         * FlushPolicy::WhenFull.
+         */
+        explicit CallbackSink(Callback    callback,
+                              std::size_t capacity = DEFAULT_CAPACITY,
+                              FlushPolicy policy   = FlushPolicy::WhenFull);
+
+        /**
+         * @brief Destructor for CallbackSink
+         *
+         * @since 0.5.3
+         *
+         * Hand the remaining output to the callback.
+         */
+        ~CallbackSink() override;
+
+    protected:
+        bool write_raw(std::string_view data) override;
+
+    private:
+        Callback m_Callback; ///< The function called with each chunk.
+    };
+
+#ifndef LIPSUM_MIN_BUILD
+    /**
+     * @brief Sink that writes to a C file
+     *
+     * @since 0.5.3
+     *
+     * Write output to a FILE*, such as stdout or a file opened with
+     * std::fopen(). The file is not closed by the sink. Not available in
+     * minimum builds.
+     */
+    class LIPSUM_API FileSink final : public Sink
+    {
+    public:
+        /**
+         * @brief Constructor for FileSink
+         *
+         * @since 0.5.3
+         *
+         * @param file The file to write to.
+         * @param capacity The size the buffer may reach before it is written
+         * out. By default Sink::DEFAULT_CAPACITY.
+         * @param policy When the buffer is written out. By default
+         * FlushPolicy::WhenFull.
+         */
+        explicit FileSink(std::FILE*  file,
+                          std::size_t capacity = DEFAULT_CAPACITY,
+                          FlushPolicy policy   = FlushPolicy::WhenFull);
+
+        /**
+         * @brief Destructor for FileSink
+         *
+         * @since 0.5.3
+         *
+         * Flush the remaining output to the file.
+         */
+        ~FileSink() override;
+
+    protected:
+        bool write_raw(std::string_view data) override;
+        bool flush_raw() override;
+
+    private:
+        std::FILE* m_File; ///< The file written to.
+    };
+
+    /**
+     * @brief Sink that writes to a file descriptor
+     *
+     * @since 0.5.3
+     *
+     * Write output to a raw file descriptor, such as 1 for standard output or
+     * a pipe, bypassing any stdio buffering. Partial and interrupted writes are
+     * retried. The descriptor is not closed by the sink. Not available in
+     * minimum builds.
+     */
+    class LIPSUM_API FdSink final : public Sink
+    {
+    public:
+        /**
+         * @brief Constructor for FdSink
+         *
+         * @since 0.5.3
+         *
+         * @param fd The file descriptor to write to.
+         * @param capacity The size the buffer may reach before it is written
+         * out. By default Sink::DEFAULT_CAPACITY.
+         * @param policy When the buffer is written out. By default
+         * FlushPolicy::WhenFull.
+         */
+        explicit FdSink(int         fd,
+                        std::size_t capacity = DEFAULT_CAPACITY,
+                        FlushPolicy policy   = FlushPolicy::WhenFull);
+
+        /**
+         * @brief Destructor for FdSink
+         *
+         * @since 0.5.3
+         *
+         * Write the remaining output to the file descriptor.
+         */
+        ~FdSink() override;
+
+    protected:
+        bool write_raw(std::string_view data) override;
+
+    private:
+        int m_Fd; ///< The file descriptor written to.
+    };
+#endif
+} // namespace lipsum
@@ -0,0 +1,226 @@
+/**
+ * @file lipsum/sink.inl
+ *
+ * @brief Definition of lipsum::Sink
+ *
+ * This defines lipsum::Sink and the built-in sinks. This file is under the BSD
+ * Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core/internal.hpp"
+#include "sink.hpp"
+
+namespace lipsum
+{
+    Sink::Sink(std::size_t capacity, FlushPolicy policy)
+        : m_Capacity(capacity), m_Policy(policy)
+    {
+        m_Buffer.reserve(capacity);
+    }
+
+    std::string& Sink::buffer()
+    {
+        return m_Buffer;
+    }
+
+    void Sink::commit()
+    {
+        if (m_Policy == FlushPolicy::EachUnit)
+        {
+            flush();
+        }
+        else if (m_Buffer.size() >= m_Capacity)
+        {
+            drain();
+        }
+    }
+
+    void Sink::write(std::string_view str)
+    {
+        if (m_Buffer.empty() && str.size() >= m_Capacity)
+        {
+            if (m_Good)
+            {
+                check(write_raw(str));
+            }
+            if (m_Policy == FlushPolicy::EachUnit)
+            {
+                flush();
+            }
+            return;
+        }
+        m_Buffer += str;
+        commit();
+    }
+
+    void Sink::flush()
+    {
+        drain();
+        if (m_Good)
+        {
+            check(flush_raw());
+        }
+    }
+
+    bool Sink::good() const
+    {
+        return m_Good;
+    }
+
+    std::size_t Sink::capacity() const
+    {
+        return m_Capacity;
+    }
+
+    bool Sink::flush_raw()
+    {
+        return true;
+    }
+
+    void Sink::drain()
+    {
+        if (m_Good && !m_Buffer.empty())
+        {
+            check(write_raw(m_Buffer));
+        }
+        // keep the buffer bounded even if the target failed
+        m_Buffer.clear();
+    }
+
+    void Sink::check(bool isOk)
+    {
+        if (!isOk)
+        {
+            internal::LogWarn(internal::LogType::Error,
+                              "lpsm::Sink: failed to write output; discarding "
+                              "the rest");
+            m_Good = false;
+        }
+    }
+
+    StringSink::StringSink(std::size_t capacity) : Sink(capacity)
+    {
+    }
+
+    StringSink::~StringSink()
+    {
+        flush();
+    }
+
+    const std::string& StringSink::str()
+    {
+        flush();
+        return m_Str;
+    }
+
+    bool StringSink::write_raw(std::string_view data)
+    {
+        m_Str += data;
+        return true;
+    }
+
+    StreamSink::StreamSink(std::ostream& stream,
+                           std::size_t   capacity,
+                           FlushPolicy   policy)
+        : Sink(capacity, policy), m_Stream(stream)
+    {
+    }
+
+    StreamSink::~StreamSink()
+    {
+        flush();
+    }
+
+    bool StreamSink::write_raw(std::string_view data)
+    {
+        m_Stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+        return !m_Stream.fail();
+    }
+
+    bool StreamSink::flush_raw()
+    {
+        m_Stream.flush();
+        return !m_Stream.fail();
+    }
+
+    CallbackSink::CallbackSink(Callback    callback,
+                               std::size_t capacity,
+                               FlushPolicy policy)
+        : Sink(capacity, policy), m_Callback(std::move(callback))
+    {
+    }
+
+    CallbackSink::~CallbackSink()
+    {
+        flush();
+    }
+
+    bool CallbackSink::write_raw(std::string_view data)
+    {
+        return m_Callback(data);
+    }
+
+#ifndef LIPSUM_MIN_BUILD
+    FileSink::FileSink(std::FILE*  file,
+                       std::size_t capacity,
+                       FlushPolicy policy)
+        : Sink(capacity, policy), m_File(file)
+    {
+    }
+
+    FileSink::~FileSink()
+    {
+        flush();
+    }
+
+    bool FileSink::write_raw(std::string_view data)
+    {
+        return std::fwrite(data.data(), 1, data.size(), m_File) == data.size();
+    }
+
+    bool FileSink::flush_raw()
+    {
+        return std::fflush(m_File) == 0;
+    }
+
+    FdSink::FdSink(int fd, std::size_t capacity, FlushPolicy policy)
+        : Sink(capacity, policy), m_Fd(fd)
+    {
+    }
+
+    FdSink::~FdSink()
+    {
+        flush();
+    }
+
+    bool FdSink::write_raw(std::string_view data)
+    {
+        while (!data.empty())
+        {
+#    ifdef _WIN32
+            auto chunk   = static_cast<unsigned int>(std::min<std::size_t>(
+                    data.size(),
+                    std::numeric_limits<int>::max()));
+            int  written = _write(m_Fd, data.data(), chunk);
+#    else
+            ssize_t written = ::write(m_Fd, data.data(), data.size());
+#    endif
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return false;
+            }
+            data.remove_prefix(static_cast<std::size_t>(written));
+        }
+        return true;
+    }
+#endif
+} // namespace lipsum
@@ -0,0 +1,186 @@
+/**
+ * @file lipsum/tagscanner.hpp
+ *
+ * @brief Declaration of lipsum::TagScanner
+ *
+ * This declares lipsum::TagScanner, which counts a set of HTML tags in one
+ * pass over a string. This file is under the BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core/core.hpp"
+#include "core/stdincludes.hpp"
+
+namespace lipsum
+{
+    /**
+     * @brief Counter of several HTML tags in one pass
+     *
+     * @since 0.5.3
+     *
+     * Holds a set of tags, each a string starting with a less-than sign such
+     * as "<p>" or "<table", and counts where each one starts in a string. The
+     * string is searched for less-than signs 16 bytes at a time if SSE2 is
+     * available, and only the tags whose second character matches are compared
+     * at each one, so adding tags costs nothing on text between tags. A tag
+     * with no closing greater-than sign also matches longer names and
+     * attributes, e.g. "<td" matches "<td>" and "<td class=\"x\">".
+     */
+    class LIPSUM_API TagScanner
+    {
+    public:
+        /**
+         * @brief Constructor for TagScanner
+         *
+         * @since 0.5.3
+         *
+         * Tags that do not start with a less-than sign followed by at least
+         * one character are rejected with a warning. They keep their place,
+         * so the counts of count_each() still line up with tags, and never
+         * match.
+         *
+         * @param tags The tags to count.
+         */
+        explicit TagScanner(const std::vector<std::string>& tags);
+
+        /**
+         * @brief Constructor for TagScanner
+         *
+         * @since 0.5.3
+         *
+         * @param tags The tags to count.
+         */
+        TagScanner(std::initializer_list<std::string_view> tags);
+
+        /**
+         * @brief Get the block-level elements lipsum::Generator writes.
+         *
+         * @since 0.5.3
+         *
+         * The scanner lpsm::CountParagraphs() uses for
+         * lpsm::CountParaMethod::HTML: "<p>", "<ol>", "<ul>" and "<h1>" to
+         * "<h6>".
+         *
+         * @return const TagScanner& The scanner, built on first use.
+         */
+        static const TagScanner& block_elements();
+
+        /**
+         * @brief Count every tag in a string.
+         *
+         * @since 0.5.3
+         *
+         * @param str The string to search.
+         *
+         * @return std::size_t The number of places a tag starts, counted once
+         * per tag that matches there.
+         */
+        [[nodiscard]] std::size_t count(std::string_view str) const;
+
+        /**
+         * @brief Count each tag in a string.
+         *
+         * @since 0.5.3
+         *
+         * @param str The string to search.
+         *
+         * @return std::vector<std::size_t> The number of times each tag
+         * starts in str, in the order the tags were given, with 0 for
+         * rejected tags.
+         */
+        [[nodiscard]] std::vector<std::size_t>
+        count_each(std::string_view str) const;
+
+        /**
+         * @brief Count the tags starting at a position.
+         *
+         * @since 0.5.3
+         *
+         * Used by lpsm::AnalyzeText(), which finds less-than signs on its
+         * own.
+         *
+         * @param str The string to search.
+         * @param pos The index of a less-than sign in str.
+         *
+         * @return std::size_t The number of tags that start at pos.
+         */
+        [[nodiscard]] std::size_t count_at(std::string_view str,
+                                           std::size_t      pos) const;
+
+        /**
+         * @brief Get the number of tags.
+         *
+         * @since 0.5.3
+         *
+         * @return std::size_t The number of tags given, including rejected
+         * ones.
+         */
+        [[nodiscard]] std::size_t size() const;
+
+    private:
+        /**
+         * @brief Add a tag.
+         *
+         * @since 0.5.3
+         *
+         * A rejected tag is kept as an empty string, which index() leaves
+         * out. This function is private.
+         *
+         * @param tag The tag.
+         */
+        void add(std::string_view tag);
+
+        /**
+         * @brief Group the tags by their second character.
+         *
+         * @since 0.5.3
+         *
+         * This function is private.
+         */
+        void index();
+
+        /**
+         * @brief Call a function for every tag that starts at a position.
+         *
+         * @since 0.5.3
+         *
+         * This function is private.
+         *
+         * @tparam F The function type.
+         *
+         * @param str The string to search.
+         * @param pos The index of a less-than sign in str.
+         * @param onTag The function, called with the index of each tag in the
+         * order the tags were given.
+         */
+        template <typename F>
+        void match_at(std::string_view str, std::size_t pos, F&& onTag) const;
+
+        /**
+         * @brief Call a function for every tag in a string.
+         *
+         * @since 0.5.3
+         *
+         * This function is private.
+         *
+         * @tparam F The function type.
+         *
+         * @param str The string to search.
+         * @param onTag The function, called with the index of each tag in the
+         * order the tags were given.
+         */
+        template <typename F>
+        void scan(std::string_view str, F&& onTag) const;
+
+        std::vector<std::string>     m_Tags;   ///< The tags, in the order
+                                               ///< given, empty if rejected
+        std::vector<std::size_t>     m_ByByte; ///< Tag indices by second byte,
+                                               ///< without rejected tags
+        std::array<std::size_t, 257> m_Buckets{}; ///< Where each second byte
+                                                  ///< starts in m_ByByte
+    };
+} // namespace lipsum
@@ -0,0 +1,182 @@
+/**
+ * @file lipsum/tagscanner.inl
+ *
+ * @brief Definition of lipsum::TagScanner
+ *
+ * This defines the functions in lipsum::TagScanner. This file is under the BSD
+ * Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core/internal.hpp"
+#include "tagscanner.hpp"
+
+namespace lipsum
+{
+    TagScanner::TagScanner(const std::vector<std::string>& tags)
+    {
+        for (const std::string& tag : tags)
+        {
+            add(tag);
+        }
+        index();
+    }
+
+    TagScanner::TagScanner(std::initializer_list<std::string_view> tags)
+    {
+        for (std::string_view tag : tags)
+        {
+            add(tag);
+        }
+        index();
+    }
+
+    const TagScanner& TagScanner::block_elements()
+    {
+        static const TagScanner BLOCK_ELEMENTS = {
+                "<p>",
+                "<ol>",
+                "<ul>",
+                "<h1>",
+                "<h2>",
+                "<h3>",
+                "<h4>",
+                "<h5>",
+                "<h6>",
+        };
+        return BLOCK_ELEMENTS;
+    }
+
+    std::size_t TagScanner::count(std::string_view str) const
+    {
+        std::size_t total = 0;
+        scan(str, [&total](std::size_t) { ++total; });
+        LPSM_VERBOSE_LOG(Trace, "Counting tags, got ", total);
+        return total;
+    }
+
+    std::vector<std::size_t> TagScanner::count_each(std::string_view str) const
+    {
+        std::vector<std::size_t> counts(m_Tags.size(), 0);
+        scan(str, [&counts](std::size_t idx) { ++counts[idx]; });
+        return counts;
+    }
+
+    std::size_t TagScanner::count_at(std::string_view str,
+                                     std::size_t      pos) const
+    {
+        std::size_t total = 0;
+        match_at(str, pos, [&total](std::size_t) { ++total; });
+        return total;
+    }
+
+    std::size_t TagScanner::size() const
+    {
+        return m_Tags.size();
+    }
+
+    void TagScanner::add(std::string_view tag)
+    {
+        if (tag.size() < 2 || tag.front() != '<')
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::TagScanner::TagScanner(): expected a tag "
+                              "starting with '<' and a name, got \"",
+                              tag,
+                              "\"; it will not be counted");
+            m_Tags.emplace_back();
+            return;
+        }
+        m_Tags.emplace_back(tag);
+    }
+
+    void TagScanner::index()
+    {
+        // counting sort of the tags by their second byte
+        // rejected tags are empty and left out, so they never match
+        m_Buckets.fill(0);
+        std::size_t kept = 0;
+        for (const std::string& tag : m_Tags)
+        {
+            if (!tag.empty())
+            {
+                ++m_Buckets[static_cast<unsigned char>(tag[1]) + 1];
+                ++kept;
+            }
+        }
+        for (std::size_t i = 1; i < m_Buckets.size(); ++i)
+        {
+            m_Buckets[i] += m_Buckets[i - 1];
+        }
+        std::array<std::size_t, 257> next = m_Buckets;
+        m_ByByte.assign(kept, 0);
+        for (std::size_t i = 0; i < m_Tags.size(); ++i)
+        {
+            if (!m_Tags[i].empty())
+            {
+                m_ByByte[next[static_cast<unsigned char>(m_Tags[i][1])]++] = i;
+            }
+        }
+    }
+
+    template <typename F>
+    void TagScanner::match_at(std::string_view str,
+                              std::size_t      pos,
+                              F&&              onTag) const
+    {
+        if (pos + 1 >= str.size())
+        {
+            return;
+        }
+        std::string_view rest   = str.substr(pos);
+        auto             second = static_cast<unsigned char>(rest[1]);
+        for (std::size_t i = m_Buckets[second]; i < m_Buckets[second + 1];
+             ++i)
+        {
+            if (rest.starts_with(m_Tags[m_ByByte[i]]))
+            {
+                onTag(m_ByByte[i]);
+            }
+        }
+    }
+
+    template <typename F>
+    void TagScanner::scan(std::string_view str, F&& onTag) const
+    {
+        std::size_t pos = 0;
+        if (m_ByByte.empty())
+        {
+            return;
+        }
+#ifdef LPSM_HAS_SSE2
+        constexpr std::size_t BLOCK = 16;
+
+        const __m128i lessThan = _mm_set1_epi8('<');
+        for (; pos + BLOCK <= str.size(); pos += BLOCK)
+        {
+            __m128i bytes = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(str.data() + pos));
+            auto bits = static_cast<std::uint32_t>(
+                    _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, lessThan)));
+            while (bits != 0)
+            {
+                match_at(str,
+                         pos + static_cast<std::size_t>(std::countr_zero(bits)),
+                         onTag);
+                bits &= bits - 1;
+            }
+        }
+#endif
+        for (; pos < str.size(); ++pos)
+        {
+            if (str[pos] == '<')
+            {
+                match_at(str, pos, onTag);
+            }
+        }
+    }
+} // namespace lipsum
@@ -0,0 +1,243 @@
+/**
+ * @file lipsum/textstats.hpp
+ *
+ * @brief Declaration of lipsum::TextStatsAccumulator
+ *
+ * This declares lipsum::TextStatsAccumulator, which counts the statistics of
+ * lpsm::AnalyzeText() over text given in chunks. This file is under the BSD
+ * Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core/core.hpp"
+#include "core/stdincludes.hpp"
+#include "misc.hpp"
+
+namespace lipsum
+{
+    /**
+     * @brief Text statistics counted a chunk at a time
+     *
+     * @since 0.5.3
+     *
+     * Counts what lpsm::AnalyzeText() counts, but over text split into
+     * chunks, so that the text never has to be in memory at once. Chunks
+     * given to add() in order count the same as the whole text; words, tags
+     * and runs of newlines may be split between chunks. Chunks can also be
+     * counted on their own, e.g. on several threads, and joined in order with
+     * merge(). Only the parenthesis depth at the start of a chunk cannot be
+     * fixed up afterwards, so a chunk counted from the wrong depth is refused
+     * by merge() if the depth changes what it counts.
+     */
+    class LIPSUM_API TextStatsAccumulator
+    {
+    public:
+        /**
+         * @brief Constructor for TextStatsAccumulator
+         *
+         * @since 0.5.3
+         *
+         * @param format The format of the text, for counting paragraphs. By
+         * default non-formatted.
+         * @param depth The parenthesis depth at the start of the text. By
+         * default 0, outside of any.
+         */
+        explicit TextStatsAccumulator(
+                CountParaMethod format = CountParaMethod::Plain,
+                std::int64_t    depth  = 0);
+
+        /**
+         * @brief Count the next chunk of text.
+         *
+         * @since 0.5.3
+         *
+         * @param chunk The text that follows the text counted so far.
+         */
+        void add(std::string_view chunk);
+
+#ifndef LIPSUM_MIN_BUILD
+        /**
+         * @brief Count the next text on several threads.
+         *
+         * @since 0.5.3
+         *
+         * Split text into chunks of PARALLEL_CHUNK bytes, count each from
+         * depth 0 with lipsum::internal::ParallelFor(), count again from
+         * their real depth the chunks that depth changes, and merge them in
+         * order. Not available in minimum builds.
+         *
+         * @param text The text that follows the text counted so far.
+         * @param threads The number of threads, or 0 for one per hardware
+         * thread. By default 0.
+         */
+        void add_parallel(std::string_view text, unsigned int threads = 0);
+
+        /**
+         * @brief Count a whole file on several threads.
+         *
+         * @since 0.5.3
+         *
+         * Map the file into memory and count it with add_parallel(). Not
+         * available in minimum builds.
+         *
+         * @param path The path to the file.
+         * @param threads The number of threads, or 0 for one per hardware
+         * thread. By default 0.
+         *
+         * @return bool Whether the file could be opened.
+         */
+        bool add_file(const std::string& path, unsigned int threads = 0);
+#endif
+
+        /**
+         * @brief Can text counted by another accumulator be merged?
+         *
+         * @since 0.5.3
+         *
+         * True if next counts the same from the depth this accumulator ends
+         * at as from the depth next started at, which is always the case if
+         * the two depths are equal, or if next has no parentheses and both
+         * depths are on the same side of 0.
+         *
+         * @param next The accumulator to merge.
+         *
+         * @return bool Whether merge() would succeed.
+         */
+        [[nodiscard]] bool joins(const TextStatsAccumulator& next) const;
+
+        /**
+         * @brief Append the counts of the text that follows.
+         *
+         * @since 0.5.3
+         *
+         * Add the counts of next, which counted the text right after the
+         * text of this accumulator, fixing up words, fragments, runs of
+         * newlines and tags split between the two. Merging is associative,
+         * so chunks can be merged in any grouping as long as their order is
+         * kept.
+         *
+         * @param next The accumulator to merge.
+         *
+         * @return bool Whether next was merged. False, changing nothing, if
+         * next counts a different format or if joins() is false, in which
+         * case next should be counted again, starting at depth().
+         */
+        bool merge(const TextStatsAccumulator& next);
+
+        /**
+         * @brief Get the counts so far.
+         *
+         * @since 0.5.3
+         *
+         * @return TextStats The counts of the text so far, as
+         * lpsm::AnalyzeText() would count it whole.
+         */
+        [[nodiscard]] TextStats stats() const;
+
+        /**
+         * @brief Get the parenthesis depth after the text so far.
+         *
+         * @since 0.5.3
+         *
+         * @return std::int64_t The depth, negative after unmatched closing
+         * parentheses.
+         */
+        [[nodiscard]] std::int64_t depth() const;
+
+        /**
+         * @brief Get the size of the text so far.
+         *
+         * @since 0.5.3
+         *
+         * @return std::uint64_t The number of bytes counted.
+         */
+        [[nodiscard]] std::uint64_t size() const;
+
+        /**
+         * @brief Size of the chunks add_parallel() counts on each thread
+         *
+         * @since 0.5.3
+         */
+        static constexpr std::size_t PARALLEL_CHUNK = 4 * 1024 * 1024;
+
+    private:
+        /**
+         * @brief Count a chunk as if nothing came before it.
+         *
+         * @since 0.5.3
+         *
+         * This function is private. Must be called once, on an accumulator
+         * with nothing counted yet.
+         *
+         * @param text The chunk.
+         */
+        void scan(std::string_view text);
+
+        /**
+         * @brief Construct an accumulator with nothing counted.
+         *
+         * @since 0.5.3
+         *
+         * This function is private. Unlike the constructor, does not warn
+         * about an unknown format again.
+         *
+         * @param format The format of the text.
+         * @param depth The depth at the start of the text.
+         *
+         * @return TextStatsAccumulator The accumulator.
+         */
+        [[nodiscard]] static TextStatsAccumulator
+        fresh(CountParaMethod format, std::int64_t depth);
+
+        /**
+         * @brief Can text counted from one depth be counted from another?
+         *
+         * @since 0.5.3
+         *
+         * This function is private.
+         *
+         * @param depth The depth the text really starts at.
+         * @param next The accumulator that counted the text.
+         *
+         * @return bool Whether next counts the same from depth.
+         */
+        [[nodiscard]] static bool
+        joins_at(std::int64_t depth, const TextStatsAccumulator& next);
+
+        /**
+         * @brief Bytes kept at each end to count tags split between chunks
+         *
+         * @since 0.5.3
+         *
+         * Longer than every tag of lpsm::TagScanner::block_elements().
+         */
+        static constexpr std::size_t EDGE = 8;
+
+        TextStats       m_Stats;        ///< The counts so far
+        CountParaMethod m_Format;       ///< The format of the text
+        std::int64_t    m_StartDepth;   ///< The depth before the text
+        std::int64_t    m_Depth;        ///< The depth after the text
+        std::int64_t    m_MinDepth = 0; ///< Lowest depth of a character
+        std::int64_t    m_MaxDepth = 0; ///< Highest depth of a character
+        std::uint64_t   m_Size     = 0; ///< Bytes counted
+        char            m_Last     = '\0';  ///< The last byte
+        bool            m_InWord   = false; ///< Whether the text ends in a
+                                            ///< word
+
+        // the first two characters outside of parentheses are the only ones
+        // whose counts depend on the text before
+        int  m_Counted        = 0;     ///< Characters outside, up to 2
+        bool m_FirstAtStart   = false; ///< Whether the first is byte 0
+        bool m_FirstWordChar  = false; ///< Whether the first is in a word
+        bool m_SecondWordChar = false; ///< Whether the second is in a word
+
+        std::uint64_t m_LeadingNewlines  = 0; ///< Newlines at the start
+        std::uint64_t m_TrailingNewlines = 0; ///< Newlines at the end
+        std::string   m_Head; ///< The first EDGE bytes
+        std::string   m_Tail; ///< The last EDGE bytes
+    };
+} // namespace lipsum
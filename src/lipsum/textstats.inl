@@ -0,0 +1,595 @@
+/**
+ * @file lipsum/textstats.inl
+ *
+ * @brief Definition of lipsum::TextStatsAccumulator
+ *
+ * This defines the functions in lipsum::TextStatsAccumulator, and
+ * lipsum::internal::ClassifyText64() it counts with. This file is under the
+ * BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core/internal.hpp"
+#include "core/mappedfile.hpp"
+#include "core/parallel.hpp"
+#include "tagscanner.hpp"
+#include "textstats.hpp"
+
+namespace lipsum
+{
+    internal::TextMasks internal::ClassifyText64(const char* data)
+    {
+        TextMasks masks;
+#ifdef LPSM_HAS_SSE2
+        const __m128i caseBit = _mm_set1_epi8(0x20);
+        const __m128i beforeA = _mm_set1_epi8('a' - 1);
+        const __m128i afterZ  = _mm_set1_epi8('z' + 1);
+        const __m128i before0 = _mm_set1_epi8('0' - 1);
+        const __m128i after9  = _mm_set1_epi8('9' + 1);
+        auto          mask    = [](__m128i found, int block)
+        {
+            return static_cast<std::uint64_t>(static_cast<std::uint32_t>(
+                           _mm_movemask_epi8(found)))
+                   << (block * 16);
+        };
+        for (int block = 0; block < 4; ++block)
+        {
+            __m128i bytes = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(data + (block * 16)));
+            auto    is    = [bytes](char chr)
+            { return _mm_cmpeq_epi8(bytes, _mm_set1_epi8(chr)); };
+
+            // as in WordMask64(), bytes over 0x7F fail every range check
+            __m128i folded = _mm_or_si128(bytes, caseBit);
+            __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(folded, beforeA),
+                                           _mm_cmplt_epi8(folded, afterZ));
+            __m128i digit  = _mm_and_si128(_mm_cmpgt_epi8(bytes, before0),
+                                          _mm_cmplt_epi8(bytes, after9));
+            __m128i hyphen = is('-');
+            __m128i period = _mm_or_si128(is('.'),
+                                          _mm_or_si128(is('?'), is('!')));
+
+            masks.alnum  |= mask(_mm_or_si128(letter, digit), block);
+            masks.joiner |= mask(
+                    _mm_or_si128(hyphen, _mm_or_si128(is('+'), is('\''))),
+                    block);
+            masks.hyphen   |= mask(hyphen, block);
+            masks.space    |= mask(is(' '), block);
+            masks.newline  |= mask(is('\n'), block);
+            masks.tab      |= mask(is('\t'), block);
+            masks.sentence |= mask(period, block);
+            masks.clause   |= mask(
+                    _mm_or_si128(is(','), _mm_or_si128(is(';'), is(':'))),
+                    block);
+            masks.open  |= mask(is('('), block);
+            masks.close |= mask(is(')'), block);
+            masks.tag   |= mask(is('<'), block);
+        }
+#else
+        for (int i = 0; i < 64; ++i)
+        {
+            char          letter = data[i];
+            std::uint64_t bit    = std::uint64_t{1} << i;
+            if ((letter >= '0' && letter <= '9') ||
+                (letter >= 'a' && letter <= 'z') ||
+                (letter >= 'A' && letter <= 'Z'))
+            {
+                masks.alnum |= bit;
+            }
+            switch (letter)
+            {
+                case '-':
+                {
+                    masks.hyphen |= bit;
+                    masks.joiner |= bit;
+                    break;
+                }
+                case '+':
+                case '\'':
+                {
+                    masks.joiner |= bit;
+                    break;
+                }
+                case ' ':
+                {
+                    masks.space |= bit;
+                    break;
+                }
+                case '\n':
+                {
+                    masks.newline |= bit;
+                    break;
+                }
+                case '\t':
+                {
+                    masks.tab |= bit;
+                    break;
+                }
+                case '.':
+                case '?':
+                case '!':
+                {
+                    masks.sentence |= bit;
+                    break;
+                }
+                case ',':
+                case ';':
+                case ':':
+                {
+                    masks.clause |= bit;
+                    break;
+                }
+                case '(':
+                {
+                    masks.open |= bit;
+                    break;
+                }
+                case ')':
+                {
+                    masks.close |= bit;
+                    break;
+                }
+                case '<':
+                {
+                    masks.tag |= bit;
+                    break;
+                }
+                default:
+                {
+                    break;
+                }
+            }
+        }
+#endif
+        return masks;
+    }
+
+    TextStatsAccumulator::TextStatsAccumulator(CountParaMethod format,
+                                               std::int64_t    depth)
+        : m_Format(format), m_StartDepth(depth), m_Depth(depth)
+    {
+        if (format != CountParaMethod::Plain &&
+            format != CountParaMethod::Markdown &&
+            format != CountParaMethod::HTML)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::TextStatsAccumulator::"
+                              "TextStatsAccumulator(): unknown format ",
+                              static_cast<int>(format));
+        }
+    }
+
+    void TextStatsAccumulator::add(std::string_view chunk)
+    {
+        TextStatsAccumulator next = fresh(m_Format, m_Depth);
+        next.scan(chunk);
+        merge(next);
+    }
+
+#ifndef LIPSUM_MIN_BUILD
+    void TextStatsAccumulator::add_parallel(std::string_view text,
+                                            unsigned int     threads)
+    {
+        std::size_t count = (text.size() + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK;
+        if (count < 2 || internal::ThreadCount(threads) == 1)
+        {
+            add(text);
+            return;
+        }
+        auto chunk = [text](std::size_t idx)
+        {
+            return text.substr(idx * PARALLEL_CHUNK, PARALLEL_CHUNK);
+        };
+
+        // most chunks start outside of parentheses, so count each from
+        // depth 0 first
+        std::vector<TextStatsAccumulator> parts(count, fresh(m_Format, 0));
+        internal::ParallelFor(count,
+                              threads,
+                              [&parts, &chunk](std::size_t idx, unsigned int)
+                              { parts[idx].scan(chunk(idx)); });
+
+        // the depth each chunk ends at does not depend on where it starts, so
+        // the real start of every chunk is known now
+        std::vector<std::size_t> again;
+        std::int64_t             depth = m_Depth;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::int64_t change = parts[i].m_Depth - parts[i].m_StartDepth;
+            if (!joins_at(depth, parts[i]))
+            {
+                parts[i] = fresh(m_Format, depth);
+                again.push_back(i);
+            }
+            depth += change;
+        }
+        if (!again.empty())
+        {
+            LPSM_VERBOSE_LOG(Trace,
+                             "Counting ",
+                             again.size(),
+                             " chunks again from their real depth");
+            internal::ParallelFor(
+                    again.size(),
+                    threads,
+                    [&parts, &chunk, &again](std::size_t idx, unsigned int)
+                    { parts[again[idx]].scan(chunk(again[idx])); });
+        }
+
+        for (const TextStatsAccumulator& part : parts)
+        {
+            merge(part);
+        }
+    }
+
+    bool TextStatsAccumulator::add_file(const std::string& path,
+                                        unsigned int       threads)
+    {
+        internal::MappedFile file;
+        if (!file.open(path))
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::TextStatsAccumulator::add_file(): Could "
+                              "not open file ",
+                              path);
+            return false;
+        }
+        add_parallel(file.data(), threads);
+        return true;
+    }
+#endif
+
+    bool TextStatsAccumulator::joins(const TextStatsAccumulator& next) const
+    {
+        return joins_at(m_Depth, next);
+    }
+
+    bool TextStatsAccumulator::merge(const TextStatsAccumulator& next)
+    {
+        if (next.m_Format != m_Format)
+        {
+            internal::LogWarn(internal::LogType::Warn,
+                              "lpsm::TextStatsAccumulator::merge(): expected "
+                              "the same format, got ",
+                              static_cast<int>(next.m_Format),
+                              " instead of ",
+                              static_cast<int>(m_Format));
+            return false;
+        }
+        if (!joins(next))
+        {
+            return false;
+        }
+        if (next.m_Size == 0)
+        {
+            return true;
+        }
+
+        // next counted its first byte as if nothing came before it, so a
+        // joiner after a newline or space was taken for part of a word, and
+        // a hyphen after a newline for a fragment
+        char first       = next.m_Head.front();
+        bool lostJoiner  = next.m_FirstAtStart && m_Size != 0 &&
+                          (first == '-' || first == '+' || first == '\'') &&
+                          (m_Last == '\n' || m_Last == ' ');
+        bool firstInWord = next.m_FirstWordChar && !lostJoiner;
+
+        TextStats add = next.m_Stats;
+        if (next.m_Counted >= 1)
+        {
+            // next started outside of a word
+            add.words -= static_cast<std::uint64_t>(next.m_FirstWordChar);
+            add.words += static_cast<std::uint64_t>(firstInWord && !m_InWord);
+        }
+        if (next.m_Counted >= 2)
+        {
+            add.words -= static_cast<std::uint64_t>(next.m_SecondWordChar &&
+                                                    !next.m_FirstWordChar);
+            add.words += static_cast<std::uint64_t>(next.m_SecondWordChar &&
+                                                    !firstInWord);
+        }
+        if (next.m_FirstAtStart && first == '-' && m_Last == '\n')
+        {
+            --add.fragments;
+        }
+        if (m_Format == CountParaMethod::Markdown &&
+            m_TrailingNewlines % 2 == 1 && next.m_LeadingNewlines % 2 == 1)
+        {
+            // the two odd newlines make one more "\n\n"
+            ++add.paragraphs;
+        }
+        if (m_Format == CountParaMethod::HTML)
+        {
+            const TagScanner& elements = TagScanner::block_elements();
+            std::string       joined   = m_Tail + next.m_Head;
+            for (std::size_t i = 0; i < m_Tail.size(); ++i)
+            {
+                if (joined[i] == '<')
+                {
+                    add.paragraphs += elements.count_at(joined, i) -
+                                      elements.count_at(m_Tail, i);
+                }
+            }
+        }
+        m_Stats.words      += add.words;
+        m_Stats.fragments  += add.fragments;
+        m_Stats.sentences  += add.sentences;
+        m_Stats.paragraphs += add.paragraphs;
+
+        std::int64_t shift = m_Depth - next.m_StartDepth;
+        m_MinDepth = (m_Size == 0 ? next.m_MinDepth + shift
+                                  : std::min(m_MinDepth,
+                                             next.m_MinDepth + shift));
+        m_MaxDepth = (m_Size == 0 ? next.m_MaxDepth + shift
+                                  : std::max(m_MaxDepth,
+                                             next.m_MaxDepth + shift));
+        m_Depth    = next.m_Depth + shift;
+
+        if (m_Counted == 0)
+        {
+            m_FirstAtStart   = (m_Size == 0 && next.m_FirstAtStart);
+            m_FirstWordChar  = firstInWord;
+            m_SecondWordChar = next.m_SecondWordChar;
+            m_Counted        = next.m_Counted;
+        }
+        else if (m_Counted == 1 && next.m_Counted >= 1)
+        {
+            m_SecondWordChar = firstInWord;
+            m_Counted        = 2;
+        }
+        if (next.m_Counted == 1)
+        {
+            m_InWord = firstInWord;
+        }
+        else if (next.m_Counted >= 2)
+        {
+            m_InWord = next.m_InWord;
+        }
+
+        if (m_LeadingNewlines == m_Size)
+        {
+            m_LeadingNewlines += next.m_LeadingNewlines;
+        }
+        m_TrailingNewlines = (next.m_TrailingNewlines == next.m_Size
+                                      ? m_TrailingNewlines + next.m_Size
+                                      : next.m_TrailingNewlines);
+        if (m_Head.size() < EDGE)
+        {
+            m_Head += next.m_Head.substr(0, EDGE - m_Head.size());
+        }
+        m_Tail += next.m_Tail;
+        if (m_Tail.size() > EDGE)
+        {
+            m_Tail.erase(0, m_Tail.size() - EDGE);
+        }
+        m_Last  = next.m_Last;
+        m_Size += next.m_Size;
+        return true;
+    }
+
+    TextStats TextStatsAccumulator::stats() const
+    {
+        return m_Stats;
+    }
+
+    std::int64_t TextStatsAccumulator::depth() const
+    {
+        return m_Depth;
+    }
+
+    std::uint64_t TextStatsAccumulator::size() const
+    {
+        return m_Size;
+    }
+
+    TextStatsAccumulator TextStatsAccumulator::fresh(CountParaMethod format,
+                                                     std::int64_t    depth)
+    {
+        // the format was checked when the caller was constructed
+        TextStatsAccumulator next(CountParaMethod::Plain, depth);
+        next.m_Format = format;
+        return next;
+    }
+
+    bool TextStatsAccumulator::joins_at(std::int64_t                depth,
+                                        const TextStatsAccumulator& next)
+    {
+        // a character is counted at depth 0 or below, so the counts only
+        // change if a character of next is moved across 0
+        std::int64_t shift = depth - next.m_StartDepth;
+        if (next.m_Size == 0 || shift == 0)
+        {
+            return true;
+        }
+        if (shift > 0)
+        {
+            return next.m_MinDepth > 0 || next.m_MaxDepth <= -shift;
+        }
+        return next.m_MaxDepth <= 0 || next.m_MinDepth > -shift;
+    }
+
+    void TextStatsAccumulator::scan(std::string_view text)
+    {
+        constexpr std::size_t BLOCK = 64;
+
+        if (text.empty())
+        {
+            return;
+        }
+
+        std::int64_t urlNum     = m_Depth;
+        std::int64_t minDepth   = std::numeric_limits<std::int64_t>::max();
+        std::int64_t maxDepth   = std::numeric_limits<std::int64_t>::min();
+        bool         inWord     = false;
+        char         lastLetter = '\0';
+        std::size_t  newlines   = 0; // newlines in a row so far
+        auto         noteOutside = [this](std::size_t at, bool isWordChar)
+        {
+            if (m_Counted == 0)
+            {
+                m_FirstAtStart  = (at == 0);
+                m_FirstWordChar = isWordChar;
+            }
+            else
+            {
+                m_SecondWordChar = isWordChar;
+            }
+            ++m_Counted;
+        };
+        for (std::size_t pos = 0; pos < text.size(); pos += BLOCK)
+        {
+            std::size_t             len  = std::min(BLOCK, text.size() - pos);
+            const char*             data = text.data() + pos;
+            std::array<char, BLOCK> padded{};
+            if (len < BLOCK)
+            {
+                // null characters are of no class, so padding counts nothing
+                std::copy_n(data, len, padded.data());
+                data = padded.data();
+            }
+            internal::TextMasks masks = internal::ClassifyText64(data);
+
+            // paragraphs are counted inside parentheses too
+            switch (m_Format)
+            {
+                case CountParaMethod::Plain:
+                {
+                    m_Stats.paragraphs += std::popcount(masks.tab);
+                    break;
+                }
+                case CountParaMethod::Markdown:
+                {
+                    // every second newline of a run closes a "\n\n"
+                    std::uint64_t bits = masks.newline;
+                    std::size_t   runEnd = 0; // a run goes on from here
+                    while (bits != 0)
+                    {
+                        auto at = static_cast<std::size_t>(
+                                std::countr_zero(bits));
+                        bits &= bits - 1;
+                        newlines = (at == runEnd ? newlines + 1 : 1);
+                        runEnd   = at + 1;
+                        if (newlines % 2 == 0)
+                        {
+                            ++m_Stats.paragraphs;
+                        }
+                    }
+                    if (runEnd != BLOCK)
+                    {
+                        newlines = 0;
+                    }
+                    break;
+                }
+                case CountParaMethod::HTML:
+                {
+                    const TagScanner& elements = TagScanner::block_elements();
+                    std::uint64_t     bits     = masks.tag;
+                    while (bits != 0)
+                    {
+                        std::size_t at = pos + static_cast<std::size_t>(
+                                                       std::countr_zero(bits));
+                        bits &= bits - 1;
+                        m_Stats.paragraphs += elements.count_at(text, at);
+                    }
+                    break;
+                }
+                default:
+                {
+                    break;
+                }
+            }
+
+            std::uint64_t afterNewline =
+                    (masks.newline << 1) |
+                    static_cast<std::uint64_t>(lastLetter == '\n');
+            std::uint64_t afterSpace =
+                    (masks.space << 1) |
+                    static_cast<std::uint64_t>(lastLetter == ' ');
+            std::uint64_t wordChars =
+                    masks.alnum |
+                    (masks.joiner & ~(afterNewline | afterSpace));
+            if ((masks.open | masks.close) == 0 && urlNum <= 0)
+            {
+                // not in parens: count straight from the masks
+                minDepth = std::min(minDepth, urlNum);
+                maxDepth = std::max(maxDepth, urlNum);
+                for (std::size_t i = 0; i < std::min<std::size_t>(len, 2) &&
+                                        m_Counted < 2;
+                     ++i)
+                {
+                    noteOutside(pos + i, ((wordChars >> i) & 1) != 0);
+                }
+                std::uint64_t carried = static_cast<std::uint64_t>(inWord);
+                std::uint64_t starts  = wordChars &
+                                       ~((wordChars << 1) | carried);
+                m_Stats.words     += std::popcount(starts);
+                m_Stats.sentences += std::popcount(masks.sentence);
+                m_Stats.fragments +=
+                        std::popcount(masks.sentence | masks.clause) +
+                        std::popcount(masks.hyphen & ~afterNewline);
+                inWord = ((wordChars >> (len - 1)) & 1) != 0;
+            }
+            else
+            {
+                for (std::size_t i = 0; i < len; ++i)
+                {
+                    std::uint64_t bit = std::uint64_t{1} << i;
+                    if ((masks.open & bit) != 0)
+                    {
+                        ++urlNum;
+                    }
+                    if ((masks.close & bit) != 0)
+                    {
+                        --urlNum;
+                    }
+                    minDepth = std::min(minDepth, urlNum);
+                    maxDepth = std::max(maxDepth, urlNum);
+                    // if not in parens
+                    if (urlNum > 0)
+                    {
+                        continue;
+                    }
+                    bool isWordChar = (wordChars & bit) != 0;
+                    if (m_Counted < 2)
+                    {
+                        noteOutside(pos + i, isWordChar);
+                    }
+                    if (isWordChar && !inWord)
+                    {
+                        ++m_Stats.words;
+                    }
+                    inWord = isWordChar;
+                    if (((masks.sentence | masks.clause) & bit) != 0 ||
+                        (masks.hyphen & ~afterNewline & bit) != 0)
+                    {
+                        ++m_Stats.fragments;
+                    }
+                    if ((masks.sentence & bit) != 0)
+                    {
+                        ++m_Stats.sentences;
+                    }
+                }
+            }
+            lastLetter = data[len - 1];
+        }
+
+        std::size_t firstText = text.find_first_not_of('\n');
+        std::size_t lastText  = text.find_last_not_of('\n');
+        m_Depth               = urlNum;
+        m_MinDepth            = minDepth;
+        m_MaxDepth            = maxDepth;
+        m_Size                = text.size();
+        m_Last                = text.back();
+        m_InWord              = inWord;
+        m_LeadingNewlines     = std::min(firstText, text.size());
+        m_TrailingNewlines    = (lastText == std::string_view::npos
+                                         ? text.size()
+                                         : text.size() - lastText - 1);
+        m_Head                = text.substr(0, EDGE);
+        m_Tail = text.substr(text.size() - std::min(EDGE, text.size()));
+    }
+} // namespace lipsum
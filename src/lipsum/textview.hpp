@@ -0,0 +1,181 @@
+/**
+ * @file lipsum/textview.hpp
+ *
+ * @brief Declaration of lipsum::TextView
+ *
+ * This declares lipsum::TextView, a lazy range of words, sentences or
+ * paragraphs. This file is under the BSD Zero-Clause License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core/core.hpp"
+#include "generator.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum
+{
+    /**
+     * @brief Kind of text a lipsum::TextView yields
+     *
+     * @since 0.5.3
+     */
+    enum class TextUnit : int
+    {
+        Word = 0,
+        Sentence,
+        Paragraph
+    };
+
+    /**
+     * @brief Lazy range of words, sentences or paragraphs
+     *
+     * @since 0.5.3
+     *
+     * An endless std::ranges input view, like std::ranges::istream_view,
+     * that generates each element from a lipsum::Generator when it is first
+     * read, into one buffer reused for every element. Elements are
+     * std::string_view and are valid until the iterator is incremented.
+     * Compose it with the standard views, such as std::views::take(), to
+     * bound it. Get one from lipsum::Generator::words(),
+     * lipsum::Generator::sentences() or lipsum::Generator::paragraphs(). Not
+     * available in minimum builds.
+     */
+    class LIPSUM_API TextView : public std::ranges::view_interface<TextView>
+    {
+    public:
+        /**
+         * @brief Input iterator of lipsum::TextView
+         *
+         * @since 0.5.3
+         */
+        class LIPSUM_API Iterator
+        {
+        public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type       = std::string_view;
+            using difference_type  = std::ptrdiff_t;
+
+            /**
+             * @brief Default constructor for Iterator
+             *
+             * @since 0.5.3
+             */
+            Iterator() = default;
+
+            /**
+             * @brief Constructor for Iterator
+             *
+             * @since 0.5.3
+             *
+             * @param view The view to read from.
+             */
+            explicit Iterator(TextView& view);
+
+            /**
+             * @brief Get the current element, generating it if needed.
+             *
+             * @since 0.5.3
+             *
+             * @return std::string_view The element, valid until the iterator
+             * is incremented.
+             */
+            std::string_view operator*() const;
+
+            /**
+             * @brief Move to the next element.
+             *
+             * @since 0.5.3
+             *
+             * @return Iterator& This iterator.
+             */
+            Iterator& operator++();
+
+            /**
+             * @brief Move to the next element.
+             *
+             * @since 0.5.3
+             */
+            void operator++(int);
+
+        private:
+            TextView* m_View = nullptr; ///< The view read from
+        };
+
+        /**
+         * @brief Default constructor for TextView
+         *
+         * @since 0.5.3
+         *
+         * Must be assigned to before it is iterated.
+         */
+        TextView() = default;
+
+        /**
+         * @brief Constructor for TextView
+         *
+         * @since 0.5.3
+         *
+         * @param gen The generator, which must outlive the view.
+         * @param unit The kind of text to yield.
+         * @param useLipsum Whether the first sentence or paragraph starts
+         * with "Lorem ipsum dolor sit amet...". Ignored for words.
+         */
+        TextView(Generator& gen, TextUnit unit, bool useLipsum);
+
+        /**
+         * @brief Get an iterator to the current element.
+         *
+         * @since 0.5.3
+         *
+         * As with every input view, the elements are read only once.
+         *
+         * @return Iterator The iterator.
+         */
+        [[nodiscard]] Iterator begin();
+
+        /**
+         * @brief Get the end of the view, which is never reached.
+         *
+         * @since 0.5.3
+         *
+         * @return std::unreachable_sentinel_t The sentinel.
+         */
+        [[nodiscard]] static constexpr std::unreachable_sentinel_t end()
+        {
+            return std::unreachable_sentinel;
+        }
+
+    private:
+        /**
+         * @brief Get the current element, generating it if needed.
+         *
+         * @since 0.5.3
+         *
+         * @return std::string_view The element.
+         */
+        std::string_view current();
+
+        /**
+         * @brief Move to the next element.
+         *
+         * @since 0.5.3
+         *
+         * An element that was skipped without being read is still generated,
+         * so that the elements after it do not depend on which were read.
+         */
+        void advance();
+
+        Generator*       m_Gen       = nullptr;        ///< The generator
+        TextUnit         m_Unit      = TextUnit::Word; ///< Kind of text
+        bool             m_UseLipsum = false;          ///< Lorem ipsum first
+        bool             m_Ready     = false;          ///< Element generated
+        std::uint64_t    m_Index     = 0;              ///< Element index
+        std::string      m_Buffer;                     ///< Reused buffer
+        std::string_view m_Current;                    ///< Current element
+    };
+} // namespace lipsum
+#endif
@@ -0,0 +1,102 @@
+/**
+ * @file lipsum/textview.inl
+ *
+ * @brief Definition of lipsum::TextView
+ *
+ * This defines lipsum::TextView. This file is under the BSD Zero-Clause
+ * License.
+ *
+ * @copyright Copyright (c) 2026 LambBread
+ *
+ * @author LambBread from github.com
+ */
+#pragma once
+
+#include "core/internal.hpp"
+#include "textview.hpp"
+
+#ifndef LIPSUM_MIN_BUILD
+namespace lipsum
+{
+    TextView::Iterator::Iterator(TextView& view) : m_View(&view)
+    {
+    }
+
+    std::string_view TextView::Iterator::operator*() const
+    {
+        return m_View->current();
+    }
+
+    TextView::Iterator& TextView::Iterator::operator++()
+    {
+        m_View->advance();
+        return *this;
+    }
+
+    void TextView::Iterator::operator++(int)
+    {
+        ++*this;
+    }
+
+    TextView::TextView(Generator& gen, TextUnit unit, bool useLipsum)
+        : m_Gen(&gen), m_Unit(unit), m_UseLipsum(useLipsum)
+    {
+    }
+
+    TextView::Iterator TextView::begin()
+    {
+        return Iterator(*this);
+    }
+
+    /*
+     * PRIVATE
+     */
+
+    std::string_view TextView::current()
+    {
+        if (m_Ready)
+        {
+            return m_Current;
+        }
+
+        m_Ready = true;
+        if (m_Unit == TextUnit::Word)
+        {
+            // words already live in the source, so nothing is copied
+            m_Current = m_Gen->source_word();
+            return m_Current;
+        }
+
+        m_Buffer.clear();
+        if (m_Unit == TextUnit::Sentence)
+        {
+            if (m_Index == 0 && m_UseLipsum)
+            {
+                m_Buffer += internal::LIPSUM_DEFAULT_SENTENCE;
+            }
+            else
+            {
+                m_Gen->single_sentence_into(m_Buffer,
+                                            m_Gen->m_Settings.word,
+                                            m_Gen->m_Settings.frag);
+            }
+        }
+        else
+        {
+            m_Gen->single_paragraph_into(m_Buffer, m_Index == 0 && m_UseLipsum);
+        }
+        m_Current = m_Buffer;
+        return m_Current;
+    }
+
+    void TextView::advance()
+    {
+        if (!m_Ready)
+        {
+            current();
+        }
+        m_Ready = false;
+        ++m_Index;
+    }
+} // namespace lipsum
+#endif
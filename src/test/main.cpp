@@ -2,9 +2,12 @@
 #    define LIPSUM_IMPLEMENTATION
 #endif
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <functional>
 #include <iomanip>
+#include <limits>
 #include <lipsum.hpp>
 #include <numeric>
 #include <unordered_map>
@@ -194,6 +197,1976 @@ static void Test_md_text_count_equal(lpsm::Generator& gen)
     }
 }
 
+static void Test_source_word_view(lpsm::Generator& gen)
+{
+    lpsm::Source source;
+    std::mt19937 engine(0);
+    if (source.size() != 167 || source.word_at(0) != "lorem" ||
+        source.word_at(source.size() - 1) != "feugiat")
+    {
+        LogTestFailure("source_word_view");
+    }
+    const char* first = source.word_at(0).data();
+    const char* last  = source.word_at(source.size() - 1).data();
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string_view word = source.random_word_view(engine);
+        if (word.empty() || word.data() < first || word.data() > last)
+        {
+            LogTestFailure("source_word_view");
+        }
+    }
+}
+
+static void Test_sink_matches_string(lpsm::Generator& gen)
+{
+    constexpr int         NUM_PARAGRAPHS = 50;
+    constexpr std::size_t CAPACITY       = 256;
+    std::string           streamed;
+    int                   chunks = 0;
+
+    gen.load_seed(42);
+    std::string expected = gen.paragraph(NUM_PARAGRAPHS);
+    gen.load_seed(42);
+    {
+        lpsm::CallbackSink sink(
+                [&](std::string_view chunk)
+                {
+                    streamed += chunk;
+                    ++chunks;
+                    return true;
+                },
+                CAPACITY);
+        gen.paragraph_to(sink, NUM_PARAGRAPHS);
+    }
+    if (streamed != expected || chunks < 2)
+    {
+        LogTestFailure("sink_matches_string");
+    }
+}
+
+static void Test_into_appends(lpsm::Generator& gen)
+{
+    constexpr int     NUM    = 3;
+    const std::string prefix = "kept ";
+
+    // each *_into() draws what the returning form draws, after what out
+    // already holds
+    for (bool useLipsum : {true, false})
+    {
+        gen.load_seed(7);
+        std::string words      = gen.word(NUM);
+        std::string sentences  = gen.sentence(NUM, useLipsum);
+        std::string paragraphs = gen.paragraph(NUM, useLipsum);
+
+        gen.load_seed(7);
+        std::string out = prefix;
+        gen.word_into(out, NUM);
+        if (out != prefix + words)
+        {
+            LogTestFailure("into_appends");
+        }
+        out = prefix;
+        gen.sentence_into(out, NUM, useLipsum);
+        if (out != prefix + sentences)
+        {
+            LogTestFailure("into_appends");
+        }
+        out = prefix;
+        gen.paragraph_into(out, NUM, useLipsum);
+        if (out != prefix + paragraphs)
+        {
+            LogTestFailure("into_appends");
+        }
+    }
+}
+
+static void Test_engine_reproducible(lpsm::Generator& gen)
+{
+    constexpr std::array<lpsm::EngineType, 6> TYPES = {
+            lpsm::EngineType::MT19937,
+            lpsm::EngineType::Xoshiro256ss,
+            lpsm::EngineType::Pcg32,
+            lpsm::EngineType::Pcg64,
+            lpsm::EngineType::WyRand,
+            lpsm::EngineType::Philox4x32};
+
+    // the default engine must stay compatible with std::mt19937
+    lpsm::Engine engine;
+    std::mt19937 reference;
+    for (int i = 0; i < 1000; ++i)
+    {
+        if (engine() != reference())
+        {
+            LogTestFailure("engine_reproducible");
+        }
+    }
+
+    // streams whose seeds share their lower 32 bits still differ
+    std::unordered_map<std::uint32_t, std::uint64_t> lowerBits;
+    for (std::uint64_t stream = 0;; ++stream)
+    {
+        auto lower = static_cast<std::uint32_t>(
+                lpsm::internal::StreamSeed(7, stream));
+        auto [found, added] = lowerBits.try_emplace(lower, stream);
+        if (!added)
+        {
+            lpsm::Engine first;
+            lpsm::Engine second;
+            first.seed(7, found->second);
+            second.seed(7, stream);
+            if (first() == second() && first() == second())
+            {
+                LogTestFailure("engine_reproducible");
+            }
+            break;
+        }
+    }
+
+    // first output of pcg32_srandom_r(42, 54) in the reference implementation
+    lpsm::Pcg32 pcg(42, 54);
+    if (pcg() != 0xA15C02B7U)
+    {
+        LogTestFailure("engine_reproducible");
+    }
+
+    for (lpsm::EngineType type : TYPES)
+    {
+        gen.load_engine(type);
+        gen.load_seed(3);
+        std::string first = gen.paragraph(3);
+        gen.load_seed(3);
+        if (first != gen.paragraph(3))
+        {
+            LogTestFailure("engine_reproducible");
+        }
+    }
+}
+
+static void Test_sampler_in_bounds(lpsm::Generator& gen)
+{
+    // (0xA15C02B7 * 10) >> 32, independent of the standard library
+    lpsm::Pcg32 pcg(42, 54);
+    if (lpsm::internal::UniformBelow(pcg, 10U) != 6)
+    {
+        LogTestFailure("sampler_in_bounds");
+    }
+
+    // word indices take the same 32-bit draw below 2^32, and 64-bit draws
+    // for larger sources
+    constexpr std::size_t LARGE_COUNT = 6'000'000'000ULL;
+    lpsm::Pcg32           again(42, 54);
+    bool                  above = false;
+    if (lpsm::internal::UniformIndex(again, 10) != 6)
+    {
+        LogTestFailure("sampler_in_bounds");
+    }
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::size_t idx = lpsm::internal::UniformIndex(again, LARGE_COUNT);
+        if (idx >= LARGE_COUNT)
+        {
+            LogTestFailure("sampler_in_bounds");
+        }
+        above = above || idx > std::numeric_limits<std::uint32_t>::max();
+    }
+    if (!above)
+    {
+        LogTestFailure("sampler_in_bounds");
+    }
+
+    lpsm::internal::BitPool pool;
+    for (int i = 0; i < 10000; ++i)
+    {
+        int           value = lpsm::internal::UniformInt(pcg, -3, 7);
+        std::uint32_t small = pool.below(pcg, 6U);
+        auto          large = lpsm::internal::UniformInt(
+                pcg, std::numeric_limits<std::int64_t>::min(), std::int64_t{5});
+        double        real  = lpsm::internal::UniformReal(pcg, 1.0, 2.0);
+        if (value < -3 || value > 7 || small >= 6 || large > 5 || real < 1.0 ||
+            real >= 2.0)
+        {
+            LogTestFailure("sampler_in_bounds");
+        }
+    }
+
+    // reseeding must also drop the bits left in the pool
+    gen.load_seed(11);
+    std::string first = gen.sentence();
+    gen.load_seed(11);
+    if (first != gen.sentence())
+    {
+        LogTestFailure("sampler_in_bounds");
+    }
+}
+
+static void Test_weighted_table(lpsm::Generator& gen)
+{
+    constexpr int DRAWS = 100000;
+
+    lpsm::WeightedTable table{70, 10, 7, 5, 5, 2, 1};
+    lpsm::Pcg32         pcg(7);
+    std::array<int, 7>  counts{};
+    for (int i = 0; i < DRAWS; ++i)
+    {
+        ++counts.at(table.sample(pcg));
+    }
+    for (std::size_t i = 0; i < counts.size(); ++i)
+    {
+        double expected = std::array{70, 10, 7, 5, 5, 2, 1}.at(i) / 100.0;
+        double actual   = static_cast<double>(counts.at(i)) / DRAWS;
+        if (std::abs(table.probability(i) - expected) > 1e-6 ||
+            std::abs(actual - expected) > 0.01)
+        {
+            LogTestFailure("weighted_table");
+        }
+    }
+
+    lpsm::WeightedTable never{0, 1};
+    lpsm::WeightedTable single{3};
+    for (int i = 0; i < 1000; ++i)
+    {
+        if (never.sample(pcg) != 1 || single.sample(pcg) != 0)
+        {
+            LogTestFailure("weighted_table");
+        }
+    }
+
+#ifndef LIPSUM_MIN_BUILD
+    gen.change_weights("endMark", {0, 0, 1});
+    std::string text = gen.sentence(20, false);
+    gen.change_weights("endMark", {80, 15, 5});
+    if (text.find('.') != std::string::npos ||
+        text.find('?') != std::string::npos)
+    {
+        LogTestFailure("weighted_table");
+    }
+#endif
+}
+
+static void Test_predicted_size(lpsm::Generator& gen)
+{
+    // measured once per load
+    const lpsm::Source& source = *gen.source();
+    std::size_t         total  = 0;
+    std::size_t         most   = 0;
+    for (std::size_t i = 0; i < source.size(); ++i)
+    {
+        total += source.word_at(i).size();
+        most   = std::max(most, source.word_at(i).size());
+    }
+    if (source.max_word_length() != most ||
+        std::abs(source.mean_word_length() -
+                 static_cast<double>(total) / source.size()) > 1e-9)
+    {
+        LogTestFailure("predicted_size");
+    }
+
+    // room for every one of many draws, with no more than as much again
+    // to spare
+    auto check = [&gen](lpsm::OutputType                    type,
+                        std::size_t                         num,
+                        bool                                useHtml,
+                        const std::function<std::string()>& make)
+    {
+        constexpr int DRAWS = 400;
+
+        std::size_t largest = 0;
+        for (int i = 0; i < DRAWS; ++i)
+        {
+            largest = std::max(largest, make().size());
+        }
+        std::size_t predicted = gen.predicted_size(type, num, useHtml);
+        if (predicted < largest || predicted > 2 * largest)
+        {
+            LogTestFailure("predicted_size");
+        }
+    };
+
+    gen.load_seed(18);
+    check(lpsm::OutputType::Word,
+          1000,
+          false,
+          [&]() { return gen.word(1000); });
+    check(lpsm::OutputType::Sentence,
+          100,
+          false,
+          [&]() { return gen.sentence(100, false); });
+    check(lpsm::OutputType::Paragraph,
+          10,
+          false,
+          [&]() { return gen.paragraph(10, false); });
+    check(lpsm::OutputType::Text, 1, false, [&]() { return gen.text(false); });
+    if (gen.predicted_size(lpsm::OutputType::Word, 0) != 0)
+    {
+        LogTestFailure("predicted_size");
+    }
+
+    // large requests fit in what they reserve, so they never grow
+    constexpr std::size_t MANY_WORDS      = 200'000;
+    constexpr std::size_t MANY_PARAGRAPHS = 2'000;
+    auto reserved = [](std::size_t size)
+    {
+        std::string probe;
+        probe.reserve(size);
+        return probe.capacity();
+    };
+    for (int seed = 0; seed < 4; ++seed)
+    {
+        gen.load_seed(seed);
+        std::string words      = gen.word(MANY_WORDS);
+        std::string paragraphs = gen.paragraph(MANY_PARAGRAPHS);
+        if (words.capacity() !=
+                    reserved(gen.predicted_size(lpsm::OutputType::Word,
+                                                MANY_WORDS)) ||
+            paragraphs.capacity() !=
+                    reserved(gen.predicted_size(lpsm::OutputType::Paragraph,
+                                                MANY_PARAGRAPHS)))
+        {
+            LogTestFailure("predicted_size");
+        }
+    }
+
+#ifndef LIPSUM_MIN_BUILD
+    check(lpsm::OutputType::FmtText,
+          15,
+          lpsm::MARKDOWN,
+          [&]() { return gen.fmt_text(15, lpsm::MARKDOWN); });
+    check(lpsm::OutputType::FmtText,
+          15,
+          lpsm::HTML,
+          [&]() { return gen.fmt_text(15, lpsm::HTML); });
+    check(lpsm::OutputType::Xml, 30, false, [&]() { return gen.xml(30); });
+    check(lpsm::OutputType::Json, 3, false, [&]() { return gen.json(3); });
+    check(lpsm::OutputType::Csv, 1, false, [&]() { return gen.csv(); });
+
+    // the weighted mean follows the word counts
+    lpsm::Source counted;
+    counted.load_buffer("a a a a bbbbb");
+    if (counted.max_word_length() != 5 || counted.mean_word_length() != 3.0 ||
+        counted.mean_word_length(true) != 1.8)
+    {
+        LogTestFailure("predicted_size");
+    }
+
+    // the mean size of deep JSON is far beyond memory, but only a bounded
+    // part of it is reserved
+    constexpr int DEEP_JSON = 130;
+    gen.load_seed(0);
+    std::string deep = gen.json(DEEP_JSON);
+    if (gen.predicted_size(lpsm::OutputType::Json, DEEP_JSON) <
+                deep.capacity() ||
+        deep.capacity() > std::size_t{64} * 1024 * 1024 + deep.size())
+    {
+        LogTestFailure("predicted_size");
+    }
+#endif
+}
+
+static void Test_compile_time(lpsm::Generator& gen)
+{
+    constexpr lpsm::ct::Settings ONE_WORD{
+            .word = {1, 1}, .frag = {1, 1}, .sent = {1, 1}};
+
+    constexpr auto WORDS     = lpsm::ct::word<7, 20>();
+    constexpr auto SENTENCES = lpsm::ct::sentence<7, 3, false>();
+    constexpr auto PARAGRAPH = lpsm::ct::paragraph<7, 2>();
+    constexpr auto SHORT     = lpsm::ct::paragraph<3, 2, false, ONE_WORD>();
+    static_assert(PARAGRAPH.front() == '\t' && PARAGRAPH.back() == '\n');
+    static_assert(lpsm::ct::word<7, 0>().empty());
+
+    auto view = [](const auto& text)
+    {
+        return std::string_view(text.data(), text.size());
+    };
+    auto count = [](std::string_view text, char chr)
+    {
+        return std::count(text.begin(), text.end(), chr);
+    };
+
+    // the same at run time, and only words from the source
+    std::string_view words = view(WORDS);
+    if (lpsm::ct::word<7, 20>() != WORDS || count(words, ' ') != 19)
+    {
+        LogTestFailure("compile_time");
+    }
+    std::istringstream stream{std::string(words)};
+    std::string        word;
+    while (stream >> word)
+    {
+        bool found = false;
+        for (std::size_t i = 0; i < gen.source()->size() && !found; ++i)
+        {
+            found = gen.source()->word_at(i) == word;
+        }
+        if (!found)
+        {
+            LogTestFailure("compile_time");
+        }
+    }
+
+    std::string_view sentences = view(SENTENCES);
+    std::string_view paragraph = view(PARAGRAPH);
+    std::string_view shortText = view(SHORT);
+    if (count(sentences, '.') != 3 || !sentences.ends_with(". ") ||
+        sentences.front() < 'A' || sentences.front() > 'Z' ||
+        !paragraph.starts_with("\tLorem ipsum") ||
+        count(paragraph, '\n') != 2 ||
+        count(shortText, ' ') != 0 || count(shortText, '.') != 2)
+    {
+        LogTestFailure("compile_time");
+    }
+}
+
+static void Test_analyze_text(lpsm::Generator& gen)
+{
+    constexpr std::size_t MAX_SHIFT = 130;
+
+    // the same counts as the functions it replaces
+    std::string paragraphs = gen.paragraph(20);
+    lpsm::TextStats stats  = lpsm::AnalyzeText(paragraphs);
+    if (static_cast<int>(stats.words) != lpsm::CountWords(paragraphs) ||
+        static_cast<int>(stats.fragments) !=
+                lpsm::CountSentenceFragments(paragraphs) ||
+        static_cast<int>(stats.sentences) != lpsm::CountSentences(paragraphs) ||
+        stats.paragraphs != 20 || stats.words == 0)
+    {
+        LogTestFailure("analyze_text");
+    }
+
+    // parentheses, leading hyphens and runs of newlines across every block
+    // boundary
+    const std::string text = "This is a test, and this is a test; testing - "
+                             "test, test. Lorem ipsum: dolor sit, amet.\n\n"
+                             "- This is a list, first letter not be counted.\n"
+                             "- Foo bar; baz - qux. (This, is not counted.)"
+                             "\n\n\n\n\nWell-known (here (and) there) end.";
+    const std::string html = "<p>One</p><h2>Two</h2><ol><li>Three</li></ol>"
+                             "<h7>Not counted</h7><ul><li>Four</li></ul>";
+    for (std::size_t shift = 0; shift < MAX_SHIFT; ++shift)
+    {
+        std::string padding(shift, ' ');
+        stats = lpsm::AnalyzeText(padding + text,
+                                  lpsm::CountParaMethod::Markdown);
+        if (stats.words != 32 || stats.fragments != 15 ||
+            stats.sentences != 5 || stats.paragraphs != 3)
+        {
+            LogTestFailure("analyze_text");
+        }
+        if (lpsm::AnalyzeText(padding + html, lpsm::CountParaMethod::HTML)
+                    .paragraphs != 4)
+        {
+            LogTestFailure("analyze_text");
+        }
+    }
+}
+
+static void Test_tag_scanner(lpsm::Generator&)
+{
+    constexpr std::size_t MAX_SHIFT = 40;
+
+    const std::string html = "<table><tr><td>1</td><td class=\"x\">2</td>"
+                             "</tr></table><p>Text <b>bold</b></p>"
+                             "<div><div id=\"y\"><p>More</p></div></div>"
+                             "<h1>Head</h1><h7>Not counted</h7><ol></ol><";
+    lpsm::TagScanner scanner = {"<table>", "<td", "<div", "<p>", "<t"};
+    for (std::size_t shift = 0; shift < MAX_SHIFT; ++shift)
+    {
+        // shifted across the 16-byte blocks and tail
+        std::string shifted = std::string(shift, 'x') + html;
+        if (scanner.count_each(shifted) !=
+                    std::vector<std::size_t>{1, 2, 2, 2, 4} ||
+            scanner.count(shifted) != 11 ||
+            lpsm::TagScanner::block_elements().count(shifted) != 4 ||
+            lpsm::CountParagraphs(shifted, lpsm::CountParaMethod::HTML) != 4)
+        {
+            LogTestFailure("tag_scanner");
+        }
+    }
+
+    // tags without a name keep their place but are never counted
+    lpsm::TagScanner skipped = {"<", "p>", "<li>", "<", "<ul>"};
+    const std::string list   = "<ul><li>a</li><li>b</li></ul>";
+    if (skipped.size() != 5 || skipped.count(list) != 3 ||
+        skipped.count_each(list) != std::vector<std::size_t>{0, 0, 2, 0, 1})
+    {
+        LogTestFailure("tag_scanner");
+    }
+}
+
+static void Test_text_stats_accumulator(lpsm::Generator& gen)
+{
+    constexpr std::array<lpsm::CountParaMethod, 3> FORMATS = {
+            lpsm::CountParaMethod::Plain,
+            lpsm::CountParaMethod::Markdown,
+            lpsm::CountParaMethod::HTML};
+
+    auto same = [](const lpsm::TextStats& lhs, const lpsm::TextStats& rhs)
+    {
+        return lhs.words == rhs.words && lhs.fragments == rhs.fragments &&
+               lhs.sentences == rhs.sentences &&
+               lhs.paragraphs == rhs.paragraphs;
+    };
+
+    // split at every byte, so words, tags, runs of newlines and parentheses
+    // are all cut somewhere
+    const std::string text = gen.sentence() +
+                             "(an aside (nested), cut) - \n\n\n- don't "
+                             "<p>stop</p><h2>here</h2>)) a-b +c end.";
+    for (lpsm::CountParaMethod format : FORMATS)
+    {
+        lpsm::TextStats want = lpsm::AnalyzeText(text, format);
+        for (std::size_t split = 0; split <= text.size(); ++split)
+        {
+            std::string_view first  = std::string_view(text).substr(0, split);
+            std::string_view second = std::string_view(text).substr(split);
+
+            lpsm::TextStatsAccumulator inOrder(format);
+            inOrder.add(first);
+            inOrder.add(second);
+
+            // counted apart from depth 0, then again from the real depth if
+            // the merge is refused
+            lpsm::TextStatsAccumulator head(format);
+            lpsm::TextStatsAccumulator tail(format);
+            head.add(first);
+            tail.add(second);
+            if (!head.merge(tail))
+            {
+                tail = lpsm::TextStatsAccumulator(format, head.depth());
+                tail.add(second);
+                if (!head.merge(tail))
+                {
+                    LogTestFailure("text_stats_accumulator");
+                }
+            }
+            if (!same(inOrder.stats(), want) || !same(head.stats(), want) ||
+                head.size() != text.size() || head.depth() != inOrder.depth())
+            {
+                LogTestFailure("text_stats_accumulator");
+            }
+        }
+    }
+
+#ifndef LIPSUM_MIN_BUILD
+    constexpr const char* PATH = "test_text_stats.txt";
+
+    // several chunks, all inside parentheses but for the last characters
+    std::string large     = "(";
+    std::string paragraph = gen.paragraph(50);
+    while (large.size() < 2 * lpsm::TextStatsAccumulator::PARALLEL_CHUNK)
+    {
+        large += paragraph;
+    }
+    large += ") end";
+    {
+        std::ofstream file(PATH, std::ios::binary);
+        file << large;
+    }
+    lpsm::TextStatsAccumulator parallel(lpsm::CountParaMethod::Markdown);
+    lpsm::TextStatsAccumulator fromFile(lpsm::CountParaMethod::Markdown);
+    parallel.add_parallel(large, 4);
+    if (!fromFile.add_file(PATH) ||
+        !same(parallel.stats(),
+              lpsm::AnalyzeText(large, lpsm::CountParaMethod::Markdown)) ||
+        !same(fromFile.stats(), parallel.stats()) ||
+        fromFile.size() != large.size())
+    {
+        LogTestFailure("text_stats_accumulator");
+    }
+    std::remove(PATH);
+#endif
+}
+
+#ifndef LIPSUM_MIN_BUILD
+static void Test_source_tokenizer(lpsm::Generator&)
+{
+    constexpr std::array<std::string_view, 7> EXPECTED = {
+            "hello", "it's", "a", "well-known", "test_42", "na", "ve"};
+
+    std::string text = "Hello, HELLO it's a well-known TEST_42... "
+                       "na\xC3\xAFve!";
+    lpsm::Source source;
+    source.load_buffer(text);
+    if (source.size() != EXPECTED.size())
+    {
+        LogTestFailure("source_tokenizer");
+    }
+    for (std::size_t i = 0; i < EXPECTED.size(); ++i)
+    {
+        if (source.word_at(i) != EXPECTED.at(i))
+        {
+            LogTestFailure("source_tokenizer");
+        }
+    }
+
+    // words crossing 64-byte blocks, threads and stream blocks
+    std::string large;
+    for (int i = 0; i < 1'000'000; ++i)
+    {
+        large += (i % 7 == 0) ? "Word" : "word";
+        large += std::to_string((i * 7919LL) % 250'000);
+        large += (i % 3 == 0) ? ", " : " ";
+    }
+    lpsm::Source serial;
+    lpsm::Source parallel;
+    lpsm::Source streamed;
+    std::istringstream stream(large);
+    serial.load_buffer(large);
+    parallel.load_buffer(large, "buffer", 4);
+    streamed.load_stream(stream);
+    if (serial.size() != 250'000 || parallel.size() != serial.size() ||
+        streamed.size() != serial.size())
+    {
+        LogTestFailure("source_tokenizer");
+    }
+    for (std::size_t i = 0; i < serial.size(); ++i)
+    {
+        if (parallel.word_at(i) != serial.word_at(i) ||
+            streamed.word_at(i) != serial.word_at(i))
+        {
+            LogTestFailure("source_tokenizer");
+        }
+    }
+}
+
+static void Test_source_compiled(lpsm::Generator&)
+{
+    constexpr const char* PATH = "test_source.lpsmsrc";
+
+    std::string text;
+    for (int i = 0; i < 10'000; ++i)
+    {
+        text += "word" + std::to_string((i * 7919LL) % 3'000) + " ";
+    }
+    lpsm::Source source;
+    source.load_buffer(text);
+    if (!source.save(PATH))
+    {
+        LogTestFailure("source_compiled");
+        return;
+    }
+
+    // mapped in place, and copied out of a buffer
+    lpsm::Source mapped(PATH);
+    lpsm::Source copied;
+    {
+        std::ifstream file(PATH, std::ios::binary);
+        std::string   data((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+        copied.load_buffer(data);
+    }
+    lpsm::Source kept = mapped;
+    mapped.load("cat");
+    if (kept.size() != source.size() || copied.size() != source.size() ||
+        !kept.has_weights() || !copied.has_weights())
+    {
+        LogTestFailure("source_compiled");
+    }
+    for (std::size_t i = 0; i < source.size(); ++i)
+    {
+        if (kept.word_at(i) != source.word_at(i) ||
+            copied.word_at(i) != source.word_at(i) ||
+            kept.weight_at(i) != source.weight_at(i) ||
+            copied.weight_at(i) != source.weight_at(i))
+        {
+            LogTestFailure("source_compiled");
+        }
+    }
+
+    // a damaged file falls back to the default source
+    {
+        std::fstream file(PATH,
+                          std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(40);
+        file.put('\x7F');
+    }
+    lpsm::Source damaged(PATH);
+    if (damaged.size() != lpsm::Source().size())
+    {
+        LogTestFailure("source_compiled");
+    }
+    std::remove(PATH);
+}
+
+static void Test_source_registry(lpsm::Generator&)
+{
+    constexpr int NUM_THREADS = 8;
+
+    lpsm::SourceRegistry registry;
+    auto                 lorem = registry.get("lorem");
+    auto                 cat   = registry.get("cat");
+    if (registry.get("default") != lorem || cat == lorem ||
+        registry.size() != 2)
+    {
+        LogTestFailure("source_registry");
+    }
+
+    // every thread gets the one source loaded by whichever came first
+    std::vector<std::shared_ptr<const lpsm::Source>> dogs(NUM_THREADS);
+#    ifdef LPSM_HAS_THREADS
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i)
+    {
+        threads.emplace_back(
+                [&registry, &dogs, i]()
+                {
+                    dogs[i] = registry.get(i % 2 == 0 ? "dog" : "doggo");
+                });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+#    else
+    for (auto& dog : dogs)
+    {
+        dog = registry.get("dog");
+    }
+#    endif
+    for (const auto& dog : dogs)
+    {
+        if (dog != dogs.front() || dog->word_at(0) != "doggo")
+        {
+            LogTestFailure("source_registry");
+        }
+    }
+
+    // generators sharing a source match generators loading it themselves
+    lpsm::Generator shared(cat, 7);
+    lpsm::Generator loaded("cat", 7);
+    if (shared.source() != cat || shared.paragraph(3) != loaded.paragraph(3) ||
+        lpsm::Generator().source() != lpsm::Generator(1).source())
+    {
+        LogTestFailure("source_registry");
+    }
+
+    lpsm::Source custom;
+    custom.load_buffer("only words here");
+    auto stored = registry.insert("custom", custom);
+    if (registry.get("custom") != stored || stored->size() != 3 ||
+        !registry.erase("custom") || registry.erase("custom"))
+    {
+        LogTestFailure("source_registry");
+    }
+    registry.clear();
+    if (registry.size() != 0 || registry.get("cat") == cat)
+    {
+        LogTestFailure("source_registry");
+    }
+
+    // a path that fails to load is not kept, and loads once it exists
+    const std::string missing = "test_registry_source.txt";
+    std::remove(missing.c_str());
+    auto fallback = registry.get(missing);
+    if (fallback != registry.get("default") || registry.size() != 2)
+    {
+        LogTestFailure("source_registry");
+    }
+    {
+        std::ofstream file(missing);
+        file << "appeared later";
+    }
+    auto appeared = registry.get(missing);
+
+    // generators given a path read it afresh, so they see changes
+    lpsm::Generator reloaded(missing);
+    {
+        std::ofstream file(missing);
+        file << "rewritten";
+    }
+    reloaded.load_source(missing);
+    std::remove(missing.c_str());
+    if (appeared == fallback || appeared->size() != 2 ||
+        appeared->word_at(0) != "appeared" ||
+        reloaded.source()->size() != 1 ||
+        reloaded.source()->word_at(0) != "rewritten")
+    {
+        LogTestFailure("source_registry");
+    }
+}
+
+static void Test_word_frequencies(lpsm::Generator&)
+{
+    constexpr int NUM_PICKS = 100'000;
+
+    // counts survive threads and stream blocks
+    std::string text;
+    for (int i = 0; i < 200'000; ++i)
+    {
+        text += (i % 10 == 0) ? "Rare " : "common ";
+    }
+    lpsm::Source       serial;
+    lpsm::Source       parallel;
+    lpsm::Source       streamed;
+    std::istringstream stream(text);
+    serial.load_buffer(text);
+    parallel.load_buffer(text, "buffer", 4);
+    streamed.load_stream(stream);
+    for (const lpsm::Source* source : {&serial, &parallel, &streamed})
+    {
+        if (source->size() != 2 || source->weight_at(0) != 20'000 ||
+            source->weight_at(1) != 180'000)
+        {
+            LogTestFailure("word_frequencies");
+        }
+    }
+
+    lpsm::Engine engine(lpsm::EngineType::Xoshiro256ss, 1);
+    std::mt19937 mt(1);
+    int          rare   = 0;
+    int          rareMt = 0;
+    for (int i = 0; i < NUM_PICKS; ++i)
+    {
+        rare   += serial.weighted_word_view(engine) == "rare" ? 1 : 0;
+        rareMt += serial.weighted_word_view(mt) == "rare" ? 1 : 0;
+    }
+    if (std::abs(rare - (NUM_PICKS / 10)) > NUM_PICKS / 100 ||
+        std::abs(rareMt - (NUM_PICKS / 10)) > NUM_PICKS / 100)
+    {
+        LogTestFailure("word_frequencies");
+    }
+
+    // built-in sources carry the counts of their sample text
+    lpsm::Source lorem;
+    if (!lorem.has_weights() || lorem.word_at(0) != "lorem" ||
+        lorem.weight_at(0) == 0)
+    {
+        LogTestFailure("word_frequencies");
+    }
+
+    lpsm::Generator gen(std::make_shared<const lpsm::Source>(serial), 3);
+    gen.use_word_frequencies(true);
+    std::string words = gen.word(NUM_PICKS / 10);
+    if (words.find("common") == std::string::npos)
+    {
+        LogTestFailure("word_frequencies");
+    }
+}
+
+static void Test_benchmark_word_frequencies(lpsm::Generator& gen)
+{
+    constexpr int NUM_RUNS = NUM_BENCHMARKS / 10;
+
+    gen.load_source("corpo");
+    for (bool useFrequencies : {false, true})
+    {
+        gen.use_word_frequencies(useFrequencies);
+        std::string words;
+        auto        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < NUM_RUNS; ++i)
+        {
+            words.clear();
+            gen.word_into(words, BENCHMARK_NUM);
+        }
+        auto milli = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+        std::cout << (useFrequencies ? "by frequency" : "uniform") << ": "
+                  << static_cast<float>(milli.count()) / NUM_RUNS << " ms\n";
+    }
+    gen.use_word_frequencies(false);
+    gen.load_source("default");
+}
+
+static void Test_benchmark_source_load(lpsm::Generator& gen)
+{
+    constexpr int         NUM_RUNS      = NUM_BENCHMARKS / 10;
+    constexpr const char* PATH          = "benchmark_source.txt";
+    constexpr const char* COMPILED_PATH = "benchmark_source.lpsmsrc";
+
+    constexpr int         NUM_PARTS = 10;
+
+    // about 40 MB of text with about a million unique words
+    {
+        std::ofstream file(PATH, std::ios::binary);
+        for (int part = 0; part < NUM_PARTS; ++part)
+        {
+            file << gen.paragraph(BENCHMARK_NUM / 100, false) << '\n';
+            for (int i = part; i < BENCHMARK_NUM; i += NUM_PARTS)
+            {
+                file << 'w' << i << ' ';
+            }
+        }
+    }
+
+    for (unsigned int threads : {1U, 0U})
+    {
+        lpsm::Source source;
+        auto         start = std::chrono::steady_clock::now();
+        for (int i = 0; i < NUM_RUNS; ++i)
+        {
+            source.load(PATH, threads);
+        }
+        auto milli = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+        std::cout << (threads == 1 ? "1 thread" : "all threads") << ": "
+                  << static_cast<float>(milli.count()) / NUM_RUNS << " ms, "
+                  << source.size() << " words\n";
+    }
+
+    lpsm::Source(PATH).save(COMPILED_PATH);
+    lpsm::Source source;
+    auto         start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_RUNS; ++i)
+    {
+        source.load(COMPILED_PATH);
+    }
+    auto micro = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+    std::cout << "compiled: " << static_cast<float>(micro.count()) / NUM_RUNS
+              << " us, " << source.size() << " words\n";
+    std::remove(PATH);
+    std::remove(COMPILED_PATH);
+}
+
+static void Test_markov_source(lpsm::Generator&)
+{
+    constexpr const char* PATH      = "test_markov.lpsmmkv";
+    constexpr int         NUM_PICKS = 30'000;
+
+    const std::unordered_map<std::string_view, std::string_view> FOLLOWERS = {
+            {"the", "cat dog"},
+            {"cat", "sat ran"},
+            {"dog", "sat"},
+            {"sat", "the"},
+            {"ran", "the"}};
+
+    auto model = std::make_shared<lpsm::MarkovSource>();
+    if (!model->train("The cat sat. The cat ran!\nThe dog sat? ", 1) ||
+        model->size() != 5 || model->order() != 1 ||
+        model->state_count() != 6 || model->edge_count() != 6)
+    {
+        LogTestFailure("markov_source");
+    }
+
+    // every word follows the one before it in the corpus, and sentence ends
+    // start over
+    std::mt19937     mt(5);
+    std::uint32_t    state = lpsm::MarkovSource::START_STATE;
+    std::string_view last  = model->next_word(mt, state);
+    int              cats  = 0;
+    int              thes  = 0;
+    for (int i = 0; i < NUM_PICKS; ++i)
+    {
+        std::string_view word = model->next_word(mt, state);
+        if (FOLLOWERS.at(last).find(word) == std::string_view::npos)
+        {
+            LogTestFailure("markov_source");
+        }
+        thes += last == "the" ? 1 : 0;
+        cats += last == "the" && word == "cat" ? 1 : 0;
+        last  = word;
+    }
+    if (std::abs((cats * 3) - (thes * 2)) > thes / 20)
+    {
+        LogTestFailure("markov_source");
+    }
+
+    // a saved model is mapped in place and picks the same words
+    if (!model->save(PATH))
+    {
+        LogTestFailure("markov_source");
+    }
+    lpsm::MarkovSource mapped(PATH);
+    lpsm::Engine       trainedGen(lpsm::EngineType::Pcg32, 9);
+    lpsm::Engine       mappedGen(lpsm::EngineType::Pcg32, 9);
+    std::uint32_t      trainedState = lpsm::MarkovSource::START_STATE;
+    std::uint32_t      mappedState  = lpsm::MarkovSource::START_STATE;
+    if (mapped.size() != model->size() || mapped.order() != 1)
+    {
+        LogTestFailure("markov_source");
+    }
+    for (int i = 0; i < NUM_PICKS; ++i)
+    {
+        if (model->next_word(trainedGen, trainedState) !=
+            mapped.next_word(mappedGen, mappedState))
+        {
+            LogTestFailure("markov_source");
+        }
+    }
+
+    // a damaged file is rejected
+    {
+        std::fstream file(PATH,
+                          std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(56);
+        file.put('\x7F');
+    }
+    lpsm::MarkovSource damaged;
+    if (damaged.load(PATH) || damaged.size() != 0)
+    {
+        LogTestFailure("markov_source");
+    }
+    std::remove(PATH);
+
+    // sentences start like the corpus, and empty models are ignored
+    lpsm::Generator gen(7);
+    gen.load_markov(model);
+    gen.load_markov(std::make_shared<lpsm::MarkovSource>());
+    for (int i = 0; i < 100; ++i)
+    {
+        std::string sentence = gen.sentence(1, false);
+        if (!sentence.starts_with("The "))
+        {
+            LogTestFailure("markov_source");
+        }
+    }
+
+    // reseeding starts the chain over, wherever it was left
+    gen.load_seed(7);
+    std::string seeded = gen.word(6);
+    gen.word(5);
+    gen.load_seed(7);
+    if (gen.word(6) != seeded)
+    {
+        LogTestFailure("markov_source");
+    }
+    gen.load_markov(nullptr);
+    if (gen.markov() != nullptr)
+    {
+        LogTestFailure("markov_source");
+    }
+}
+
+static void Test_benchmark_markov_words(lpsm::Generator& gen)
+{
+    constexpr int NUM_RUNS = NUM_BENCHMARKS / 10;
+
+    gen.load_source("corpo");
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_RUNS; ++i)
+    {
+        std::string words;
+        gen.word_into(words, BENCHMARK_NUM);
+    }
+    auto milli = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+    std::cout << "uniform: " << static_cast<float>(milli.count()) / NUM_RUNS
+              << " ms\n";
+
+    // a model that fits in cache, and one that does not
+    for (int paragraphs : {BENCHMARK_NUM / 1000, BENCHMARK_NUM / 100})
+    {
+        auto model = std::make_shared<lpsm::MarkovSource>();
+        gen.load_markov(nullptr);
+        model->train(gen.paragraph(paragraphs, false), 2);
+        gen.load_markov(model);
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < NUM_RUNS; ++i)
+        {
+            std::string words;
+            gen.word_into(words, BENCHMARK_NUM);
+        }
+        milli = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+        std::cout << "markov, " << model->edge_count()
+                  << " transitions: "
+                  << static_cast<float>(milli.count()) / NUM_RUNS << " ms\n";
+    }
+    gen.load_markov(nullptr);
+    gen.load_source("default");
+}
+
+static void Test_parallel_generator(lpsm::Generator& gen)
+{
+    constexpr std::size_t                 NUM_PARAGRAPHS = 300;
+    constexpr std::size_t                 NUM_ELEMENTS   = 200;
+    constexpr std::size_t                 NUM_ROWS       = 3000;
+    constexpr std::array<unsigned int, 3> THREADS        = {1, 2, 8};
+
+    lpsm::ParallelGenerator pgen(42, gen, 1);
+    std::string             paragraphs = pgen.paragraph(NUM_PARAGRAPHS);
+    std::string             md         = pgen.fmt_text(NUM_ELEMENTS);
+    std::string             html       = pgen.fmt_text(NUM_ELEMENTS, true);
+    std::string             csv        = pgen.csv(NUM_ROWS);
+    if (paragraphs.find("Lorem ipsum") == std::string::npos ||
+        static_cast<std::size_t>(std::count(csv.begin(), csv.end(), '\n')) !=
+                NUM_ROWS + 1 ||
+        html.rfind("<h1>", 0) != 0 || md.rfind("# ", 0) != 0)
+    {
+        LogTestFailure("parallel_generator");
+    }
+
+    // the thread count never changes the output
+    for (unsigned int threads : THREADS)
+    {
+        pgen.set_threads(threads);
+        if (pgen.paragraph(NUM_PARAGRAPHS) != paragraphs ||
+            pgen.fmt_text(NUM_ELEMENTS) != md ||
+            pgen.fmt_text(NUM_ELEMENTS, true) != html ||
+            pgen.csv(NUM_ROWS) != csv)
+        {
+            LogTestFailure("parallel_generator");
+        }
+
+        lpsm::StringSink sink;
+        pgen.paragraph_to(sink, NUM_PARAGRAPHS);
+        pgen.fmt_text_to(sink, NUM_ELEMENTS);
+        pgen.csv_to(sink, NUM_ROWS);
+        if (sink.str() != paragraphs + md + csv)
+        {
+            LogTestFailure("parallel_generator");
+        }
+    }
+
+    pgen.load_seed(43);
+    if (pgen.paragraph(NUM_PARAGRAPHS) == paragraphs)
+    {
+        LogTestFailure("parallel_generator");
+    }
+
+    // two headers never follow each other, across blocks as within them
+    auto headersInARow = [](std::string_view doc)
+    {
+        bool lastHeader = false;
+        while (!doc.empty())
+        {
+            std::size_t end = doc.find("\n\n");
+            bool header = doc.starts_with('#') ||
+                          (doc.starts_with("<h") && doc.size() > 2 &&
+                           std::isdigit(static_cast<unsigned char>(doc[2])));
+            if (header && lastHeader)
+            {
+                return true;
+            }
+            lastHeader = header;
+            doc.remove_prefix(end == doc.npos ? doc.size() : end + 2);
+        }
+        return false;
+    };
+    for (int seed = 0; seed < 20; ++seed)
+    {
+        pgen.load_seed(seed);
+        if (headersInARow(pgen.fmt_text(NUM_ELEMENTS * 5)) ||
+            headersInARow(pgen.fmt_text(NUM_ELEMENTS * 5, true)))
+        {
+            LogTestFailure("parallel_generator");
+        }
+    }
+}
+
+static void Test_benchmark_parallel_paragraphs(lpsm::Generator& gen)
+{
+    constexpr std::size_t NUM_PARAGRAPHS = BENCHMARK_NUM / 16;
+    constexpr int         NUM_RUNS       = NUM_BENCHMARKS / 10;
+
+    lpsm::ParallelGenerator pgen(42, gen);
+    for (unsigned int threads : {1U, 0U})
+    {
+        pgen.set_threads(threads);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < NUM_RUNS; ++i)
+        {
+            std::string paragraphs;
+            pgen.paragraph_into(paragraphs, NUM_PARAGRAPHS);
+        }
+        auto milli = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+        std::cout << (threads == 0 ? "all" : std::to_string(threads))
+                  << " threads: "
+                  << static_cast<float>(milli.count()) / NUM_RUNS << " ms\n";
+    }
+}
+
+static void Test_generator_pool(lpsm::Generator& gen)
+{
+    constexpr std::size_t CAPACITY = 4;
+
+    lpsm::GeneratorPool      pool(42, gen, CAPACITY);
+    lpsm::GeneratorPool      samePool(42, gen, CAPACITY);
+    std::vector<std::string> sentences;
+    std::vector<std::string> sameSentences;
+    {
+        std::vector<lpsm::GeneratorPool::Lease> leases;
+        std::vector<lpsm::GeneratorPool::Lease> sameLeases;
+        for (std::size_t i = 0; i <= CAPACITY; ++i)
+        {
+            leases.push_back(pool.acquire());
+            sameLeases.push_back(samePool.acquire());
+            sentences.push_back(leases.back()->sentence(1, false));
+            sameSentences.push_back(sameLeases.back()->sentence(1, false));
+            if (leases.back().pooled() != (i < CAPACITY))
+            {
+                LogTestFailure("generator_pool");
+            }
+        }
+    }
+
+    // every generator has its own stream of the seed, and the same seed
+    // gives the same streams
+    std::sort(sentences.begin(), sentences.end());
+    std::sort(sameSentences.begin(), sameSentences.end());
+    if (sentences != sameSentences ||
+        std::adjacent_find(sentences.begin(), sentences.end()) !=
+                sentences.end() ||
+        pool.capacity() != CAPACITY)
+    {
+        LogTestFailure("generator_pool");
+    }
+
+    // a thread gets its last generator back
+    lpsm::Generator* last = nullptr;
+    {
+        auto lease = pool.acquire();
+        last       = &*lease;
+    }
+    if (&*pool.acquire() != last)
+    {
+        LogTestFailure("generator_pool");
+    }
+
+#    ifdef LPSM_HAS_THREADS
+    // more threads than generators
+    auto work = [&pool]
+    {
+        std::size_t size = 0;
+        for (int i = 0; i < 1000; ++i)
+        {
+            size += pool.acquire()->word().size();
+        }
+        return size;
+    };
+    std::vector<std::future<std::size_t>> tasks;
+    for (std::size_t t = 0; t < CAPACITY * 2; ++t)
+    {
+        tasks.push_back(std::async(std::launch::async, work));
+    }
+    for (auto& task : tasks)
+    {
+        if (task.get() == 0)
+        {
+            LogTestFailure("generator_pool");
+        }
+    }
+#    endif
+}
+
+static void Test_benchmark_generator_pool(lpsm::Generator& gen)
+{
+    constexpr int NUM_REQUESTS = BENCHMARK_NUM / 100;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_REQUESTS; ++i)
+    {
+        lpsm::Generator perRequest;
+        (void)perRequest;
+    }
+    auto nano = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start);
+    std::cout << "new generator: "
+              << static_cast<float>(nano.count()) / NUM_REQUESTS << " ns\n";
+
+    lpsm::GeneratorPool pool(42, gen);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_REQUESTS; ++i)
+    {
+        auto lease = pool.acquire();
+        (void)lease;
+    }
+    nano = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start);
+    std::cout << "pooled generator: "
+              << static_cast<float>(nano.count()) / NUM_REQUESTS << " ns\n";
+}
+
+static void Test_random_access(lpsm::Generator& gen)
+{
+    constexpr std::array<lpsm::EngineType, 2> TYPES = {
+            lpsm::EngineType::Philox4x32, lpsm::EngineType::MT19937};
+    constexpr int NUM_UNITS = 40;
+    constexpr int SPLIT     = 13;
+
+    // known-answer tests of Philox4x32-10 from the Random123 distribution
+    using Philox = lpsm::Philox4x32;
+    if (Philox::encrypt({0, 0, 0, 0}, {0, 0}) !=
+                Philox::Block{0x6627E8D5, 0xE169C58D, 0xBC57AC4C, 0x9B00DBD8} ||
+        Philox::encrypt({0x243F6A88, 0x85A308D3, 0x13198A2E, 0x03707344},
+                        {0xA4093822, 0x299F31D0}) !=
+                Philox::Block{0xD16CFE09, 0x94FDCCEB, 0x5001E420, 0x24126EA1})
+    {
+        LogTestFailure("random_access");
+    }
+
+    for (lpsm::EngineType type : TYPES)
+    {
+        gen.load_engine(type);
+        gen.load_seed(11);
+        std::string words      = gen.word_at(0, NUM_UNITS);
+        std::string sentences  = gen.sentence_at(0, NUM_UNITS);
+        std::string paragraphs = gen.paragraph_at(0, NUM_UNITS);
+        std::string csv        = gen.csv_at(0, NUM_UNITS);
+        std::string json       = gen.json_at(NUM_UNITS);
+
+        // the same units, in pieces and after other draws
+        (void)gen.paragraph(3);
+        if (gen.word_at(0, SPLIT) + gen.word_at(SPLIT, NUM_UNITS - SPLIT) !=
+                    words ||
+            gen.sentence_at(0, SPLIT) +
+                            gen.sentence_at(SPLIT, NUM_UNITS - SPLIT) !=
+                    sentences ||
+            gen.paragraph_at(0, SPLIT) +
+                            gen.paragraph_at(SPLIT, NUM_UNITS - SPLIT) !=
+                    paragraphs ||
+            gen.csv_at(0, SPLIT) + gen.csv_at(SPLIT, NUM_UNITS - SPLIT) !=
+                    csv ||
+            gen.json_at(NUM_UNITS) != json)
+        {
+            LogTestFailure("random_access");
+        }
+
+        if (sentences.rfind("Lorem ipsum", 0) != 0 ||
+            static_cast<int>(std::count(csv.begin(), csv.end(), '\n')) !=
+                    NUM_UNITS + 1 ||
+            gen.paragraph_at(1) == gen.paragraph_at(2))
+        {
+            LogTestFailure("random_access");
+        }
+
+        gen.load_seed(12);
+        if (gen.paragraph_at(0, NUM_UNITS) == paragraphs)
+        {
+            LogTestFailure("random_access");
+        }
+    }
+    gen.load_engine(lpsm::EngineType::MT19937);
+}
+
+static void Test_benchmark_random_access(lpsm::Generator& gen)
+{
+    constexpr std::array<lpsm::EngineType, 2> TYPES = {
+            lpsm::EngineType::MT19937, lpsm::EngineType::Philox4x32};
+    constexpr int NUM_PARAGRAPHS = BENCHMARK_NUM / 100;
+
+    for (lpsm::EngineType type : TYPES)
+    {
+        gen.load_engine(type);
+        gen.load_seed(42);
+        auto start = std::chrono::steady_clock::now();
+        (void)gen.paragraph(NUM_PARAGRAPHS);
+        auto milli = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+
+        // far from the start, which a sequential generator would replay
+        start = std::chrono::steady_clock::now();
+        (void)gen.paragraph_at(std::uint64_t{1} << 40, NUM_PARAGRAPHS);
+        auto atMilli = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+
+        std::cout << lpsm::Engine::name(type) << ": " << NUM_PARAGRAPHS
+                  << " paragraphs in " << milli.count() << " ms, "
+                  << "by index in " << atMilli.count() << " ms\n";
+    }
+    gen.load_engine(lpsm::EngineType::MT19937);
+}
+
+static void Test_text_views(lpsm::Generator& gen)
+{
+    static_assert(std::ranges::input_range<lpsm::TextView> &&
+                  std::ranges::view<lpsm::TextView>);
+    constexpr int NUM_UNITS = 30;
+
+    gen.load_seed(21);
+    std::string words      = gen.word(NUM_UNITS);
+    std::string sentences  = gen.sentence(NUM_UNITS);
+    std::string paragraphs = gen.paragraph(NUM_UNITS);
+
+    // the same draws, one element at a time
+    gen.load_seed(21);
+    std::string viewWords;
+    for (std::string_view word : gen.words() | std::views::take(NUM_UNITS))
+    {
+        if (!viewWords.empty())
+        {
+            viewWords += ' ';
+        }
+        viewWords += word;
+    }
+    std::string viewSentences;
+    for (std::string_view sentence :
+         gen.sentences() | std::views::take(NUM_UNITS))
+    {
+        viewSentences += sentence;
+        viewSentences += ' ';
+    }
+    std::string viewParagraphs;
+    for (std::string_view paragraph :
+         gen.paragraphs() | std::views::take(NUM_UNITS))
+    {
+        viewParagraphs += paragraph;
+    }
+    if (viewWords != words || viewSentences != sentences ||
+        viewParagraphs != paragraphs)
+    {
+        LogTestFailure("text_views");
+    }
+
+    // only the elements taken are drawn, even those skipped unread
+    gen.load_seed(22);
+    std::string sixWords = gen.word(6);
+    gen.load_seed(22);
+    auto taken = gen.words() | std::views::take(5);
+    for (auto it = taken.begin(); it != taken.end(); ++it)
+    {
+    }
+    if (!sixWords.ends_with(" " + gen.word()))
+    {
+        LogTestFailure("text_views");
+    }
+
+    gen.load_seed(23);
+    auto lipsum   = gen.sentences();
+    auto noLipsum = gen.sentences(false);
+    if ((*lipsum.begin()).rfind("Lorem ipsum", 0) != 0 ||
+        (*noLipsum.begin()).rfind("Lorem ipsum", 0) == 0)
+    {
+        LogTestFailure("text_views");
+    }
+}
+
+static void Test_chunk_streams(lpsm::Generator& gen)
+{
+    static_assert(std::ranges::input_range<lpsm::ChunkStream> &&
+                  std::ranges::view<lpsm::ChunkStream>);
+    constexpr std::array<std::size_t, 3> CHUNK_SIZES = {
+            1, 100, lpsm::Sink::DEFAULT_CAPACITY};
+    constexpr int NUM_ELEMENTS = 40;
+    constexpr int NUM_CHOICES  = 300;
+    constexpr int JSON_DEPTH   = 5;
+
+    for (std::size_t chunkSize : CHUNK_SIZES)
+    {
+        gen.load_seed(31);
+        std::string text = gen.fmt_text(NUM_ELEMENTS, lpsm::HTML);
+        std::string xml  = gen.xml(NUM_CHOICES);
+        std::string json = gen.json(JSON_DEPTH, lpsm::ARRAY);
+
+        // the same draws, pulled a chunk at a time; every chunk but the last
+        // is full
+        gen.load_seed(31);
+        auto join = [chunkSize](lpsm::ChunkStream stream)
+        {
+            std::string joined;
+            std::size_t lastSize = chunkSize;
+            for (std::string_view chunk : stream)
+            {
+                if (lastSize < chunkSize || chunk.empty())
+                {
+                    LogTestFailure("chunk_streams");
+                }
+                joined += chunk;
+                lastSize = chunk.size();
+            }
+            return joined;
+        };
+        if (join(gen.fmt_text_stream(NUM_ELEMENTS, lpsm::HTML, chunkSize)) !=
+                    text ||
+            join(gen.xml_stream(NUM_CHOICES, chunkSize)) != xml ||
+            join(gen.json_stream(JSON_DEPTH, lpsm::ARRAY, chunkSize)) != json)
+        {
+            LogTestFailure("chunk_streams");
+        }
+    }
+
+    // nothing is drawn until a chunk is asked for, and a stream can be
+    // dropped halfway
+    gen.load_seed(32);
+    std::string sentence = gen.sentence();
+    gen.load_seed(32);
+    {
+        lpsm::ChunkStream unused = gen.xml_stream();
+        lpsm::ChunkStream dropped =
+                gen.json_stream(JSON_DEPTH, lpsm::OBJECT, 1);
+        (void)dropped.next();
+        (void)dropped.next();
+    }
+    gen.load_seed(32);
+    lpsm::ChunkStream stream = gen.fmt_text_stream(0);
+    if (!stream.next().empty() || !stream.next().empty() ||
+        gen.sentence() != sentence)
+    {
+        LogTestFailure("chunk_streams");
+    }
+}
+
+static void Test_benchmark_chunk_streams(lpsm::Generator& gen)
+{
+    constexpr int NUM_CHOICES = BENCHMARK_NUM * 4;
+
+    gen.load_seed(42);
+    auto start = std::chrono::steady_clock::now();
+    std::string whole = gen.xml(NUM_CHOICES);
+    auto milli = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+    std::cout << "xml(): " << whole.size() << " bytes in " << milli.count()
+              << " ms, " << whole.capacity() << " bytes held\n";
+
+    gen.load_seed(42);
+    std::size_t total   = 0;
+    std::size_t largest = 0;
+    start               = std::chrono::steady_clock::now();
+    for (std::string_view chunk : gen.xml_stream(NUM_CHOICES))
+    {
+        total += chunk.size();
+        largest = std::max(largest, chunk.size());
+    }
+    milli = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+    std::cout << "xml_stream(): " << total << " bytes in " << milli.count()
+              << " ms, largest chunk " << largest << " bytes\n";
+}
+
+static void Test_byte_budget(lpsm::Generator& gen)
+{
+    constexpr std::array<std::size_t, 8> BUDGETS = {
+            9, 10, 64, 100, 177, 4096, 65'536 + 7, 1'048'576};
+
+    gen.load_seed(41);
+    for (std::size_t bytes : BUDGETS)
+    {
+        std::string text = gen.paragraph_bytes(bytes);
+        std::string md   = gen.fmt_text_bytes(bytes, lpsm::MARKDOWN);
+        std::string html = gen.fmt_text_bytes(bytes, lpsm::HTML);
+        std::string json = gen.json_bytes(bytes);
+        if (text.size() != bytes || md.size() != bytes ||
+            html.size() != bytes || json.size() != bytes)
+        {
+            LogTestFailure("byte_budget");
+        }
+
+        // still well-formed: whole paragraphs, elements and members
+        auto count = [](const std::string& str, char chr)
+        {
+            return std::count(str.begin(), str.end(), chr);
+        };
+        if (text.front() != '\t' || text.back() != '\n' ||
+            count(text, '\t') != count(text, '\n') ||
+            !md.ends_with("\n\n") || !html.ends_with("</p>\n\n") ||
+            count(html, '<') != count(html, '>') || json.front() != '{' ||
+            json.back() != '}' || count(json, '{') != count(json, '}') ||
+            count(json, '[') != count(json, ']') || count(json, '"') % 2 != 0)
+        {
+            LogTestFailure("byte_budget");
+        }
+        if (bytes >= 100 && (text.find("  ") != std::string::npos ||
+                             json.find("  ") != std::string::npos))
+        {
+            // padding is only for sizes too small for a word
+            LogTestFailure("byte_budget");
+        }
+    }
+
+    // below the smallest document, nothing
+    if (gen.paragraph_bytes(2) != "\t\n" || !gen.json_bytes(1).empty() ||
+        !gen.fmt_text_bytes(8, lpsm::HTML).empty())
+    {
+        LogTestFailure("byte_budget");
+    }
+
+    // the same draws whether returned or written to a sink
+    lpsm::StringSink sink(64);
+    gen.load_seed(42);
+    std::string text = gen.paragraph_bytes(10'000);
+    std::string json = gen.json_bytes(10'000);
+    gen.load_seed(42);
+    gen.paragraph_bytes_to(sink, 10'000);
+    gen.json_bytes_to(sink, 10'000);
+    if (sink.str() != text + json || !text.starts_with("\tLorem ipsum"))
+    {
+        LogTestFailure("byte_budget");
+    }
+}
+
+static void Test_benchmark_byte_budget(lpsm::Generator& gen)
+{
+    constexpr std::size_t NUM_BYTES = std::size_t{64} << 20;
+
+    gen.load_seed(42);
+    std::string content;
+    auto        start = std::chrono::steady_clock::now();
+    while (content.size() < NUM_BYTES)
+    {
+        gen.paragraph_into(content);
+    }
+    auto milli = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+    std::cout << "paragraph() until " << NUM_BYTES << " bytes: "
+              << milli.count() << " ms\n";
+
+    content.clear();
+    start = std::chrono::steady_clock::now();
+    gen.paragraph_bytes_into(content, NUM_BYTES);
+    milli = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+    std::cout << "paragraph_bytes(" << NUM_BYTES << "): " << milli.count()
+              << " ms\n";
+}
+
+static void Test_format_policies(lpsm::Generator& gen)
+{
+    // each element in the markup of its format
+    gen.load_seed(43);
+    std::string md   = gen.fmt_header(2, lpsm::MARKDOWN);
+    std::string html = gen.fmt_header(2, lpsm::HTML);
+    if (!md.starts_with("## ") || !md.ends_with("\n\n") ||
+        !html.starts_with("<h2>") || !html.ends_with("</h2>\n\n"))
+    {
+        LogTestFailure("format_policies");
+    }
+
+    md   = gen.fmt_list(lpsm::ORDERED, lpsm::MARKDOWN);
+    html = gen.fmt_list(lpsm::ORDERED, lpsm::HTML);
+    if (!md.starts_with("1. ") || !md.ends_with("\n\n") ||
+        !html.starts_with("<ol><li>") || !html.ends_with("</li></ol>\n\n"))
+    {
+        LogTestFailure("format_policies");
+    }
+
+    md   = gen.fmt_link(lpsm::MARKDOWN);
+    html = gen.fmt_link(lpsm::HTML);
+    if (!md.starts_with('[') || md.find("](https://") == std::string::npos ||
+        !md.ends_with(')') || !html.starts_with("<a href=\"https://") ||
+        !html.ends_with("</a>"))
+    {
+        LogTestFailure("format_policies");
+    }
+
+    md   = gen.fmt_emphasis(lpsm::BOLD, lpsm::MARKDOWN);
+    html = gen.fmt_emphasis(lpsm::ITALIC, lpsm::HTML);
+    if (!md.starts_with("**") || !md.ends_with("**") ||
+        !html.starts_with("<em>") || !html.ends_with("</em>"))
+    {
+        LogTestFailure("format_policies");
+    }
+
+    // out-of-range levels are still written, as before
+    if (gen.fmt_header(8, lpsm::HTML).find("</h8>") == std::string::npos ||
+        !gen.fmt_header(0, lpsm::MARKDOWN).starts_with(' '))
+    {
+        LogTestFailure("format_policies");
+    }
+
+    // whole documents: balanced tags, and the same text in every form
+    gen.load_seed(44);
+    html = gen.fmt_text(200, lpsm::HTML);
+    auto count = [&html](std::string_view tag)
+    {
+        std::size_t num = 0;
+        std::size_t pos = html.find(tag);
+        while (pos != std::string::npos)
+        {
+            ++num;
+            pos = html.find(tag, pos + 1);
+        }
+        return num;
+    };
+    if (count("<p>") != count("</p>") || count("<li>") != count("</li>") ||
+        count("<ol>") + count("<ul>") != count("</ol>") + count("</ul>") ||
+        count("<a ") != count("</a>"))
+    {
+        LogTestFailure("format_policies");
+    }
+
+    lpsm::StringSink sink(256);
+    gen.load_seed(44);
+    gen.fmt_text_to(sink, 200, lpsm::HTML);
+    gen.load_seed(44);
+    std::string streamed;
+    for (std::string_view chunk : gen.fmt_text_stream(200, lpsm::HTML, 256))
+    {
+        streamed += chunk;
+    }
+    if (sink.str() != html || streamed != html)
+    {
+        LogTestFailure("format_policies");
+    }
+}
+
+static void Test_html_escaping(lpsm::Generator& gen)
+{
+    auto escape = [](std::string_view str)
+    {
+        std::string ret;
+        for (char chr : str)
+        {
+            switch (chr)
+            {
+                case '&':
+                {
+                    ret += "&amp;";
+                    break;
+                }
+                case '<':
+                {
+                    ret += "&lt;";
+                    break;
+                }
+                case '>':
+                {
+                    ret += "&gt;";
+                    break;
+                }
+                case '"':
+                {
+                    ret += "&quot;";
+                    break;
+                }
+                case '\'':
+                {
+                    ret += "&apos;";
+                    break;
+                }
+                default:
+                {
+                    ret += chr;
+                }
+            }
+        }
+        return ret;
+    };
+
+    // entities at every position of the 16-byte blocks and after them
+    constexpr std::string_view SPECIAL = "&<>\"'";
+    for (std::size_t size = 0; size < 40; ++size)
+    {
+        for (std::size_t at = 0; at < size; ++at)
+        {
+            std::string str(size, 'a');
+            str[at] = SPECIAL[at % SPECIAL.size()];
+            std::string into = "x";
+            lpsm::internal::HandleHTMLEntityInto(into, str);
+            if (lpsm::internal::HandleHTMLEntity(str) != escape(str) ||
+                into != "x" + escape(str) ||
+                lpsm::internal::FindHTMLEntity(str) != at ||
+                lpsm::internal::FindHTMLEntity(str, at + 1) !=
+                        std::string::npos)
+            {
+                LogTestFailure("html_escaping");
+            }
+        }
+    }
+
+    // only the words that need it are escaped, once per load
+    auto source = std::make_shared<lpsm::Source>();
+    source->load_buffer("don't stop rock'n'roll o'clock plain words here");
+    if (!source->needs_escaping() || gen.source()->needs_escaping() ||
+        source->escaped_word(source->word_at(0)) != "don&apos;t" ||
+        source->escaped_word(source->word_at(2)) !=
+                "rock&apos;n&apos;roll" ||
+        source->escaped_word(source->word_at(1)).data() !=
+                source->word_at(1).data())
+    {
+        LogTestFailure("html_escaping");
+    }
+
+    // HTML and XML text escaped, Markdown left as is
+    lpsm::Generator escaped(source, 45);
+    std::string     html  = escaped.fmt_text(100, lpsm::HTML);
+    std::string     bytes = escaped.fmt_text_bytes(4096, lpsm::HTML);
+    std::string     md    = escaped.fmt_text(100, lpsm::MARKDOWN);
+    std::string     xml   = escaped.xml(100);
+    if (html.find('\'') != std::string::npos ||
+        html.find("&apos;") == std::string::npos ||
+        bytes.size() != 4096 || bytes.find('\'') != std::string::npos ||
+        md.find('\'') == std::string::npos ||
+        md.find("&apos;") != std::string::npos ||
+        xml.find("&apos;") == std::string::npos)
+    {
+        LogTestFailure("html_escaping");
+    }
+
+    // names are made of the words that are not names, once per load
+    std::string name = "x";
+    lpsm::internal::XmlNameInto(name, "30,000");
+    if (!lpsm::internal::IsXmlName("rock-n.roll_2") ||
+        lpsm::internal::IsXmlName("don't") ||
+        lpsm::internal::IsXmlName("2nd") || lpsm::internal::IsXmlName("") ||
+        name != "x_30_000" ||
+        source->xml_name(source->word_at(0)) != "don_t" ||
+        source->xml_name(source->word_at(1)).data() !=
+                source->word_at(1).data())
+    {
+        LogTestFailure("html_escaping");
+    }
+
+    // tags nest, names are names, and text and values hold no markup
+    auto wellFormed = [](std::string_view doc)
+    {
+        constexpr std::string_view DECL =
+                R"(<?xml version="1.0" encoding="UTF-8"?>)";
+        if (!doc.starts_with(DECL))
+        {
+            return false;
+        }
+        doc.remove_prefix(DECL.size());
+
+        std::vector<std::string_view> open;
+        while (!doc.empty())
+        {
+            std::size_t tag = doc.find('<');
+            if (doc.substr(0, tag).find_first_of("'\">") != doc.npos ||
+                tag == doc.npos)
+            {
+                return false;
+            }
+            std::size_t end = doc.find('>', tag);
+            if (end == doc.npos)
+            {
+                return false;
+            }
+            std::string_view inner = doc.substr(tag + 1, end - tag - 1);
+            doc.remove_prefix(end + 1);
+            if (inner.starts_with('/'))
+            {
+                if (open.empty() || open.back() != inner.substr(1))
+                {
+                    return false;
+                }
+                open.pop_back();
+                if (open.empty())
+                {
+                    return doc.empty();
+                }
+                continue;
+            }
+
+            std::size_t      space = inner.find(' ');
+            std::string_view elem  = inner.substr(0, space);
+            if (!lpsm::internal::IsXmlName(elem))
+            {
+                return false;
+            }
+            if (space != inner.npos)
+            {
+                std::string_view attrib = inner.substr(space + 1);
+                std::size_t      equals = attrib.find("=\"");
+                if (equals == attrib.npos || !attrib.ends_with('"') ||
+                    !lpsm::internal::IsXmlName(attrib.substr(0, equals)) ||
+                    attrib.substr(equals + 2, attrib.size() - equals - 3)
+                                    .find_first_of("<>\"'") != attrib.npos)
+                {
+                    return false;
+                }
+            }
+            open.push_back(elem);
+        }
+        return false;
+    };
+    auto named = std::make_shared<lpsm::Source>();
+    named->load_buffer("it's 30,000 don't o'clock -dash .dot rock'n'roll");
+    lpsm::Generator apostrophes(named, 12);
+    if (!wellFormed(xml) || !wellFormed(apostrophes.xml(200)) ||
+        !wellFormed(gen.xml(200)))
+    {
+        LogTestFailure("html_escaping");
+    }
+}
+
+static void Test_json_writer(lpsm::Generator& gen)
+{
+    constexpr std::array<int, 4> DEPTHS   = {0, 1, 4, 8};
+    constexpr std::size_t        CAPACITY = 64;
+
+    // brackets match, and nest no deeper than maxDepth + 1
+    auto wellFormed = [](std::string_view json, int maxDepth)
+    {
+        std::string open;
+        bool        inString = false;
+        for (char c : json)
+        {
+            if (c == '"')
+            {
+                inString = !inString;
+            }
+            else if (inString)
+            {
+                continue;
+            }
+            else if (c == '{' || c == '[')
+            {
+                open += (c == '{' ? '}' : ']');
+                if (std::cmp_greater(open.size(), maxDepth + 1))
+                {
+                    return false;
+                }
+            }
+            else if (c == '}' || c == ']')
+            {
+                if (open.empty() || open.back() != c)
+                {
+                    return false;
+                }
+                open.pop_back();
+            }
+        }
+        return open.empty() && !inString;
+    };
+
+    for (int maxDepth : DEPTHS)
+    {
+        for (bool isObject : {lpsm::OBJECT, lpsm::ARRAY})
+        {
+            gen.load_seed(static_cast<std::uint64_t>(60 + maxDepth));
+            std::string whole = gen.json(maxDepth, isObject);
+
+            gen.load_seed(static_cast<std::uint64_t>(60 + maxDepth));
+            std::string into = "x";
+            gen.json_into(into, maxDepth, isObject);
+
+            // written a member at a time through a small sink
+            gen.load_seed(static_cast<std::uint64_t>(60 + maxDepth));
+            std::string streamed;
+            int         chunks = 0;
+            {
+                lpsm::CallbackSink sink(
+                        [&](std::string_view chunk)
+                        {
+                            streamed += chunk;
+                            ++chunks;
+                            return true;
+                        },
+                        CAPACITY);
+                gen.json_to(sink, maxDepth, isObject);
+            }
+
+            if (into != "x" + whole || streamed != whole ||
+                (whole.size() > CAPACITY && chunks < 2) ||
+                whole.front() != (isObject ? '{' : '[') ||
+                !wellFormed(whole, maxDepth))
+            {
+                LogTestFailure("json_writer");
+            }
+        }
+
+        std::string value = gen.json_value(maxDepth);
+        if (value.empty() || !wellFormed(value, maxDepth))
+        {
+            LogTestFailure("json_writer");
+        }
+    }
+
+    // deep documents reserve little, and match the written ones
+    constexpr int DEEP = 200;
+    gen.load_seed(0);
+    std::string deep = gen.json(DEEP);
+    gen.load_seed(0);
+    std::string deepStreamed;
+    {
+        lpsm::CallbackSink sink(
+                [&](std::string_view chunk)
+                {
+                    deepStreamed += chunk;
+                    return true;
+                });
+        gen.json_to(sink, DEEP);
+    }
+    if (deep != deepStreamed || !wellFormed(deep, DEEP) ||
+        deep.capacity() > lpsm::Sink::DEFAULT_CAPACITY + deep.size())
+    {
+        LogTestFailure("json_writer");
+    }
+}
+#endif
+
 static void Test_benchmark_words(lpsm::Generator& gen)
 {
     BENCHMARK(word, 5.0f);
@@ -209,6 +2182,48 @@ static void Test_benchmark_paragraphs(lpsm::Generator& gen)
     BENCHMARK(paragraph, 0.0625f);
 }
 
+static void Test_benchmark_engines(lpsm::Generator& gen)
+{
+    constexpr std::array<lpsm::EngineType, 6> TYPES = {
+            lpsm::EngineType::MT19937,
+            lpsm::EngineType::Xoshiro256ss,
+            lpsm::EngineType::Pcg32,
+            lpsm::EngineType::Pcg64,
+            lpsm::EngineType::WyRand,
+            lpsm::EngineType::Philox4x32};
+    constexpr int NUM_DRAWS = BENCHMARK_NUM * 100;
+    constexpr int NUM_RUNS  = NUM_BENCHMARKS / 10;
+
+    for (lpsm::EngineType type : TYPES)
+    {
+        lpsm::Engine  engine(type);
+        std::uint32_t sink = 0;
+        auto          start = std::chrono::steady_clock::now();
+        for (int i = 0; i < NUM_DRAWS; ++i)
+        {
+            sink ^= engine();
+        }
+        auto drawMilli = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+
+        gen.load_engine(type);
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < NUM_RUNS; ++i)
+        {
+            std::string content = gen.word(BENCHMARK_NUM);
+            sink ^= static_cast<std::uint32_t>(content.size());
+        }
+        auto wordMilli = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+
+        std::cout << lpsm::Engine::name(type) << ": " << drawMilli.count()
+                  << " ms for " << NUM_DRAWS << " draws, "
+                  << static_cast<float>(wordMilli.count()) / NUM_RUNS
+                  << " ms per " << BENCHMARK_NUM << " words (" << sink
+                  << ")\n";
+    }
+}
+
 static void Test_benchmark_md_paragraphs(lpsm::Generator& gen)
 {
     BENCHMARK(fmt_paragraph, 0.0625f);
@@ -242,16 +2257,50 @@ int main(int argc, char** argv)
         TEST_MAP(sentence_count_equal),
         TEST_MAP(paragraph_count_in_bounds),
         TEST_MAP(paragraph_count_equal),
+        TEST_MAP(source_word_view),
+        TEST_MAP(sink_matches_string),
+        TEST_MAP(into_appends),
+        TEST_MAP(engine_reproducible),
+        TEST_MAP(sampler_in_bounds),
+        TEST_MAP(weighted_table),
+        TEST_MAP(predicted_size),
+        TEST_MAP(compile_time),
+        TEST_MAP(analyze_text),
+        TEST_MAP(tag_scanner),
+        TEST_MAP(text_stats_accumulator),
 #ifndef LIPSUM_MIN_BUILD
         TEST_MAP(md_sentence_count_in_bounds),
         TEST_MAP(md_paragraph_count_equal),
         TEST_MAP(md_text_count_equal),
         TEST_MAP(benchmark_md_paragraphs),
         TEST_MAP(benchmark_md_text),
+        TEST_MAP(source_tokenizer),
+        TEST_MAP(source_compiled),
+        TEST_MAP(source_registry),
+        TEST_MAP(word_frequencies),
+        TEST_MAP(benchmark_word_frequencies),
+        TEST_MAP(benchmark_source_load),
+        TEST_MAP(markov_source),
+        TEST_MAP(benchmark_markov_words),
+        TEST_MAP(parallel_generator),
+        TEST_MAP(benchmark_parallel_paragraphs),
+        TEST_MAP(generator_pool),
+        TEST_MAP(benchmark_generator_pool),
+        TEST_MAP(random_access),
+        TEST_MAP(benchmark_random_access),
+        TEST_MAP(text_views),
+        TEST_MAP(chunk_streams),
+        TEST_MAP(benchmark_chunk_streams),
+        TEST_MAP(byte_budget),
+        TEST_MAP(benchmark_byte_budget),
+        TEST_MAP(format_policies),
+        TEST_MAP(html_escaping),
+        TEST_MAP(json_writer),
 #endif
         TEST_MAP(benchmark_words),
         TEST_MAP(benchmark_sentences),
-        TEST_MAP(benchmark_paragraphs)
+        TEST_MAP(benchmark_paragraphs),
+        TEST_MAP(benchmark_engines)
     };
     // clang-format on
 